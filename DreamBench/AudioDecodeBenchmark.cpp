@@ -0,0 +1,151 @@
+#include "AudioDecodeBenchmark.h"
+
+#include <atomic>
+#include <thread>
+
+using std::atomic;
+using std::thread;
+
+namespace octronic::dream::bench
+{
+  AudioDecodeBenchmark::AudioDecodeBenchmark
+  (const string& directory, unsigned int threads, unsigned int repeat)
+    : mDirectory(directory),
+      mThreads(threads == 0 ? 1 : threads),
+      mRepeat(repeat == 0 ? 1 : repeat)
+  {
+  }
+
+  bool
+  AudioDecodeBenchmark::readFiles
+  ()
+  {
+    StorageManager sm;
+    auto& dir = sm.openDirectory(mDirectory);
+
+    if (!dir.exists())
+    {
+      LOG_ERROR("AudioDecodeBenchmark: Directory {} does not exist", mDirectory);
+      return false;
+    }
+
+    for (auto& name : dir.list("\\.ogg$"))
+    {
+      auto& file = sm.openFile(dir.getPath() + Constants::DIRECTORY_PATH_SEP + name);
+      if (file.readBinary())
+      {
+        EncodedFile& encoded = mFiles.emplace_back();
+        encoded.name = name;
+        encoded.data.swap(file.getBinaryData());
+      }
+      sm.closeFile(file);
+    }
+
+    sm.closeDirectory(dir);
+    return !mFiles.empty();
+  }
+
+  json
+  AudioDecodeBenchmark::runPass
+  (unsigned int threads)
+  const
+  {
+    size_t fileCount = mFiles.size() * mRepeat;
+    vector<size_t> pcmBytes(fileCount, 0);
+    vector<double> audioSeconds(fileCount, 0.0);
+    atomic<size_t> nextFile(0);
+    atomic<unsigned int> failures(0);
+
+    auto worker = [&]()
+    {
+      // One loader per thread, decode state is per instance
+      OggLoader loader;
+      size_t index;
+      while ((index = nextFile++) < fileCount)
+      {
+        auto& encoded = mFiles[index % mFiles.size()];
+        loader.setData(encoded.data.data(), encoded.data.size());
+        if (loader.decodeIntoBuffer())
+        {
+          pcmBytes[index] = loader.getAudioBuffer().size();
+          audioSeconds[index] = static_cast<double>(loader.getDurationInSamples()) / loader.getSampleRate();
+        }
+        else
+        {
+          failures++;
+        }
+      }
+    };
+
+    uint64_t start = SteadyClock::Now();
+    vector<thread> workers;
+    for (unsigned int i = 0; i < threads; i++)
+    {
+      workers.emplace_back(worker);
+    }
+    for (auto& t : workers)
+    {
+      t.join();
+    }
+    double seconds = (SteadyClock::Now() - start) / 1e9;
+
+    size_t totalPcmBytes = 0;
+    double totalAudioSeconds = 0.0;
+    for (size_t i = 0; i < fileCount; i++)
+    {
+      totalPcmBytes += pcmBytes[i];
+      totalAudioSeconds += audioSeconds[i];
+    }
+
+    json pass;
+    pass["threads"] = threads;
+    pass["decodes"] = fileCount;
+    pass["failures"] = failures.load();
+    pass["seconds"] = seconds;
+    pass["pcm_bytes"] = totalPcmBytes;
+    pass["audio_seconds"] = totalAudioSeconds;
+    pass["pcm_mb_per_second"] = seconds > 0.0 ? (totalPcmBytes / (1024.0*1024.0)) / seconds : 0.0;
+    pass["realtime_factor"] = seconds > 0.0 ? totalAudioSeconds / seconds : 0.0;
+    return pass;
+  }
+
+  bool
+  AudioDecodeBenchmark::run
+  ()
+  {
+    mResults = json::object();
+    mResults["benchmark"] = "audio_decode";
+    mResults["directory"] = mDirectory;
+
+    if (!readFiles())
+    {
+      LOG_ERROR("AudioDecodeBenchmark: No .ogg files found in {}", mDirectory);
+      return false;
+    }
+
+    size_t encodedBytes = 0;
+    for (auto& encoded : mFiles)
+    {
+      encodedBytes += encoded.data.size();
+    }
+
+    mResults["files"] = mFiles.size();
+    mResults["repeat"] = mRepeat;
+    mResults["encoded_bytes"] = encodedBytes;
+    mResults["passes"] = json::array();
+    mResults["passes"].push_back(runPass(1));
+    if (mThreads > 1)
+    {
+      mResults["passes"].push_back(runPass(mThreads));
+    }
+    return true;
+  }
+
+  json
+  AudioDecodeBenchmark::getResults
+  ()
+  const
+  {
+    return mResults;
+  }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <DreamCore.h>
+
+#include <string>
+#include <vector>
+#include <json.hpp>
+
+using std::string;
+using std::vector;
+using nlohmann::json;
+
+namespace octronic::dream::bench
+{
+  /**
+   * @brief Measures Ogg decode throughput over every .ogg file in a
+   * directory. Files are read into memory up front so only decoding is
+   * timed, then decoded once on a single thread and once spread across
+   * the requested number of threads, each thread with its own OggLoader.
+   */
+  class AudioDecodeBenchmark
+  {
+  public:
+    AudioDecodeBenchmark(const string& directory, unsigned int threads, unsigned int repeat);
+
+    bool run();
+    json getResults() const;
+
+  private:
+    struct EncodedFile
+    {
+      string name;
+      vector<uint8_t> data;
+    };
+
+    bool readFiles();
+    json runPass(unsigned int threads) const;
+
+  private:
+    string mDirectory;
+    unsigned int mThreads;
+    unsigned int mRepeat;
+    vector<EncodedFile> mFiles;
+    json mResults;
+  };
+}
@@ -0,0 +1,297 @@
+#include <iostream>
+#include <thread>
+#include <string>
+
+#include <DreamCore.h>
+
+#include "AudioDecodeBenchmark.h"
+#include "SpriteBatchBenchmark.h"
+#include "OcclusionBenchmark.h"
+#include "SceneBenchmark.h"
+
+// Using
+
+using std::stoi;
+using std::cout;
+using std::endl;
+using octronic::dream::bench::AudioDecodeBenchmark;
+using octronic::dream::bench::SpriteBatchBenchmark;
+using octronic::dream::bench::OcclusionBenchmark;
+using octronic::dream::bench::SceneBenchmark;
+using octronic::dream::bench::SceneGeneratorOptions;
+
+// Count every allocation for the allocation results
+
+DREAM_ALLOCATION_HOOK()
+
+// Global variables
+
+string       _option_logLevel = "off";
+string       _option_audio_dir;
+unsigned int _option_threads = std::thread::hardware_concurrency();
+unsigned int _option_repeat = 1;
+unsigned int _option_sprites = 0;
+unsigned int _option_sprite_textures = 16;
+unsigned int _option_occlusion_boxes = 0;
+string       _option_project_dir;
+unsigned int _option_scene_frames = 300;
+unsigned int _option_scene_warmup = 30;
+unsigned int _option_scene_entities = 0;
+unsigned int _option_scene_models = 1;
+unsigned int _option_scene_scripts = 0;
+unsigned int _option_scene_bodies = 0;
+string       _option_replay;
+
+// Global Functions
+
+void printUsage()
+{
+  cout << "Usage: DreamBench [-a <ogg directory>] [-s <sprite count> [-x textures]] [-o <occludee count>] [-p <project directory> [-f frames] [-w warmup frames] [-n entities [-m models] [-k scripted] [-b bodies]] [-y replay log]] [-t threads] [-r repeat] [-l log level]" << endl;
+}
+
+void parseArguments(int argc, char** argv)
+{
+  for (int i=0; i<argc; i++)
+  {
+    if (string(argv[i]) == "-l")
+    {
+      if (argc > i+1)
+      {
+        _option_logLevel = string(argv[i+1]);
+      }
+      else
+      {
+        LOG_ERROR("Main: Log Level argument not found");
+      }
+    }
+    else if (string(argv[i]) == "-a")
+    {
+      if (argc > i+1)
+      {
+        _option_audio_dir = string(argv[i+1]);
+      }
+      else
+      {
+        LOG_ERROR("Main: Audio directory argument not found");
+      }
+    }
+    else if (string(argv[i]) == "-t")
+    {
+      if (argc > i+1)
+      {
+        _option_threads = stoi(argv[i+1]);
+      }
+      else
+      {
+        LOG_ERROR("Main: Threads argument not found");
+      }
+    }
+    else if (string(argv[i]) == "-s")
+    {
+      if (argc > i+1)
+      {
+        _option_sprites = stoi(argv[i+1]);
+      }
+      else
+      {
+        LOG_ERROR("Main: Sprite count argument not found");
+      }
+    }
+    else if (string(argv[i]) == "-x")
+    {
+      if (argc > i+1)
+      {
+        _option_sprite_textures = stoi(argv[i+1]);
+      }
+      else
+      {
+        LOG_ERROR("Main: Sprite textures argument not found");
+      }
+    }
+    else if (string(argv[i]) == "-o")
+    {
+      if (argc > i+1)
+      {
+        _option_occlusion_boxes = stoi(argv[i+1]);
+      }
+      else
+      {
+        LOG_ERROR("Main: Occludee count argument not found");
+      }
+    }
+    else if (string(argv[i]) == "-r")
+    {
+      if (argc > i+1)
+      {
+        _option_repeat = stoi(argv[i+1]);
+      }
+      else
+      {
+        LOG_ERROR("Main: Repeat argument not found");
+      }
+    }
+    else if (string(argv[i]) == "-p")
+    {
+      if (argc > i+1)
+      {
+        _option_project_dir = string(argv[i+1]);
+      }
+      else
+      {
+        LOG_ERROR("Main: Project directory argument not found");
+      }
+    }
+    else if (string(argv[i]) == "-f")
+    {
+      if (argc > i+1)
+      {
+        _option_scene_frames = stoi(argv[i+1]);
+      }
+      else
+      {
+        LOG_ERROR("Main: Frames argument not found");
+      }
+    }
+    else if (string(argv[i]) == "-w")
+    {
+      if (argc > i+1)
+      {
+        _option_scene_warmup = stoi(argv[i+1]);
+      }
+      else
+      {
+        LOG_ERROR("Main: Warmup frames argument not found");
+      }
+    }
+    else if (string(argv[i]) == "-n")
+    {
+      if (argc > i+1)
+      {
+        _option_scene_entities = stoi(argv[i+1]);
+      }
+      else
+      {
+        LOG_ERROR("Main: Entity count argument not found");
+      }
+    }
+    else if (string(argv[i]) == "-m")
+    {
+      if (argc > i+1)
+      {
+        _option_scene_models = stoi(argv[i+1]);
+      }
+      else
+      {
+        LOG_ERROR("Main: Model count argument not found");
+      }
+    }
+    else if (string(argv[i]) == "-k")
+    {
+      if (argc > i+1)
+      {
+        _option_scene_scripts = stoi(argv[i+1]);
+      }
+      else
+      {
+        LOG_ERROR("Main: Scripted entity count argument not found");
+      }
+    }
+    else if (string(argv[i]) == "-b")
+    {
+      if (argc > i+1)
+      {
+        _option_scene_bodies = stoi(argv[i+1]);
+      }
+      else
+      {
+        LOG_ERROR("Main: Rigid body count argument not found");
+      }
+    }
+    else if (string(argv[i]) == "-y")
+    {
+      if (argc > i+1)
+      {
+        _option_replay = string(argv[i+1]);
+      }
+      else
+      {
+        LOG_ERROR("Main: Replay log argument not found");
+      }
+    }
+  }
+}
+
+void setupLogger()
+{
+  LOG_LEVEL(spdlog::level::from_str(_option_logLevel));
+  LOG_PATTERN("[%H:%M:%S]%l: %v");
+}
+
+// Entry Point
+
+int main(int argc,char** argv)
+{
+  parseArguments(argc, argv);
+  setupLogger();
+
+  if (_option_audio_dir.empty() && _option_sprites == 0 && _option_occlusion_boxes == 0 && _option_project_dir.empty())
+  {
+    printUsage();
+    return 1;
+  }
+
+  if (!_option_audio_dir.empty())
+  {
+    AudioDecodeBenchmark audioBench(_option_audio_dir, _option_threads, _option_repeat);
+    if (!audioBench.run())
+    {
+      return 2;
+    }
+    cout << audioBench.getResults().dump(2) << endl;
+  }
+
+  if (_option_sprites > 0)
+  {
+    SpriteBatchBenchmark spriteBench(_option_sprites, _option_sprite_textures, _option_repeat);
+    if (!spriteBench.run())
+    {
+      return 2;
+    }
+    cout << spriteBench.getResults().dump(2) << endl;
+  }
+
+  if (_option_occlusion_boxes > 0)
+  {
+    OcclusionBenchmark occlusionBench(_option_occlusion_boxes, _option_threads, _option_repeat);
+    if (!occlusionBench.run())
+    {
+      return 2;
+    }
+    cout << occlusionBench.getResults().dump(2) << endl;
+  }
+
+  if (!_option_project_dir.empty())
+  {
+    SceneBenchmark sceneBench(_option_project_dir, _option_scene_frames, _option_scene_warmup);
+    if (_option_scene_entities > 0)
+    {
+      SceneGeneratorOptions generatorOptions;
+      generatorOptions.entities = _option_scene_entities;
+      generatorOptions.models = _option_scene_models;
+      generatorOptions.scripts = _option_scene_scripts;
+      generatorOptions.bodies = _option_scene_bodies;
+      sceneBench.setGenerator(generatorOptions);
+    }
+    if (!_option_replay.empty())
+    {
+      sceneBench.setReplay(_option_replay);
+    }
+    if (!sceneBench.run())
+    {
+      return 2;
+    }
+    cout << sceneBench.getResults().dump(2) << endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,137 @@
+#include "OcclusionBenchmark.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+#include <glm/gtc/matrix_transform.hpp>
+
+using std::vector;
+using std::unique_ptr;
+using std::make_unique;
+using std::mt19937;
+using std::uniform_real_distribution;
+using glm::translate;
+using glm::scale;
+using glm::perspective;
+using glm::lookAt;
+using glm::radians;
+
+namespace octronic::dream::bench
+{
+  OcclusionBenchmark::OcclusionBenchmark
+  (size_t boxes, unsigned int threads, unsigned int repeat)
+    : mBoxes(boxes),
+      mThreads(threads == 0 ? 1 : threads),
+      mRepeat(repeat == 0 ? 1 : repeat)
+  {
+  }
+
+  bool
+  OcclusionBenchmark::run
+  ()
+  {
+    mResults = json::object();
+    mResults["benchmark"] = "occlusion";
+    mResults["boxes"] = mBoxes;
+    mResults["threads"] = mThreads;
+    mResults["frames"] = mRepeat;
+
+    if (mBoxes == 0)
+    {
+      LOG_ERROR("OcclusionBenchmark: No boxes requested");
+      return false;
+    }
+
+    // Unit cube, 12 triangles
+    const vector<vec3> cube =
+    {
+      {-1,-1,-1}, { 1,-1,-1}, { 1, 1,-1}, {-1, 1,-1},
+      {-1,-1, 1}, { 1,-1, 1}, { 1, 1, 1}, {-1, 1, 1}
+    };
+    const vector<GLuint> cubeIndices =
+    {
+      0,2,1, 0,3,2,  4,5,6, 4,6,7,  0,1,5, 0,5,4,
+      3,6,2, 3,7,6,  0,4,7, 0,7,3,  1,2,6, 1,6,5
+    };
+
+    // Same scene every run: a row of walls across the view with gaps
+    // between them, boxes spread through the space behind
+    vector<mat4> walls;
+    for (int i = -4; i <= 4; i++)
+    {
+      mat4 m = translate(mat4(1.f), vec3(i * 9.f, 0.f, -30.f));
+      walls.push_back(scale(m, vec3(4.f, 20.f, 1.f)));
+    }
+
+    mt19937 rng(1234);
+    uniform_real_distribution<float> x(-60.f, 60.f);
+    uniform_real_distribution<float> y(-15.f, 15.f);
+    uniform_real_distribution<float> z(-150.f, -5.f);
+    uniform_real_distribution<float> size(0.25f, 2.f);
+
+    struct Box
+    {
+      vec3 minimum;
+      vec3 maximum;
+    };
+
+    vector<Box> boxes(mBoxes);
+    for (auto& box : boxes)
+    {
+      vec3 center(x(rng), y(rng), z(rng));
+      vec3 extent(size(rng));
+      box.minimum = center - extent;
+      box.maximum = center + extent;
+    }
+
+    mat4 projection = perspective(radians(60.f), 16.f/9.f, 0.1f, 200.f);
+    mat4 view = lookAt(vec3(0.f, 2.f, 0.f), vec3(0.f, 2.f, -1.f), vec3(0.f, 1.f, 0.f));
+
+    OcclusionCuller culler;
+    // Started before timing, as the GraphicsComponent keeps its pool
+    unique_ptr<WorkerPool> workers;
+    if (mThreads > 1) workers = make_unique<WorkerPool>("Occlusion", mThreads - 1);
+    double rasterSeconds = 0.0;
+    double testSeconds = 0.0;
+    size_t hidden = 0;
+
+    for (unsigned int frame = 0; frame < mRepeat; frame++)
+    {
+      uint64_t start = SteadyClock::Now();
+      culler.begin(projection * view);
+      for (auto& wall : walls)
+      {
+        culler.addOccluder(cube, cubeIndices, wall);
+      }
+      culler.rasterize(workers.get());
+      uint64_t rastered = SteadyClock::Now();
+
+      hidden = 0;
+      for (auto& box : boxes)
+      {
+        if (!culler.isVisible(box.minimum, box.maximum)) hidden++;
+      }
+      uint64_t tested = SteadyClock::Now();
+
+      rasterSeconds += (rastered - start) / 1e9;
+      testSeconds += (tested - rastered) / 1e9;
+    }
+
+    mResults["resolution"] = {culler.getWidth(), culler.getHeight()};
+    mResults["occluder_triangles"] = culler.getOccluderTriangleCount();
+    mResults["hidden"] = hidden;
+    mResults["hidden_fraction"] = static_cast<double>(hidden) / mBoxes;
+    mResults["raster_mean_ms"] = rasterSeconds * 1000.0 / mRepeat;
+    mResults["test_mean_ms"] = testSeconds * 1000.0 / mRepeat;
+    mResults["ns_per_test"] = testSeconds * 1e9 / (static_cast<double>(mBoxes) * mRepeat);
+    return true;
+  }
+
+  json
+  OcclusionBenchmark::getResults
+  ()
+  const
+  {
+    return mResults;
+  }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <DreamCore.h>
+
+#include <json.hpp>
+
+using nlohmann::json;
+
+namespace octronic::dream::bench
+{
+  /**
+   * @brief Measures the OcclusionCuller without a GL context. A fixed
+   * seed builds a scene of wall occluders in front of the camera and the
+   * requested number of boxes scattered behind and around them. Each frame
+   * the walls are rasterized and every box is tested against the Hi-Z
+   * pyramid, and the two stages are timed separately.
+   */
+  class OcclusionBenchmark
+  {
+  public:
+    OcclusionBenchmark(size_t boxes, unsigned int threads, unsigned int repeat);
+
+    bool run();
+    json getResults() const;
+
+  private:
+    size_t mBoxes;
+    unsigned int mThreads;
+    unsigned int mRepeat;
+    json mResults;
+  };
+}
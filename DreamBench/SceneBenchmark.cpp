@@ -0,0 +1,281 @@
+#include "SceneBenchmark.h"
+
+#include <HeadlessWindowComponent.h>
+#include <NullAudioComponent.h>
+
+#include <algorithm>
+#include <map>
+
+using std::map;
+using std::optional;
+using std::exception;
+using octronic::dream::headless::HeadlessWindowComponent;
+using octronic::dream::headless::NullAudioComponent;
+using octronic::dream::headless::HEADLESS_CONTEXT_NULL;
+
+namespace octronic::dream::bench
+{
+  const unsigned int SceneBenchmark::MAX_LOAD_FRAMES = 10000;
+
+  SceneBenchmark::SceneBenchmark
+  (const string& projectDir, unsigned int frames, unsigned int warmup)
+    : mProjectDirectory(projectDir),
+      mFrames(frames == 0 ? 1 : frames),
+      mWarmup(warmup),
+      mGenerate(false)
+  {
+  }
+
+  void
+  SceneBenchmark::setGenerator
+  (const SceneGeneratorOptions& options)
+  {
+    mGenerate = true;
+    mGeneratorOptions = options;
+  }
+
+  void
+  SceneBenchmark::setReplay
+  (const string& replayPath)
+  {
+    mReplayPath = replayPath;
+  }
+
+  bool
+  SceneBenchmark::run
+  ()
+  {
+    mResults = json::object();
+    mResults["benchmark"] = "scene";
+    mResults["project"] = mProjectDirectory;
+    mResults["frames"] = mFrames;
+    mResults["warmup"] = mWarmup;
+
+    StorageManager storageManager;
+    HeadlessWindowComponent windowComponent(HEADLESS_CONTEXT_NULL);
+    NullAudioComponent audioComponent;
+
+    if (!windowComponent.init())
+    {
+      LOG_ERROR("SceneBenchmark: Unable to init headless window");
+      return false;
+    }
+
+    if (!audioComponent.init())
+    {
+      LOG_ERROR("SceneBenchmark: Unable to init null audio");
+      return false;
+    }
+
+    bool success = false;
+    optional<SceneGenerator> generator;
+    {
+      ProjectContext context(windowComponent, audioComponent, storageManager, mProjectDirectory);
+      uint64_t loadStart = SteadyClock::Now();
+      try
+      {
+        if (mGenerate)
+        {
+          auto& pDir = context.getProjectDirectory().value();
+          auto& pDefOpt = context.getProjectDefinition();
+          pDefOpt.emplace(pDir.readProjectDefinition());
+          generator.emplace(pDir, pDefOpt.value());
+          if (!generator.value().generate(mGeneratorOptions))
+          {
+            generator.value().removeGeneratedAssets();
+            return false;
+          }
+          mResults["generated"] = generator.value().getSummary();
+          context.createProjectRuntime();
+        }
+        else if (!context.openFromPath())
+        {
+          LOG_ERROR("SceneBenchmark: Unable to open project {}", mProjectDirectory);
+          return false;
+        }
+      }
+      catch (exception& ex)
+      {
+        LOG_ERROR("SceneBenchmark: Unable to load project {} {}", mProjectDirectory, ex.what());
+        if (generator) generator.value().removeGeneratedAssets();
+        return false;
+      }
+
+      auto& pRunt = context.getProjectRuntime().value();
+
+      if (!mReplayPath.empty())
+      {
+        if (!pRunt.startReplay(mReplayPath))
+        {
+          if (generator) generator.value().removeGeneratedAssets();
+          return false;
+        }
+        mResults["replay"]["path"] = mReplayPath;
+        mResults["replay"]["seed"] = pRunt.getRandomSeed();
+      }
+
+      // Step until the startup scene and everything it loads is ready
+      unsigned int loadFrames = 0;
+      while (!pRunt.hasActiveSceneRuntime() && loadFrames < MAX_LOAD_FRAMES)
+      {
+        windowComponent.updateWindow();
+        context.step();
+        windowComponent.swapBuffers();
+        loadFrames++;
+      }
+
+      if (pRunt.hasActiveSceneRuntime())
+      {
+        mResults["load_frames"] = loadFrames;
+        mResults["load_ms"] = (SteadyClock::Now() - loadStart) / 1e6;
+
+        for (unsigned int frame = 0; frame < mWarmup; frame++)
+        {
+          windowComponent.updateWindow();
+          context.step();
+          windowComponent.swapBuffers();
+        }
+
+        bool profilerWasEnabled = Profiler::IsEnabled();
+        Profiler::SetEnabled(true);
+        Profiler::Clear();
+
+        vector<double> frameMs;
+        vector<double> allocations;
+        vector<double> allocatedBytes;
+        map<string, vector<double>> phases;
+        map<string, vector<double>> phaseAllocations;
+        json glCounters;
+
+        // A replay is measured to the end of its log, checked before each
+        // step so no frame runs past it
+        unsigned int frame = 0;
+        for (; pRunt.isReplaying() ? pRunt.hasReplayFrames() : frame < mFrames; frame++)
+        {
+          auto allocationsBefore = AllocationTracker::Get();
+          uint64_t start = SteadyClock::Now();
+
+          windowComponent.updateWindow();
+          context.step();
+          windowComponent.swapBuffers();
+
+          uint64_t end = SteadyClock::Now();
+          auto allocated = AllocationTracker::Since(allocationsBefore);
+          frameMs.push_back((end - start) / 1e6);
+          allocations.push_back(allocated.allocations);
+          allocatedBytes.push_back(allocated.bytes);
+          glCounters = GLDispatch::GetCountersJson();
+
+          map<string, double> frameZones;
+          map<string, double> frameZoneAllocations;
+          for (auto& event : Profiler::GetEvents())
+          {
+            frameZones[event.name] += (event.end - event.start) / 1e6;
+            frameZoneAllocations[event.name] += event.allocations;
+          }
+          Profiler::Clear();
+
+          // Zones missing from a frame count as zero
+          for (auto& zone : frameZones)
+          {
+            auto& samples = phases[zone.first];
+            samples.resize(frame, 0.0);
+            samples.push_back(zone.second);
+          }
+          for (auto& zone : frameZoneAllocations)
+          {
+            auto& samples = phaseAllocations[zone.first];
+            samples.resize(frame, 0.0);
+            samples.push_back(zone.second);
+          }
+        }
+
+        Profiler::SetEnabled(profilerWasEnabled);
+        mResults["frames"] = frame;
+
+        json phasesJs = json::object();
+        for (auto& phase : phases)
+        {
+          phase.second.resize(frame, 0.0);
+          phasesJs[phase.first] = Percentiles(phase.second);
+        }
+
+        json phaseAllocationsJs = json::object();
+        for (auto& phase : phaseAllocations)
+        {
+          phase.second.resize(frame, 0.0);
+          phaseAllocationsJs[phase.first] = Percentiles(phase.second);
+        }
+
+        auto& renderQueue = pRunt.getGraphicsComponent().getRenderQueue();
+        auto& sceneRuntime = pRunt.getActiveSceneRuntime().value().get();
+
+        mResults["entities"] = sceneRuntime.getFlatView().size();
+        mResults["frame_ms"] = Percentiles(frameMs);
+        mResults["allocations"] = Percentiles(allocations);
+        mResults["allocated_bytes"] = Percentiles(allocatedBytes);
+        mResults["phases_ms"] = phasesJs;
+        mResults["phases_allocations"] = phaseAllocationsJs;
+        mResults["gl"] = glCounters;
+        mResults["render_queue"]["packets"] = renderQueue.getPackets().size();
+        mResults["render_queue"]["batches"] = renderQueue.getBatches().size();
+        mResults["render_queue"]["occluded"] = renderQueue.getOccludedCount();
+
+        json memory = json::object();
+        for (auto& usage : pRunt.getCacheMemoryUsage())
+        {
+          memory[usage.name]["runtimes"] = usage.runtimes;
+          memory[usage.name]["cpu_bytes"] = usage.cpuBytes;
+          memory[usage.name]["gpu_bytes"] = usage.gpuBytes;
+        }
+        mResults["cache_memory"] = memory;
+        // The runtime's own rolling window, warmup frames included
+        mResults["frame_stats"] = pRunt.getFrameStats().toJson();
+        success = true;
+      }
+      else
+      {
+        LOG_ERROR("SceneBenchmark: Startup scene did not load within {} frames", MAX_LOAD_FRAMES);
+      }
+    }
+
+    // Runtimes are gone, safe to delete their data
+    if (generator) generator.value().removeGeneratedAssets();
+    return success;
+  }
+
+  json
+  SceneBenchmark::Percentiles
+  (vector<double> samples)
+  {
+    json js = json::object();
+    if (samples.empty()) return js;
+
+    std::sort(samples.begin(), samples.end());
+    double total = 0.0;
+    for (double s : samples) total += s;
+
+    // Nearest rank
+    auto rank = [&samples](double p)
+    {
+      size_t index = static_cast<size_t>(p * (samples.size() - 1) + 0.5);
+      return samples[std::min(index, samples.size() - 1)];
+    };
+
+    js["mean"] = total / samples.size();
+    js["min"] = samples.front();
+    js["p50"] = rank(0.50);
+    js["p95"] = rank(0.95);
+    js["p99"] = rank(0.99);
+    js["max"] = samples.back();
+    return js;
+  }
+
+  json
+  SceneBenchmark::getResults
+  ()
+  const
+  {
+    return mResults;
+  }
+}
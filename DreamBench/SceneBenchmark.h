@@ -0,0 +1,65 @@
+#pragma once
+
+#include "SceneGenerator.h"
+
+#include <DreamCore.h>
+
+#include <json.hpp>
+
+using nlohmann::json;
+
+namespace octronic::dream::bench
+{
+  /**
+   * @brief Runs a project headless for a fixed number of frames and
+   * reports per frame timings. The window is a HeadlessWindowComponent on
+   * the null GL backend and audio is a NullAudioComponent, so the CPU
+   * side of every ProjectRuntime::step is measured without a GPU or
+   * sound device.
+   *
+   * Phase timings are the profiler zones recorded during each frame,
+   * summed per zone name across all threads. Allocation counts come from
+   * the AllocationTracker hook DreamBench installs, per frame and per
+   * zone.
+   */
+  class SceneBenchmark
+  {
+  public:
+    SceneBenchmark(const string& projectDir, unsigned int frames, unsigned int warmup);
+
+    /**
+     * @brief Add a synthetic workload to the startup scene before it
+     * loads, see SceneGenerator.
+     */
+    void setGenerator(const SceneGeneratorOptions& options);
+
+    /**
+     * @brief Drive the project from a log written with
+     * ProjectRuntime::startRecording. Loading and warmup take their frames
+     * from the log and the rest are measured, so the frame count is the
+     * log's.
+     */
+    void setReplay(const string& replayPath);
+
+    bool run();
+    json getResults() const;
+
+    /**
+     * @brief Frames stepped waiting for the startup scene before giving
+     * up.
+     */
+    const static unsigned int MAX_LOAD_FRAMES;
+
+  private:
+    static json Percentiles(vector<double> samples);
+
+  private:
+    string mProjectDirectory;
+    unsigned int mFrames;
+    unsigned int mWarmup;
+    bool mGenerate;
+    SceneGeneratorOptions mGeneratorOptions;
+    string mReplayPath;
+    json mResults;
+  };
+}
@@ -0,0 +1,277 @@
+#include "SceneGenerator.h"
+
+#include <cmath>
+#include <map>
+#include <random>
+#include <sstream>
+#include <tuple>
+
+using std::map;
+using std::mt19937;
+using std::stringstream;
+using std::tuple;
+using std::make_tuple;
+using std::uniform_int_distribution;
+using std::uniform_real_distribution;
+
+namespace octronic::dream::bench
+{
+  namespace
+  {
+    const float ENTITY_SPACING = 3.f;
+    const char* SCRIPT_SOURCE =
+        "-- Generated by DreamBench\n"
+        "function onInit(entity)\n"
+        "end\n"
+        "\n"
+        "function onUpdate(entity)\n"
+        "  local transform = entity:getTransform()\n"
+        "  transform:setYaw(transform:getYaw() + Time:perSecond(1.0))\n"
+        "  entity:setTransform(transform)\n"
+        "end\n"
+        "\n"
+        "function onEvent(entity)\n"
+        "end\n";
+  }
+
+  SceneGenerator::SceneGenerator
+  (ProjectDirectory& pDir, ProjectDefinition& pDef)
+    : mProjectDirectory(pDir),
+      mProjectDefinition(pDef),
+      mTemplates(0),
+      mTriangles(0)
+  {
+  }
+
+  bool
+  SceneGenerator::generate
+  (const SceneGeneratorOptions& options)
+  {
+    mOptions = options;
+    if (mOptions.models == 0) mOptions.models = 1;
+
+    auto sceneDefOpt = mProjectDefinition.getStartupSceneDefinition();
+    if (!sceneDefOpt)
+    {
+      LOG_ERROR("SceneGenerator: Project has no startup scene");
+      return false;
+    }
+    auto& rootOpt = sceneDefOpt.value().get().getRootSceneEntityDefinition();
+    if (!rootOpt)
+    {
+      LOG_ERROR("SceneGenerator: Startup scene has no root entity");
+      return false;
+    }
+    auto& root = rootOpt.value();
+
+    auto materials = mProjectDefinition.getAssetDefinitionsVector(ASSET_TYPE_ENUM_MATERIAL);
+    if (materials.empty())
+    {
+      LOG_ERROR("SceneGenerator: Project has no material for generated models");
+      return false;
+    }
+    UuidType material = materials.front().get().getUuid();
+
+    vector<AssetDefinition*> models;
+    for (size_t i = 0; i < mOptions.models; i++)
+    {
+      auto model = createModel(i, material);
+      if (model == nullptr) return false;
+      models.push_back(model);
+    }
+
+    AssetDefinition* script = nullptr;
+    if (mOptions.scripts > 0)
+    {
+      script = createScript();
+      if (script == nullptr) return false;
+    }
+
+    AssetDefinition* body = nullptr;
+    size_t side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(mOptions.entities))));
+    float extent = side * ENTITY_SPACING * 0.5f + ENTITY_SPACING;
+
+    if (mOptions.bodies > 0)
+    {
+      body = createBody(vec3(0.5f), 1.f);
+
+      // Static ground the bodies come to rest on
+      auto ground = createBody(vec3(extent, 0.5f, extent), 0.f);
+      auto& groundTemplate = mProjectDefinition.createTemplateEntityDefinition();
+      groundTemplate.setName("Bench Ground");
+      groundTemplate.setAssetDefinition(ASSET_TYPE_ENUM_PHYSICS, ground->getUuid());
+      mTemplates++;
+
+      auto& groundEntity = root.createChildDefinition();
+      groundEntity.setName("Bench Ground");
+      groundEntity.setTemplateUuid(groundTemplate.getUuid());
+      Transform tx;
+      tx.setTranslation(vec3(0.f, -1.f, -extent));
+      groundEntity.setTransform(tx);
+    }
+
+    mt19937 rng(mOptions.seed);
+    uniform_int_distribution<size_t> pickModel(0, mOptions.models - 1);
+    uniform_real_distribution<float> dropHeight(2.f, 12.f);
+
+    map<tuple<size_t, bool, bool>, UuidType> templates;
+
+    for (size_t i = 0; i < mOptions.entities; i++)
+    {
+      size_t model = pickModel(rng);
+      bool hasScript = i < mOptions.scripts;
+      // Bodies go to the last entities so scripts and bodies only share
+      // entities when there are more of both than entities
+      bool hasBody = i + mOptions.bodies >= mOptions.entities;
+
+      auto key = make_tuple(model, hasScript, hasBody);
+      auto itr = templates.find(key);
+      if (itr == templates.end())
+      {
+        auto& templateDef = mProjectDefinition.createTemplateEntityDefinition();
+        templateDef.setName("Bench Template " + std::to_string(templates.size()));
+        templateDef.setAssetDefinition(ASSET_TYPE_ENUM_MODEL, models[model]->getUuid());
+        if (hasScript) templateDef.setAssetDefinition(ASSET_TYPE_ENUM_SCRIPT, script->getUuid());
+        if (hasBody) templateDef.setAssetDefinition(ASSET_TYPE_ENUM_PHYSICS, body->getUuid());
+        itr = templates.emplace(key, templateDef.getUuid()).first;
+        mTemplates++;
+      }
+
+      auto& entity = root.createChildDefinition();
+      entity.setName("Bench Entity " + std::to_string(i));
+      entity.setTemplateUuid(itr->second);
+
+      float x = (static_cast<float>(i % side) - side * 0.5f) * ENTITY_SPACING;
+      float z = -static_cast<float>(i / side) * ENTITY_SPACING - ENTITY_SPACING;
+      Transform tx;
+      tx.setTranslation(vec3(x, hasBody ? dropHeight(rng) : 0.f, z));
+      entity.setTransform(tx);
+    }
+
+    LOG_INFO("SceneGenerator: Generated {} entities from {} templates", mOptions.entities, mTemplates);
+    return true;
+  }
+
+  AssetDefinition*
+  SceneGenerator::createModel
+  (size_t index, UuidType material)
+  {
+    // Detail varies between models so meshes are not all the same size
+    unsigned int rings = 6 + static_cast<unsigned int>(index % 8) * 4;
+    string obj = GenerateSphere(rings, rings * 2);
+
+    auto& def = static_cast<ModelDefinition&>(
+          mProjectDefinition.createAssetDefinition(ASSET_TYPE_ENUM_MODEL));
+    def.setName("Bench Model " + std::to_string(index));
+    def.setFormat(Constants::ASSET_FORMAT_MODEL_ASSIMP);
+    // Assimp names the material of an OBJ without a library
+    def.addModelMaterial("DefaultMaterial", material);
+    mGeneratedAssets.push_back(&def);
+
+    if (!mProjectDirectory.writeAssetStringData(def, obj))
+    {
+      LOG_ERROR("SceneGenerator: Unable to write model data for {}", def.getName());
+      return nullptr;
+    }
+    mTriangles += rings * rings * 2 * 2;
+    return &def;
+  }
+
+  AssetDefinition*
+  SceneGenerator::createScript
+  ()
+  {
+    auto& def = mProjectDefinition.createAssetDefinition(ASSET_TYPE_ENUM_SCRIPT);
+    def.setName("Bench Script");
+    def.setFormat(Constants::ASSET_FORMAT_SCRIPT_LUA);
+    mGeneratedAssets.push_back(&def);
+
+    if (!mProjectDirectory.writeAssetStringData(def, SCRIPT_SOURCE))
+    {
+      LOG_ERROR("SceneGenerator: Unable to write script data");
+      return nullptr;
+    }
+    return &def;
+  }
+
+  AssetDefinition*
+  SceneGenerator::createBody
+  (const vec3& halfExtents, float mass)
+  {
+    auto& def = static_cast<PhysicsDefinition&>(
+          mProjectDefinition.createAssetDefinition(ASSET_TYPE_ENUM_PHYSICS));
+    def.setName(mass > 0.f ? "Bench Body" : "Bench Ground");
+    def.setFormat(Constants::COLLISION_SHAPE_BOX);
+    def.setHalfExtents(halfExtents);
+    def.setMass(mass);
+    return &def;
+  }
+
+  string
+  SceneGenerator::GenerateSphere
+  (unsigned int rings, unsigned int sectors)
+  {
+    stringstream obj;
+    obj << "# Generated by DreamBench\n";
+    obj << "o sphere\n";
+
+    for (unsigned int r = 0; r <= rings; r++)
+    {
+      float phi = static_cast<float>(M_PI) * r / rings;
+      for (unsigned int s = 0; s <= sectors; s++)
+      {
+        float theta = 2.f * static_cast<float>(M_PI) * s / sectors;
+        float x = std::sin(phi) * std::cos(theta);
+        float y = std::cos(phi);
+        float z = std::sin(phi) * std::sin(theta);
+        obj << "v " << x << " " << y << " " << z << "\n";
+        obj << "vt " << static_cast<float>(s) / sectors << " " << static_cast<float>(r) / rings << "\n";
+        obj << "vn " << x << " " << y << " " << z << "\n";
+      }
+    }
+
+    // OBJ indices start at 1
+    for (unsigned int r = 0; r < rings; r++)
+    {
+      for (unsigned int s = 0; s < sectors; s++)
+      {
+        unsigned int a = r * (sectors + 1) + s + 1;
+        unsigned int b = a + sectors + 1;
+        obj << "f " << a << "/" << a << "/" << a << " "
+            << b << "/" << b << "/" << b << " "
+            << a + 1 << "/" << a + 1 << "/" << a + 1 << "\n";
+        obj << "f " << a + 1 << "/" << a + 1 << "/" << a + 1 << " "
+            << b << "/" << b << "/" << b << " "
+            << b + 1 << "/" << b + 1 << "/" << b + 1 << "\n";
+      }
+    }
+    return obj.str();
+  }
+
+  void
+  SceneGenerator::removeGeneratedAssets
+  ()
+  {
+    for (auto def : mGeneratedAssets)
+    {
+      mProjectDirectory.removeAssetDirectory(*def);
+    }
+    mGeneratedAssets.clear();
+  }
+
+  json
+  SceneGenerator::getSummary
+  ()
+  const
+  {
+    json summary;
+    summary["entities"] = mOptions.entities;
+    summary["models"] = mOptions.models;
+    summary["scripts"] = mOptions.scripts;
+    summary["bodies"] = mOptions.bodies;
+    summary["seed"] = mOptions.seed;
+    summary["templates"] = mTemplates;
+    summary["model_triangles"] = mTriangles;
+    return summary;
+  }
+}
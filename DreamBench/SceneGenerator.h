@@ -0,0 +1,57 @@
+#pragma once
+
+#include <DreamCore.h>
+
+#include <json.hpp>
+#include <vector>
+
+using nlohmann::json;
+using std::vector;
+
+namespace octronic::dream::bench
+{
+  struct SceneGeneratorOptions
+  {
+    // Entities added to the startup scene
+    size_t entities = 0;
+    // Distinct models shared between them
+    size_t models = 1;
+    // Entities given the generated script
+    size_t scripts = 0;
+    // Entities given a dynamic box rigid body
+    size_t bodies = 0;
+    unsigned int seed = 1;
+  };
+
+  /**
+   * @brief Fills the startup scene of a loaded project with a synthetic
+   * workload. Models are UV spheres of varying detail written as OBJ
+   * text, the script spins its entity and rigid bodies fall onto a static
+   * ground box. Generated asset data is written into the project
+   * directory and removed again by removeGeneratedAssets, the project
+   * file itself is never saved.
+   */
+  class SceneGenerator
+  {
+  public:
+    SceneGenerator(ProjectDirectory& pDir, ProjectDefinition& pDef);
+
+    bool generate(const SceneGeneratorOptions& options);
+    void removeGeneratedAssets();
+    json getSummary() const;
+
+  private:
+    AssetDefinition* createModel(size_t index, UuidType material);
+    AssetDefinition* createScript();
+    AssetDefinition* createBody(const vec3& halfExtents, float mass);
+    static string GenerateSphere(unsigned int rings, unsigned int sectors);
+
+  private:
+    ProjectDirectory& mProjectDirectory;
+    ProjectDefinition& mProjectDefinition;
+    SceneGeneratorOptions mOptions;
+    vector<AssetDefinition*> mGeneratedAssets;
+    size_t mTemplates;
+    size_t mTriangles;
+  };
+}
@@ -0,0 +1,103 @@
+#include "SpriteBatchBenchmark.h"
+
+#include <random>
+#include <vector>
+#include <glm/gtc/matrix_transform.hpp>
+
+using std::vector;
+using std::mt19937;
+using std::uniform_real_distribution;
+using std::uniform_int_distribution;
+using glm::translate;
+using glm::rotate;
+using glm::scale;
+
+namespace octronic::dream::bench
+{
+  SpriteBatchBenchmark::SpriteBatchBenchmark
+  (size_t sprites, unsigned int textures, unsigned int repeat)
+    : mSprites(sprites),
+      mTextures(textures == 0 ? 1 : textures),
+      mRepeat(repeat == 0 ? 1 : repeat)
+  {
+  }
+
+  bool
+  SpriteBatchBenchmark::run
+  ()
+  {
+    mResults = json::object();
+    mResults["benchmark"] = "sprite_batch";
+    mResults["sprites"] = mSprites;
+    mResults["textures"] = mTextures;
+    mResults["frames"] = mRepeat;
+
+    if (mSprites == 0)
+    {
+      LOG_ERROR("SpriteBatchBenchmark: No sprites requested");
+      return false;
+    }
+
+    // Same scene every run
+    mt19937 rng(1234);
+    uniform_real_distribution<float> position(0.f, 1920.f);
+    uniform_real_distribution<float> angle(0.f, 6.2831853f);
+    uniform_real_distribution<float> size(8.f, 64.f);
+    uniform_int_distribution<unsigned int> texture(1, mTextures);
+
+    struct Sprite
+    {
+      GLuint texture;
+      mat4 transform;
+    };
+
+    vector<Sprite> sprites(mSprites);
+    for (auto& sprite : sprites)
+    {
+      sprite.texture = texture(rng);
+      mat4 m = translate(mat4(1.f), vec3(position(rng), position(rng), 0.f));
+      m = rotate(m, angle(rng), vec3(0.f, 0.f, 1.f));
+      sprite.transform = scale(m, vec3(size(rng), size(rng), 1.f));
+    }
+
+    SpriteBatch batch;
+    double totalSeconds = 0.0;
+    double minSeconds = 0.0;
+    double maxSeconds = 0.0;
+
+    for (unsigned int frame = 0; frame < mRepeat; frame++)
+    {
+      uint64_t start = SteadyClock::Now();
+      batch.clear();
+      for (auto& sprite : sprites)
+      {
+        batch.add(sprite.texture, sprite.transform);
+      }
+      batch.build();
+      double seconds = (SteadyClock::Now() - start) / 1e9;
+
+      totalSeconds += seconds;
+      if (frame == 0 || seconds < minSeconds) minSeconds = seconds;
+      if (frame == 0 || seconds > maxSeconds) maxSeconds = seconds;
+    }
+
+    double meanSeconds = totalSeconds / mRepeat;
+    mResults["groups"] = batch.getGroups().size();
+    mResults["quads"] = batch.getQuadCount();
+    mResults["vertex_bytes"] = batch.getVertices().size() * sizeof(SpriteVertex);
+    mResults["mean_ms"] = meanSeconds * 1000.0;
+    mResults["min_ms"] = minSeconds * 1000.0;
+    mResults["max_ms"] = maxSeconds * 1000.0;
+    mResults["ns_per_sprite"] = meanSeconds * 1e9 / mSprites;
+    mResults["sprites_per_second"] = meanSeconds > 0.0 ? mSprites / meanSeconds : 0.0;
+    return true;
+  }
+
+  json
+  SpriteBatchBenchmark::getResults
+  ()
+  const
+  {
+    return mResults;
+  }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <DreamCore.h>
+
+#include <json.hpp>
+
+using nlohmann::json;
+
+namespace octronic::dream::bench
+{
+  /**
+   * @brief Measures the CPU side of the sprite pass. A fixed seed scatters
+   * the requested number of sprites over the screen, spread across a
+   * number of fake texture ids, then SpriteBatch clear, add and build are
+   * timed over several frames. No GL context is needed.
+   */
+  class SpriteBatchBenchmark
+  {
+  public:
+    SpriteBatchBenchmark(size_t sprites, unsigned int textures, unsigned int repeat);
+
+    bool run();
+    json getResults() const;
+
+  private:
+    size_t mSprites;
+    unsigned int mTextures;
+    unsigned int mRepeat;
+    json mResults;
+  };
+}
@@ -40,7 +40,10 @@ namespace octronic::dream
 
   void Definition::setJson(const json& js)
   {
+    string oldName = getName();
+    UuidType oldUuid = getUuid();
     mJson = js;
+    onIdentityChanged(oldName, oldUuid);
   }
 
   json
@@ -71,7 +74,9 @@ namespace octronic::dream
   void
   Definition::setName(const string& name)
   {
+    string oldName = getName();
     mJson[Constants::NAME] = name;
+    onIdentityChanged(oldName, getUuid());
   }
 
   bool
@@ -95,7 +100,14 @@ namespace octronic::dream
   void
   Definition::setUuid(UuidType uuid)
   {
+    UuidType oldUuid = getUuid();
     mJson[Constants::UUID] = uuid;
+    onIdentityChanged(getName(), oldUuid);
+  }
+
+  void
+  Definition::onIdentityChanged(const string&, UuidType)
+  {
   }
 
   string
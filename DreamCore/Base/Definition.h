@@ -89,6 +89,13 @@ namespace octronic::dream
         string getGroup() const;
 
 
+    protected:
+        /**
+         * @brief Called after setName, setUuid or setJson with the values
+         * they replaced, so an owner indexing by either can update itself.
+         */
+        virtual void onIdentityChanged(const string& oldName, UuidType oldUuid);
+
     protected:
         /**
          * @brief Internal JSON structure that defines the object.
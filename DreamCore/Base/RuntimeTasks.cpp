@@ -14,6 +14,7 @@ namespace octronic::dream
       mRuntime(runtime)
   {
     LOG_TRACE("RuntimeLoadFromDefTask: Constructing for Runtime: {}", getRuntime().getNameAndUuidString());
+    setProfilerName(getName() + " " + getRuntime().getName());
   }
 
   void RuntimeLoadFromDefinitionTask::execute()
@@ -0,0 +1,101 @@
+#include "AllocationTracker.h"
+
+#include <atomic>
+
+using std::atomic;
+
+namespace octronic::dream
+{
+    namespace
+    {
+        // Constant initialised, the hook can run before any constructor
+        atomic<bool> Installed(false);
+        atomic<uint64_t> Allocations(0);
+        atomic<uint64_t> Frees(0);
+        atomic<uint64_t> Bytes(0);
+
+        AllocationCounts FrameStart;
+        AllocationCounts LastFrame;
+
+        thread_local uint64_t ThreadAllocations = 0;
+        thread_local uint64_t ThreadFrees = 0;
+        thread_local uint64_t ThreadBytes = 0;
+    }
+
+    bool
+    AllocationTracker::IsInstalled
+    ()
+    {
+        return Installed.load(std::memory_order_relaxed);
+    }
+
+    void
+    AllocationTracker::RecordAllocation
+    (size_t bytes)
+    {
+        Allocations.fetch_add(1, std::memory_order_relaxed);
+        Bytes.fetch_add(bytes, std::memory_order_relaxed);
+        ThreadAllocations++;
+        ThreadBytes += bytes;
+        if (!Installed.load(std::memory_order_relaxed))
+        {
+            Installed.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    void
+    AllocationTracker::RecordFree
+    ()
+    {
+        Frees.fetch_add(1, std::memory_order_relaxed);
+        ThreadFrees++;
+    }
+
+    AllocationCounts
+    AllocationTracker::Get
+    ()
+    {
+        AllocationCounts counts;
+        counts.allocations = Allocations.load(std::memory_order_relaxed);
+        counts.frees = Frees.load(std::memory_order_relaxed);
+        counts.bytes = Bytes.load(std::memory_order_relaxed);
+        return counts;
+    }
+
+    AllocationCounts
+    AllocationTracker::GetThread
+    ()
+    {
+        AllocationCounts counts;
+        counts.allocations = ThreadAllocations;
+        counts.frees = ThreadFrees;
+        counts.bytes = ThreadBytes;
+        return counts;
+    }
+
+    AllocationCounts
+    AllocationTracker::Since
+    (const AllocationCounts& from)
+    {
+        AllocationCounts now = Get();
+        now.allocations -= from.allocations;
+        now.frees -= from.frees;
+        now.bytes -= from.bytes;
+        return now;
+    }
+
+    void
+    AllocationTracker::MarkFrame
+    ()
+    {
+        LastFrame = Since(FrameStart);
+        FrameStart = Get();
+    }
+
+    AllocationCounts
+    AllocationTracker::GetLastFrame
+    ()
+    {
+        return LastFrame;
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace octronic::dream
+{
+    struct AllocationCounts
+    {
+        uint64_t allocations = 0;
+        uint64_t frees = 0;
+        uint64_t bytes = 0;
+    };
+
+    /**
+     * @brief AllocationTracker counts heap allocations for the whole
+     * process, the calling thread, the last frame and each profiler zone.
+     *
+     * Nothing is counted unless an executable opts in by expanding
+     * DREAM_ALLOCATION_HOOK() once at namespace scope in one of its own
+     * source files. That replaces the global operator new and delete with
+     * versions that feed the tracker, at the cost of two relaxed atomic
+     * adds and two thread local adds per allocation.
+     */
+    class AllocationTracker
+    {
+    public:
+        /**
+         * @brief True once the hook has seen an allocation.
+         */
+        static bool IsInstalled();
+
+        static void RecordAllocation(size_t bytes);
+        static void RecordFree();
+
+        /**
+         * @brief Counts for the whole process.
+         */
+        static AllocationCounts Get();
+        /**
+         * @brief Counts made by the calling thread.
+         */
+        static AllocationCounts GetThread();
+        /**
+         * @brief Counts made since the given snapshot of Get.
+         */
+        static AllocationCounts Since(const AllocationCounts& from);
+
+        /**
+         * @brief Close the current frame, called by ProjectRuntime::step.
+         */
+        static void MarkFrame();
+        /**
+         * @brief Counts made by every thread during the last complete frame.
+         */
+        static AllocationCounts GetLastFrame();
+    };
+}
+
+#define DREAM_ALLOCATION_HOOK()                                                                  \
+    void* operator new(std::size_t size)                                                         \
+    {                                                                                            \
+        octronic::dream::AllocationTracker::RecordAllocation(size);                              \
+        void* ptr = std::malloc(size == 0 ? 1 : size);                                           \
+        if (ptr == nullptr) throw std::bad_alloc();                                              \
+        return ptr;                                                                              \
+    }                                                                                            \
+    void* operator new[](std::size_t size) { return operator new(size); }                        \
+    void operator delete(void* ptr) noexcept                                                     \
+    {                                                                                            \
+        if (ptr == nullptr) return;                                                              \
+        octronic::dream::AllocationTracker::RecordFree();                                        \
+        std::free(ptr);                                                                          \
+    }                                                                                            \
+    void operator delete[](void* ptr) noexcept { operator delete(ptr); }                         \
+    void operator delete(void* ptr, std::size_t) noexcept { operator delete(ptr); }              \
+    void operator delete[](void* ptr, std::size_t) noexcept { operator delete(ptr); }
@@ -13,6 +13,7 @@ namespace octronic::dream
   // Project ==================================================================
   const string Constants::PROJECT_DEFAULT_NAME = "Untitled Project";
   const string Constants::PROJECT_FILE_EXTENSION = ".json";
+  const string Constants::PROJECT_COMPILED_FILE_EXTENSION = ".dreamc";
   const string Constants::PROJECT_TEMPLATE_ENTITIES_ARRAY = "template_entities";
   const string Constants::PROJECT_SCENE_ARRAY = "scenes";
   const string Constants::PROJECT_AUDIO_ASSET_ARRAY = "audio_assets";
@@ -225,6 +226,12 @@ namespace octronic::dream
   const string Constants::ASSET_ATTR_MODEL_MATERIAL_LIST = "material_list";
   const string Constants::ASSET_ATTR_MODEL_MODEL_MATERIAL = "model_material";
   const string Constants::ASSET_ATTR_MODEL_DREAM_MATERIAL = "dream_material";
+  const string Constants::ASSET_ATTR_MODEL_LOD_LIST = "lod_list";
+  const string Constants::ASSET_ATTR_MODEL_LOD_SCREEN_SIZE = "screen_size";
+  const string Constants::ASSET_ATTR_MODEL_LOD_RATIO = "ratio";
+  const string Constants::ASSET_ATTR_MODEL_LOD_MESH_SUFFIX = "_LOD";
+  const string Constants::ASSET_ATTR_MODEL_OCCLUDER = "occluder";
+  const string Constants::ASSET_ATTR_MODEL_COMPACT_VERTICES = "compact_vertices";
 
   // Lua =====================================================================
   const string Constants::SCRIPT_INIT_FUNCTION   = "onInit";
@@ -259,6 +266,8 @@ namespace octronic::dream
   const string Constants::ASSET_ATTR_TEXTURE_FLIP_VERTICAL = "flip_vertical";
 
   // Audio ===================================================================
+  const string Constants::ASSET_ATTR_AUDIO_STREAM = "stream";
+  const string Constants::ASSET_ATTR_AUDIO_PRIORITY = "priority";
 
   // Animation / Keyframe ====================================================
   const string Constants::KEYFRAME_ID = "kf_id";
@@ -30,6 +30,7 @@ namespace octronic::dream
     const static string PROJECT_DEFAULT_NAME;
     const static int    PROJECT_UUID_LENGTH;
     const static string PROJECT_FILE_EXTENSION;
+    const static string PROJECT_COMPILED_FILE_EXTENSION;
     const static string PROJECT_PATH_SEP;
     const static string PROJECT_TEMPLATE_ENTITIES_ARRAY;
     const static string PROJECT_SCENE_ARRAY;
@@ -221,6 +222,12 @@ namespace octronic::dream
     const static string ASSET_ATTR_MODEL_MATERIAL_LIST;
     const static string ASSET_ATTR_MODEL_MODEL_MATERIAL;
     const static string ASSET_ATTR_MODEL_DREAM_MATERIAL;
+    const static string ASSET_ATTR_MODEL_LOD_LIST;
+    const static string ASSET_ATTR_MODEL_LOD_SCREEN_SIZE;
+    const static string ASSET_ATTR_MODEL_LOD_RATIO;
+    const static string ASSET_ATTR_MODEL_LOD_MESH_SUFFIX;
+    const static string ASSET_ATTR_MODEL_OCCLUDER;
+    const static string ASSET_ATTR_MODEL_COMPACT_VERTICES;
     // Shader ==================================================================
     const static string SHADER_FRAGMENT;
     const static string SHADER_VERTEX;
@@ -249,6 +256,9 @@ namespace octronic::dream
     const static string ASSET_ATTR_TEXTURE_BRDF_LUT_SHADER;
     const static string ASSET_ATTR_TEXTURE_IS_ENVIRONMENT;
     const static string ASSET_ATTR_TEXTURE_FLIP_VERTICAL;
+    // Audio ===================================================================
+    const static string ASSET_ATTR_AUDIO_STREAM;
+    const static string ASSET_ATTR_AUDIO_PRIORITY;
     // Data Maps ===============================================================
     static map<AssetType, vector<string>> DREAM_ASSET_FORMATS_MAP;
     static vector<string> DREAM_PATH_SPLINE_TYPES;
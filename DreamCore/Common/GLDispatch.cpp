@@ -0,0 +1,951 @@
+#include "GLDispatch.h"
+
+#include "Logger.h"
+
+#include <map>
+
+using std::map;
+using std::to_string;
+
+namespace octronic::dream
+{
+    const size_t GLDispatch::RECORDING_MAX_CALLS = 1000000;
+    GLDispatchCounters GLDispatch::Counters;
+    vector<string> GLDispatch::Recording;
+    GLDispatchBackend GLDispatch::Backend = GL_DISPATCH_NATIVE;
+}
+
+#if !defined(__ANDROID__)
+
+namespace
+{
+    using octronic::dream::GLDispatch;
+    using octronic::dream::GL_DISPATCH_RECORDING;
+
+    // Null GL state =========================================================
+
+    const GLint  NULL_MAX_SIZE = 16384;
+    const char*  NULL_VERSION = "3.3 Dream Null GL";
+    const char*  NULL_GLSL_VERSION = "3.30 Dream Null GL";
+    const char*  NULL_VENDOR = "Dream";
+
+    GLuint NextName = 1;
+    GLuint CurrentProgram = 0;
+    GLuint CurrentVAO = 0;
+    GLuint CurrentFramebuffer = 0;
+    GLenum CurrentActiveTexture = GL_TEXTURE0;
+    map<GLenum, GLuint> CurrentBuffers;
+    map<GLenum, GLuint> CurrentTextures;
+    map<GLenum, bool> CurrentCaps;
+
+    void
+    AppendArg
+    (string& call, const char* value)
+    {
+        call += value;
+    }
+
+    template <typename T>
+    void
+    AppendArg
+    (string& call, T value)
+    {
+        call += to_string(value);
+    }
+
+    /**
+     * Arguments are passed as values and only formatted when recording, so
+     * the null backend does not allocate on every call it counts.
+     */
+    template <typename... Args>
+    void
+    Record
+    (const char* name, Args... args)
+    {
+        GLDispatch::Counters.calls++;
+        if (GLDispatch::GetBackend() == GL_DISPATCH_RECORDING &&
+            GLDispatch::Recording.size() < GLDispatch::RECORDING_MAX_CALLS)
+        {
+            string call(name);
+            call += "(";
+            [[maybe_unused]] const char* separator = "";
+            ((call += separator, AppendArg(call, args), separator = ", "), ...);
+            call += ")";
+            GLDispatch::Recording.push_back(std::move(call));
+        }
+    }
+
+    void
+    StateChange
+    (bool redundant)
+    {
+        GLDispatch::Counters.stateChanges++;
+        if (redundant) GLDispatch::Counters.redundantStateChanges++;
+    }
+
+    void
+    GenNames
+    (GLsizei n, GLuint* names)
+    {
+        for (GLsizei i = 0; i < n; i++) names[i] = NextName++;
+        GLDispatch::Counters.objectsCreated += n;
+    }
+
+    size_t
+    PixelBytes
+    (GLenum format, GLenum type)
+    {
+        size_t components = 4;
+        switch (format)
+        {
+            case GL_RED:
+            case GL_DEPTH_COMPONENT:
+                components = 1;
+                break;
+            case GL_RG:
+                components = 2;
+                break;
+            case GL_RGB:
+                components = 3;
+                break;
+            default:
+                break;
+        }
+
+        switch (type)
+        {
+            case GL_UNSIGNED_BYTE:
+            case GL_BYTE:
+                return components;
+            case GL_HALF_FLOAT:
+            case GL_UNSIGNED_SHORT:
+            case GL_SHORT:
+                return components * 2;
+            default:
+                return components * 4;
+        }
+    }
+
+    // State =================================================================
+
+    void APIENTRY
+    NullEnable
+    (GLenum cap)
+    {
+        Record("glEnable", cap);
+        StateChange(CurrentCaps[cap]);
+        CurrentCaps[cap] = true;
+    }
+
+    void APIENTRY
+    NullDisable
+    (GLenum cap)
+    {
+        Record("glDisable", cap);
+        auto itr = CurrentCaps.find(cap);
+        StateChange(itr != CurrentCaps.end() && !itr->second);
+        CurrentCaps[cap] = false;
+    }
+
+    void APIENTRY
+    NullViewport
+    (GLint x, GLint y, GLsizei width, GLsizei height)
+    {
+        Record("glViewport", x, y, width, height);
+        StateChange(false);
+    }
+
+    void APIENTRY
+    NullCullFace
+    (GLenum mode)
+    {
+        Record("glCullFace", mode);
+        StateChange(false);
+    }
+
+    void APIENTRY
+    NullDepthFunc
+    (GLenum func)
+    {
+        Record("glDepthFunc", func);
+        StateChange(false);
+    }
+
+    void APIENTRY
+    NullDepthMask
+    (GLboolean flag)
+    {
+        Record("glDepthMask", flag);
+        StateChange(false);
+    }
+
+    void APIENTRY
+    NullBlendFunc
+    (GLenum sfactor, GLenum dfactor)
+    {
+        Record("glBlendFunc", sfactor, dfactor);
+        StateChange(false);
+    }
+
+    void APIENTRY
+    NullClearColor
+    (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+    {
+        Record("glClearColor", red, green, blue, alpha);
+        StateChange(false);
+    }
+
+    void APIENTRY
+    NullClear
+    (GLbitfield mask)
+    {
+        Record("glClear", mask);
+    }
+
+    void APIENTRY
+    NullPixelStorei
+    (GLenum pname, GLint param)
+    {
+        Record("glPixelStorei", pname, param);
+    }
+
+    void APIENTRY
+    NullDrawBuffer
+    (GLenum buf)
+    {
+        Record("glDrawBuffer", buf);
+    }
+
+    void APIENTRY
+    NullDrawBuffers
+    (GLsizei n, const GLenum*)
+    {
+        Record("glDrawBuffers", n);
+    }
+
+    void APIENTRY
+    NullReadBuffer
+    (GLenum src)
+    {
+        Record("glReadBuffer", src);
+    }
+
+    // Queries ===============================================================
+
+    GLenum APIENTRY
+    NullGetError
+    ()
+    {
+        return GL_NO_ERROR;
+    }
+
+    const GLubyte* APIENTRY
+    NullGetString
+    (GLenum name)
+    {
+        Record("glGetString", name);
+        switch (name)
+        {
+            case GL_VERSION:
+                return reinterpret_cast<const GLubyte*>(NULL_VERSION);
+            case GL_SHADING_LANGUAGE_VERSION:
+                return reinterpret_cast<const GLubyte*>(NULL_GLSL_VERSION);
+            default:
+                return reinterpret_cast<const GLubyte*>(NULL_VENDOR);
+        }
+    }
+
+    void APIENTRY
+    NullGetIntegerv
+    (GLenum pname, GLint* data)
+    {
+        Record("glGetIntegerv", pname);
+        switch (pname)
+        {
+            case GL_MAX_RENDERBUFFER_SIZE:
+            case GL_MAX_TEXTURE_SIZE:
+                data[0] = NULL_MAX_SIZE;
+                break;
+            case GL_VIEWPORT:
+                data[0] = data[1] = data[2] = data[3] = 0;
+                break;
+            default:
+                data[0] = 0;
+                break;
+        }
+    }
+
+    GLenum APIENTRY
+    NullCheckFramebufferStatus
+    (GLenum target)
+    {
+        Record("glCheckFramebufferStatus", target);
+        return GL_FRAMEBUFFER_COMPLETE;
+    }
+
+    // Objects ===============================================================
+
+    void APIENTRY
+    NullGenBuffers
+    (GLsizei n, GLuint* names)
+    {
+        Record("glGenBuffers", n);
+        GenNames(n, names);
+    }
+
+    void APIENTRY
+    NullGenTextures
+    (GLsizei n, GLuint* names)
+    {
+        Record("glGenTextures", n);
+        GenNames(n, names);
+    }
+
+    void APIENTRY
+    NullGenVertexArrays
+    (GLsizei n, GLuint* names)
+    {
+        Record("glGenVertexArrays", n);
+        GenNames(n, names);
+    }
+
+    void APIENTRY
+    NullGenFramebuffers
+    (GLsizei n, GLuint* names)
+    {
+        Record("glGenFramebuffers", n);
+        GenNames(n, names);
+    }
+
+    void APIENTRY
+    NullGenRenderbuffers
+    (GLsizei n, GLuint* names)
+    {
+        Record("glGenRenderbuffers", n);
+        GenNames(n, names);
+    }
+
+    void APIENTRY
+    NullDeleteBuffers
+    (GLsizei n, const GLuint*)
+    {
+        Record("glDeleteBuffers", n);
+        GLDispatch::Counters.objectsDeleted += n;
+    }
+
+    void APIENTRY
+    NullDeleteTextures
+    (GLsizei n, const GLuint*)
+    {
+        Record("glDeleteTextures", n);
+        GLDispatch::Counters.objectsDeleted += n;
+    }
+
+    void APIENTRY
+    NullDeleteVertexArrays
+    (GLsizei n, const GLuint*)
+    {
+        Record("glDeleteVertexArrays", n);
+        GLDispatch::Counters.objectsDeleted += n;
+    }
+
+    void APIENTRY
+    NullDeleteFramebuffers
+    (GLsizei n, const GLuint*)
+    {
+        Record("glDeleteFramebuffers", n);
+        GLDispatch::Counters.objectsDeleted += n;
+    }
+
+    void APIENTRY
+    NullDeleteRenderbuffers
+    (GLsizei n, const GLuint*)
+    {
+        Record("glDeleteRenderbuffers", n);
+        GLDispatch::Counters.objectsDeleted += n;
+    }
+
+    // Binding ===============================================================
+
+    void APIENTRY
+    NullUseProgram
+    (GLuint program)
+    {
+        Record("glUseProgram", program);
+        StateChange(CurrentProgram == program);
+        CurrentProgram = program;
+    }
+
+    void APIENTRY
+    NullBindVertexArray
+    (GLuint array)
+    {
+        Record("glBindVertexArray", array);
+        StateChange(CurrentVAO == array);
+        CurrentVAO = array;
+    }
+
+    void APIENTRY
+    NullBindBuffer
+    (GLenum target, GLuint buffer)
+    {
+        Record("glBindBuffer", target, buffer);
+        StateChange(CurrentBuffers[target] == buffer);
+        CurrentBuffers[target] = buffer;
+    }
+
+    void APIENTRY
+    NullBindBufferBase
+    (GLenum target, GLuint index, GLuint buffer)
+    {
+        Record("glBindBufferBase", target, index, buffer);
+        StateChange(false);
+    }
+
+    void APIENTRY
+    NullBindFramebuffer
+    (GLenum target, GLuint framebuffer)
+    {
+        Record("glBindFramebuffer", target, framebuffer);
+        StateChange(CurrentFramebuffer == framebuffer);
+        CurrentFramebuffer = framebuffer;
+    }
+
+    void APIENTRY
+    NullBindRenderbuffer
+    (GLenum target, GLuint renderbuffer)
+    {
+        Record("glBindRenderbuffer", target, renderbuffer);
+        StateChange(false);
+    }
+
+    void APIENTRY
+    NullActiveTexture
+    (GLenum texture)
+    {
+        Record("glActiveTexture", texture);
+        StateChange(CurrentActiveTexture == texture);
+        CurrentActiveTexture = texture;
+    }
+
+    void APIENTRY
+    NullBindTexture
+    (GLenum target, GLuint texture)
+    {
+        Record("glBindTexture", target, texture);
+        StateChange(CurrentTextures[CurrentActiveTexture] == texture);
+        CurrentTextures[CurrentActiveTexture] = texture;
+    }
+
+    // Upload ================================================================
+
+    void APIENTRY
+    NullBufferData
+    (GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+    {
+        Record("glBufferData", target, size, usage);
+        if (data) GLDispatch::Counters.bytesUploaded += size;
+    }
+
+    void APIENTRY
+    NullBufferSubData
+    (GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+    {
+        Record("glBufferSubData", target, offset, size);
+        if (data) GLDispatch::Counters.bytesUploaded += size;
+    }
+
+    void APIENTRY
+    NullTexImage2D
+    (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+     GLint border, GLenum format, GLenum type, const void* pixels)
+    {
+        Record("glTexImage2D", target, level, internalformat, width, height);
+        if (pixels) GLDispatch::Counters.bytesUploaded += width * height * PixelBytes(format, type);
+    }
+
+    void APIENTRY
+    NullTexSubImage2D
+    (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
+     GLenum format, GLenum type, const void* pixels)
+    {
+        Record("glTexSubImage2D", target, level, width, height);
+        if (pixels) GLDispatch::Counters.bytesUploaded += width * height * PixelBytes(format, type);
+    }
+
+    void APIENTRY
+    NullTexParameteri
+    (GLenum target, GLenum pname, GLint param)
+    {
+        Record("glTexParameteri", target, pname, param);
+    }
+
+    void APIENTRY
+    NullTexParameterfv
+    (GLenum target, GLenum pname, const GLfloat*)
+    {
+        Record("glTexParameterfv", target, pname);
+    }
+
+    void APIENTRY
+    NullGenerateMipmap
+    (GLenum target)
+    {
+        Record("glGenerateMipmap", target);
+    }
+
+    void APIENTRY
+    NullRenderbufferStorage
+    (GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+    {
+        Record("glRenderbufferStorage", internalformat, width, height);
+    }
+
+    void APIENTRY
+    NullFramebufferTexture2D
+    (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+    {
+        Record("glFramebufferTexture2D", attachment, texture);
+    }
+
+    void APIENTRY
+    NullFramebufferRenderbuffer
+    (GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
+    {
+        Record("glFramebufferRenderbuffer", attachment, renderbuffer);
+    }
+
+    void APIENTRY
+    NullReadPixels
+    (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void*)
+    {
+        Record("glReadPixels", width, height);
+    }
+
+    // Vertex Attributes =====================================================
+
+    void APIENTRY
+    NullEnableVertexAttribArray
+    (GLuint index)
+    {
+        Record("glEnableVertexAttribArray", index);
+    }
+
+    void APIENTRY
+    NullVertexAttribPointer
+    (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void*)
+    {
+        Record("glVertexAttribPointer", index, size, type, stride);
+    }
+
+    // Draw ==================================================================
+
+    void APIENTRY
+    NullDrawArrays
+    (GLenum mode, GLint first, GLsizei count)
+    {
+        Record("glDrawArrays", mode, first, count);
+        GLDispatch::Counters.drawCalls++;
+        GLDispatch::Counters.instancesDrawn++;
+        GLDispatch::Counters.elementsDrawn += count;
+    }
+
+    void APIENTRY
+    NullDrawElements
+    (GLenum mode, GLsizei count, GLenum type, const void*)
+    {
+        Record("glDrawElements", mode, count);
+        GLDispatch::Counters.drawCalls++;
+        GLDispatch::Counters.instancesDrawn++;
+        GLDispatch::Counters.elementsDrawn += count;
+    }
+
+    void APIENTRY
+    NullDrawElementsInstanced
+    (GLenum mode, GLsizei count, GLenum type, const void*, GLsizei instancecount)
+    {
+        Record("glDrawElementsInstanced", mode, count, instancecount);
+        GLDispatch::Counters.drawCalls++;
+        GLDispatch::Counters.instancesDrawn += instancecount;
+        GLDispatch::Counters.elementsDrawn += count * instancecount;
+    }
+
+    // Shaders ===============================================================
+
+    GLuint APIENTRY
+    NullCreateShader
+    (GLenum type)
+    {
+        Record("glCreateShader", type);
+        GLDispatch::Counters.objectsCreated++;
+        return NextName++;
+    }
+
+    GLuint APIENTRY
+    NullCreateProgram
+    ()
+    {
+        Record("glCreateProgram");
+        GLDispatch::Counters.objectsCreated++;
+        return NextName++;
+    }
+
+    void APIENTRY
+    NullDeleteShader
+    (GLuint shader)
+    {
+        Record("glDeleteShader", shader);
+        GLDispatch::Counters.objectsDeleted++;
+    }
+
+    void APIENTRY
+    NullDeleteProgram
+    (GLuint program)
+    {
+        Record("glDeleteProgram", program);
+        GLDispatch::Counters.objectsDeleted++;
+    }
+
+    void APIENTRY
+    NullShaderSource
+    (GLuint shader, GLsizei count, const GLchar* const*, const GLint*)
+    {
+        Record("glShaderSource", shader);
+    }
+
+    void APIENTRY
+    NullCompileShader
+    (GLuint shader)
+    {
+        Record("glCompileShader", shader);
+    }
+
+    void APIENTRY
+    NullAttachShader
+    (GLuint program, GLuint shader)
+    {
+        Record("glAttachShader", program, shader);
+    }
+
+    void APIENTRY
+    NullLinkProgram
+    (GLuint program)
+    {
+        Record("glLinkProgram", program);
+    }
+
+    void APIENTRY
+    NullGetShaderOrProgramiv
+    (GLuint, GLenum pname, GLint* params)
+    {
+        Record("glGetShaderiv", pname);
+        *params = (pname == GL_COMPILE_STATUS || pname == GL_LINK_STATUS) ? GL_TRUE : 0;
+    }
+
+    void APIENTRY
+    NullGetInfoLog
+    (GLuint, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+    {
+        Record("glGetInfoLog");
+        if (length) *length = 0;
+        if (infoLog && bufSize > 0) infoLog[0] = '\0';
+    }
+
+    // Uniforms ==============================================================
+
+    GLint APIENTRY
+    NullGetUniformLocation
+    (GLuint program, const GLchar* name)
+    {
+        Record("glGetUniformLocation", name);
+        // Every name is found, callers only compare against -1
+        return 0;
+    }
+
+    GLuint APIENTRY
+    NullGetUniformBlockIndex
+    (GLuint program, const GLchar* name)
+    {
+        Record("glGetUniformBlockIndex", name);
+        // As with uniforms, every block is found
+        return 0;
+    }
+
+    void APIENTRY
+    NullUniformBlockBinding
+    (GLuint program, GLuint index, GLuint binding)
+    {
+        Record("glUniformBlockBinding", program, index, binding);
+    }
+
+    void APIENTRY
+    NullGetUniformfv
+    (GLuint, GLint, GLfloat* params)
+    {
+        Record("glGetUniformfv");
+        *params = 0.f;
+    }
+
+    void APIENTRY
+    NullGetUniformiv
+    (GLuint, GLint, GLint* params)
+    {
+        Record("glGetUniformiv");
+        *params = 0;
+    }
+
+    void APIENTRY
+    NullGetUniformuiv
+    (GLuint, GLint, GLuint* params)
+    {
+        Record("glGetUniformuiv");
+        *params = 0;
+    }
+
+    void
+    UniformUpload
+    (const char* name, GLint location, size_t bytes)
+    {
+        Record(name, location, bytes);
+        GLDispatch::Counters.uniformUploads++;
+        GLDispatch::Counters.bytesUploaded += bytes;
+    }
+
+    void APIENTRY NullUniform1i(GLint l, GLint)   { UniformUpload("glUniform1i",  l, sizeof(GLint)); }
+    void APIENTRY NullUniform1ui(GLint l, GLuint) { UniformUpload("glUniform1ui", l, sizeof(GLuint)); }
+    void APIENTRY NullUniform1f(GLint l, GLfloat) { UniformUpload("glUniform1f",  l, sizeof(GLfloat)); }
+
+#define DREAM_NULL_UNIFORM_V(fn, type, components)                                       \
+    void APIENTRY Null##fn(GLint l, GLsizei c, const type*)                               \
+    { UniformUpload("gl" #fn, l, c * components * sizeof(type)); }
+
+#define DREAM_NULL_UNIFORM_MATRIX(fn, components)                                        \
+    void APIENTRY Null##fn(GLint l, GLsizei c, GLboolean, const GLfloat*)                \
+    { UniformUpload("gl" #fn, l, c * components * sizeof(GLfloat)); }
+
+    DREAM_NULL_UNIFORM_V(Uniform1iv,  GLint,   1)
+    DREAM_NULL_UNIFORM_V(Uniform2iv,  GLint,   2)
+    DREAM_NULL_UNIFORM_V(Uniform3iv,  GLint,   3)
+    DREAM_NULL_UNIFORM_V(Uniform4iv,  GLint,   4)
+    DREAM_NULL_UNIFORM_V(Uniform1uiv, GLuint,  1)
+    DREAM_NULL_UNIFORM_V(Uniform2uiv, GLuint,  2)
+    DREAM_NULL_UNIFORM_V(Uniform3uiv, GLuint,  3)
+    DREAM_NULL_UNIFORM_V(Uniform4uiv, GLuint,  4)
+    DREAM_NULL_UNIFORM_V(Uniform1fv,  GLfloat, 1)
+    DREAM_NULL_UNIFORM_V(Uniform2fv,  GLfloat, 2)
+    DREAM_NULL_UNIFORM_V(Uniform3fv,  GLfloat, 3)
+    DREAM_NULL_UNIFORM_V(Uniform4fv,  GLfloat, 4)
+
+    DREAM_NULL_UNIFORM_MATRIX(UniformMatrix2fv,   4)
+    DREAM_NULL_UNIFORM_MATRIX(UniformMatrix3fv,   9)
+    DREAM_NULL_UNIFORM_MATRIX(UniformMatrix4fv,   16)
+    DREAM_NULL_UNIFORM_MATRIX(UniformMatrix2x3fv, 6)
+    DREAM_NULL_UNIFORM_MATRIX(UniformMatrix3x2fv, 6)
+    DREAM_NULL_UNIFORM_MATRIX(UniformMatrix2x4fv, 8)
+    DREAM_NULL_UNIFORM_MATRIX(UniformMatrix4x2fv, 8)
+    DREAM_NULL_UNIFORM_MATRIX(UniformMatrix3x4fv, 12)
+    DREAM_NULL_UNIFORM_MATRIX(UniformMatrix4x3fv, 12)
+
+#undef DREAM_NULL_UNIFORM_V
+#undef DREAM_NULL_UNIFORM_MATRIX
+}
+
+#endif
+
+namespace octronic::dream
+{
+    bool
+    GLDispatch::InstallBackend
+    (GLDispatchBackend backend)
+    {
+#if defined(__ANDROID__)
+        if (backend != GL_DISPATCH_NATIVE)
+        {
+            LOG_ERROR("GLDispatch: Null backends are not available on Android");
+            return false;
+        }
+        Backend = backend;
+        return true;
+#else
+        if (backend == GL_DISPATCH_NATIVE)
+        {
+            // The window component restores the native entry points when it
+            // loads glad.
+            LOG_DEBUG("GLDispatch: Using native backend");
+            Backend = backend;
+            return true;
+        }
+
+        LOG_INFO("GLDispatch: Installing {} backend",
+                 backend == GL_DISPATCH_RECORDING ? "recording" : "null");
+
+        Backend = backend;
+        ClearCounters();
+        ClearRecording();
+
+        // State
+        glad_glEnable = NullEnable;
+        glad_glDisable = NullDisable;
+        glad_glViewport = NullViewport;
+        glad_glCullFace = NullCullFace;
+        glad_glDepthFunc = NullDepthFunc;
+        glad_glDepthMask = NullDepthMask;
+        glad_glBlendFunc = NullBlendFunc;
+        glad_glClearColor = NullClearColor;
+        glad_glClear = NullClear;
+        glad_glPixelStorei = NullPixelStorei;
+        glad_glDrawBuffer = NullDrawBuffer;
+        glad_glDrawBuffers = NullDrawBuffers;
+        glad_glReadBuffer = NullReadBuffer;
+        // Queries
+        glad_glGetError = NullGetError;
+        glad_glGetString = NullGetString;
+        glad_glGetIntegerv = NullGetIntegerv;
+        glad_glCheckFramebufferStatus = NullCheckFramebufferStatus;
+        // Objects
+        glad_glGenBuffers = NullGenBuffers;
+        glad_glGenTextures = NullGenTextures;
+        glad_glGenVertexArrays = NullGenVertexArrays;
+        glad_glGenFramebuffers = NullGenFramebuffers;
+        glad_glGenRenderbuffers = NullGenRenderbuffers;
+        glad_glDeleteBuffers = NullDeleteBuffers;
+        glad_glDeleteTextures = NullDeleteTextures;
+        glad_glDeleteVertexArrays = NullDeleteVertexArrays;
+        glad_glDeleteFramebuffers = NullDeleteFramebuffers;
+        glad_glDeleteRenderbuffers = NullDeleteRenderbuffers;
+        // Binding
+        glad_glUseProgram = NullUseProgram;
+        glad_glBindVertexArray = NullBindVertexArray;
+        glad_glBindBuffer = NullBindBuffer;
+        glad_glBindBufferBase = NullBindBufferBase;
+        glad_glBindFramebuffer = NullBindFramebuffer;
+        glad_glBindRenderbuffer = NullBindRenderbuffer;
+        glad_glActiveTexture = NullActiveTexture;
+        glad_glBindTexture = NullBindTexture;
+        // Upload
+        glad_glBufferData = NullBufferData;
+        glad_glBufferSubData = NullBufferSubData;
+        glad_glTexImage2D = NullTexImage2D;
+        glad_glTexSubImage2D = NullTexSubImage2D;
+        glad_glTexParameteri = NullTexParameteri;
+        glad_glTexParameterfv = NullTexParameterfv;
+        glad_glGenerateMipmap = NullGenerateMipmap;
+        glad_glRenderbufferStorage = NullRenderbufferStorage;
+        glad_glFramebufferTexture2D = NullFramebufferTexture2D;
+        glad_glFramebufferRenderbuffer = NullFramebufferRenderbuffer;
+        glad_glReadPixels = NullReadPixels;
+        // Vertex Attributes
+        glad_glEnableVertexAttribArray = NullEnableVertexAttribArray;
+        glad_glVertexAttribPointer = NullVertexAttribPointer;
+        // Draw
+        glad_glDrawArrays = NullDrawArrays;
+        glad_glDrawElements = NullDrawElements;
+        glad_glDrawElementsInstanced = NullDrawElementsInstanced;
+        // Shaders
+        glad_glCreateShader = NullCreateShader;
+        glad_glCreateProgram = NullCreateProgram;
+        glad_glDeleteShader = NullDeleteShader;
+        glad_glDeleteProgram = NullDeleteProgram;
+        glad_glShaderSource = NullShaderSource;
+        glad_glCompileShader = NullCompileShader;
+        glad_glAttachShader = NullAttachShader;
+        glad_glLinkProgram = NullLinkProgram;
+        glad_glGetShaderiv = NullGetShaderOrProgramiv;
+        glad_glGetProgramiv = NullGetShaderOrProgramiv;
+        glad_glGetShaderInfoLog = NullGetInfoLog;
+        glad_glGetProgramInfoLog = NullGetInfoLog;
+        // Uniforms
+        glad_glGetUniformLocation = NullGetUniformLocation;
+        glad_glGetUniformBlockIndex = NullGetUniformBlockIndex;
+        glad_glUniformBlockBinding = NullUniformBlockBinding;
+        glad_glGetUniformfv = NullGetUniformfv;
+        glad_glGetUniformiv = NullGetUniformiv;
+        glad_glGetUniformuiv = NullGetUniformuiv;
+        glad_glUniform1i = NullUniform1i;
+        glad_glUniform1ui = NullUniform1ui;
+        glad_glUniform1f = NullUniform1f;
+        glad_glUniform1iv = NullUniform1iv;
+        glad_glUniform2iv = NullUniform2iv;
+        glad_glUniform3iv = NullUniform3iv;
+        glad_glUniform4iv = NullUniform4iv;
+        glad_glUniform1uiv = NullUniform1uiv;
+        glad_glUniform2uiv = NullUniform2uiv;
+        glad_glUniform3uiv = NullUniform3uiv;
+        glad_glUniform4uiv = NullUniform4uiv;
+        glad_glUniform1fv = NullUniform1fv;
+        glad_glUniform2fv = NullUniform2fv;
+        glad_glUniform3fv = NullUniform3fv;
+        glad_glUniform4fv = NullUniform4fv;
+        glad_glUniformMatrix2fv = NullUniformMatrix2fv;
+        glad_glUniformMatrix3fv = NullUniformMatrix3fv;
+        glad_glUniformMatrix4fv = NullUniformMatrix4fv;
+        glad_glUniformMatrix2x3fv = NullUniformMatrix2x3fv;
+        glad_glUniformMatrix3x2fv = NullUniformMatrix3x2fv;
+        glad_glUniformMatrix2x4fv = NullUniformMatrix2x4fv;
+        glad_glUniformMatrix4x2fv = NullUniformMatrix4x2fv;
+        glad_glUniformMatrix3x4fv = NullUniformMatrix3x4fv;
+        glad_glUniformMatrix4x3fv = NullUniformMatrix4x3fv;
+        return true;
+#endif
+    }
+
+    GLDispatchBackend
+    GLDispatch::GetBackend
+    ()
+    {
+        return Backend;
+    }
+
+    bool
+    GLDispatch::IsNullBackend
+    ()
+    {
+        return Backend != GL_DISPATCH_NATIVE;
+    }
+
+    void
+    GLDispatch::ClearCounters
+    ()
+    {
+        Counters = GLDispatchCounters();
+    }
+
+    const GLDispatchCounters&
+    GLDispatch::GetCounters
+    ()
+    {
+        return Counters;
+    }
+
+    json
+    GLDispatch::GetCountersJson
+    ()
+    {
+        json js = json::object();
+        js["calls"] = Counters.calls;
+        js["draw_calls"] = Counters.drawCalls;
+        js["instances_drawn"] = Counters.instancesDrawn;
+        js["elements_drawn"] = Counters.elementsDrawn;
+        js["state_changes"] = Counters.stateChanges;
+        js["redundant_state_changes"] = Counters.redundantStateChanges;
+        js["uniform_uploads"] = Counters.uniformUploads;
+        js["bytes_uploaded"] = Counters.bytesUploaded;
+        js["objects_created"] = Counters.objectsCreated;
+        js["objects_deleted"] = Counters.objectsDeleted;
+        return js;
+    }
+
+    const vector<string>&
+    GLDispatch::GetRecording
+    ()
+    {
+        return Recording;
+    }
+
+    void
+    GLDispatch::ClearRecording
+    ()
+    {
+        Recording.clear();
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "GLHeader.h"
+
+#include <string>
+#include <vector>
+#include <json.hpp>
+
+using std::string;
+using std::vector;
+using nlohmann::json;
+
+namespace octronic::dream
+{
+    enum GLDispatchBackend
+    {
+        GL_DISPATCH_NATIVE,
+        GL_DISPATCH_NULL,
+        GL_DISPATCH_RECORDING
+    };
+
+    struct GLDispatchCounters
+    {
+        unsigned long calls = 0;
+        unsigned long drawCalls = 0;
+        unsigned long instancesDrawn = 0;
+        unsigned long elementsDrawn = 0;
+        unsigned long stateChanges = 0;
+        unsigned long redundantStateChanges = 0;
+        unsigned long uniformUploads = 0;
+        unsigned long bytesUploaded = 0;
+        unsigned long objectsCreated = 0;
+        unsigned long objectsDeleted = 0;
+    };
+
+    /**
+     * @brief GLDispatch swaps the GL entry points glad dispatches through for
+     * ones that do no GPU work, so the render path can run without a GL
+     * context.
+     *
+     * The null backend counts calls, draws, state changes and bytes uploaded.
+     * The recording backend also keeps the name and main arguments of every
+     * call. Object creation returns increasing fake names and queries report
+     * success, so shaders compile and framebuffers are complete.
+     *
+     * Only the entry points Dream uses are replaced, any other function
+     * pointer is left as it was. Counters are per frame and cleared by
+     * ProjectRuntime::step. Not available on Android, which calls GLES
+     * directly rather than through glad.
+     */
+    class GLDispatch
+    {
+    public:
+        const static size_t RECORDING_MAX_CALLS;
+
+        static bool InstallBackend(GLDispatchBackend backend);
+        static GLDispatchBackend GetBackend();
+        static bool IsNullBackend();
+
+        static void ClearCounters();
+        static const GLDispatchCounters& GetCounters();
+        static json GetCountersJson();
+
+        static const vector<string>& GetRecording();
+        static void ClearRecording();
+
+        static GLDispatchCounters Counters;
+        static vector<string> Recording;
+    private:
+        static GLDispatchBackend Backend;
+    };
+}
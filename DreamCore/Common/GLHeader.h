@@ -42,6 +42,9 @@
 	#include <string>
 	using std::string;
 
+	// glGetError waits on the driver, so errors are only checked in debug
+	// builds even when release builds log
+	#if !defined(NDEBUG)
 	/**
 	* @brief Used to check for OpenGL Runtime Errors. This will display the
 	* file and line from which the error was detected. This function should
@@ -98,6 +101,9 @@
 		while(errorCode != 0);
 		return wasError;
 	}
+	#else
+	#define GLCheckError()
+	#endif
 
     /**
       @brief Get Framebuffer Error string from the given enum
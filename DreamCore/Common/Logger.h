@@ -1,23 +1,38 @@
 #pragma once
 
-#ifndef NDEBUG
+// Compile time log threshold. LOG_* calls below DREAM_LOG_ACTIVE_LEVEL
+// compile to nothing, so their arguments are never formatted. Debug builds
+// keep everything, release builds keep warnings and above.
+
+#define DREAM_LOG_LEVEL_TRACE    0
+#define DREAM_LOG_LEVEL_DEBUG    1
+#define DREAM_LOG_LEVEL_INFO     2
+#define DREAM_LOG_LEVEL_WARN     3
+#define DREAM_LOG_LEVEL_ERROR    4
+#define DREAM_LOG_LEVEL_CRITICAL 5
+#define DREAM_LOG_LEVEL_OFF      6
+
+#ifndef DREAM_LOG_ACTIVE_LEVEL
+	#ifdef NDEBUG
+		#define DREAM_LOG_ACTIVE_LEVEL DREAM_LOG_LEVEL_WARN
+	#else
+		#define DREAM_LOG_ACTIVE_LEVEL DREAM_LOG_LEVEL_TRACE
+	#endif
+#endif
+
+#if DREAM_LOG_ACTIVE_LEVEL < DREAM_LOG_LEVEL_OFF
 #define ENABLE_LOGGING
 #endif
 
 #ifdef ENABLE_LOGGING
 	#include <spdlog/spdlog.h>
+	#include <spdlog/async.h>
 	#if defined(__ANDROID__)
 		#include "spdlog/sinks/android_sink.h"
 	#else
 		#include <spdlog/sinks/stdout_color_sinks.h>
 	#endif
 		#define LOG_LEVEL(x) spdlog::set_level(x)
-		#define LOG_TRACE(...) spdlog::trace(__VA_ARGS__)
-		#define LOG_DEBUG(...) spdlog::debug(__VA_ARGS__)
-		#define LOG_INFO(...) spdlog::info(__VA_ARGS__)
-		#define LOG_CRITICAL(...) spdlog::critical(__VA_ARGS__)
-		#define LOG_WARN(...) spdlog::warn(__VA_ARGS__)
-		#define LOG_ERROR(...) spdlog::error(__VA_ARGS__)
 		#define LOG_LEVEL_TRACE spdlog::level::trace
 		#define LOG_LEVEL_DEBUG spdlog::level::debug
 		#define LOG_LEVEL_CRITICAL spdlog::level::critical
@@ -27,14 +42,37 @@
 		#define LOG_LEVEL_OFF spdlog::level::off
 		#define LOG_GET_LEVEL() spdlog::get_level()
 		#define LOG_PATTERN(x) spdlog::set_pattern(x)
+		#define LOG_ASYNC(queueSize) octronic::dream::LogInitAsync(queueSize)
+		#define LOG_SHUTDOWN() spdlog::shutdown()
+
+	namespace octronic::dream
+	{
+		/**
+		 * @brief Replace the default logger with one that formats and writes
+		 * on a background thread. Callers only copy the message into the
+		 * queue. When the queue is full the oldest message is dropped rather
+		 * than blocking the caller. Errors request a flush so they are not
+		 * held back. Call LOG_SHUTDOWN once nothing else will log, to write
+		 * out what is still queued before the process exits.
+		 */
+		inline void LogInitAsync(size_t queueSize)
+		{
+			spdlog::init_thread_pool(queueSize, 1);
+	#if defined(__ANDROID__)
+			auto sink = std::make_shared<spdlog::sinks::android_sink_mt>("Dream");
+	#else
+			auto sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+	#endif
+			auto logger = std::make_shared<spdlog::async_logger>(
+						"dream", sink, spdlog::thread_pool(),
+						spdlog::async_overflow_policy::overrun_oldest);
+			logger->set_level(spdlog::get_level());
+			logger->flush_on(spdlog::level::err);
+			spdlog::set_default_logger(logger);
+		}
+	}
 #else
 	#define LOG_LEVEL(x)
-	#define LOG_TRACE(...)
-	#define LOG_DEBUG(...)
-	#define LOG_INFO(...)
-	#define LOG_CRITICAL(...)
-	#define LOG_WARN(...)
-	#define LOG_ERROR(...)
 	#define LOG_LEVEL_TRACE
 	#define LOG_LEVEL_DEBUG
 	#define LOG_LEVEL_INFO
@@ -43,4 +81,42 @@
 	#define LOG_LEVEL_ERROR
 	#define LOG_LEVEL_OFF
 	#define LOG_PATTERN(x)
+	#define LOG_ASYNC(queueSize)
+	#define LOG_SHUTDOWN()
+#endif
+
+#if DREAM_LOG_ACTIVE_LEVEL <= DREAM_LOG_LEVEL_TRACE
+	#define LOG_TRACE(...) spdlog::trace(__VA_ARGS__)
+#else
+	#define LOG_TRACE(...)
+#endif
+
+#if DREAM_LOG_ACTIVE_LEVEL <= DREAM_LOG_LEVEL_DEBUG
+	#define LOG_DEBUG(...) spdlog::debug(__VA_ARGS__)
+#else
+	#define LOG_DEBUG(...)
+#endif
+
+#if DREAM_LOG_ACTIVE_LEVEL <= DREAM_LOG_LEVEL_INFO
+	#define LOG_INFO(...) spdlog::info(__VA_ARGS__)
+#else
+	#define LOG_INFO(...)
+#endif
+
+#if DREAM_LOG_ACTIVE_LEVEL <= DREAM_LOG_LEVEL_WARN
+	#define LOG_WARN(...) spdlog::warn(__VA_ARGS__)
+#else
+	#define LOG_WARN(...)
+#endif
+
+#if DREAM_LOG_ACTIVE_LEVEL <= DREAM_LOG_LEVEL_ERROR
+	#define LOG_ERROR(...) spdlog::error(__VA_ARGS__)
+#else
+	#define LOG_ERROR(...)
+#endif
+
+#if DREAM_LOG_ACTIVE_LEVEL <= DREAM_LOG_LEVEL_CRITICAL
+	#define LOG_CRITICAL(...) spdlog::critical(__VA_ARGS__)
+#else
+	#define LOG_CRITICAL(...)
 #endif
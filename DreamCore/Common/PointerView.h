@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+using std::unique_ptr;
+using std::vector;
+
+namespace octronic::dream
+{
+    /**
+     * @brief A non owning view of a vector of unique_ptr that iterates
+     * the pointed to objects as references, so callers can walk a
+     * container of owned objects without copying it into a vector of
+     * reference_wrapper.
+     *
+     * The view refers to the owner's vector, it is invalidated by
+     * anything that adds or removes elements.
+     */
+    template <typename T>
+    class PointerView
+    {
+    public:
+        using Container = vector<unique_ptr<T>>;
+
+        class Iterator
+        {
+        public:
+            Iterator(typename Container::const_iterator itr) : mItr(itr) {}
+
+            T& operator*() const { return **mItr; }
+            T* operator->() const { return mItr->get(); }
+            Iterator& operator++() { ++mItr; return *this; }
+            bool operator==(const Iterator& other) const { return mItr == other.mItr; }
+            bool operator!=(const Iterator& other) const { return mItr != other.mItr; }
+
+        private:
+            typename Container::const_iterator mItr;
+        };
+
+        PointerView(const Container& container) : mContainer(container) {}
+
+        Iterator begin() const { return Iterator(mContainer.begin()); }
+        Iterator end() const { return Iterator(mContainer.end()); }
+        size_t size() const { return mContainer.size(); }
+        bool empty() const { return mContainer.empty(); }
+        T& operator[](size_t index) const { return *mContainer[index]; }
+
+    private:
+        const Container& mContainer;
+    };
+}
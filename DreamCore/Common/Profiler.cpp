@@ -0,0 +1,353 @@
+#include "Profiler.h"
+#include "AllocationTracker.h"
+#include "SteadyClock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
+using std::atomic;
+using std::lock_guard;
+using std::mutex;
+using std::unique_ptr;
+using std::unordered_set;
+using std::to_string;
+
+namespace octronic::dream
+{
+    const size_t Profiler::RING_CAPACITY = 32768;
+
+    namespace
+    {
+        /**
+         * A ProfilerEvent as stored in a ring. Readers copy slots while the
+         * owning thread may be writing them, so every field is a relaxed
+         * atomic and sequence works as a seqlock: odd while the slot is
+         * written, 2 * (index + 1) once zone index is complete. A copy is
+         * kept only if sequence held that value before and after it.
+         */
+        struct RingSlot
+        {
+            atomic<uint64_t> sequence{0};
+            atomic<const char*> name{nullptr};
+            atomic<uint64_t> start{0};
+            atomic<uint64_t> end{0};
+            atomic<uint32_t> depth{0};
+            atomic<uint64_t> allocations{0};
+            atomic<uint64_t> bytes{0};
+        };
+
+        struct ThreadRing
+        {
+            uint32_t id = 0;
+            string name;
+            unique_ptr<RingSlot[]> slots;
+            // Count of zones ever written, the next slot is head % capacity
+            atomic<uint64_t> head{0};
+            // Only touched by the owning thread
+            uint32_t depth = 0;
+        };
+
+        const uint64_t Epoch = SteadyClock::Now();
+        atomic<bool> Enabled(false);
+
+        atomic<uint64_t> FrameNumber(0);
+        atomic<uint64_t> FrameStart(0);
+        atomic<uint64_t> LastFrameStart(0);
+        atomic<uint64_t> ClearedAt(0);
+
+        mutex RingsMutex;
+        vector<unique_ptr<ThreadRing>> Rings;
+        // Rings of exited threads, reused so short lived workers do not
+        // each allocate a ring
+        vector<ThreadRing*> FreeRings;
+
+        mutex InternMutex;
+        unordered_set<string> InternedNames;
+
+        struct ThreadRingOwner
+        {
+            ThreadRing* ring = nullptr;
+
+            ~ThreadRingOwner()
+            {
+                if (ring == nullptr) return;
+                lock_guard<mutex> lock(RingsMutex);
+                ring->depth = 0;
+                FreeRings.push_back(ring);
+            }
+        };
+
+        thread_local ThreadRingOwner CurrentRing;
+
+        ThreadRing&
+        GetThreadRing
+        ()
+        {
+            if (CurrentRing.ring == nullptr)
+            {
+                lock_guard<mutex> lock(RingsMutex);
+                if (!FreeRings.empty())
+                {
+                    CurrentRing.ring = FreeRings.back();
+                    FreeRings.pop_back();
+                }
+                else
+                {
+                    auto ring = std::make_unique<ThreadRing>();
+                    ring->slots = std::make_unique<RingSlot[]>(Profiler::RING_CAPACITY);
+                    ring->id = static_cast<uint32_t>(Rings.size());
+                    CurrentRing.ring = ring.get();
+                    Rings.push_back(std::move(ring));
+                }
+                CurrentRing.ring->name = "Thread " + to_string(CurrentRing.ring->id);
+            }
+            return *CurrentRing.ring;
+        }
+    }
+
+    void
+    Profiler::SetEnabled
+    (bool enabled)
+    {
+        Enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool
+    Profiler::IsEnabled
+    ()
+    {
+        return Enabled.load(std::memory_order_relaxed);
+    }
+
+    uint64_t
+    Profiler::Now
+    ()
+    {
+        return SteadyClock::Now() - Epoch;
+    }
+
+    const char*
+    Profiler::Intern
+    (const string& name)
+    {
+        lock_guard<mutex> lock(InternMutex);
+        // Set nodes never move, so the pointer stays valid
+        return InternedNames.insert(name).first->c_str();
+    }
+
+    void
+    Profiler::SetThreadName
+    (const string& name)
+    {
+        auto& ring = GetThreadRing();
+        lock_guard<mutex> lock(RingsMutex);
+        ring.name = name;
+    }
+
+    uint32_t
+    Profiler::EnterZone
+    ()
+    {
+        return GetThreadRing().depth++;
+    }
+
+    void
+    Profiler::ExitZone
+    (const char* name, uint64_t start, uint32_t depth,
+     uint64_t allocations, uint64_t bytes)
+    {
+        uint64_t end = Now();
+        auto& ring = GetThreadRing();
+        ring.depth = depth;
+
+        uint64_t head = ring.head.load(std::memory_order_relaxed);
+        auto& slot = ring.slots[head % RING_CAPACITY];
+        slot.sequence.store(2 * head + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.start.store(start, std::memory_order_relaxed);
+        slot.end.store(end, std::memory_order_relaxed);
+        slot.depth.store(depth, std::memory_order_relaxed);
+        slot.allocations.store(allocations, std::memory_order_relaxed);
+        slot.bytes.store(bytes, std::memory_order_relaxed);
+        slot.sequence.store(2 * head + 2, std::memory_order_release);
+        ring.head.store(head + 1, std::memory_order_release);
+    }
+
+    void
+    Profiler::MarkFrame
+    ()
+    {
+        LastFrameStart.store(FrameStart.load());
+        FrameStart.store(Now());
+        FrameNumber++;
+    }
+
+    uint64_t
+    Profiler::GetFrameNumber
+    ()
+    {
+        return FrameNumber.load();
+    }
+
+    vector<ProfilerEvent>
+    Profiler::GetEventsBetween
+    (uint64_t from, uint64_t to)
+    {
+        vector<ProfilerEvent> events;
+        from = std::max(from, ClearedAt.load());
+
+        lock_guard<mutex> lock(RingsMutex);
+        for (auto& ring : Rings)
+        {
+            uint64_t head = ring->head.load(std::memory_order_acquire);
+            uint64_t count = std::min<uint64_t>(head, RING_CAPACITY);
+
+            for (uint64_t i = head - count; i < head; i++)
+            {
+                auto& slot = ring->slots[i % RING_CAPACITY];
+                uint64_t sequence = 2 * i + 2;
+                if (slot.sequence.load(std::memory_order_acquire) != sequence) continue;
+
+                ProfilerEvent event;
+                event.name = slot.name.load(std::memory_order_relaxed);
+                event.start = slot.start.load(std::memory_order_relaxed);
+                event.end = slot.end.load(std::memory_order_relaxed);
+                event.thread = ring->id;
+                event.depth = slot.depth.load(std::memory_order_relaxed);
+                event.allocations = slot.allocations.load(std::memory_order_relaxed);
+                event.bytes = slot.bytes.load(std::memory_order_relaxed);
+
+                // Drop the copy if the writer reached the slot during it
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) != sequence) continue;
+
+                if (event.start < from || event.start >= to) continue;
+                events.push_back(event);
+            }
+        }
+
+        std::sort(events.begin(), events.end(),
+                  [](const ProfilerEvent& a, const ProfilerEvent& b)
+        {
+            if (a.start != b.start) return a.start < b.start;
+            return a.depth < b.depth;
+        });
+        return events;
+    }
+
+    vector<ProfilerEvent>
+    Profiler::GetEvents
+    ()
+    {
+        return GetEventsBetween(0, UINT64_MAX);
+    }
+
+    vector<ProfilerEvent>
+    Profiler::GetLastFrameEvents
+    ()
+    {
+        if (FrameNumber.load() < 2) return vector<ProfilerEvent>();
+        return GetEventsBetween(LastFrameStart.load(), FrameStart.load());
+    }
+
+    uint64_t
+    Profiler::GetLastFrameDuration
+    ()
+    {
+        if (FrameNumber.load() < 2) return 0;
+        return FrameStart.load() - LastFrameStart.load();
+    }
+
+    vector<string>
+    Profiler::GetThreadNames
+    ()
+    {
+        vector<string> names;
+        lock_guard<mutex> lock(RingsMutex);
+        for (auto& ring : Rings) names.push_back(ring->name);
+        return names;
+    }
+
+    json
+    Profiler::ToChromeTrace
+    ()
+    {
+        json traceEvents = json::array();
+
+        auto threadNames = GetThreadNames();
+        for (size_t i = 0; i < threadNames.size(); i++)
+        {
+            json meta;
+            meta["name"] = "thread_name";
+            meta["ph"] = "M";
+            meta["pid"] = 0;
+            meta["tid"] = i;
+            meta["args"]["name"] = threadNames[i];
+            traceEvents.push_back(meta);
+        }
+
+        for (auto& event : GetEvents())
+        {
+            json e;
+            e["name"] = event.name;
+            e["cat"] = "dream";
+            e["ph"] = "X";
+            e["pid"] = 0;
+            e["tid"] = event.thread;
+            // Trace timestamps are in microseconds
+            e["ts"] = event.start / 1000.0;
+            e["dur"] = (event.end - event.start) / 1000.0;
+            if (event.allocations > 0)
+            {
+                e["args"]["allocations"] = event.allocations;
+                e["args"]["bytes"] = event.bytes;
+            }
+            traceEvents.push_back(e);
+        }
+
+        json trace;
+        trace["traceEvents"] = traceEvents;
+        trace["displayTimeUnit"] = "ms";
+        return trace;
+    }
+
+    void
+    Profiler::Clear
+    ()
+    {
+        ClearedAt.store(Now());
+    }
+
+    // ProfilerZone ============================================================
+
+    ProfilerZone::ProfilerZone
+    (const char* name)
+        : mName(nullptr),
+          mStart(0),
+          mDepth(0),
+          mStartAllocations(0),
+          mStartBytes(0)
+    {
+        if (!Profiler::IsEnabled()) return;
+        mName = name;
+        mDepth = Profiler::EnterZone();
+        auto counts = AllocationTracker::GetThread();
+        mStartAllocations = counts.allocations;
+        mStartBytes = counts.bytes;
+        mStart = Profiler::Now();
+    }
+
+    ProfilerZone::~ProfilerZone
+    ()
+    {
+        if (mName == nullptr) return;
+        auto counts = AllocationTracker::GetThread();
+        Profiler::ExitZone(mName, mStart, mDepth,
+                           counts.allocations - mStartAllocations,
+                           counts.bytes - mStartBytes);
+    }
+}
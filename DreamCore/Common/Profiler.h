@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <json.hpp>
+
+#ifndef DREAM_NO_PROFILER
+#define DREAM_PROFILER_ENABLED
+#endif
+
+#define DREAM_PROFILE_CONCAT_INNER(a,b) a##b
+#define DREAM_PROFILE_CONCAT(a,b) DREAM_PROFILE_CONCAT_INNER(a,b)
+
+#ifdef DREAM_PROFILER_ENABLED
+    #define DREAM_PROFILE_ZONE(name) octronic::dream::ProfilerZone DREAM_PROFILE_CONCAT(_profilerZone,__LINE__)(name)
+    #define DREAM_PROFILE_FRAME() octronic::dream::Profiler::MarkFrame()
+#else
+    #define DREAM_PROFILE_ZONE(name)
+    #define DREAM_PROFILE_FRAME()
+#endif
+
+using std::string;
+using std::vector;
+using nlohmann::json;
+
+namespace octronic::dream
+{
+    /**
+     * @brief A completed zone, times in nanoseconds since the profiler
+     * started.
+     */
+    struct ProfilerEvent
+    {
+        const char* name = nullptr;
+        uint64_t start = 0;
+        uint64_t end = 0;
+        uint32_t thread = 0;
+        // Number of zones open around this one on its thread
+        uint32_t depth = 0;
+        // Heap allocations made inside the zone, including nested zones.
+        // Zero unless the AllocationTracker hook is installed
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+    };
+
+    /**
+     * @brief Profiler collects nested timing zones from every thread.
+     *
+     * Each thread writes completed zones into its own fixed size ring
+     * buffer, so recording takes no lock and never allocates after the
+     * thread's first zone. Once a ring is full the oldest zones are
+     * overwritten. Zone names are not copied, they must be string literals
+     * or come from Intern.
+     *
+     * Zones are compiled into every build type and cost one relaxed
+     * atomic load while the profiler is disabled. Define DREAM_NO_PROFILER
+     * to strip them entirely.
+     *
+     * Readers snapshot the rings while threads keep writing. Each slot
+     * carries a sequence number, and zones a writer overwrote during the
+     * copy are discarded.
+     */
+    class Profiler
+    {
+    public:
+        const static size_t RING_CAPACITY;
+
+        static void SetEnabled(bool enabled);
+        static bool IsEnabled();
+
+        /**
+         * @brief Nanoseconds since the profiler started.
+         */
+        static uint64_t Now();
+        /**
+         * @brief A pointer to a copy of name that lives as long as the
+         * program, for zones named at runtime.
+         */
+        static const char* Intern(const string& name);
+        /**
+         * @brief Name the calling thread in traces.
+         */
+        static void SetThreadName(const string& name);
+
+        static uint32_t EnterZone();
+        static void ExitZone(const char* name, uint64_t start, uint32_t depth,
+                             uint64_t allocations, uint64_t bytes);
+
+        /**
+         * @brief Mark the start of a frame, called by ProjectRuntime::step.
+         */
+        static void MarkFrame();
+        static uint64_t GetFrameNumber();
+
+        /**
+         * @brief Every buffered zone from all threads, ordered by start.
+         */
+        static vector<ProfilerEvent> GetEvents();
+        /**
+         * @brief Zones that started during the last complete frame.
+         */
+        static vector<ProfilerEvent> GetLastFrameEvents();
+        static uint64_t GetLastFrameDuration();
+        static vector<string> GetThreadNames();
+
+        /**
+         * @brief Buffered zones in the Chrome trace event format, load in
+         * chrome://tracing or Perfetto.
+         */
+        static json ToChromeTrace();
+        /**
+         * @brief Drop everything buffered so far.
+         */
+        static void Clear();
+
+    private:
+        static vector<ProfilerEvent> GetEventsBetween(uint64_t from, uint64_t to);
+    };
+
+    /**
+     * @brief Times the enclosing scope, see DREAM_PROFILE_ZONE.
+     */
+    class ProfilerZone
+    {
+    public:
+        ProfilerZone(const char* name);
+        ~ProfilerZone();
+
+        ProfilerZone(const ProfilerZone&) = delete;
+        ProfilerZone& operator=(const ProfilerZone&) = delete;
+
+    private:
+        const char* mName;
+        uint64_t mStart;
+        uint32_t mDepth;
+        uint64_t mStartAllocations;
+        uint64_t mStartBytes;
+    };
+}
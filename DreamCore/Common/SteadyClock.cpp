@@ -0,0 +1,16 @@
+#include "SteadyClock.h"
+
+#include <chrono>
+
+using std::chrono::steady_clock;
+using std::chrono::nanoseconds;
+
+namespace octronic::dream
+{
+    uint64_t
+    SteadyClock::Now
+    ()
+    {
+        return std::chrono::duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+}
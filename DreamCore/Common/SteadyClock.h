@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+namespace octronic::dream
+{
+    /**
+     * @brief The one place the engine reads std::chrono::steady_clock for
+     * frame timing, pacing and profiling, so every timestamp it passes
+     * around is whole nanoseconds on the same clock and can be compared
+     * or subtracted with any other.
+     */
+    class SteadyClock
+    {
+    public:
+        /**
+         * @brief Nanoseconds since the steady clock's epoch.
+         */
+        static uint64_t Now();
+    };
+}
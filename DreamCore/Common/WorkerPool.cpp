@@ -0,0 +1,75 @@
+#include "WorkerPool.h"
+
+#include "Common/Logger.h"
+#include "Common/Profiler.h"
+
+#include <algorithm>
+
+namespace octronic::dream
+{
+    WorkerPool::WorkerPool
+    (const string& name, unsigned int threads)
+        : mName(name),
+          mStopping(false)
+    {
+        threads = std::max(1u, threads);
+        LOG_DEBUG("WorkerPool: Starting {} with {} threads", mName, threads);
+        for (unsigned int i = 0; i < threads; i++)
+        {
+            mThreads.emplace_back(&WorkerPool::run, this, i);
+        }
+    }
+
+    WorkerPool::~WorkerPool
+    ()
+    {
+        {
+            std::lock_guard<mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mCondition.notify_all();
+        for (auto& worker : mThreads)
+        {
+            worker.join();
+        }
+    }
+
+    unsigned int
+    WorkerPool::getThreadCount
+    ()
+    const
+    {
+        return static_cast<unsigned int>(mThreads.size());
+    }
+
+    void
+    WorkerPool::push
+    (function<void()> job)
+    {
+        {
+            std::lock_guard<mutex> lock(mMutex);
+            mQueue.push_back(std::move(job));
+        }
+        mCondition.notify_one();
+    }
+
+    void
+    WorkerPool::run
+    (unsigned int index)
+    {
+        Profiler::SetThreadName(mName + " " + std::to_string(index));
+
+        while (true)
+        {
+            function<void()> job;
+            {
+                std::unique_lock<mutex> lock(mMutex);
+                mCondition.wait(lock, [this]() { return mStopping || !mQueue.empty(); });
+                if (mQueue.empty()) return;
+                job = std::move(mQueue.front());
+                mQueue.pop_front();
+            }
+            job();
+        }
+    }
+}
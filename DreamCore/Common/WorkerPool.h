@@ -0,0 +1,78 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using std::condition_variable;
+using std::deque;
+using std::function;
+using std::future;
+using std::mutex;
+using std::string;
+using std::thread;
+using std::vector;
+
+namespace octronic::dream
+{
+    /**
+     * @brief A fixed set of threads started once and fed from a queue, so
+     * work that is handed off every frame or per asset does not pay for
+     * creating a thread each time, and the number of threads stays
+     * bounded however much work is queued.
+     *
+     * Threads are named "<name> <index>" in the profiler. Jobs still
+     * queued when the pool is destroyed are run before it returns.
+     */
+    class WorkerPool
+    {
+    public:
+        WorkerPool(const string& name, unsigned int threads);
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        /**
+         * @brief Queue job to run on a worker.
+         * @return Future for the job's result.
+         */
+        template <typename Job>
+        auto submit(Job&& job) -> future<std::invoke_result_t<Job>>;
+
+        unsigned int getThreadCount() const;
+
+    private:
+        void push(function<void()> job);
+        void run(unsigned int index);
+
+    private:
+        string mName;
+        vector<thread> mThreads;
+        deque<function<void()>> mQueue;
+        mutex mMutex;
+        condition_variable mCondition;
+        bool mStopping;
+    };
+
+    template <typename Job>
+    auto
+    WorkerPool::submit
+    (Job&& job)
+    -> future<std::invoke_result_t<Job>>
+    {
+        using Result = std::invoke_result_t<Job>;
+        // function needs a copyable target, packaged_task is move only
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Job>(job));
+        auto result = task->get_future();
+        push([task]() { (*task)(); });
+        return result;
+    }
+}
@@ -59,7 +59,7 @@ namespace octronic::dream
         mAnimationSeekTime = mDuration;
         mRunning = false;
       }
-      seekAll(mAnimationSeekTime);
+      seekAll(static_cast<unsigned int>(mAnimationSeekTime));
     }
   }
 
@@ -68,7 +68,7 @@ namespace octronic::dream
   ()
   const
   {
-    return mAnimationSeekTime;
+    return static_cast<long>(mAnimationSeekTime);
   }
 
   void
@@ -46,7 +46,8 @@ namespace octronic::dream
     shared_ptr<AnimationUpdateTask> mUpdateTask;
     vector<AnimationKeyframe> mKeyframes;
     bool mRunning;
-    long mAnimationSeekTime;
+    // Fractional ms accumulate between frames
+    double mAnimationSeekTime;
     long mDuration;
 
     bool mRelative;
@@ -91,11 +91,18 @@ namespace octronic::dream
     return mProjectDefinition;
   }
 
+  void
+  AssetDefinition::onIdentityChanged
+  (const string& oldName, UuidType oldUuid)
+  {
+    mProjectDefinition.get().reindexAssetDefinition(*this, oldName, oldUuid);
+  }
+
   void
   AssetDefinition::duplicateInto
   (AssetDefinition& newDef)
   {
-    newDef.mJson = mJson;
+    newDef.setJson(mJson);
     newDef.setUuid(Uuid::RandomUuid());
     string name = newDef.getName();
     regex numRegex("(\\d+)$");
@@ -60,6 +60,9 @@ namespace octronic::dream
         bool hasType(AssetType) const;
         bool hasType(string) const;
 
+    protected:
+        void onIdentityChanged(const string& oldName, UuidType oldUuid) override;
+
     protected:
         reference_wrapper<ProjectDefinition> mProjectDefinition;
     };
@@ -4,14 +4,25 @@
 #include "Components/Cache.h"
 #include "AudioDefinition.h"
 #include "AudioRuntime.h"
+#include "Entity/EntityRuntime.h"
+#include "Scene/SceneRuntime.h"
 #include "Project/ProjectRuntime.h"
 
+#include <glm/geometric.hpp>
 #include <iostream>
 
 namespace octronic::dream
 {
+  const size_t AudioComponent::DEFAULT_VOICE_COUNT = 32;
+  const unsigned int AudioComponent::LOADER_THREAD_COUNT = 2;
+  const int AudioComponent::VOICE_NONE = -1;
+  const int AudioComponent::VOICE_STREAMED = -2;
+
   AudioComponent::AudioComponent
-  () : Component()
+  () : Component(),
+    mVoices(DEFAULT_VOICE_COUNT),
+    mListenerPosition(0.0f),
+    mVoicesStarted(0)
   {
     LOG_TRACE("AudioComponent: Constructing");
   }
@@ -28,10 +39,244 @@ namespace octronic::dream
     {
       ProjectRuntime& pr = mProjectRuntime.value().get();
 			AudioCache& audioCache = pr.getAudioCache();
-			for (auto& audioRuntime : audioCache.getRuntimeVector())
+			for (auto& audioRuntime : audioCache.getRuntimeView())
 			{
-			  audioRuntime.get().pushTasks();
+			  audioRuntime.pushTasks();
 			}
+
+      auto activeScene = pr.getActiveSceneRuntime();
+      if (activeScene)
+      {
+        auto& camera = activeScene.value().get().getCameraRuntime();
+        setListenerPosition(camera.getTransform().getTranslation());
+      }
+
+      updateVoices();
+    }
+  }
+
+  // Loading ===================================================================
+
+  WorkerPool&
+  AudioComponent::getLoaderPool
+  ()
+  {
+    if (!mLoaderPool)
+    {
+      mLoaderPool = std::make_unique<WorkerPool>("Audio Loader", LOADER_THREAD_COUNT);
+    }
+    return *mLoaderPool;
+  }
+
+  // Voices ====================================================================
+
+  int
+  AudioComponent::playVoice
+  (AudioRuntime& runtime, EntityRuntime& entity)
+  {
+    auto& def = static_cast<AudioDefinition&>(runtime.getDefinition());
+    int voice = playVoice(runtime, entity.getTransform().getTranslation(), def.getPriority());
+    if (voice >= 0)
+    {
+      mVoices[voice].entityUuid = entity.getUuid();
+    }
+    return voice;
+  }
+
+  int
+  AudioComponent::playVoice
+  (AudioRuntime& runtime, const vec3& position, int priority)
+  {
+    if (!runtime.getLoaded()) return VOICE_NONE;
+
+    // Streamed assets have no shared buffer, they keep their own source
+    auto& def = static_cast<AudioDefinition&>(runtime.getDefinition());
+    if (def.getStream())
+    {
+      LOG_DEBUG("AudioComponent: Playing streamed {} on its own source", runtime.getNameAndUuidString());
+      runtime.play();
+      return VOICE_STREAMED;
+    }
+
+    int voice = findVoice(position, priority);
+    if (voice < 0)
+    {
+      LOG_DEBUG("AudioComponent: No voice available for {}", runtime.getNameAndUuidString());
+      return VOICE_NONE;
+    }
+
+    if (mVoices[voice].runtime)
+    {
+      LOG_DEBUG("AudioComponent: Stealing voice {} for {}", voice, runtime.getNameAndUuidString());
+      releaseVoice(voice);
+    }
+
+    AudioVoice& v = mVoices[voice];
+    v = AudioVoice();
+
+    if (!startVoice(voice, runtime, position))
+    {
+      releaseVoice(voice);
+      return VOICE_NONE;
+    }
+
+    v.runtime = runtime;
+    v.position = position;
+    v.priority = priority;
+    v.startedAt = mVoicesStarted++;
+    return voice;
+  }
+
+  void
+  AudioComponent::stopVoice
+  (int voice)
+  {
+    if (voice < 0 || voice >= static_cast<int>(mVoices.size())) return;
+
+    if (mVoices[voice].runtime)
+    {
+      releaseVoice(voice);
+      mVoices[voice] = AudioVoice();
+    }
+  }
+
+  void
+  AudioComponent::stopVoices
+  (AudioRuntime& runtime)
+  {
+    for (size_t i = 0; i < mVoices.size(); i++)
+    {
+      auto& v = mVoices[i];
+      if (v.runtime && &v.runtime.value().get() == &runtime)
+      {
+        releaseVoice(i);
+        v = AudioVoice();
+      }
+    }
+  }
+
+  void
+  AudioComponent::stopAllVoices
+  ()
+  {
+    for (size_t i = 0; i < mVoices.size(); i++)
+    {
+      stopVoice(i);
+    }
+  }
+
+  size_t
+  AudioComponent::getVoiceCount
+  ()
+  const
+  {
+    return mVoices.size();
+  }
+
+  size_t
+  AudioComponent::countActiveVoices
+  ()
+  const
+  {
+    size_t count = 0;
+    for (auto& v : mVoices)
+    {
+      if (v.runtime) count++;
+    }
+    return count;
+  }
+
+  vec3
+  AudioComponent::getListenerPosition
+  ()
+  const
+  {
+    return mListenerPosition;
+  }
+
+  int
+  AudioComponent::findVoice
+  (const vec3& position, int priority)
+  const
+  {
+    int candidate = -1;
+    float candidateDistance = 0.0f;
+
+    for (size_t i = 0; i < mVoices.size(); i++)
+    {
+      auto& v = mVoices[i];
+
+      // Free voice
+      if (!v.runtime) return i;
+
+      float distance = glm::distance(v.position, mListenerPosition);
+
+      if (candidate < 0)
+      {
+        candidate = i;
+        candidateDistance = distance;
+        continue;
+      }
+
+      auto& c = mVoices[candidate];
+      if (v.priority < c.priority ||
+          (v.priority == c.priority && distance > candidateDistance) ||
+          (v.priority == c.priority && distance == candidateDistance && v.startedAt < c.startedAt))
+      {
+        candidate = i;
+        candidateDistance = distance;
+      }
+    }
+
+    if (candidate < 0) return -1;
+
+    // Never steal a more important or nearer voice than the one requested
+    auto& c = mVoices[candidate];
+    if (c.priority > priority) return -1;
+    if (c.priority == priority &&
+        candidateDistance < glm::distance(position, mListenerPosition))
+    {
+      return -1;
+    }
+    return candidate;
+  }
+
+  void
+  AudioComponent::updateVoices
+  ()
+  {
+    optional<reference_wrapper<SceneRuntime>> activeScene;
+    if (mProjectRuntime)
+    {
+      activeScene = mProjectRuntime.value().get().getActiveSceneRuntime();
+    }
+
+    for (size_t i = 0; i < mVoices.size(); i++)
+    {
+      auto& v = mVoices[i];
+      if (!v.runtime) continue;
+
+      if (!isVoicePlaying(i))
+      {
+        releaseVoice(i);
+        v = AudioVoice();
+        continue;
+      }
+
+      // Follow the entity, if it has gone the voice finishes where it was
+      if (v.entityUuid != Uuid::INVALID && activeScene)
+      {
+        auto entity = activeScene.value().get().getEntityRuntimeByUuid(v.entityUuid);
+        if (entity)
+        {
+          v.position = entity.value().get().getTransform().getTranslation();
+          setVoicePosition(i, v.position);
+        }
+        else
+        {
+          v.entityUuid = Uuid::INVALID;
+        }
+      }
     }
   }
 }
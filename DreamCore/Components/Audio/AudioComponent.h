@@ -1,16 +1,48 @@
 #pragma once
 
 #include "AudioStatus.h"
+#include "AudioVoice.h"
 #include "Components/Component.h"
 #include "Math/Vector.h"
+#include "Common/WorkerPool.h"
+
+#include <memory>
+#include <vector>
+
+using std::unique_ptr;
+using std::vector;
 
 namespace octronic::dream
 {
     class AudioRuntime;
     class AudioDefinition;
+    class EntityRuntime;
+
+    /**
+     * @brief AudioComponent owns a fixed size pool of voices. Entities
+     * playing a shared AudioRuntime each take a voice that plays the
+     * runtime's decoded buffer, so one asset can be heard from many
+     * entities at once while the number of sources stays bounded.
+     *
+     * When the pool is full the lowest priority voice is stolen, between
+     * voices of equal priority the one furthest from the listener goes
+     * first, then the oldest.
+     */
     class AudioComponent : public Component
     {
     public:
+        static const size_t DEFAULT_VOICE_COUNT;
+        /**
+         * @brief Threads decoding audio assets, however many load at once.
+         */
+        static const unsigned int LOADER_THREAD_COUNT;
+        /**
+         * @brief playVoice results that are not a voice index. A streamed
+         * asset plays on its own source rather than a pooled voice.
+         */
+        static const int VOICE_NONE;
+        static const int VOICE_STREAMED;
+
         AudioComponent();
         virtual ~AudioComponent();
         virtual void setListenerPosition(const vec3&) = 0;
@@ -18,5 +50,54 @@ namespace octronic::dream
         virtual float getVolume() = 0;
     	  virtual AudioRuntime& getAudioRuntime(AudioDefinition& def) = 0;
         void pushTasks() override;
+
+        // Voices ==============================================================
+
+        /**
+         * @brief Play the runtime on a pooled voice that follows the entity.
+         * @return Index of the voice, VOICE_STREAMED if the runtime started
+         * on its own source, or VOICE_NONE if it could not be played.
+         */
+        int playVoice(AudioRuntime& runtime, EntityRuntime& entity);
+
+        /**
+         * @brief Play the runtime on a pooled voice at a fixed position.
+         * @return As playVoice(runtime, entity).
+         */
+        int playVoice(AudioRuntime& runtime, const vec3& position, int priority);
+
+        void stopVoice(int voice);
+        void stopVoices(AudioRuntime& runtime);
+        void stopAllVoices();
+
+        size_t getVoiceCount() const;
+        size_t countActiveVoices() const;
+        vec3 getListenerPosition() const;
+
+        // Loading =============================================================
+
+        /**
+         * @brief Pool that decodes audio assets off the task thread, started
+         * on first use.
+         */
+        WorkerPool& getLoaderPool();
+
+    protected:
+        /**
+         * @brief Begin playback of the runtime's buffer on the voice's source.
+         */
+        virtual bool startVoice(size_t voice, AudioRuntime& runtime, const vec3& position) = 0;
+        virtual void releaseVoice(size_t voice) = 0;
+        virtual bool isVoicePlaying(size_t voice) const = 0;
+        virtual void setVoicePosition(size_t voice, const vec3& position) = 0;
+
+        int findVoice(const vec3& position, int priority) const;
+        void updateVoices();
+
+    protected:
+        vector<AudioVoice> mVoices;
+        vec3 mListenerPosition;
+        unsigned long mVoicesStarted;
+        unique_ptr<WorkerPool> mLoaderPool;
     };
 }
@@ -47,4 +47,42 @@ namespace octronic::dream
     }
     return mJson[Constants::ASSET_ATTR_LOOP];
   }
+
+  void
+  AudioDefinition::setStream
+  (bool stream)
+  {
+    mJson[Constants::ASSET_ATTR_AUDIO_STREAM] = stream;
+  }
+
+  bool
+  AudioDefinition::getStream
+  ()
+  const
+  {
+    if (mJson.find(Constants::ASSET_ATTR_AUDIO_STREAM) == mJson.end())
+    {
+      return false;
+    }
+    return mJson[Constants::ASSET_ATTR_AUDIO_STREAM];
+  }
+
+  void
+  AudioDefinition::setPriority
+  (int priority)
+  {
+    mJson[Constants::ASSET_ATTR_AUDIO_PRIORITY] = priority;
+  }
+
+  int
+  AudioDefinition::getPriority
+  ()
+  const
+  {
+    if (mJson.find(Constants::ASSET_ATTR_AUDIO_PRIORITY) == mJson.end())
+    {
+      return 0;
+    }
+    return mJson[Constants::ASSET_ATTR_AUDIO_PRIORITY];
+  }
 }
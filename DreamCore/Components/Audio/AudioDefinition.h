@@ -17,5 +17,20 @@ namespace octronic::dream
 
         void setLoop(bool);
         bool getLoop() const;
+
+        /**
+         * @brief Stream the asset from a small ring of decoded buffers
+         * instead of decoding it entirely into memory. Intended for long or
+         * looping music, short effects should leave this off.
+         */
+        void setStream(bool);
+        bool getStream() const;
+
+        /**
+         * @brief Voice priority, when the AudioComponent's voice pool is
+         * full lower priority voices are stolen first.
+         */
+        void setPriority(int);
+        int getPriority() const;
     };
 }
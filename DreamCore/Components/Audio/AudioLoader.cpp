@@ -1,7 +1,11 @@
 #include "AudioLoader.h"
 
+#include "AudioDefinition.h"
 #include "Common/Logger.h"
-
+#include "Storage/StorageManager.h"
+#include "Storage/File.h"
+#include "Project/ProjectDirectory.h"
+#include "Project/ProjectRuntime.h"
 
 
 namespace octronic::dream
@@ -9,7 +13,11 @@ namespace octronic::dream
 
     AudioLoader::AudioLoader
     (): mChannels(0),
-        mSampleRate(0)
+        mSampleRate(0),
+        mStreamOpen(false),
+        mDurationInSamples(0),
+        mData(nullptr),
+        mDataSize(0)
     {
 
     }
@@ -19,6 +27,93 @@ namespace octronic::dream
     {
     }
 
+    bool
+    AudioLoader::loadIntoBuffer
+    (ProjectRuntime& projectRuntime, AudioDefinition& audioDefinition)
+    {
+        if (!readFileData(projectRuntime, audioDefinition)) return false;
+        bool decoded = decodeIntoBuffer();
+        releaseData();
+        return decoded;
+    }
+
+    bool
+    AudioLoader::openStream
+    (ProjectRuntime& projectRuntime, AudioDefinition& audioDefinition)
+    {
+        closeStream();
+        if (!readFileData(projectRuntime, audioDefinition)) return false;
+        if (!openDataStream())
+        {
+            releaseData();
+            return false;
+        }
+        return true;
+    }
+
+    bool
+    AudioLoader::readFileData
+    (ProjectRuntime& projectRuntime, AudioDefinition& audioDefinition)
+    {
+        auto& pDir = projectRuntime.getProjectDirectory();
+        auto absPath = pDir.getAssetAbsolutePath(audioDefinition);
+        LOG_DEBUG("AudioLoader: Reading {}", absPath);
+
+        auto& sm = projectRuntime.getStorageManager();
+        auto& file = sm.openFile(absPath);
+
+        if (!file.exists())
+        {
+            LOG_ERROR("AudioLoader: Cannot open {} for reading, may not exist", absPath);
+            sm.closeFile(file);
+            return false;
+        }
+
+        if (!file.readBinary())
+        {
+            LOG_ERROR("AudioLoader: Error reading binary data from {}", absPath);
+            sm.closeFile(file);
+            return false;
+        }
+
+        // Take the encoded data rather than copying it, the File is closed here.
+        mFileData.clear();
+        mFileData.swap(file.getBinaryData());
+        sm.closeFile(file);
+
+        mData = mFileData.data();
+        mDataSize = mFileData.size();
+        return true;
+    }
+
+    void
+    AudioLoader::setData
+    (const uint8_t* data, size_t size)
+    {
+        closeStream();
+        mFileData.clear();
+        mData = data;
+        mDataSize = size;
+    }
+
+    bool
+    AudioLoader::hasData
+    ()
+    const
+    {
+        return mData != nullptr && mDataSize > 0;
+    }
+
+    void
+    AudioLoader::releaseData
+    ()
+    {
+        mFileData.clear();
+        mFileData.shrink_to_fit();
+        mData = nullptr;
+        mDataSize = 0;
+    }
+
     bool
     AudioLoader::checkLoaded
     ()
@@ -36,14 +131,53 @@ namespace octronic::dream
 
     }
 
-    vector<uint8_t>
-    AudioLoader::getAudioBuffer
+    bool
+    AudioLoader::checkStreamOpen
+    ()
+    const
+    {
+        LOG_INFO("AudioLoader: Checking Stream\n"
+				 "\tChannels:{}\n"
+                 "\tSampleRate:{}\n"
+                 "\tDurationInSamples:{}",
+                 mChannels, mSampleRate, getDurationInSamples());
+
+        return mStreamOpen      &&
+               mChannels   != 0 &&
+               mSampleRate != 0;
+    }
+
+    bool
+    AudioLoader::isStreamOpen
+    ()
+    const
+    {
+        return mStreamOpen;
+    }
+
+    unsigned long
+    AudioLoader::getDurationInSamples
     ()
     const
+    {
+        return mDurationInSamples;
+    }
+
+    vector<uint8_t>&
+    AudioLoader::getAudioBuffer
+    ()
     {
         return mAudioBuffer;
     }
 
+    size_t
+    AudioLoader::getMemoryUsage
+    ()
+    const
+    {
+        return mAudioBuffer.capacity() + mFileData.capacity();
+    }
+
     uint8_t
     AudioLoader::getChannels
     ()
@@ -12,22 +12,105 @@ namespace octronic::dream
 {
   class AudioDefinition;
   class ProjectRuntime;
+
+  /**
+   * @brief AudioLoader decodes an audio asset to 16-bit PCM, either all at
+   * once into mAudioBuffer or incrementally as a stream.
+   *
+   * All decoding state is held by the loader instance and decoding only
+   * touches the encoded data span, so separate loaders can decode on
+   * separate threads. Reading the file through the StorageManager is not
+   * thread safe and should be done on the main thread with readFileData,
+   * or the data can be supplied directly with setData.
+   */
   class AudioLoader
   {
   public:
     AudioLoader();
     virtual ~AudioLoader();
-    virtual bool loadIntoBuffer(ProjectRuntime& pDef, AudioDefinition& aDef) = 0;
 
-    vector<uint8_t> getAudioBuffer() const;
+    /**
+     * @brief Read the asset's file and decode it into mAudioBuffer.
+     */
+    bool loadIntoBuffer(ProjectRuntime& pDef, AudioDefinition& aDef);
+
+    /**
+     * @brief Read the asset's file and prepare it for incremental decoding
+     * with readStream.
+     */
+    bool openStream(ProjectRuntime& pDef, AudioDefinition& aDef);
+
+    // Encoded Data ========================================================
+
+    /**
+     * @brief Read the asset's file into memory owned by the loader.
+     */
+    bool readFileData(ProjectRuntime& pDef, AudioDefinition& aDef);
+
+    /**
+     * @brief Decode from a caller owned span, such as a mapped file. The
+     * memory must outlive any decoding done by this loader.
+     */
+    void setData(const uint8_t* data, size_t size);
+    bool hasData() const;
+    void releaseData();
+
+    // Decoding ============================================================
+
+    /**
+     * @brief Decode the whole of the encoded data into mAudioBuffer.
+     */
+    virtual bool decodeIntoBuffer() = 0;
+
+    /**
+     * @brief Prepare the encoded data for incremental decoding.
+     */
+    virtual bool openDataStream() = 0;
+
+    /**
+     * @brief Decode up to maxBytes of 16-bit PCM into dest.
+     * @return Bytes written, 0 at the end of the stream or -1 on error.
+     */
+    virtual long readStream(uint8_t* dest, size_t maxBytes) = 0;
+
+    /**
+     * @brief Move the stream read position to the given sample.
+     * @return false if the loader cannot seek to that position.
+     */
+    virtual bool seekStream(unsigned long sampleOffset) = 0;
+
+    virtual void closeStream() = 0;
+
+    bool isStreamOpen() const;
+
+    /**
+     * @return The length of the decoded audio in samples, or 0 if unknown.
+     */
+    unsigned long getDurationInSamples() const;
+
+    vector<uint8_t>& getAudioBuffer();
+    /**
+     * @return Bytes of decoded and encoded data owned by the loader.
+     */
+    size_t getMemoryUsage() const;
     uint8_t getChannels() const;
     long getSampleRate() const;
   protected:
     bool checkLoaded() const;
+    bool checkStreamOpen() const;
 
   protected:
     vector<uint8_t> mAudioBuffer;
     uint8_t  mChannels;
     long     mSampleRate;
+    bool     mStreamOpen;
+    unsigned long mDurationInSamples;
+    /**
+     * @brief Encoded data read by readFileData. mData points into this
+     * unless setData was given an external span.
+     */
+    vector<uint8_t> mFileData;
+    const uint8_t* mData;
+    size_t mDataSize;
   };
 }
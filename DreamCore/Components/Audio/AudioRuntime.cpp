@@ -17,7 +17,7 @@ namespace octronic::dream
     : SharedAssetRuntime(project, def),
       mImpl(nullptr),
       mLoader(nullptr),
-      mLooping(false)
+      mLooping(def.getLoop())
   {
     LOG_DEBUG("AudioRuntime: {}", __FUNCTION__);
   }
@@ -52,6 +52,14 @@ namespace octronic::dream
     return mLoader;
   }
 
+  size_t
+  AudioRuntime::getCpuMemoryUsage
+  ()
+  const
+  {
+    return mLoader ? mLoader->getMemoryUsage() : 0;
+  }
+
   void
   AudioRuntime::setAudioLoader
   (const shared_ptr<AudioLoader>& loader)
@@ -98,6 +106,11 @@ namespace octronic::dream
     }
   }
 
+  int AudioRuntime::playVoice(EntityRuntime& entity)
+  {
+    return getProjectRuntime().getAudioComponent().playVoice(*this, entity);
+  }
+
   // Implementation ============================================================
 
   void AudioRuntime::play()
@@ -113,6 +126,7 @@ namespace octronic::dream
   void AudioRuntime::stop()
   {
     mImpl->stop();
+    getProjectRuntime().getAudioComponent().stopVoices(*this);
   }
 
   vec3 AudioRuntime::getSourcePosition() const
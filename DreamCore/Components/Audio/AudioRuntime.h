@@ -16,6 +16,7 @@ namespace octronic::dream
 {
   class AudioDefinition;
   class AudioComponent;
+  class EntityRuntime;
 
   /**
      * @brief AudioRuntime holds data for an Audio Clip.
@@ -36,6 +37,13 @@ namespace octronic::dream
     void setLooping(bool);
     bool getLooping() const;
 
+    /**
+     * @brief Play this asset on one of the AudioComponent's pooled voices,
+     * positioned at and following the entity.
+     * @return See AudioComponent::playVoice.
+     */
+    int playVoice(EntityRuntime& entity);
+
     // Implementation
     void play();
     void pause();
@@ -50,6 +58,8 @@ namespace octronic::dream
     unsigned long getDurationInSamples();
     bool loadFromDefinition() override;
 
+    size_t getCpuMemoryUsage() const override;
+
   protected:
     shared_ptr<AudioRuntimeImplementation> mImpl;
     shared_ptr<AudioLoader> mLoader;
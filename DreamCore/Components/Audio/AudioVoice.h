@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Common/Uuid.h"
+
+#include <glm/vec3.hpp>
+#include <memory>
+#include <optional>
+
+using glm::vec3;
+using std::optional;
+using std::reference_wrapper;
+
+namespace octronic::dream
+{
+    class AudioRuntime;
+
+    /**
+     * @brief A single playback slot in the AudioComponent's voice pool.
+     * Voices refer to the AudioRuntime's decoded buffer rather than owning
+     * any audio data, so many voices can play one asset at the same time.
+     */
+    struct AudioVoice
+    {
+        optional<reference_wrapper<AudioRuntime>> runtime;
+        UuidType entityUuid = Uuid::INVALID;
+        vec3 position = vec3(0.0f);
+        int priority = 0;
+        unsigned long startedAt = 0;
+    };
+}
@@ -1,108 +1,120 @@
 #include "OggLoader.h"
 
 #include <Common/Logger.h>
-#include "Storage/StorageManager.h"
-#include "Storage/File.h"
-#include "Project/ProjectDirectory.h"
 
-#include "Project/ProjectRuntime.h"
-#include "Components/Audio/AudioDefinition.h"
-
-#include <vorbis/vorbisfile.h>
-
-using octronic::dream::File;
-
-
-static size_t seekIndex = 0;
-
-size_t octronic_dream_oggloader_read
-(void* buffer, size_t elementSize, size_t elementCount, void* dataSource)
-{
-  // copy the next elementCount bytes from dataSource into buffer
-  assert(elementSize == 1);
-  File* f = static_cast<File*>(dataSource);
-  size_t capped_count = 0;
-  if(seekIndex+elementCount > f->getBinaryData().size())
-  {
-    size_t overflow =  (seekIndex+elementCount) - f->getBinaryData().size();
-    capped_count = elementCount-overflow;
-  }
-  else
-  {
-    capped_count = elementCount;
-  }
-  //LOG_TRACE("OggLoader: Accessing index[{}/{}] Requesting {} elements (capped to {})",
-  //          seekIndex, f->getBinaryDataSize(), elementCount,capped_count);
-  vector<uint8_t> data = f->getBinaryData();
-  memcpy(buffer,&data[seekIndex], capped_count);
-  seekIndex += capped_count;
-  return capped_count;
-}
+#include <cassert>
+#include <cstdio>
+#include <cstring>
 
 namespace octronic::dream
 {
-  const uint16_t OggLoader::OGG_LOAD_BUFFER_SIZE = 1024;
+  const size_t OggLoader::OGG_LOAD_BUFFER_SIZE = 65536;
 
   OggLoader::OggLoader()
-    : AudioLoader()
+    : AudioLoader(),
+      mReadOffset(0)
   {
     LOG_TRACE("OggLoader: {}",__FUNCTION__);
+    memset(&mOggFile,0,sizeof(OggVorbis_File));
   }
 
   OggLoader::~OggLoader()
   {
     LOG_TRACE("OggLoader: {}",__FUNCTION__);
+    closeStream();
   }
 
-  bool
-  OggLoader::loadIntoBuffer
-  (ProjectRuntime& projectRuntime, AudioDefinition& audioDefinition)
+  // Callbacks =================================================================
+
+  size_t
+  OggLoader::ReadCallback
+  (void* buffer, size_t elementSize, size_t elementCount, void* dataSource)
   {
-    LOG_TRACE("OggLoader: {}",__FUNCTION__);
+    // copy the next elementCount bytes from dataSource into buffer
+    assert(elementSize == 1);
+    OggLoader* loader = static_cast<OggLoader*>(dataSource);
+    size_t remaining = loader->mDataSize - loader->mReadOffset;
+    size_t capped_count = elementCount > remaining ? remaining : elementCount;
+    memcpy(buffer, loader->mData + loader->mReadOffset, capped_count);
+    loader->mReadOffset += capped_count;
+    return capped_count;
+  }
 
-    auto& pDir = projectRuntime.getProjectDirectory();
-    auto absPath = pDir.getAssetAbsolutePath(audioDefinition);
-    LOG_DEBUG("OggLoader: Loading Runtime: {}", absPath);
+  int
+  OggLoader::SeekCallback
+  (void* dataSource, ogg_int64_t offset, int whence)
+  {
+    OggLoader* loader = static_cast<OggLoader*>(dataSource);
+    ogg_int64_t target = 0;
 
-    // Open/Read the file
-    auto& sm = projectRuntime.getStorageManager();
-    auto& file = sm.openFile(absPath);
+    switch (whence)
+    {
+      case SEEK_SET:
+        target = offset;
+        break;
+      case SEEK_CUR:
+        target = static_cast<ogg_int64_t>(loader->mReadOffset) + offset;
+        break;
+      case SEEK_END:
+        target = static_cast<ogg_int64_t>(loader->mDataSize) + offset;
+        break;
+      default:
+        return -1;
+    }
 
-    if (!file.exists())
+    if (target < 0 || target > static_cast<ogg_int64_t>(loader->mDataSize))
     {
-      LOG_ERROR("OggLoader: Cannot open {} for reading, may not exist", absPath);
-      return false;
+      return -1;
     }
 
-    if (!file.readBinary())
+    loader->mReadOffset = static_cast<size_t>(target);
+    return 0;
+  }
+
+  long
+  OggLoader::TellCallback
+  (void* dataSource)
+  {
+    OggLoader* loader = static_cast<OggLoader*>(dataSource);
+    return static_cast<long>(loader->mReadOffset);
+  }
+
+  // Stream ====================================================================
+
+  bool
+  OggLoader::openDataStream
+  ()
+  {
+    LOG_TRACE("OggLoader: {}",__FUNCTION__);
+
+    closeStream();
+
+    if (!hasData())
     {
-      LOG_ERROR("OggLoader: Error reading binary data");
-      sm.closeFile(file);
+      LOG_ERROR("OggLoader: No encoded data to open");
       return false;
     }
 
     // Setup Callbacks
     ov_callbacks callbacks;
     memset(&callbacks,0,sizeof(ov_callbacks));
-    callbacks.read_func  = octronic_dream_oggloader_read;
-    callbacks.seek_func  = NULL;//octronic_dream_oggloader_seek;
-    callbacks.tell_func  = NULL;//octronic_dream_oggloader_tell;
+    callbacks.read_func  = OggLoader::ReadCallback;
+    callbacks.seek_func  = OggLoader::SeekCallback;
+    callbacks.tell_func  = OggLoader::TellCallback;
     callbacks.close_func = NULL;
-    seekIndex = 0;
+    mReadOffset = 0;
 
-    // Try opening the given file
-    OggVorbis_File oggFile;
-    File* f = &file;
-    int error = ov_open_callbacks(f, &oggFile, nullptr, 0, callbacks);
+    // Try opening the given data
+    int error = ov_open_callbacks(this, &mOggFile, nullptr, 0, callbacks);
     if (error < 0)
     {
-      LOG_ERROR("OggLoader: Error opening {} for decoding, ov_open failed\n\t{}", absPath, getOggErrorString(error));
+      LOG_ERROR("OggLoader: Error opening stream for decoding, ov_open failed\n\t{}", getOggErrorString(error));
       return false;
     }
 
     // Get some information about the OGG file
     vorbis_info *oggInfo;
-    oggInfo = ov_info(&oggFile, -1);
+    oggInfo = ov_info(&mOggFile, -1);
 
     // Check the number of channels... always use 16-bit samples
     if (oggInfo->channels == 1)
@@ -117,32 +129,110 @@ namespace octronic::dream
     // The frequency of the sampling rate
     mSampleRate = oggInfo->rate;
 
-    // Keep reading until all is read
+    ogg_int64_t total = ov_pcm_total(&mOggFile, -1);
+    mDurationInSamples = total > 0 ? static_cast<unsigned long>(total) : 0;
+
+    mStreamOpen = true;
+    return checkStreamOpen();
+  }
+
+  long
+  OggLoader::readStream
+  (uint8_t* dest, size_t maxBytes)
+  {
+    if (!mStreamOpen) return -1;
+
+    // ov_read returns at most one packet per call, keep going until full
     int bitStream = 0;
+    size_t total = 0;
+    while (total < maxBytes)
+    {
+      // 0 for Little-Endian, 1 for Big-Endian
+      long bytes = ov_read(&mOggFile, reinterpret_cast<char*>(dest + total),
+                           static_cast<int>(maxBytes - total), 0, 2, 1, &bitStream);
+      // A hole is a gap in the data, the next call carries on after it
+      if (bytes == OV_HOLE)
+      {
+        LOG_WARN("OggLoader: Skipping hole in stream");
+        continue;
+      }
+      if (bytes < 0)
+      {
+        LOG_ERROR("OggLoader: Error decoding stream\n\t{}", getOggErrorString(bytes));
+        // Keep what was decoded, the next call reports the error if it persists
+        return total > 0 ? static_cast<long>(total) : -1;
+      }
+      if (bytes == 0) break;
+      total += bytes;
+    }
+    return static_cast<long>(total);
+  }
+
+  bool
+  OggLoader::seekStream
+  (unsigned long sampleOffset)
+  {
+    if (!mStreamOpen) return false;
+
+    int error = ov_pcm_seek(&mOggFile, static_cast<ogg_int64_t>(sampleOffset));
+    if (error != 0)
+    {
+      LOG_WARN("OggLoader: Cannot seek to sample {}\n\t{}", sampleOffset, getOggErrorString(error));
+      return false;
+    }
+    return true;
+  }
+
+  void
+  OggLoader::closeStream
+  ()
+  {
+    if (mStreamOpen)
+    {
+      ov_clear(&mOggFile);
+      mStreamOpen = false;
+    }
+    mReadOffset = 0;
+  }
+
+  // Buffer ====================================================================
+
+  bool
+  OggLoader::decodeIntoBuffer
+  ()
+  {
+    LOG_TRACE("OggLoader: {}",__FUNCTION__);
+
+    if (!openDataStream())
+    {
+      return false;
+    }
+
+    // Decode straight into the audio buffer, the total length is known up
+    // front now that the stream is seekable.
+    mAudioBuffer.clear();
+    mAudioBuffer.reserve(mDurationInSamples * mChannels * 2);
     long bytes = 0;
-    char fixed_buffer[OGG_LOAD_BUFFER_SIZE];
-    vector<uint8_t> expanding_buffer;
     do
     {
-      // Read up to a buffer's worth of decoded sound data
-      // 0 for Little-Endian, 1 for Big-Endian
-      bytes = ov_read(&oggFile, &fixed_buffer[0], OGG_LOAD_BUFFER_SIZE, 0, 2, 1, &bitStream);
+      size_t offset = mAudioBuffer.size();
+      mAudioBuffer.resize(offset + OGG_LOAD_BUFFER_SIZE);
+      bytes = readStream(&mAudioBuffer[offset], OGG_LOAD_BUFFER_SIZE);
 
       if (bytes < 0)
       {
-        ov_clear(&oggFile);
-        LOG_ERROR("OggLoader: Error decoding {}", absPath);
+        LOG_ERROR("OggLoader: Error decoding buffer");
+        mAudioBuffer.clear();
+        closeStream();
         return false;
       }
-      // Append to end of buffer
-      expanding_buffer.insert(expanding_buffer.end(), &fixed_buffer[0], &fixed_buffer[0] + bytes);
+      mAudioBuffer.resize(offset + bytes);
     }
     while (bytes > 0);
-    mAudioBuffer.insert(mAudioBuffer.begin(), expanding_buffer.begin(), expanding_buffer.end());
 
     // Clean up!
-    ov_clear(&oggFile);
-    sm.closeFile(file);
+    closeStream();
+    mDurationInSamples = mAudioBuffer.size() / (mChannels * 2);
 
     return checkLoaded();
   }
@@ -163,6 +253,14 @@ namespace octronic::dream
         return "OV_EBADHEADER: Invalid Vorbis bitstream header.";
       case OV_EFAULT:
         return "OV_EFAULT: Internal logic fault; indicates a bug or heap/stack corruption.";
+      case OV_HOLE:
+        return "OV_HOLE: Interruption in the data.";
+      case OV_EBADLINK:
+        return "OV_EBADLINK: Invalid stream section supplied to libvorbisfile.";
+      case OV_ENOSEEK:
+        return "OV_ENOSEEK: Bitstream is not seekable.";
+      case OV_EINVAL:
+        return "OV_EINVAL: Invalid argument value.";
       default:
         return "Unknown Error";
     }
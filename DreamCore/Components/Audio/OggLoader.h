@@ -2,6 +2,7 @@
 
 #include "AudioLoader.h"
 #include <string>
+#include <vorbis/vorbisfile.h>
 
 using std::string;
 
@@ -10,11 +11,28 @@ namespace octronic::dream
   class OggLoader : public AudioLoader
   {
   public:
-    static const uint16_t OGG_LOAD_BUFFER_SIZE;
+    static const size_t OGG_LOAD_BUFFER_SIZE;
     OggLoader();
     ~OggLoader();
-    string getOggErrorString(int error);
+    static string getOggErrorString(int error);
 
-    bool loadIntoBuffer(ProjectRuntime& project, AudioDefinition& def) override;
+    bool decodeIntoBuffer() override;
+
+    bool openDataStream() override;
+    long readStream(uint8_t* dest, size_t maxBytes) override;
+    bool seekStream(unsigned long sampleOffset) override;
+    void closeStream() override;
+
+  private:
+    static size_t ReadCallback(void* buffer, size_t elementSize, size_t elementCount, void* dataSource);
+    static int SeekCallback(void* dataSource, ogg_int64_t offset, int whence);
+    static long TellCallback(void* dataSource);
+
+  private:
+    /**
+     * @brief Position of the decoder within the encoded data span.
+     */
+    size_t mReadOffset;
+    OggVorbis_File mOggFile;
   };
 }
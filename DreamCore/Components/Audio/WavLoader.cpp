@@ -1,20 +1,16 @@
 #include "WavLoader.h"
 
 #include "Common/Logger.h"
-#include "Components/Audio/AudioDefinition.h"
-#include "Storage/StorageManager.h"
-#include "Project/ProjectDirectory.h"
-#include "Storage/File.h"
-
-#include "Project/ProjectRuntime.h"
-
 
+#include <cstring>
 
 namespace octronic::dream
 {
   WavLoader::WavLoader
   ()
-    : AudioLoader()
+    : AudioLoader(),
+      mWavHeader(),
+      mReadOffset(0)
   {
     LOG_TRACE("WavLoader: {}",__FUNCTION__);
   }
@@ -25,55 +21,29 @@ namespace octronic::dream
   }
 
   bool
-  WavLoader::loadIntoBuffer
-  (ProjectRuntime& projectRuntime, AudioDefinition& audioDefinition)
+  WavLoader::readHeader
+  ()
   {
-    LOG_TRACE("WavLoader: {}",__FUNCTION__);
-    auto& pDir = projectRuntime.getProjectDirectory();
-    string absPath = pDir.getAssetAbsolutePath(audioDefinition);
-
-    LOG_DEBUG("WavLoader: Loading wav file from {}", absPath);
-
-    int headerSize = sizeof(mWavHeader), filelength = 0;
-    auto& storageManager = projectRuntime.getStorageManager();
-    auto& wavFile = storageManager.openFile(absPath);
-
-    if (!wavFile.exists())
-    {
+    size_t headerSize = sizeof(mWavHeader);
 
-      LOG_ERROR("WavLoader: Wav file does not exist: {}", absPath);
-      storageManager.closeFile(wavFile);
-      return false;
-    }
-
-    //Read the header
-    if (!wavFile.readBinary())
+    if (!hasData() || mDataSize < headerSize)
     {
-      storageManager.closeFile(wavFile);
+      LOG_ERROR("WavLoader: Data is smaller than a wav header");
       return false;
     }
 
-    // Read in the headerr
-    //size_t bytesRead = fread(&mWavHeader, 1, headerSize, wavFile);
-    memcpy(&mWavHeader, &wavFile.getBinaryData()[0], headerSize);
-    size_t bytesRead = headerSize;
-    LOG_DEBUG("WavLoader: Header Read {} bytes" ,bytesRead);
+    // Read in the header
+    memcpy(&mWavHeader, mData, headerSize);
+    LOG_DEBUG("WavLoader: Header Read {} bytes" ,headerSize);
     LOG_DEBUG("WavLoader: Reserved Subchunk2Size {} bytes" ,mWavHeader.Subchunk2Size);
 
-    // Read the data
-
     // OOB check
-    if(bytesRead + mWavHeader.Subchunk2Size != wavFile.getBinaryData().size())
+    if(headerSize + mWavHeader.Subchunk2Size != mDataSize)
     {
       LOG_ERROR("WavLoader: Failed bounds check");
-     return false;
+      return false;
     }
 
-    auto& wvData = wavFile.getBinaryData();
-    auto wvBegin = wvData.begin() + bytesRead;
-    mAudioBuffer.insert(mAudioBuffer.begin(), wvBegin, wvBegin + mWavHeader.Subchunk2Size);
-    LOG_DEBUG("WavLoader: Read subchunk2 from index [{}], size {} bytes", bytesRead, mWavHeader.Subchunk2Size);
-
     mSampleRate = mWavHeader.SamplesPerSecond;
 
     if (mWavHeader.NumOfChannels == 1)
@@ -92,9 +62,7 @@ namespace octronic::dream
       return false;
     }
 
-    LOG_DEBUG("WavLoader: Read {} bytes", mAudioBuffer.size());
-
-    filelength = wavFile.getBinaryData().size();
+    mDurationInSamples = mWavHeader.Subchunk2Size / (mChannels * getBytesPerSample());
 
     LOG_DEBUG(
           "Status...\n"
@@ -111,7 +79,7 @@ namespace octronic::dream
             "\tAudio Format: {}\n"
             "\tBlock align: {}\n"
             "\tData string: {} {} {} {}\n",
-          filelength,
+          mDataSize,
           mWavHeader.RIFF[0], mWavHeader.RIFF[1], mWavHeader.RIFF[2], mWavHeader.RIFF[3],
         mWavHeader.WAVE[0], mWavHeader.WAVE[1], mWavHeader.WAVE[2], mWavHeader.WAVE[3],
         mWavHeader.fmt[0], mWavHeader.fmt[1], mWavHeader.fmt[2], mWavHeader.fmt[3] ,
@@ -129,8 +97,89 @@ namespace octronic::dream
         mWavHeader.Subchunk2ID[3]
         );
 
-    // Close File
-    storageManager.closeFile(wavFile);
+    return true;
+  }
+
+  bool
+  WavLoader::decodeIntoBuffer
+  ()
+  {
+    LOG_TRACE("WavLoader: {}",__FUNCTION__);
+
+    if (!readHeader())
+    {
+      return false;
+    }
+
+    // Wav is already PCM, just copy out the data chunk
+    const uint8_t* pcmBegin = mData + sizeof(mWavHeader);
+    mAudioBuffer.assign(pcmBegin, pcmBegin + mWavHeader.Subchunk2Size);
+    LOG_DEBUG("WavLoader: Read {} bytes", mAudioBuffer.size());
+
     return checkLoaded();
   }
+
+  bool
+  WavLoader::openDataStream
+  ()
+  {
+    LOG_TRACE("WavLoader: {}",__FUNCTION__);
+    closeStream();
+
+    if (!readHeader())
+    {
+      return false;
+    }
+
+    mReadOffset = sizeof(mWavHeader);
+    mStreamOpen = true;
+
+    return checkStreamOpen();
+  }
+
+  long
+  WavLoader::readStream
+  (uint8_t* dest, size_t maxBytes)
+  {
+    if (!mStreamOpen) return -1;
+
+    size_t remaining = mDataSize - mReadOffset;
+    size_t count = maxBytes > remaining ? remaining : maxBytes;
+    memcpy(dest, mData + mReadOffset, count);
+    mReadOffset += count;
+    return static_cast<long>(count);
+  }
+
+  bool
+  WavLoader::seekStream
+  (unsigned long sampleOffset)
+  {
+    if (!mStreamOpen) return false;
+
+    if (sampleOffset > mDurationInSamples)
+    {
+      LOG_WARN("WavLoader: Cannot seek to sample {}, past the end of the stream", sampleOffset);
+      return false;
+    }
+
+    mReadOffset = sizeof(mWavHeader) + (sampleOffset * mChannels * getBytesPerSample());
+    return true;
+  }
+
+  void
+  WavLoader::closeStream
+  ()
+  {
+    mStreamOpen = false;
+    mReadOffset = 0;
+  }
+
+  size_t
+  WavLoader::getBytesPerSample
+  ()
+  const
+  {
+    size_t bytes = mWavHeader.BitsPerSample / 8;
+    return bytes == 0 ? 2 : bytes;
+  }
 }
@@ -12,8 +12,23 @@ namespace octronic::dream
   public:
     WavLoader();
     ~WavLoader();
-    bool loadIntoBuffer(ProjectRuntime& project, AudioDefinition& definition) override;
+    bool decodeIntoBuffer() override;
+
+    bool openDataStream() override;
+    long readStream(uint8_t* dest, size_t maxBytes) override;
+    bool seekStream(unsigned long sampleOffset) override;
+    void closeStream() override;
+
+  private:
+    bool readHeader();
+    size_t getBytesPerSample() const;
+
   private:
     WavHeader mWavHeader;
+    /**
+     * @brief Position of the stream within the encoded data span, PCM
+     * starts after the header.
+     */
+    size_t mReadOffset;
   };
 }
@@ -2,6 +2,7 @@
 
 #include "Common/Uuid.h"
 #include "Common/AssetType.h"
+#include "Common/PointerView.h"
 
 #include <string>
 #include <vector>
@@ -20,6 +21,17 @@ namespace octronic::dream
   class SharedAssetRuntime;
   class AssetDefinition;
 
+  /**
+   * @brief Memory held by the runtimes of one Cache.
+   */
+  struct CacheMemoryUsage
+  {
+    string name;
+    size_t runtimes = 0;
+    size_t cpuBytes = 0;
+    size_t gpuBytes = 0;
+  };
+
   /**
      * @brief Cache is an abstract class that is used to define a common
      * interface for a instanciating and storing SharedAssetRuntime objects.
@@ -60,6 +72,12 @@ namespace octronic::dream
          */
     vector<reference_wrapper<RuntimeType>> getRuntimeVector() const;
 
+    /**
+     * @return The runtimes managed by this Cache without copying them,
+     * invalidated when a runtime is loaded or removed.
+     */
+    PointerView<RuntimeType> getRuntimeView() const;
+
     /**
          * @brief removeRuntime remove a runtime from the cache based on definition
          * @param definition
@@ -83,6 +101,11 @@ namespace octronic::dream
      */
     size_t runtimeCount() const;
 
+    /**
+     * @return The memory reported by every runtime in this Cache.
+     */
+    CacheMemoryUsage getMemoryUsage() const;
+
   protected:
     ProjectRuntime& getProjectRuntime() const;
     ProjectDirectory& getProjectDirectory() const;
@@ -75,6 +75,15 @@ namespace octronic::dream
     return ret;
   }
 
+  template <typename DefinitionType, typename RuntimeType>
+  PointerView<RuntimeType>
+  Cache<DefinitionType, RuntimeType>::getRuntimeView
+  ()
+  const
+  {
+    return PointerView<RuntimeType>(mRuntimes);
+  }
+
   template <typename DefinitionType, typename RuntimeType>
   size_t
   Cache<DefinitionType, RuntimeType>::runtimeCount
@@ -84,6 +93,22 @@ namespace octronic::dream
     return mRuntimes.size();
   }
 
+  template <typename DefinitionType, typename RuntimeType>
+  CacheMemoryUsage
+  Cache<DefinitionType, RuntimeType>::getMemoryUsage
+  ()
+  const
+  {
+    CacheMemoryUsage usage;
+    usage.runtimes = mRuntimes.size();
+    for (auto& rt : mRuntimes)
+    {
+      usage.cpuBytes += rt->getCpuMemoryUsage();
+      usage.gpuBytes += rt->getGpuMemoryUsage();
+    }
+    return usage;
+  }
+
   template <typename DefinitionType, typename RuntimeType>
   RuntimeType&
   Cache<DefinitionType, RuntimeType>::loadRuntime
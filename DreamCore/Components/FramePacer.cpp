@@ -0,0 +1,137 @@
+#include "FramePacer.h"
+
+#include "Common/Logger.h"
+#include "Common/SteadyClock.h"
+
+#include <chrono>
+#include <thread>
+
+using std::chrono::nanoseconds;
+
+namespace octronic::dream
+{
+    FramePacer::FramePacer
+    ()
+        : mMode(FRAME_PACING_UNLIMITED),
+          mTargetFrameRate(0.0),
+          mSpinThreshold(DEFAULT_SPIN_THRESHOLD),
+          mNextFrame(0),
+          mLastWait(0)
+    {
+    }
+
+    void
+    FramePacer::setMode
+    (FramePacingMode mode)
+    {
+        mMode = mode;
+        mNextFrame = 0;
+    }
+
+    FramePacingMode
+    FramePacer::getMode
+    ()
+    const
+    {
+        return mMode;
+    }
+
+    void
+    FramePacer::setTargetFrameRate
+    (double framesPerSecond)
+    {
+        mTargetFrameRate = framesPerSecond < 0.0 ? 0.0 : framesPerSecond;
+        mNextFrame = 0;
+    }
+
+    double
+    FramePacer::getTargetFrameRate
+    ()
+    const
+    {
+        return mTargetFrameRate;
+    }
+
+    void
+    FramePacer::setSpinThreshold
+    (uint64_t nanoseconds)
+    {
+        mSpinThreshold = nanoseconds;
+    }
+
+    uint64_t
+    FramePacer::getSpinThreshold
+    ()
+    const
+    {
+        return mSpinThreshold;
+    }
+
+    int
+    FramePacer::getSwapInterval
+    ()
+    const
+    {
+        switch (mMode)
+        {
+            case FRAME_PACING_VSYNC:
+                return 1;
+            case FRAME_PACING_ADAPTIVE_VSYNC:
+                return -1;
+            default:
+                return 0;
+        }
+    }
+
+    void
+    FramePacer::waitForNextFrame
+    ()
+    {
+        mLastWait = 0;
+        if (mMode != FRAME_PACING_LIMITED || mTargetFrameRate <= 0.0)
+        {
+            return;
+        }
+
+        const uint64_t period = static_cast<uint64_t>(1e9 / mTargetFrameRate);
+        uint64_t now = SteadyClock::Now();
+
+        // First frame, or so far behind that catching up would run a burst
+        // of frames back to back
+        if (mNextFrame == 0 || now > mNextFrame + period)
+        {
+            mNextFrame = now + period;
+            return;
+        }
+
+        const uint64_t start = now;
+        while (now < mNextFrame)
+        {
+            uint64_t remaining = mNextFrame - now;
+            if (remaining > mSpinThreshold)
+            {
+                std::this_thread::sleep_for(nanoseconds(remaining - mSpinThreshold));
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+            now = SteadyClock::Now();
+        }
+
+        mLastWait = now - start;
+        mNextFrame += period;
+        LOG_TRACE("FramePacer: Waited {}ns", mLastWait);
+    }
+
+    uint64_t
+    FramePacer::getLastWait
+    ()
+    const
+    {
+        return mLastWait;
+    }
+
+    // Covers typical sleep overshoot on Linux and macOS
+    const uint64_t FramePacer::DEFAULT_SPIN_THRESHOLD = 1000000;
+}
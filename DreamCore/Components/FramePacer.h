@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+
+namespace octronic::dream
+{
+    enum FramePacingMode
+    {
+        /**
+         * @brief Run frames as fast as possible.
+         */
+        FRAME_PACING_UNLIMITED,
+        /**
+         * @brief Wait for the target frame rate before each frame, vsync
+         * off.
+         */
+        FRAME_PACING_LIMITED,
+        /**
+         * @brief Let swapBuffers wait for the display.
+         */
+        FRAME_PACING_VSYNC,
+        /**
+         * @brief Wait for the display, but swap immediately when a frame
+         * misses it rather than waiting a whole refresh. Falls back to
+         * VSYNC where the driver does not support it.
+         */
+        FRAME_PACING_ADAPTIVE_VSYNC
+    };
+
+    /**
+     * @brief Holds the main loop to a target frame rate.
+     *
+     * Frames are scheduled against a fixed deadline rather than a delay
+     * after the last frame, so the rate does not drift with frame cost. The
+     * wait sleeps until the spin threshold before the deadline, then yields
+     * until it passes, which absorbs the OS sleep overshoot. A spin
+     * threshold of 0 only sleeps, for servers and headless instances that
+     * prefer idle CPU over precise frame times.
+     */
+    class FramePacer
+    {
+    public:
+        FramePacer();
+
+        void setMode(FramePacingMode mode);
+        FramePacingMode getMode() const;
+
+        /**
+         * @brief Frames per second in FRAME_PACING_LIMITED, 0 for no limit.
+         */
+        void setTargetFrameRate(double framesPerSecond);
+        double getTargetFrameRate() const;
+
+        void setSpinThreshold(uint64_t nanoseconds);
+        uint64_t getSpinThreshold() const;
+
+        /**
+         * @return The swap interval the window should use for this mode.
+         * -1 asks for adaptive vsync.
+         */
+        int getSwapInterval() const;
+
+        /**
+         * @brief Block until the next frame is due. Call once per frame.
+         */
+        void waitForNextFrame();
+
+        /**
+         * @return Nanoseconds the last call spent waiting.
+         */
+        uint64_t getLastWait() const;
+
+        const static uint64_t DEFAULT_SPIN_THRESHOLD;
+
+    private:
+        FramePacingMode mMode;
+        double mTargetFrameRate;
+        uint64_t mSpinThreshold;
+        uint64_t mNextFrame;
+        uint64_t mLastWait;
+    };
+}
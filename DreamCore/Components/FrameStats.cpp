@@ -0,0 +1,304 @@
+#include "FrameStats.h"
+
+#include "Common/Logger.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace octronic::dream
+{
+    namespace
+    {
+        // 16 sub buckets per power of two
+        const unsigned int SUB_BUCKET_BITS = 4;
+        const uint64_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+
+        unsigned int
+        HighestBit
+        (uint64_t value)
+        {
+            unsigned int bit = 0;
+            while (value >>= 1) bit++;
+            return bit;
+        }
+    }
+
+    const size_t FrameStatHistogram::WINDOW_SIZE = 1024;
+    // Values below SUB_BUCKETS are exact, then one row per power of two
+    const size_t FrameStatHistogram::BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    FrameStatHistogram::FrameStatHistogram
+    ()
+        : mBuckets(BUCKET_COUNT),
+          mWindow(WINDOW_SIZE),
+          mCount(0),
+          mWindowSum(0)
+    {
+    }
+
+    size_t
+    FrameStatHistogram::BucketIndex
+    (uint64_t value)
+    {
+        if (value < SUB_BUCKETS) return value;
+        unsigned int bit = HighestBit(value);
+        uint64_t mantissa = (value >> (bit - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+        return (bit - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + mantissa;
+    }
+
+    uint64_t
+    FrameStatHistogram::BucketValue
+    (size_t index)
+    {
+        if (index < SUB_BUCKETS) return index;
+        unsigned int shift = index / SUB_BUCKETS - 1;
+        uint64_t mantissa = index % SUB_BUCKETS;
+        uint64_t lower = (SUB_BUCKETS + mantissa) << shift;
+        // Midpoint of the bucket
+        return lower + ((uint64_t(1) << shift) >> 1);
+    }
+
+    void
+    FrameStatHistogram::record
+    (uint64_t value)
+    {
+        uint64_t count = mCount.load(std::memory_order_relaxed);
+        auto& slot = mWindow[count % WINDOW_SIZE];
+
+        if (count >= WINDOW_SIZE)
+        {
+            uint64_t evicted = slot.load(std::memory_order_relaxed);
+            mBuckets[BucketIndex(evicted)].fetch_sub(1, std::memory_order_relaxed);
+            mWindowSum.fetch_sub(evicted, std::memory_order_relaxed);
+        }
+
+        slot.store(value, std::memory_order_relaxed);
+        mBuckets[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        mWindowSum.fetch_add(value, std::memory_order_relaxed);
+        mCount.store(count + 1, std::memory_order_release);
+    }
+
+    uint64_t
+    FrameStatHistogram::getPercentile
+    (double p)
+    const
+    {
+        uint64_t total = 0;
+        for (auto& bucket : mBuckets) total += bucket.load(std::memory_order_relaxed);
+        if (total == 0) return 0;
+
+        uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p * total)));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; i++)
+        {
+            seen += mBuckets[i].load(std::memory_order_relaxed);
+            if (seen >= rank) return BucketValue(i);
+        }
+        return BucketValue(BUCKET_COUNT - 1);
+    }
+
+    FrameStatSummary
+    FrameStatHistogram::getSummary
+    ()
+    const
+    {
+        FrameStatSummary summary;
+        uint64_t count = mCount.load(std::memory_order_acquire);
+        summary.samples = std::min<uint64_t>(count, WINDOW_SIZE);
+        if (summary.samples == 0) return summary;
+
+        summary.mean = static_cast<double>(mWindowSum.load(std::memory_order_relaxed)) / summary.samples;
+        summary.p50 = getPercentile(0.50);
+        summary.p95 = getPercentile(0.95);
+        summary.p99 = getPercentile(0.99);
+
+        // Max is exact, taken from the window rather than the buckets
+        for (size_t i = 0; i < summary.samples; i++)
+        {
+            summary.max = std::max(summary.max, mWindow[i].load(std::memory_order_relaxed));
+        }
+
+        // A bucket midpoint can lie past the largest value in it
+        summary.p50 = std::min(summary.p50, summary.max);
+        summary.p95 = std::min(summary.p95, summary.max);
+        summary.p99 = std::min(summary.p99, summary.max);
+        return summary;
+    }
+
+    size_t
+    FrameStatHistogram::getHistory
+    (float* out, size_t count, double scale)
+    const
+    {
+        uint64_t recorded = mCount.load(std::memory_order_acquire);
+        size_t available = std::min<uint64_t>(recorded, WINDOW_SIZE);
+        count = std::min(count, available);
+
+        uint64_t first = recorded - count;
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = static_cast<float>(mWindow[(first + i) % WINDOW_SIZE].load(std::memory_order_relaxed) * scale);
+        }
+        return count;
+    }
+
+    // FrameStats ==============================================================
+
+    const double FrameStats::HITCH_FACTOR = 2.0;
+    const uint64_t FrameStats::HITCH_MIN_FRAMES = 30;
+
+    FrameStats::FrameStats
+    ()
+        : mShared(std::make_unique<Shared>()),
+          mFrameTime(0)
+    {
+    }
+
+    void
+    FrameStats::record
+    (FrameStat stat, uint64_t value)
+    {
+        if (stat == FRAME_STAT_FRAME_TIME) mFrameTime = value;
+        mShared->histograms[stat].record(value);
+    }
+
+    void
+    FrameStats::endFrame
+    ()
+    {
+        uint64_t frame = mShared->frames.load(std::memory_order_relaxed) + 1;
+
+        if (frame > HITCH_MIN_FRAMES)
+        {
+            uint64_t median = mShared->histograms[FRAME_STAT_FRAME_TIME].getPercentile(0.5);
+            if (mFrameTime > HITCH_FACTOR * median)
+            {
+                mShared->hitches.fetch_add(1, std::memory_order_relaxed);
+                mShared->lastHitchFrame.store(frame, std::memory_order_relaxed);
+                mShared->lastHitchTime.store(mFrameTime, std::memory_order_relaxed);
+                LOG_DEBUG("FrameStats: Hitch on frame {}, {:.3f} ms against a median of {:.3f} ms",
+                          frame, mFrameTime / 1e6, median / 1e6);
+            }
+        }
+
+        mShared->frames.store(frame, std::memory_order_release);
+    }
+
+    const FrameStatHistogram&
+    FrameStats::getHistogram
+    (FrameStat stat)
+    const
+    {
+        return mShared->histograms[stat];
+    }
+
+    FrameStatSummary
+    FrameStats::getSummary
+    (FrameStat stat)
+    const
+    {
+        return mShared->histograms[stat].getSummary();
+    }
+
+    uint64_t
+    FrameStats::getFrameCount
+    ()
+    const
+    {
+        return mShared->frames.load(std::memory_order_acquire);
+    }
+
+    uint64_t
+    FrameStats::getHitchCount
+    ()
+    const
+    {
+        return mShared->hitches.load(std::memory_order_relaxed);
+    }
+
+    uint64_t
+    FrameStats::getLastHitchFrame
+    ()
+    const
+    {
+        return mShared->lastHitchFrame.load(std::memory_order_relaxed);
+    }
+
+    uint64_t
+    FrameStats::getLastHitchTime
+    ()
+    const
+    {
+        return mShared->lastHitchTime.load(std::memory_order_relaxed);
+    }
+
+    double
+    FrameStats::getAverageFrameRate
+    ()
+    const
+    {
+        auto summary = getSummary(FRAME_STAT_FRAME_TIME);
+        if (summary.mean <= 0.0) return 0.0;
+        return 1e9 / summary.mean;
+    }
+
+    json
+    FrameStats::toJson
+    ()
+    const
+    {
+        json js;
+        for (int i = 0; i < FRAME_STAT_COUNT; i++)
+        {
+            auto stat = static_cast<FrameStat>(i);
+            auto summary = getSummary(stat);
+            // Times are reported in ms, counts as they are
+            double scale = stat <= FRAME_STAT_DESTRUCTION_TIME ? 1e-6 : 1.0;
+
+            json statJs;
+            statJs["samples"] = summary.samples;
+            statJs["mean"] = summary.mean * scale;
+            statJs["p50"] = summary.p50 * scale;
+            statJs["p95"] = summary.p95 * scale;
+            statJs["p99"] = summary.p99 * scale;
+            statJs["max"] = summary.max * scale;
+            js[GetStatName(stat)] = statJs;
+        }
+        js["frames"] = getFrameCount();
+        js["hitches"] = getHitchCount();
+        js["last_hitch_frame"] = getLastHitchFrame();
+        js["last_hitch_ms"] = getLastHitchTime() / 1e6;
+        return js;
+    }
+
+    const char*
+    FrameStats::GetStatName
+    (FrameStat stat)
+    {
+        switch (stat)
+        {
+            case FRAME_STAT_FRAME_TIME:
+                return "frame_ms";
+            case FRAME_STAT_UPDATE_TIME:
+                return "update_ms";
+            case FRAME_STAT_TASK_TIME:
+                return "task_ms";
+            case FRAME_STAT_GRAPHICS_TIME:
+                return "graphics_ms";
+            case FRAME_STAT_DESTRUCTION_TIME:
+                return "destruction_ms";
+            case FRAME_STAT_TASKS:
+                return "tasks";
+            case FRAME_STAT_GRAPHICS_TASKS:
+                return "graphics_tasks";
+            case FRAME_STAT_DRAW_CALLS:
+                return "draw_calls";
+            case FRAME_STAT_UPLOAD_BYTES:
+                return "upload_bytes";
+            case FRAME_STAT_COUNT:
+                break;
+        }
+        return "";
+    }
+}
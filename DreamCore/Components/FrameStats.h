@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <json.hpp>
+
+using std::atomic;
+using std::unique_ptr;
+using std::vector;
+using nlohmann::json;
+
+namespace octronic::dream
+{
+    enum FrameStat
+    {
+        // Nanoseconds between the start of this frame and the last
+        FRAME_STAT_FRAME_TIME = 0,
+        // Nanoseconds spent in each part of ProjectRuntime::step
+        FRAME_STAT_UPDATE_TIME,
+        FRAME_STAT_TASK_TIME,
+        FRAME_STAT_GRAPHICS_TIME,
+        FRAME_STAT_DESTRUCTION_TIME,
+        // Tasks queued when each queue ran
+        FRAME_STAT_TASKS,
+        FRAME_STAT_GRAPHICS_TASKS,
+        // Geometry and shadow pass draw calls
+        FRAME_STAT_DRAW_CALLS,
+        // Bytes passed to buffer and texture uploads, only counted by the
+        // null and recording GLDispatch backends
+        FRAME_STAT_UPLOAD_BYTES,
+        FRAME_STAT_COUNT
+    };
+
+    struct FrameStatSummary
+    {
+        uint64_t samples = 0;
+        double mean = 0.0;
+        uint64_t p50 = 0;
+        uint64_t p95 = 0;
+        uint64_t p99 = 0;
+        uint64_t max = 0;
+    };
+
+    /**
+     * @brief A histogram of the last WINDOW_SIZE values of one statistic.
+     *
+     * Buckets are log-linear, 16 per power of two, so any value is within
+     * about 3% of its bucket's midpoint and the histogram never grows.
+     * Recording adds the new value and removes the one leaving the window.
+     *
+     * There must be a single writer. Every field is atomic, so readers on
+     * other threads never block it, at the cost of a summary that may mix
+     * two adjacent frames.
+     */
+    class FrameStatHistogram
+    {
+    public:
+        FrameStatHistogram();
+
+        FrameStatHistogram(const FrameStatHistogram&) = delete;
+        FrameStatHistogram& operator=(const FrameStatHistogram&) = delete;
+
+        void record(uint64_t value);
+
+        FrameStatSummary getSummary() const;
+        /**
+         * @brief Value at percentile p, 0 to 1, from the buckets.
+         */
+        uint64_t getPercentile(double p) const;
+        /**
+         * @brief Copy up to count of the most recent values into out, oldest
+         * first, multiplied by scale.
+         * @return The number of values written.
+         */
+        size_t getHistory(float* out, size_t count, double scale = 1.0) const;
+
+        static size_t BucketIndex(uint64_t value);
+        static uint64_t BucketValue(size_t index);
+
+        const static size_t WINDOW_SIZE;
+        const static size_t BUCKET_COUNT;
+
+    private:
+        vector<atomic<uint32_t>> mBuckets;
+        vector<atomic<uint64_t>> mWindow;
+        // Values ever recorded, the next window slot is mCount % WINDOW_SIZE
+        atomic<uint64_t> mCount;
+        atomic<uint64_t> mWindowSum;
+    };
+
+    /**
+     * @brief Per frame statistics for a ProjectRuntime, each kept in a
+     * FrameStatHistogram so percentiles cost nothing to maintain.
+     *
+     * ProjectRuntime::step records each statistic once per frame and calls
+     * endFrame. A frame slower than HITCH_FACTOR times the median frame time
+     * is counted as a hitch once HITCH_MIN_FRAMES have been seen.
+     *
+     * Getters can be called from any thread, e.g. DreamTool or a monitoring
+     * thread, without stalling the frame.
+     */
+    class FrameStats
+    {
+    public:
+        FrameStats();
+
+        void record(FrameStat stat, uint64_t value);
+        void endFrame();
+
+        const FrameStatHistogram& getHistogram(FrameStat stat) const;
+        FrameStatSummary getSummary(FrameStat stat) const;
+
+        uint64_t getFrameCount() const;
+        uint64_t getHitchCount() const;
+        /**
+         * @return Frame number and frame time in ns of the last hitch.
+         */
+        uint64_t getLastHitchFrame() const;
+        uint64_t getLastHitchTime() const;
+
+        /**
+         * @return Frames per second from the mean frame time in the window.
+         */
+        double getAverageFrameRate() const;
+
+        /**
+         * @brief Summaries of every statistic, times in milliseconds.
+         */
+        json toJson() const;
+
+        static const char* GetStatName(FrameStat stat);
+
+        const static double HITCH_FACTOR;
+        const static uint64_t HITCH_MIN_FRAMES;
+
+    private:
+        struct Shared
+        {
+            FrameStatHistogram histograms[FRAME_STAT_COUNT];
+            atomic<uint64_t> frames{0};
+            atomic<uint64_t> hitches{0};
+            atomic<uint64_t> lastHitchFrame{0};
+            atomic<uint64_t> lastHitchTime{0};
+        };
+        // On the heap so the stats move with ProjectRuntime while the
+        // atomics readers use stay in place
+        unique_ptr<Shared> mShared;
+        uint64_t mFrameTime;
+    };
+}
@@ -127,6 +127,14 @@ namespace octronic::dream
     return result != Frustum::TEST_INSIDE;
   }
 
+  const Frustum&
+  CameraRuntime::getFrustum
+  ()
+  const
+  {
+    return mFrustum;
+  }
+
   bool
   CameraRuntime::containedInFrustumAfterTransform
   (const EntityRuntime& er, const mat4& tx)
@@ -42,6 +42,7 @@ namespace octronic::dream
     bool containedInFrustum(const BoundingBox&) const;
     bool containedInFrustumAfterTransform(const EntityRuntime&,const mat4& tx) const;
     bool exceedsFrustumPlaneAtTranslation(Frustum::Plane plane, const EntityRuntime& sor, const vec3& tx) const;
+    const Frustum& getFrustum() const;
 
     void setTransform(const Transform&);
     Transform getTransform() const;
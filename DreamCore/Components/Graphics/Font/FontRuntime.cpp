@@ -4,6 +4,7 @@
 
 #include "Common/Logger.h"
 #include "Components/Graphics/GraphicsComponent.h"
+#include "Components/Graphics/Shader/ShaderRuntime.h"
 #include "Storage/StorageManager.h"
 #include "Project/ProjectDirectory.h"
 #include "Storage/File.h"
@@ -31,7 +32,10 @@ namespace octronic::dream
       mAtlasWidth(0),
       mAtlasHeight(0),
       mVao(0),
-      mVbo(0)
+      mVbo(0),
+      mFontVersion(0),
+      mBatchDirty(true),
+      mBatchUploadCount(0)
   {
     LOG_TRACE("FontRuntime: {}", __FUNCTION__);
     memset(&mCharacterInfo, 0, sizeof(FontCharacterInfo)*CHAR_INFO_SZ);
@@ -121,76 +125,174 @@ namespace octronic::dream
 
   }
 
-  void FontRuntime::draw
+  bool
+  FontRuntime::updateTextMesh
   (EntityRuntime& entity)
   {
-    LOG_TRACE("FontRuntime: {}", __FUNCTION__);
+    auto& mesh = entity.getTextMesh();
+    float scale = entity.getFontScale();
+    const string& text = entity.getFontText();
+
+    if (mesh.font == this &&
+        mesh.fontVersion == mFontVersion &&
+        mesh.scale == scale &&
+        mesh.text == text)
+    {
+      return false;
+    }
 
-    float sx = entity.getFontScale();
-    float sy = sx;
-    Transform tx = entity.getTransform();
-    vec3 translation = tx.getTranslation();
-    float x = translation.x;
-    float y = translation.y;
-    string text = entity.getFontText();
+    LOG_TRACE("FontRuntime: Generating text mesh for string length {}", text.size());
 
-    glActiveTexture(GL_TEXTURE0);
-    GLCheckError();
+    mesh.vertices.clear();
+    mesh.vertices.reserve(6 * text.size());
 
-    glBindTexture(GL_TEXTURE_2D, mAtlasTexture);
-    GLCheckError();
+    float x = 0.f;
+    float y = 0.f;
 
-    glBindVertexArray(mVao);
-    GLCheckError();
+    for (const char c : text)
+    {
+      auto& ci = mCharacterInfo[(size_t)c & (CHAR_INFO_SZ-1)];
+      float x2 =  x + ci.bl * scale;
+      float y2 = -y - ci.bt * scale;
+      float w = ci.bw * scale;
+      float h = ci.bh * scale;
+
+      /* Advance the cursor to the start of the next character */
+      x += ci.ax * scale;
+      y += ci.ay * scale;
+
+      /* Skip glyphs that have no pixels */
+      if(!w || !h) continue;
+
+      float s2 = ci.tx + ci.bw / mAtlasWidth;
+      float t2 = ci.bh / mAtlasHeight; //remember: each glyph occupies a different amount of vertical space
+
+      mesh.vertices.push_back({x2,     -y2,     ci.tx, 0});
+      mesh.vertices.push_back({x2 + w, -y2,     s2,    0});
+      mesh.vertices.push_back({x2,     -y2 - h, ci.tx, t2});
+      mesh.vertices.push_back({x2 + w, -y2,     s2,    0});
+      mesh.vertices.push_back({x2,     -y2 - h, ci.tx, t2});
+      mesh.vertices.push_back({x2 + w, -y2 - h, s2,    t2});
+    }
+
+    mesh.text = text;
+    mesh.scale = scale;
+    mesh.font = this;
+    mesh.fontVersion = mFontVersion;
+    mesh.version++;
+    return true;
+  }
+
+  void
+  FontRuntime::rebuildBatch
+  ()
+  {
+    mBatchVertices.clear();
+    mBatchRuns.clear();
+
+    for (auto& instance : mBatchInstances)
+    {
+      auto& mesh = instance.entity->getTextMesh();
+      if (mesh.vertices.empty()) continue;
+
+      GLint first = static_cast<GLint>(mBatchVertices.size());
+      const mat4& m = instance.transform;
+      for (auto& v : mesh.vertices)
+      {
+        vec4 p = m[0] * v.x + m[1] * v.y + m[3];
+        mBatchVertices.push_back({p.x, p.y, v.s, v.t});
+      }
+
+      GLsizei count = static_cast<GLsizei>(mesh.vertices.size());
+      if (!mBatchRuns.empty() && mBatchRuns.back().color == instance.color)
+      {
+        mBatchRuns.back().count += count;
+      }
+      else
+      {
+        mBatchRuns.push_back({first, count, instance.color});
+      }
+    }
 
     glBindBuffer(GL_ARRAY_BUFFER, mVbo);
     GLCheckError();
+    glBufferData(GL_ARRAY_BUFFER, mBatchVertices.size() * sizeof(FontVertex),
+                 mBatchVertices.data(), GL_DYNAMIC_DRAW);
+    GLCheckError();
 
-    unsigned int num_points = 6 * text.size();
+    LOG_TRACE("FontRuntime: Uploaded {} vertices in {} runs", mBatchVertices.size(), mBatchRuns.size());
+    mBatchUploadCount++;
+    mBatchDirty = false;
+  }
 
-    LOG_TRACE("FontRuntime: Generating for string length {}, {} points {} triangles",
-              text.size(), num_points, num_points/6);
+  void
+  FontRuntime::drawInstances
+  (ShaderRuntime& shader)
+  {
+    LOG_TRACE("FontRuntime: {}", __FUNCTION__);
 
-    struct point
-    {
-      GLfloat x;
-      GLfloat y;
-      GLfloat s;
-      GLfloat t;
-    } coords[num_points];
+    if (mVao == 0) return;
 
-    int n = 0;
-    const char* c_text = text.c_str();
+    if (mBatchInstances.size() != mInstances.size())
+    {
+      mBatchInstances.resize(mInstances.size());
+      mBatchDirty = true;
+    }
 
-    for(const char *p = c_text; *p; p++)
+    for (size_t i = 0; i < mInstances.size(); i++)
     {
-      float x2 =  x + mCharacterInfo[(size_t)*p].bl * sx;
-      float y2 = -y - mCharacterInfo[(size_t)*p].bt * sy;
-      float w = mCharacterInfo[(size_t)*p].bw * sx;
-      float h = mCharacterInfo[(size_t)*p].bh * sy;
+      auto& entity = mInstances[i].get();
+      updateTextMesh(entity);
+
+      auto& instance = mBatchInstances[i];
+      mat4 transform = entity.getTransform().getMatrix();
+      vec4 color = entity.getFontColor();
+      unsigned long meshVersion = entity.getTextMesh().version;
+
+      if (instance.entity != &entity ||
+          instance.meshVersion != meshVersion ||
+          instance.transform != transform ||
+          instance.color != color)
+      {
+        instance.entity = &entity;
+        instance.meshVersion = meshVersion;
+        instance.transform = transform;
+        instance.color = color;
+        mBatchDirty = true;
+      }
+    }
 
-      /* Advance the cursor to the start of the next character */
-      x += mCharacterInfo[(size_t)*p].ax * sx;
-      y += mCharacterInfo[(size_t)*p].ay * sy;
+    shader.bindVertexArray(mVao);
+    if (mBatchDirty) rebuildBatch();
+    if (mBatchRuns.empty()) return;
 
-      /* Skip glyphs that have no pixels */
-      if(!w || !h) continue;
+    shader.setTexture(GL_TEXTURE0, GL_TEXTURE_2D, mAtlasTexture);
+    // Instances are already transformed into the batch
+    shader.setModelMatrixUniform(mat4(1.f));
 
-      coords[n++] = {x2, -y2, mCharacterInfo[(size_t)*p].tx, 0};
-      coords[n++] = {x2 + w, -y2, mCharacterInfo[(size_t)*p].tx + mCharacterInfo[(size_t)*p].bw / mAtlasWidth, 0};
-      coords[n++] = {x2, -y2 - h, mCharacterInfo[(size_t)*p].tx, mCharacterInfo[(size_t)*p].bh / mAtlasHeight}; //remember: each glyph occupies a different amount of vertical space
-      coords[n++] = {x2 + w, -y2, mCharacterInfo[(size_t)*p].tx + mCharacterInfo[(size_t)*p].bw / mAtlasWidth, 0};
-      coords[n++] = {x2, -y2 - h, mCharacterInfo[(size_t)*p].tx, mCharacterInfo[(size_t)*p].bh / mAtlasHeight};
-      coords[n++] = {x2 + w, -y2 - h, mCharacterInfo[(size_t)*p].tx + mCharacterInfo[(size_t)*p].bw / mAtlasWidth, mCharacterInfo[(size_t)*p].bh / mAtlasHeight};
+    for (auto& run : mBatchRuns)
+    {
+      shader.setColorUniform(run.color);
+      shader.syncUniforms();
+      glDrawArrays(GL_TRIANGLES, run.first, run.count);
+      GLCheckError();
     }
+  }
 
-    LOG_TRACE("Font: Buffering {}bytes ({}points) triangle points ({} tris)", sizeof(coords), sizeof(coords)/sizeof(point), n);
+  size_t
+  FontRuntime::getBatchVertexCount
+  ()
+  const
+  {
+    return mBatchVertices.size();
+  }
 
-    glBufferData(GL_ARRAY_BUFFER, sizeof(coords), &coords[0], GL_DYNAMIC_DRAW);
-    GLCheckError();
-    glDrawArrays(GL_TRIANGLES, 0, n);
-    GLCheckError();
-    glBindVertexArray(0);
+  unsigned long
+  FontRuntime::getBatchUploadCount
+  ()
+  const
+  {
+    return mBatchUploadCount;
   }
 
   void
@@ -242,6 +344,29 @@ namespace octronic::dream
     mAtlasHeight = atlasHeight;
   }
 
+  size_t
+  FontRuntime::getCpuMemoryUsage
+  ()
+  const
+  {
+    return mFontData.capacity() +
+        mBatchInstances.capacity() * sizeof(BatchInstance) +
+        mBatchRuns.capacity() * sizeof(BatchRun) +
+        mBatchVertices.capacity() * sizeof(FontVertex);
+  }
+
+  size_t
+  FontRuntime::getGpuMemoryUsage
+  ()
+  const
+  {
+    size_t bytes = 0;
+    // One byte per texel atlas
+    if (mAtlasTexture != 0) bytes += static_cast<size_t>(mAtlasWidth) * mAtlasHeight;
+    if (mVbo != 0) bytes += mBatchVertices.size() * sizeof(FontVertex);
+    return bytes;
+  }
+
   GLuint
   FontRuntime::getAtlasTexture
   () const
@@ -401,6 +526,9 @@ namespace octronic::dream
       }
 
       FT_Done_Face(face);
+      // Cached text meshes hold this atlas' coordinates
+      mFontVersion++;
+      mBatchDirty = true;
       return true;
     }
     return false;
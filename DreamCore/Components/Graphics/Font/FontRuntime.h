@@ -6,8 +6,16 @@
 #include "Common/GLHeader.h"
 
 #include <memory>
+#include <string>
+#include <vector>
+#include <glm/matrix.hpp>
+#include <glm/vec4.hpp>
 
 using std::shared_ptr;
+using std::string;
+using std::vector;
+using glm::mat4;
+using glm::vec4;
 
 #define CHAR_INFO_SZ 128
 
@@ -20,7 +28,41 @@ namespace octronic::dream
   class File;
   class FontDefinition;
   class EntityRuntime;
+  class ShaderRuntime;
 
+  struct FontVertex
+  {
+    GLfloat x;
+    GLfloat y;
+    GLfloat s;
+    GLfloat t;
+  };
+
+  /**
+   * @brief Glyph quads for one entity's text, relative to the entity's
+   * origin. Kept on the entity and only regenerated when the text, scale
+   * or font changes.
+   */
+  struct TextMesh
+  {
+    vector<FontVertex> vertices;
+    string text;
+    float scale = 0.f;
+    const FontRuntime* font = nullptr;
+    unsigned long fontVersion = 0;
+    unsigned long version = 0;
+  };
+
+  /**
+   * @brief FontRuntime renders every instance of a font from one shared
+   * vertex buffer.
+   *
+   * Each instance's TextMesh is transformed by its entity into the shared
+   * buffer, which is only rebuilt and uploaded when an instance's text,
+   * transform or colour changes, so static text costs no uploads. Runs of
+   * instances with the same colour are drawn with one call against the
+   * font's atlas.
+   */
   class FontRuntime : public SharedAssetRuntime
   {
   public:
@@ -34,7 +76,22 @@ namespace octronic::dream
     void pushTasks() override;
     void pushDestructionTask();
 
-    void draw(EntityRuntime& er);
+    /**
+     * @brief Regenerate the entity's TextMesh if its text, scale or this
+     * font has changed since it was built.
+     * @return true if the mesh was regenerated.
+     */
+    bool updateTextMesh(EntityRuntime& er);
+
+    /**
+     * @brief Draw every instance of this font, the shader must be in use.
+     */
+    void drawInstances(ShaderRuntime& shader);
+    size_t getBatchVertexCount() const;
+    unsigned long getBatchUploadCount() const;
+
+    size_t getCpuMemoryUsage() const override;
+    size_t getGpuMemoryUsage() const override;
 
     float getWidthOf(string s);
 
@@ -65,6 +122,24 @@ namespace octronic::dream
   private:
     static FT_Library sFreeTypeLibrary;
 
+  private:
+    struct BatchInstance
+    {
+      const EntityRuntime* entity;
+      unsigned long meshVersion;
+      mat4 transform;
+      vec4 color;
+    };
+
+    struct BatchRun
+    {
+      GLint first;
+      GLsizei count;
+      vec4 color;
+    };
+
+    void rebuildBatch();
+
   private:
     int mSize;
     FontCharacterInfo mCharacterInfo[CHAR_INFO_SZ];
@@ -74,6 +149,12 @@ namespace octronic::dream
     GLuint mVao;
     GLuint mVbo;
     vector<uint8_t> mFontData;
+    unsigned long mFontVersion;
+    vector<BatchInstance> mBatchInstances;
+    vector<BatchRun> mBatchRuns;
+    vector<FontVertex> mBatchVertices;
+    bool mBatchDirty;
+    unsigned long mBatchUploadCount;
     shared_ptr<FontLoadIntoGLTask> mFontLoadIntoGLTask;
     shared_ptr<FontRemoveFromGLTask> mFontRemoveFromGLTask;
   };
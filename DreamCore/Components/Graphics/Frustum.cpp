@@ -9,6 +9,11 @@ namespace octronic::dream
 
     }
 
+    Frustum::Frustum()
+    {
+
+    }
+
     Frustum::~Frustum()
     {
 
@@ -18,9 +23,15 @@ namespace octronic::dream
     Frustum::updatePlanes
     ()
     {
-        const mat4 &v = mCamera.get().getViewMatrix();
-        const mat4 &p = mCamera.get().getProjectionMatrix();
+        if (!mCamera) return;
+        auto& camera = mCamera.value().get();
+        updatePlanes(camera.getViewMatrix(), camera.getProjectionMatrix());
+    }
 
+    void
+    Frustum::updatePlanes
+    (const mat4& v, const mat4& p)
+    {
         mat4 clipMatrix;
 
         clipMatrix[0][0] = v[0][0 ]*p[0][0]+v[0][1]*p[1][0]+v[0][2]*p[2][0]+v[0][3]*p[3][0];
@@ -76,6 +87,33 @@ namespace octronic::dream
         }
     }
 
+    Frustum::TestResult
+    Frustum::testIntersection
+    (const vec3& minimum, const vec3& maximum)
+    const
+    {
+        TestResult result = TEST_INSIDE;
+        for( uint i = 0; i < 6; i++ )
+        {
+            const vec3 normal = vec3(mPlanes[i].x,mPlanes[i].y,mPlanes[i].z);
+            const vec3 positive(normal.x >= 0.0f ? maximum.x : minimum.x,
+                                normal.y >= 0.0f ? maximum.y : minimum.y,
+                                normal.z >= 0.0f ? maximum.z : minimum.z);
+            if(glm::dot(normal, positive)+mPlanes[i].w < 0.0f)
+            {
+                return TEST_OUTSIDE;
+            }
+            const vec3 negative(normal.x >= 0.0f ? minimum.x : maximum.x,
+                                normal.y >= 0.0f ? minimum.y : maximum.y,
+                                normal.z >= 0.0f ? minimum.z : maximum.z);
+            if(glm::dot(normal, negative)+mPlanes[i].w < 0.0f)
+            {
+                result = TEST_INTERSECT;
+            }
+        }
+        return result;
+    }
+
     // check whether an AABB intersects the frustum
     Frustum::TestResult
     Frustum::testIntersection
@@ -4,9 +4,11 @@
 #include "Entity/BoundingBox.h"
 
 #include <glm/matrix.hpp>
+#include <optional>
 
 using glm::mat4;
 using std::reference_wrapper;
+using std::optional;
 
 namespace octronic::dream
 {
@@ -32,13 +34,22 @@ namespace octronic::dream
         };
 
         Frustum(CameraRuntime& cam);
+        /**
+         * @brief A frustum with no camera, set by updatePlanes(view, projection).
+         */
+        Frustum();
         ~Frustum();
         void updatePlanes();
+        void updatePlanes(const mat4& view, const mat4& projection);
         Frustum::TestResult testIntersection(const mat4& modelMatrix, const BoundingBox& box) const;
+        /**
+         * @brief Test a world space box given by its corners.
+         */
+        Frustum::TestResult testIntersection(const vec3& minimum, const vec3& maximum) const;
         Frustum::TestResult testIntersectionWithPlane(Plane plane, const vec3& modelPos, const BoundingBox& box) const;
 
     protected:
         vec4 mPlanes[6];
-        reference_wrapper<CameraRuntime> mCamera;
+        optional<reference_wrapper<CameraRuntime>> mCamera;
     };
 }
@@ -11,6 +11,7 @@
 
 #include "Common/GLHeader.h"
 #include "Common/Logger.h"
+#include "Common/Profiler.h"
 
 #include "Components/Cache.h"
 #include "Math/Transform.h"
@@ -22,8 +23,12 @@
 #include "Entity/EntityRuntime.h"
 
 #include "Project/ProjectRuntime.h"
+#include "Storage/StorageManager.h"
+#include "Storage/File.h"
 
+#include <algorithm>
 #include <functional>
+#include <thread>
 #include "glm/glm.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtc/type_ptr.hpp"
@@ -44,13 +49,15 @@ namespace octronic::dream
   GraphicsComponent::GraphicsComponent
   (ProjectRuntime& pr)
     : Component(),
+      // Geometry
+      mRenderQueueThreads(std::max(1u, std::thread::hardware_concurrency())),
+      mFrameDataUBO(0),
+      // Occlusion
+      mOcclusionCulling(false),
       // Shadow Pass Vars
       mShadowPassFB(0),
       mShadowPassDepthBuffer(0),
       mShadowMatrix(mat4(1.0f)),
-      // Sprite
-      mSpriteQuadVAO(0),
-      mSpriteQuadVBO(0),
       // Tasks
       mTaskQueue("GraphicsTaskQueue"),
       mDestructionTaskQueue("GraphicsDestructionTaskQueue"),
@@ -76,7 +83,8 @@ namespace octronic::dream
   {
     LOG_TRACE("GraphicsComponent: Destroying Object");
     freeShadowBuffers();
-    freeSpriteQuad();
+    mSpriteBatch.freeBuffers();
+    freeFrameDataBuffer();
   }
 
   // Init/Setup ===============================================================
@@ -127,10 +135,17 @@ namespace octronic::dream
       return false;
     }
 
-    freeSpriteQuad();
-    if (!setupSpriteQuad())
+    mSpriteBatch.freeBuffers();
+    if (!mSpriteBatch.setupBuffers())
     {
-      LOG_ERROR("GraphicsComponent: Unable to create screen quad");
+      LOG_ERROR("GraphicsComponent: Unable to create sprite batch buffers");
+      return false;
+    }
+
+    freeFrameDataBuffer();
+    if (!setupFrameDataBuffer())
+    {
+      LOG_ERROR("GraphicsComponent: Unable to create frame data buffer");
       return false;
     }
 
@@ -190,12 +205,62 @@ namespace octronic::dream
     glDepthFunc(GL_LEQUAL);
   }
 
+  // Frame Data ==============================================================
+
+  bool
+  GraphicsComponent::setupFrameDataBuffer
+  ()
+  {
+    glGenBuffers(1, &mFrameDataUBO);
+    GLCheckError();
+    glBindBuffer(GL_UNIFORM_BUFFER, mFrameDataUBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniformData), nullptr, GL_DYNAMIC_DRAW);
+    GLCheckError();
+    glBindBufferBase(GL_UNIFORM_BUFFER, ShaderRuntime::FRAME_DATA_BINDING, mFrameDataUBO);
+    GLCheckError();
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    return mFrameDataUBO != 0;
+  }
+
+  void
+  GraphicsComponent::freeFrameDataBuffer
+  ()
+  {
+    if (mFrameDataUBO > 0)
+    {
+      glDeleteBuffers(1, &mFrameDataUBO);
+      mFrameDataUBO = 0;
+    }
+  }
+
+  void
+  GraphicsComponent::updateFrameData
+  (CameraRuntime& camera)
+  {
+    if (mFrameDataUBO == 0) return;
+
+    mFrameData.projection = camera.getProjectionMatrix();
+    mFrameData.view = camera.getViewMatrix();
+    mFrameData.cameraPosition = vec4(camera.getTransform().getTranslation(), 1.f);
+    for (size_t i = 0; i < GC_LIGHT_COUNT; i++)
+    {
+      mFrameData.lightPositions[i] = vec4(mLightPositions[i], 1.f);
+      mFrameData.lightColors[i] = vec4(mLightColors[i], 1.f);
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, mFrameDataUBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameUniformData), &mFrameData);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    GLCheckError();
+  }
+
   // Environment =============================================================
 
   void
   GraphicsComponent::renderEnvironment
   (SceneRuntime& sr)
   {
+    DREAM_PROFILE_ZONE("GraphicsComponent::renderEnvironment");
     auto envShaderOpt = sr.getEnvironmentShader();
     if (!envShaderOpt || !envShaderOpt.value().get().getLoaded()) return;
 
@@ -240,14 +305,14 @@ namespace octronic::dream
   GraphicsComponent::renderModels
   (SceneRuntime& sr)
   {
+    DREAM_PROFILE_ZONE("GraphicsComponent::renderModels");
     LOG_TRACE("GraphicsComponent: {}",__FUNCTION__);
 
     auto& camera = sr.getCameraRuntime();
-    auto& shaderCache = mProjectRuntime.value().get().getShaderCache();
     auto& windowComp = mProjectRuntime.value().get().getWindowComponent();
     checkFrameBufferDimensions();
 
-    LOG_DEBUG("GraphicsComponent: ==> Running Model Render Pass");
+    LOG_TRACE("GraphicsComponent: ==> Running Model Render Pass");
 
     glBindFramebuffer(GL_FRAMEBUFFER,windowComp.getFrameBuffer());
     GLCheckError();
@@ -255,56 +320,198 @@ namespace octronic::dream
     glEnable(GL_CULL_FACE);
     glCullFace(GL_BACK);
 
-    auto envTextureOpt = sr.getEnvironmentTexture();
-    if (envTextureOpt)
+    updateFrameData(camera);
+
+    // Both vectors are kept between frames so culling does not allocate
+    sr.getEntitiesInFrustum(camera.getFrustum(), mVisibleEntities);
+    mVisibleRuntimes.clear();
+    for (auto* entity : mVisibleEntities) mVisibleRuntimes.push_back(*entity);
+
+    if (mOcclusionCulling)
     {
-      auto& envTexture = envTextureOpt.value().get();
+      updateOcclusion(camera, mVisibleRuntimes);
+    }
 
-      for (auto shaderWrapper : shaderCache.getRuntimeVector())
+    mRenderQueue.build(camera, mVisibleRuntimes, getRenderWorkers(),
+                       mOcclusionCulling ? &mOcclusionCuller : nullptr);
+    mRenderQueue.sort();
+
+    if (!mRenderQueueDumpPath.empty())
+    {
+      auto& sm = mProjectRuntime.value().get().getStorageManager();
+      auto& file = sm.openFile(mRenderQueueDumpPath);
+      if (!file.writeString(mRenderQueue.toJson().dump(2)))
       {
-        auto& shader = shaderWrapper.get();
-        LOG_DEBUG("GraphicsComponent: Rending shader {}",shader.getNameAndUuidString());
+        LOG_ERROR("GraphicsComponent: Unable to dump RenderQueue to {}", mRenderQueueDumpPath);
+      }
+      sm.closeFile(file);
+      mRenderQueueDumpPath.clear();
+    }
 
-        if (shader.countMaterials() == 0)
-        {
-          LOG_DEBUG("GraphicsComponent: Shader {} has no materials",shader.getNameAndUuidString());
-          continue;
-        }
+    submitRenderQueue(sr);
+  }
+
+  void
+  GraphicsComponent::submitRenderQueue
+  (SceneRuntime& sr)
+  {
+    DREAM_PROFILE_ZONE("GraphicsComponent::submitRenderQueue");
+    auto& camera = sr.getCameraRuntime();
+    auto envTextureOpt = sr.getEnvironmentTexture();
+    if (!envTextureOpt) return;
+
+    auto& envTexture = envTextureOpt.value().get();
+    auto& packets = mRenderQueue.getPackets();
+    ShaderRuntime* currentShader = nullptr;
+    MaterialRuntime* currentMaterial = nullptr;
+    bool shaderInUse = false;
+
+    for (auto& batch : mRenderQueue.getBatches())
+    {
+      auto& first = packets[batch.first];
+
+      if (first.shader != currentShader)
+      {
+        currentShader = first.shader;
+        currentMaterial = nullptr;
+        auto& shader = *currentShader;
+        shaderInUse = shader.use();
 
-        if(shader.use())
+        if (shaderInUse)
         {
-          LOG_INFO("GraphicsComponent: Shader {} all good, rendering geometry pass",shader.getNameAndUuidString());
-          shader.setViewMatrixUniform(camera.getViewMatrix());
-          shader.setProjectionMatrixUniform(camera.getProjectionMatrix());
-          shader.setCameraPositionUniform(camera.getTransform().getTranslation());
+          LOG_TRACE("GraphicsComponent: Shader {} all good, rendering geometry pass",shader.getNameAndUuidString());
+          // Shaders with the FrameData block read these from mFrameDataUBO
+          if (!shader.usesFrameData())
+          {
+            shader.setViewMatrixUniform(camera.getViewMatrix());
+            shader.setProjectionMatrixUniform(camera.getProjectionMatrix());
+            shader.setCameraPositionUniform(camera.getTransform().getTranslation());
+            shader.setLightPositionsUniform(&mLightPositions[0], GC_LIGHT_COUNT);
+            shader.setLightColorsUniform(&mLightColors[0], GC_LIGHT_COUNT);
+          }
 
           shader.setIrradianceTextureUniform(envTexture.getIrradianceTextureID());
           shader.setPreFilterTextureUniform(envTexture.getPreFilterTextureID());
           shader.setBrdfLutTextureUniform(envTexture.getBrdfLutTextureID());
-          shader.setLightPositionsUniform(&mLightPositions[0], 4);
-          shader.setLightColorsUniform(&mLightColors[0], 4);
+        }
+      }
 
-          for (auto& materialWrap : shader.getMaterialsVector())
-          {
-            auto& material = materialWrap.get();
-            if (material.getUsedByVector().size() == 0) continue;
-
-            shader.bindMaterial(material);
-            for (auto& modelMeshWrap : material.getUsedByVector())
-            {
-              auto& modelMesh = modelMeshWrap.get();
-
-              if (modelMesh.getLoaded())
-              {
-                modelMesh.drawModelRuntimes(camera,shader);
-              }
-            }
-          }
+      if (!shaderInUse) continue;
+
+      if (first.material != currentMaterial)
+      {
+        currentMaterial = first.material;
+        currentShader->bindMaterial(*currentMaterial);
+      }
+
+      // Batches larger than the shader's instance array take several draws
+      size_t end = batch.first + batch.count;
+      for (size_t i = batch.first; i < end; i += ShaderRuntime::MAX_RUNTIMES)
+      {
+        size_t chunkEnd = std::min(i + ShaderRuntime::MAX_RUNTIMES, end);
+        mRenderQueueRuntimes.clear();
+        for (size_t p = i; p < chunkEnd; p++)
+        {
+          mRenderQueueRuntimes.push_back(*packets[p].entity);
         }
+        first.mesh->drawRuntimes(*currentShader, mRenderQueueRuntimes, first.lod);
       }
     }
   }
 
+  RenderQueue&
+  GraphicsComponent::getRenderQueue
+  ()
+  {
+    return mRenderQueue;
+  }
+
+  void
+  GraphicsComponent::dumpRenderQueue
+  (const string& path)
+  {
+    mRenderQueueDumpPath = path;
+  }
+
+  unsigned int
+  GraphicsComponent::getRenderQueueThreads
+  ()
+  const
+  {
+    return mRenderQueueThreads;
+  }
+
+  void
+  GraphicsComponent::setRenderQueueThreads
+  (unsigned int threads)
+  {
+    threads = threads > 0 ? threads : 1;
+    if (threads != mRenderQueueThreads) mRenderWorkers.reset();
+    mRenderQueueThreads = threads;
+  }
+
+  WorkerPool*
+  GraphicsComponent::getRenderWorkers
+  ()
+  {
+    if (mRenderQueueThreads < 2) return nullptr;
+    if (!mRenderWorkers)
+    {
+      mRenderWorkers = make_unique<WorkerPool>("Render Queue", mRenderQueueThreads - 1);
+    }
+    return mRenderWorkers.get();
+  }
+
+  // Occlusion ================================================================
+
+  OcclusionCuller&
+  GraphicsComponent::getOcclusionCuller
+  ()
+  {
+    return mOcclusionCuller;
+  }
+
+  bool
+  GraphicsComponent::getOcclusionCulling
+  ()
+  const
+  {
+    return mOcclusionCulling;
+  }
+
+  void
+  GraphicsComponent::setOcclusionCulling
+  (bool enabled)
+  {
+    mOcclusionCulling = enabled;
+  }
+
+  void
+  GraphicsComponent::updateOcclusion
+  (CameraRuntime& camera,
+   const vector<reference_wrapper<EntityRuntime>>& entities)
+  {
+    DREAM_PROFILE_ZONE("GraphicsComponent::updateOcclusion");
+    mOcclusionCuller.begin(camera.getProjectionMatrix() * camera.getViewMatrix());
+
+    for (auto& entityRef : entities)
+    {
+      auto& entity = entityRef.get();
+      if (!entity.hasModelRuntime()) continue;
+      auto& model = entity.getModelRuntime();
+      if (!model.getLoaded()) continue;
+
+      mat4 matrix = entity.getTransform().getMatrix();
+      for (auto& mesh : model.getMeshView())
+      {
+        if (!mesh.isOccluder()) continue;
+        mOcclusionCuller.addOccluder(mesh.getOccluderPositions(), mesh.getOccluderIndices(), matrix);
+      }
+    }
+
+    mOcclusionCuller.rasterize(getRenderWorkers());
+  }
+
   // Shadow Pass ==============================================================
 
   bool
@@ -379,13 +586,14 @@ namespace octronic::dream
   GraphicsComponent::renderShadowPass
   (SceneRuntime& sr)
   {
+    DREAM_PROFILE_ZONE("GraphicsComponent::renderShadowPass");
     LOG_TRACE("GraphicsComponent: {}",__FUNCTION__);
 
     auto shadowPassShaderOpt = sr.getShadowPassShader();
     if (!shadowPassShaderOpt || !shadowPassShaderOpt.value().get().getLoaded()) return;
 
     auto& shaderCache = getProjectRuntime().getShaderCache();
-    LOG_DEBUG("==> Running Shadow Render Pass");
+    LOG_TRACE("==> Running Shadow Render Pass");
 
     glBindFramebuffer(GL_FRAMEBUFFER, mShadowPassFB);
     GLCheckError();
@@ -426,9 +634,8 @@ namespace octronic::dream
       {
         //shadowPassShader.value().get().setLightSpaceMatrixUniform(lightMat);
 
-        for (auto shaderWrapper : shaderCache.getRuntimeVector())
+        for (auto& shader : shaderCache.getRuntimeView())
         {
-          auto& shader = shaderWrapper.get();
           shader.drawShadowPass(shadowPassShader);
         }
       }
@@ -457,11 +664,12 @@ namespace octronic::dream
   GraphicsComponent::renderFonts
   (SceneRuntime& sceneRuntime)
   {
+    DREAM_PROFILE_ZONE("GraphicsComponent::renderFonts");
     LOG_TRACE("GraphicsComponent: {}",__FUNCTION__);
-    LOG_DEBUG("==> Running Font Pass");
+    LOG_TRACE("==> Running Font Pass");
 
     auto fontShaderOpt = sceneRuntime.getFontShader();
-    if (!fontShaderOpt || fontShaderOpt.value().get().getLoaded())
+    if (!fontShaderOpt || !fontShaderOpt.value().get().getLoaded())
     {
       LOG_ERROR("GraphicsComponent: Font shader not found");
       return;
@@ -487,81 +695,53 @@ namespace octronic::dream
 
       fontShader.setProjectionMatrixUniform(mScreenSpaceProjectionMatrix);
 
-      // Iterate through FontRuntimes
-      for (auto& fontRuntimeWrapper : fontCache.getRuntimeVector())
+      // Each FontRuntime draws all of its instances from one buffer
+      for (auto& fontRuntime : fontCache.getRuntimeView())
       {
-        auto& fontRuntime = fontRuntimeWrapper.get();
-        // Iterate through FontTextInstances
-        for (auto& entityWrapper : fontRuntime.getInstanceVector())
-        {
-          auto& entity = entityWrapper.get();
-          fontShader.setModelMatrixUniform(entity.getTransform().getMatrix());
-          GLCheckError();
-          fontShader.setColorUniform(entity.getFontColor());
-          fontShader.syncUniforms();
-          GLCheckError();
-          fontRuntime.draw(entity);
-        }
+        if (!fontRuntime.getLoaded()) continue;
+        fontRuntime.drawInstances(fontShader);
       }
     }
   }
 
   // Sprite ==================================================================
 
-  void GraphicsComponent::freeSpriteQuad()
-  {
-    if (mSpriteQuadVBO > 0) glDeleteBuffers(1,&mSpriteQuadVBO);
-    if (mSpriteQuadVAO > 0) glDeleteBuffers(1,&mSpriteQuadVAO);
-  }
-
-  bool
-  GraphicsComponent::setupSpriteQuad()
+  SpriteBatch&
+  GraphicsComponent::getSpriteBatch
+  ()
   {
-    LOG_TRACE("GraphicsComponent: {}",__FUNCTION__);
-
-    static float quadVertices[] = {
-      // positions        // texture Coords
-      -1.0f,  1.0f, 0.0f, 0.0f, 1.0f,
-      -1.0f, -1.0f, 0.0f, 0.0f, 0.0f,
-      1.0f,  1.0f, 0.0f, 1.0f, 1.0f,
-      1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
-    };
-
-    // setup plane VAO
-    glGenVertexArrays(1, &mSpriteQuadVAO);
-    GLCheckError();
-    glGenBuffers(1, &mSpriteQuadVBO);
-    GLCheckError();
-    glBindVertexArray(mSpriteQuadVAO);
-    GLCheckError();
-    glBindBuffer(GL_ARRAY_BUFFER, mSpriteQuadVBO);
-    GLCheckError();
-    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), &quadVertices, GL_STATIC_DRAW);
-    GLCheckError();
-    glEnableVertexAttribArray(0);
-    GLCheckError();
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-    GLCheckError();
-    glEnableVertexAttribArray(1);
-    GLCheckError();
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-    GLCheckError();
-    glBindVertexArray(0);
-    GLCheckError();
-    return true;
+    return mSpriteBatch;
   }
 
   void
   GraphicsComponent::renderSprites
   (SceneRuntime& sceneRuntime)
   {
+    DREAM_PROFILE_ZONE("GraphicsComponent::renderSprites");
     LOG_TRACE("GraphicsComponent: {}",__FUNCTION__);
-    LOG_DEBUG("==> Running Sprite Pass");
+    LOG_TRACE("==> Running Sprite Pass");
 
     auto shaderOpt = sceneRuntime.getSpriteShader();
     if (!shaderOpt || !shaderOpt.value().get().getLoaded()) return;
 
     auto& pr = mProjectRuntime.value().get();
+    auto& textureCache = pr.getTextureCache();
+    if (textureCache.runtimeCount() == 0) return;
+
+    mSpriteBatch.clear();
+    for (auto& textureRuntime : textureCache.getRuntimeView())
+    {
+      if (!textureRuntime.getLoaded()) continue;
+
+      for (auto& erWrapper : textureRuntime.getInstanceView())
+      {
+        auto& er = erWrapper.get();
+        mSpriteBatch.add(textureRuntime.getTextureID(), er.getTransform().getMatrix());
+      }
+    }
+    mSpriteBatch.build();
+    if (mSpriteBatch.getQuadCount() == 0) return;
+
     auto& windowComp = pr.getWindowComponent();
     windowComp.bindFrameBuffer();
 
@@ -571,34 +751,14 @@ namespace octronic::dream
     glDisable(GL_DEPTH_TEST);
     GLCheckError();
 
-    auto& textureCache = pr.getTextureCache();
-    if (textureCache.runtimeCount() == 0) return;
-
+    // Vertices are already in screen space, only the projection is needed
     auto& shader = shaderOpt.value().get();
-    // Activate the Shader
     shader.use();
     shader.setProjectionMatrixUniform(mScreenSpaceProjectionMatrix);
-    shader.bindVertexArray(mSpriteQuadVAO);
-
-    // Iterate through Textureuntimes
-    for (auto& textureRuntimeWrapper : textureCache.getRuntimeVector())
-    {
-      auto& textureRuntime = textureRuntimeWrapper.get();
-      // None
-      if (textureRuntime.getInstanceVector().empty()) continue;
-
-      glBindTexture(GL_TEXTURE_2D, textureRuntime.getTextureID());
-      GLCheckError();
+    shader.syncUniforms();
 
-      // Iterate through SpriteRuntimes
-      for (auto& erWrapper : textureRuntime.getInstanceVector())
-      {
-        auto& er = erWrapper.get();
-        shader.setModelMatrixUniform(er.getTransform().getMatrix());
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        GLCheckError();
-      }
-    }
+    mSpriteBatch.upload();
+    mSpriteBatch.draw(shader);
   }
 
   // Lights ==============================================================
@@ -669,40 +829,41 @@ namespace octronic::dream
   GraphicsComponent::pushTasks
   ()
   {
+    DREAM_PROFILE_ZONE("GraphicsComponent::pushTasks");
     auto& pr = mProjectRuntime.value().get();
     // Materials
     MaterialCache& materialCache = pr.getMaterialCache();
-    for (auto& material : materialCache.getRuntimeVector())
+    for (auto& material : materialCache.getRuntimeView())
     {
-      material.get().pushTasks();
+      material.pushTasks();
     }
 
     // Models
     ModelCache& modelCache = pr.getModelCache();
-    for (auto& model : modelCache.getRuntimeVector())
+    for (auto& model : modelCache.getRuntimeView())
     {
-      model.get().pushTasks();
+      model.pushTasks();
     }
 
     // Shaders
     ShaderCache& shaderCache = pr.getShaderCache();
-    for (auto& shader : shaderCache.getRuntimeVector())
+    for (auto& shader : shaderCache.getRuntimeView())
     {
-      shader.get().pushTasks();
+      shader.pushTasks();
     }
 
     // Textures
     TextureCache& textureCache = pr.getTextureCache();
-    for (auto& texture : textureCache.getRuntimeVector())
+    for (auto& texture : textureCache.getRuntimeView())
     {
-      texture.get().pushTasks();
+      texture.pushTasks();
     }
 
     // Fonts
     FontCache& fontCache = pr.getFontCache();
-    for (auto& font : fontCache.getRuntimeVector())
+    for (auto& font : fontCache.getRuntimeView())
     {
-      font.get().pushTasks();
+      font.pushTasks();
     }
 
     // This
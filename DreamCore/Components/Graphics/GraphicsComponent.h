@@ -3,7 +3,11 @@
 #include "Common/GLHeader.h"
 #include "Components/Component.h"
 #include "GraphicsComponentTasks.h"
+#include "RenderQueue.h"
+#include "OcclusionCuller.h"
+#include "SpriteBatch.h"
 #include "Task/TaskQueue.h"
+#include "Common/WorkerPool.h"
 
 #include <glm/matrix.hpp>
 #include <string>
@@ -13,8 +17,11 @@
 
 using glm::mat4;
 using glm::vec3;
+using glm::vec4;
 using std::vector;
 using std::shared_ptr;
+using std::unique_ptr;
+using std::string;
 
 #define GC_LIGHT_COUNT 4
 #define SHADOW_SIZE  1024
@@ -25,10 +32,24 @@ namespace octronic::dream
   class ModelRuntime;
   class ShaderRuntime;
   class SceneRuntime;
+  class CameraRuntime;
   class EntityRuntime;
   class MaterialRuntime;
   class ShaderRuntime;
 
+  /**
+   * @brief Per frame data shared by every shader through the std140
+   * FrameData uniform block. vec3s are padded to vec4 to match std140.
+   */
+  struct FrameUniformData
+  {
+    mat4 projection;
+    mat4 view;
+    vec4 cameraPosition;
+    vec4 lightPositions[GC_LIGHT_COUNT];
+    vec4 lightColors[GC_LIGHT_COUNT];
+  };
+
   typedef TaskQueue<GraphicsTask> GraphicsTaskQueue;
   typedef TaskQueue<GraphicsDestructionTask> GraphicsDestructionTaskQueue;
   /**
@@ -46,12 +67,17 @@ namespace octronic::dream
      *
      *
      * 2. Geometry Pass:
-     * 		- Renders all 3D objects using GL instanced rendering, arranged
-     *        hierarchally to minimise shader/material/buffer switching.
+     * 		- Renders all 3D objects using GL instanced rendering. Visible
+     *        meshes are culled into a RenderQueue and radix sorted by
+     *        pass, shader, material, mesh and depth to minimise
+     *        shader/material/buffer switching. With occlusion culling on,
+     *        occluder models are first rasterized on the CPU and meshes
+     *        hidden behind them are left out of the queue.
      *
-     *        For All meshes
-     *        	Render All Meshes that use the same Shader, then switch to next shader
-     *        		Render All Meshes that use the same Material, then switch to next Material
+     *        For All sorted batches
+     *        	Switch Shader when it differs from the last batch
+     *        		Switch Material when it differs from the last batch
+     *        			Draw the batch's instances of its mesh
      *
      *        The resulting buffers are passed to the lighting shader
      *
@@ -59,12 +85,14 @@ namespace octronic::dream
      * 4. Sprite Rendering
      * 		- After the 3D scene has been rendered and lit, 2D elements are drawn
      *        on top. The TextureCache's Runtimes are iterated and all instances of
-     *        sprites are drawn to the screen in screen-space.
+     *        sprites are added to a SpriteBatch, which is uploaded once and
+     *        drawn to the screen in screen-space with one call per texture.
      *
      * 5. Font Rendering
      * 		- After the 3D scene & sprites have been rendered, Font instances are
-     *        drawn on top. The FontRuntime cache is iterated and all instances of
-     *        text are drawn to the screen in screen-space.
+     *        drawn on top. The FontRuntime cache is iterated and each font
+     *        draws all of its text instances from one cached vertex buffer
+     *        in screen-space.
      */
   class GraphicsComponent : public Component
   {
@@ -79,6 +107,28 @@ namespace octronic::dream
     void clearBuffers(SceneRuntime& sr);
     // Geometry ============================================================
     void renderModels(SceneRuntime&);
+    RenderQueue& getRenderQueue();
+    /**
+     * @brief Write the next frame's sorted RenderQueue to path as json.
+     */
+    void dumpRenderQueue(const string& path);
+    unsigned int getRenderQueueThreads() const;
+    /**
+     * @brief Threads used to build the RenderQueue, including the render
+     * thread. The extra threads are kept in a WorkerPool between frames.
+     */
+    void setRenderQueueThreads(unsigned int threads);
+    bool setupFrameDataBuffer();
+    void freeFrameDataBuffer();
+    /**
+     * @brief Upload the camera and light data to the FrameData uniform
+     * buffer, once per frame before any pass is drawn.
+     */
+    void updateFrameData(CameraRuntime& camera);
+    // Occlusion ===========================================================
+    OcclusionCuller& getOcclusionCuller();
+    bool getOcclusionCulling() const;
+    void setOcclusionCulling(bool enabled);
     // Environment =========================================================
     void renderEnvironment(SceneRuntime&);
     // Shadow ==============================================================
@@ -88,8 +138,7 @@ namespace octronic::dream
     GLuint getShadowPassDepthBuffer() const;
     // Sprite ===============================================================
     void renderSprites(SceneRuntime& sceneRuntime);
-    bool setupSpriteQuad();
-    void freeSpriteQuad();
+    SpriteBatch& getSpriteBatch();
     // Font ================================================================
     void renderFonts(SceneRuntime& sceneRuntime);
     // Task ================================================================
@@ -109,8 +158,29 @@ namespace octronic::dream
 
   protected:
     void checkFrameBufferDimensions();
+    void submitRenderQueue(SceneRuntime&);
+    void updateOcclusion(CameraRuntime& camera,
+                         const vector<reference_wrapper<EntityRuntime>>& entities);
+    /**
+     * @brief The pool of threads working alongside the render thread, or
+     * nullptr when only one thread is wanted. Started on first use.
+     */
+    WorkerPool* getRenderWorkers();
 
   private:
+    // Geometry ============================================================
+    RenderQueue mRenderQueue;
+    vector<reference_wrapper<EntityRuntime>> mRenderQueueRuntimes;
+    vector<EntityRuntime*> mVisibleEntities;
+    vector<reference_wrapper<EntityRuntime>> mVisibleRuntimes;
+    unsigned int mRenderQueueThreads;
+    unique_ptr<WorkerPool> mRenderWorkers;
+    string mRenderQueueDumpPath;
+    GLuint mFrameDataUBO;
+    FrameUniformData mFrameData;
+    // Occlusion ===========================================================
+    OcclusionCuller mOcclusionCuller;
+    bool mOcclusionCulling;
     // Shadow ==============================================================
     optional<reference_wrapper<EntityRuntime>> mShadowLight;
     GLuint mShadowPassFB;
@@ -118,8 +188,7 @@ namespace octronic::dream
     mat4 mShadowMatrix;
     // Font & Sprite =======================================================
     mat4 mScreenSpaceProjectionMatrix;
-    GLuint mSpriteQuadVAO;
-    GLuint mSpriteQuadVBO;
+    SpriteBatch mSpriteBatch;
     // Task ================================================================
     GraphicsTaskQueue mTaskQueue;
     GraphicsDestructionTaskQueue mDestructionTaskQueue;
@@ -0,0 +1,206 @@
+#include "MeshOptimizer.h"
+
+#include "Common/Logger.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace octronic::dream
+{
+  const size_t MeshOptimizer::VERTEX_CACHE_SIZE = 32;
+
+  namespace
+  {
+    // Forsyth's tuning constants
+    const float CACHE_DECAY_POWER = 1.5f;
+    const float LAST_TRIANGLE_SCORE = 0.75f;
+    const float VALENCE_BOOST_SCALE = 2.0f;
+    const float VALENCE_BOOST_POWER = 0.5f;
+
+    struct VertexState
+    {
+      int cachePosition = -1;
+      float score = 0.f;
+      // Triangles not yet emitted
+      vector<size_t> triangles;
+    };
+
+    float
+    VertexScore
+    (const VertexState& v, size_t cacheSize)
+    {
+      if (v.triangles.empty()) return -1.f;
+
+      float score = 0.f;
+      if (v.cachePosition >= 0)
+      {
+        if (v.cachePosition < 3)
+        {
+          // Vertices of the triangle just emitted
+          score = LAST_TRIANGLE_SCORE;
+        }
+        else
+        {
+          float scale = 1.f / (cacheSize - 3);
+          score = std::pow(1.f - (v.cachePosition - 3) * scale, CACHE_DECAY_POWER);
+        }
+      }
+
+      // Favour finishing off vertices with few triangles left
+      score += VALENCE_BOOST_SCALE * std::pow(static_cast<float>(v.triangles.size()), -VALENCE_BOOST_POWER);
+      return score;
+    }
+  }
+
+  vector<GLuint>
+  MeshOptimizer::OptimizeVertexCache
+  (const vector<GLuint>& indices, size_t vertexCount)
+  {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2) return indices;
+
+    vector<VertexState> vertices(vertexCount);
+    for (size_t t = 0; t < triangleCount; t++)
+    {
+      for (size_t k = 0; k < 3; k++)
+      {
+        GLuint v = indices[t*3+k];
+        if (v >= vertexCount) return indices;
+        vertices[v].triangles.push_back(t);
+      }
+    }
+
+    for (auto& v : vertices) v.score = VertexScore(v, VERTEX_CACHE_SIZE);
+
+    vector<float> triangleScores(triangleCount);
+    vector<bool> emitted(triangleCount, false);
+    for (size_t t = 0; t < triangleCount; t++)
+    {
+      triangleScores[t] = vertices[indices[t*3]].score +
+                          vertices[indices[t*3+1]].score +
+                          vertices[indices[t*3+2]].score;
+    }
+
+    vector<GLuint> result;
+    result.reserve(triangleCount * 3);
+    vector<GLuint> cache;
+    cache.reserve(VERTEX_CACHE_SIZE + 3);
+
+    size_t best = std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin();
+    size_t cursor = 0;
+
+    for (size_t emittedCount = 0; emittedCount < triangleCount; emittedCount++)
+    {
+      if (best == triangleCount)
+      {
+        // Nothing left touching the cache, take the next unemitted triangle
+        while (emitted[cursor]) cursor++;
+        best = cursor;
+      }
+
+      emitted[best] = true;
+      GLuint tri[3] = {indices[best*3], indices[best*3+1], indices[best*3+2]};
+
+      for (GLuint v : tri)
+      {
+        result.push_back(v);
+        auto& triangles = vertices[v].triangles;
+        triangles.erase(std::find(triangles.begin(), triangles.end(), best));
+
+        auto itr = std::find(cache.begin(), cache.end(), v);
+        if (itr != cache.end()) cache.erase(itr);
+      }
+      cache.insert(cache.begin(), tri, tri + 3);
+
+      // Rescore everything in the cache, including what just fell out
+      for (size_t i = 0; i < cache.size(); i++)
+      {
+        vertices[cache[i]].cachePosition = i < VERTEX_CACHE_SIZE ? static_cast<int>(i) : -1;
+      }
+
+      best = triangleCount;
+      float bestScore = -1.f;
+      for (GLuint v : cache)
+      {
+        auto& state = vertices[v];
+        float newScore = VertexScore(state, VERTEX_CACHE_SIZE);
+        float delta = newScore - state.score;
+        state.score = newScore;
+
+        for (size_t t : state.triangles)
+        {
+          triangleScores[t] += delta;
+        }
+      }
+
+      for (size_t i = 0; i < std::min(cache.size(), VERTEX_CACHE_SIZE); i++)
+      {
+        for (size_t t : vertices[cache[i]].triangles)
+        {
+          if (triangleScores[t] > bestScore)
+          {
+            bestScore = triangleScores[t];
+            best = t;
+          }
+        }
+      }
+
+      if (cache.size() > VERTEX_CACHE_SIZE) cache.resize(VERTEX_CACHE_SIZE);
+    }
+
+    return result;
+  }
+
+  void
+  MeshOptimizer::OptimizeVertexFetch
+  (vector<Vertex>& vertices, vector<GLuint>& indices)
+  {
+    const GLuint unused = static_cast<GLuint>(-1);
+    vector<GLuint> remap(vertices.size(), unused);
+    vector<Vertex> reordered;
+    reordered.reserve(vertices.size());
+
+    for (GLuint& index : indices)
+    {
+      if (index >= vertices.size()) continue;
+      if (remap[index] == unused)
+      {
+        remap[index] = static_cast<GLuint>(reordered.size());
+        reordered.push_back(vertices[index]);
+      }
+      index = remap[index];
+    }
+
+    if (reordered.size() < vertices.size())
+    {
+      LOG_DEBUG("MeshOptimizer: Dropped {} unused vertices", vertices.size() - reordered.size());
+    }
+    vertices.swap(reordered);
+  }
+
+  float
+  MeshOptimizer::AverageCacheMissRatio
+  (const vector<GLuint>& indices, size_t vertexCount, size_t cacheSize)
+  {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return 0.f;
+
+    // Entry time of each vertex in a FIFO cache
+    vector<size_t> insertedAt(vertexCount, 0);
+    vector<bool> everCached(vertexCount, false);
+    size_t time = 0;
+    size_t misses = 0;
+
+    for (GLuint v : indices)
+    {
+      if (v >= vertexCount) continue;
+      if (!everCached[v] || time - insertedAt[v] >= cacheSize)
+      {
+        misses++;
+        insertedAt[v] = time++;
+        everCached[v] = true;
+      }
+    }
+    return static_cast<float>(misses) / triangleCount;
+  }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Common/GLHeader.h"
+#include "Components/Graphics/Vertex.h"
+
+#include <vector>
+
+using std::vector;
+
+namespace octronic::dream
+{
+  /**
+   * @brief Reorders mesh data for the GPU without changing what is drawn.
+   *
+   * Triangles are reordered with Forsyth's linear speed vertex cache
+   * optimisation so consecutive triangles reuse recently transformed
+   * vertices, then vertices are reordered by first use so the vertex
+   * fetch walks the buffer front to back.
+   */
+  class MeshOptimizer
+  {
+  public:
+    /**
+     * @brief Size of the simulated post transform vertex cache.
+     */
+    const static size_t VERTEX_CACHE_SIZE;
+
+    /**
+     * @brief Reorder a triangle list for vertex cache reuse.
+     */
+    static vector<GLuint> OptimizeVertexCache(const vector<GLuint>& indices, size_t vertexCount);
+
+    /**
+     * @brief Reorder vertices by first use in indices, rewriting indices
+     * in place. Vertices no index refers to are dropped.
+     */
+    static void OptimizeVertexFetch(vector<Vertex>& vertices, vector<GLuint>& indices);
+
+    /**
+     * @brief Average transformed vertices per triangle through a FIFO
+     * cache of cacheSize, 3 with no reuse and 0.5 at best.
+     */
+    static float AverageCacheMissRatio(const vector<GLuint>& indices, size_t vertexCount,
+                                       size_t cacheSize = VERTEX_CACHE_SIZE);
+  };
+}
@@ -0,0 +1,324 @@
+#include "MeshSimplifier.h"
+
+#include "Common/Logger.h"
+
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+
+using std::priority_queue;
+using std::unordered_map;
+using glm::dot;
+using glm::cross;
+using glm::length;
+
+namespace octronic::dream
+{
+  const double MeshSimplifier::BORDER_WEIGHT = 1000.0;
+
+  namespace
+  {
+    // Symmetric 4x4 plane quadric, upper triangle only
+    struct Quadric
+    {
+      double a2 = 0, ab = 0, ac = 0, ad = 0;
+      double b2 = 0, bc = 0, bd = 0;
+      double c2 = 0, cd = 0;
+      double d2 = 0;
+
+      void
+      addPlane
+      (double a, double b, double c, double d, double w)
+      {
+        a2 += w*a*a; ab += w*a*b; ac += w*a*c; ad += w*a*d;
+        b2 += w*b*b; bc += w*b*c; bd += w*b*d;
+        c2 += w*c*c; cd += w*c*d;
+        d2 += w*d*d;
+      }
+
+      void
+      add
+      (const Quadric& o)
+      {
+        a2 += o.a2; ab += o.ab; ac += o.ac; ad += o.ad;
+        b2 += o.b2; bc += o.bc; bd += o.bd;
+        c2 += o.c2; cd += o.cd;
+        d2 += o.d2;
+      }
+
+      double
+      error
+      (const vec3& v)
+      const
+      {
+        double x = v.x, y = v.y, z = v.z;
+        return a2*x*x + 2*ab*x*y + 2*ac*x*z + 2*ad*x
+                      +   b2*y*y + 2*bc*y*z + 2*bd*y
+                                 +   c2*z*z + 2*cd*z
+                                            +   d2;
+      }
+    };
+
+    struct Collapse
+    {
+      double cost;
+      GLuint from;
+      GLuint to;
+      unsigned int fromVersion;
+      unsigned int toVersion;
+
+      bool operator>(const Collapse& o) const { return cost > o.cost; }
+    };
+
+    struct PositionHash
+    {
+      size_t
+      operator()
+      (const vec3& p)
+      const
+      {
+        // Adding zero turns -0 into +0, which compare equal
+        vec3 q = p + vec3(0.f);
+        uint32_t bits[3];
+        memcpy(bits, &q, sizeof(bits));
+        return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+      }
+    };
+
+    uint64_t
+    EdgeKey
+    (GLuint a, GLuint b)
+    {
+      return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+    }
+  }
+
+  vector<GLuint>
+  MeshSimplifier::Simplify
+  (const vector<Vertex>& vertices, const vector<GLuint>& indices,
+   float ratio, double maxError)
+  {
+    const size_t triangleCount = indices.size() / 3;
+    const size_t target = static_cast<size_t>(triangleCount * ratio);
+    if (ratio >= 1.f || triangleCount == 0 || target >= triangleCount)
+    {
+      return indices;
+    }
+
+    // Weld vertices sharing a position so seams collapse together
+    vector<GLuint> positionOf(vertices.size());
+    vector<vec3> positions;
+    vector<vector<GLuint>> verticesAt;
+    unordered_map<vec3, GLuint, PositionHash> positionIds;
+    for (size_t v = 0; v < vertices.size(); v++)
+    {
+      auto itr = positionIds.find(vertices[v].Position);
+      if (itr == positionIds.end())
+      {
+        itr = positionIds.emplace(vertices[v].Position, static_cast<GLuint>(positions.size())).first;
+        positions.push_back(vertices[v].Position);
+        verticesAt.emplace_back();
+      }
+      positionOf[v] = itr->second;
+      verticesAt[itr->second].push_back(static_cast<GLuint>(v));
+    }
+
+    const size_t positionCount = positions.size();
+    vector<GLuint> corners(indices);
+    vector<bool> triangleAlive(triangleCount, true);
+    vector<vector<size_t>> trianglesAt(positionCount);
+    vector<Quadric> quadrics(positionCount);
+    vector<GLuint> collapsedTo(positionCount);
+    vector<unsigned int> version(positionCount, 0);
+    unordered_map<uint64_t, int> edgeUse;
+
+    for (GLuint p = 0; p < positionCount; p++) collapsedTo[p] = p;
+
+    auto cornerPosition = [&](size_t corner) { return positionOf[corners[corner]]; };
+
+    // Surface quadrics, area weighted
+    for (size_t t = 0; t < triangleCount; t++)
+    {
+      GLuint p0 = cornerPosition(t*3), p1 = cornerPosition(t*3+1), p2 = cornerPosition(t*3+2);
+      if (p0 == p1 || p1 == p2 || p0 == p2)
+      {
+        triangleAlive[t] = false;
+        continue;
+      }
+
+      vec3 n = cross(positions[p1] - positions[p0], positions[p2] - positions[p0]);
+      float area = length(n);
+      if (area > 0.f) n /= area;
+      double d = -dot(n, positions[p0]);
+
+      for (GLuint p : {p0, p1, p2})
+      {
+        quadrics[p].addPlane(n.x, n.y, n.z, d, area);
+        trianglesAt[p].push_back(t);
+      }
+
+      edgeUse[EdgeKey(p0, p1)]++;
+      edgeUse[EdgeKey(p1, p2)]++;
+      edgeUse[EdgeKey(p2, p0)]++;
+    }
+
+    // Border edges get a plane perpendicular to their face
+    for (size_t t = 0; t < triangleCount; t++)
+    {
+      if (!triangleAlive[t]) continue;
+      GLuint p[3] = {cornerPosition(t*3), cornerPosition(t*3+1), cornerPosition(t*3+2)};
+      vec3 n = cross(positions[p[1]] - positions[p[0]], positions[p[2]] - positions[p[0]]);
+
+      for (int e = 0; e < 3; e++)
+      {
+        GLuint a = p[e], b = p[(e+1)%3];
+        if (edgeUse[EdgeKey(a, b)] != 1) continue;
+
+        vec3 edge = positions[b] - positions[a];
+        vec3 bn = cross(edge, n);
+        float len = length(bn);
+        if (len <= 0.f) continue;
+        bn /= len;
+        double d = -dot(bn, positions[a]);
+        double w = BORDER_WEIGHT * dot(edge, edge);
+        quadrics[a].addPlane(bn.x, bn.y, bn.z, d, w);
+        quadrics[b].addPlane(bn.x, bn.y, bn.z, d, w);
+      }
+    }
+
+    priority_queue<Collapse, vector<Collapse>, std::greater<Collapse>> heap;
+
+    auto pushCollapse = [&](GLuint from, GLuint to)
+    {
+      Quadric q = quadrics[from];
+      q.add(quadrics[to]);
+      heap.push({q.error(positions[to]), from, to, version[from], version[to]});
+    };
+
+    for (auto& edge : edgeUse)
+    {
+      GLuint a = static_cast<GLuint>(edge.first >> 32);
+      GLuint b = static_cast<GLuint>(edge.first & 0xFFFFFFFF);
+      pushCollapse(a, b);
+      pushCollapse(b, a);
+    }
+
+    size_t aliveCount = 0;
+    for (bool alive : triangleAlive) if (alive) aliveCount++;
+
+    auto resolve = [&](GLuint p)
+    {
+      while (collapsedTo[p] != p) p = collapsedTo[p];
+      return p;
+    };
+
+    while (aliveCount > target && !heap.empty())
+    {
+      Collapse c = heap.top();
+      heap.pop();
+
+      if (c.fromVersion != version[c.from] || c.toVersion != version[c.to]) continue;
+      if (collapsedTo[c.from] != c.from || collapsedTo[c.to] != c.to) continue;
+      if (maxError > 0.0 && c.cost > maxError) break;
+
+      // Reject collapses that flip or degenerate a surviving triangle
+      bool valid = true;
+      bool sharesEdge = false;
+      for (size_t t : trianglesAt[c.from])
+      {
+        if (!triangleAlive[t]) continue;
+        GLuint p[3] = {resolve(cornerPosition(t*3)), resolve(cornerPosition(t*3+1)), resolve(cornerPosition(t*3+2))};
+        if (p[0] == c.to || p[1] == c.to || p[2] == c.to)
+        {
+          sharesEdge = true;
+          continue;
+        }
+
+        vec3 before = cross(positions[p[1]] - positions[p[0]], positions[p[2]] - positions[p[0]]);
+        for (GLuint& q : p) if (q == c.from) q = c.to;
+        vec3 after = cross(positions[p[1]] - positions[p[0]], positions[p[2]] - positions[p[0]]);
+        if (dot(before, after) <= 0.f || length(after) <= 1e-12f)
+        {
+          valid = false;
+          break;
+        }
+      }
+      if (!valid || !sharesEdge) continue;
+
+      // Collapse
+      collapsedTo[c.from] = c.to;
+      quadrics[c.to].add(quadrics[c.from]);
+      version[c.to]++;
+
+      for (size_t t : trianglesAt[c.from])
+      {
+        if (!triangleAlive[t]) continue;
+        bool hasTo = false;
+        for (int k = 0; k < 3; k++)
+        {
+          GLuint p = resolve(cornerPosition(t*3+k));
+          if (p == c.to && positionOf[corners[t*3+k]] != c.from) hasTo = true;
+        }
+
+        if (hasTo)
+        {
+          triangleAlive[t] = false;
+          aliveCount--;
+          continue;
+        }
+
+        // Move the corner to the vertex at the new position with the
+        // closest texture coordinate, keeping UV seams intact
+        for (int k = 0; k < 3; k++)
+        {
+          GLuint& corner = corners[t*3+k];
+          if (resolve(positionOf[corner]) != c.to || positionOf[corner] == c.to) continue;
+          vec2 uv = vertices[corner].TexCoords;
+          GLuint best = verticesAt[c.to].front();
+          float bestDistance = length(vertices[best].TexCoords - uv);
+          for (GLuint v : verticesAt[c.to])
+          {
+            float distance = length(vertices[v].TexCoords - uv);
+            if (distance < bestDistance)
+            {
+              best = v;
+              bestDistance = distance;
+            }
+          }
+          corner = best;
+        }
+        trianglesAt[c.to].push_back(t);
+      }
+      trianglesAt[c.from].clear();
+
+      // Re-cost every edge around the merged vertex
+      for (size_t t : trianglesAt[c.to])
+      {
+        if (!triangleAlive[t]) continue;
+        for (int k = 0; k < 3; k++)
+        {
+          GLuint p = resolve(cornerPosition(t*3+k));
+          if (p == c.to) continue;
+          pushCollapse(c.to, p);
+          pushCollapse(p, c.to);
+        }
+      }
+    }
+
+    vector<GLuint> result;
+    result.reserve(aliveCount * 3);
+    for (size_t t = 0; t < triangleCount; t++)
+    {
+      if (!triangleAlive[t]) continue;
+      result.push_back(corners[t*3]);
+      result.push_back(corners[t*3+1]);
+      result.push_back(corners[t*3+2]);
+    }
+
+    LOG_DEBUG("MeshSimplifier: Simplified {} triangles to {} (target {})",
+              triangleCount, aliveCount, target);
+    return result;
+  }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Common/GLHeader.h"
+#include "Components/Graphics/Vertex.h"
+
+#include <vector>
+
+using std::vector;
+
+namespace octronic::dream
+{
+  /**
+   * @brief Quadric error metric mesh simplification by half edge collapse.
+   *
+   * Vertices are only ever collapsed onto existing vertices, so the result
+   * is a new index list over the unchanged vertex array and every level of
+   * detail can share the original vertex buffer. Vertices at the same
+   * position (UV seams, hard edges) are collapsed together. Open borders
+   * are weighted to hold their shape, and collapses that would flip a
+   * triangle are rejected.
+   */
+  class MeshSimplifier
+  {
+  public:
+    /**
+     * @brief Error weight of the planes added along open borders,
+     * relative to the surface planes.
+     */
+    const static double BORDER_WEIGHT;
+
+    /**
+     * @brief Simplify a triangle list down to ratio of its triangles, or
+     * as close as can be reached without flipping faces.
+     * @param maxError Stop once the cheapest collapse costs more than this.
+     */
+    static vector<GLuint> Simplify(const vector<Vertex>& vertices,
+                                   const vector<GLuint>& indices,
+                                   float ratio, double maxError = 0.0);
+  };
+}
@@ -111,4 +111,98 @@ namespace octronic::dream
     }
     return Uuid::INVALID;
   }
+
+  vector<ModelLodLevel>
+  ModelDefinition::getLodLevels
+  ()
+  const
+  {
+    vector<ModelLodLevel> levels;
+    if (mJson.find(Constants::ASSET_ATTR_MODEL_LOD_LIST) == mJson.end())
+    {
+      return levels;
+    }
+
+    for (auto& levelJs : mJson[Constants::ASSET_ATTR_MODEL_LOD_LIST])
+    {
+      if (!levelJs.is_object()) continue;
+      ModelLodLevel level;
+      level.screenSize = levelJs.value(Constants::ASSET_ATTR_MODEL_LOD_SCREEN_SIZE, 0.f);
+      level.ratio = levelJs.value(Constants::ASSET_ATTR_MODEL_LOD_RATIO, 1.f);
+      levels.push_back(level);
+    }
+    return levels;
+  }
+
+  void
+  ModelDefinition::addLodLevel
+  (float screenSize, float ratio)
+  {
+    if (mJson.find(Constants::ASSET_ATTR_MODEL_LOD_LIST) == mJson.end())
+    {
+      mJson[Constants::ASSET_ATTR_MODEL_LOD_LIST] = json::array();
+    }
+
+    auto levelJs = json::object();
+    levelJs[Constants::ASSET_ATTR_MODEL_LOD_SCREEN_SIZE] = screenSize;
+    levelJs[Constants::ASSET_ATTR_MODEL_LOD_RATIO] = ratio;
+    mJson[Constants::ASSET_ATTR_MODEL_LOD_LIST].push_back(levelJs);
+  }
+
+  void
+  ModelDefinition::removeLodLevel
+  (size_t index)
+  {
+    if (mJson.find(Constants::ASSET_ATTR_MODEL_LOD_LIST) == mJson.end()) return;
+    auto& levels = mJson[Constants::ASSET_ATTR_MODEL_LOD_LIST];
+    if (index < levels.size())
+    {
+      levels.erase(index);
+    }
+  }
+
+  void
+  ModelDefinition::clearLodLevels
+  ()
+  {
+    mJson[Constants::ASSET_ATTR_MODEL_LOD_LIST] = json::array();
+  }
+
+  bool
+  ModelDefinition::getOccluder
+  ()
+  const
+  {
+    if (mJson.find(Constants::ASSET_ATTR_MODEL_OCCLUDER) == mJson.end())
+    {
+      return false;
+    }
+    return mJson[Constants::ASSET_ATTR_MODEL_OCCLUDER];
+  }
+
+  void
+  ModelDefinition::setOccluder
+  (bool occluder)
+  {
+    mJson[Constants::ASSET_ATTR_MODEL_OCCLUDER] = occluder;
+  }
+
+  bool
+  ModelDefinition::getCompactVertices
+  ()
+  const
+  {
+    if (mJson.find(Constants::ASSET_ATTR_MODEL_COMPACT_VERTICES) == mJson.end())
+    {
+      return false;
+    }
+    return mJson[Constants::ASSET_ATTR_MODEL_COMPACT_VERTICES];
+  }
+
+  void
+  ModelDefinition::setCompactVertices
+  (bool compact)
+  {
+    mJson[Constants::ASSET_ATTR_MODEL_COMPACT_VERTICES] = compact;
+  }
 }
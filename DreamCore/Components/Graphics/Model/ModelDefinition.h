@@ -4,6 +4,18 @@
 
 namespace octronic::dream
 {
+    /**
+     * @brief A level of detail below full detail. Levels are used once
+     * the mesh covers less than screenSize of the screen height, either
+     * authored as meshes named <mesh>_LOD<n> in the model file or
+     * generated by simplifying to ratio of the full detail triangles.
+     */
+    struct ModelLodLevel
+    {
+        float screenSize;
+        float ratio;
+    };
+
     class ModelDefinition : public AssetDefinition
     {
     public:
@@ -19,5 +31,27 @@ namespace octronic::dream
         void removeModelMaterial(const string& material);
         void clearModelMaterialList();
         UuidType getDreamMaterialForModelMaterial(const string& mat);
+
+        /**
+         * @brief LOD levels 1 and up, in order of decreasing screen size.
+         */
+        vector<ModelLodLevel> getLodLevels() const;
+        void addLodLevel(float screenSize, float ratio);
+        void removeLodLevel(size_t index);
+        void clearLodLevels();
+
+        /**
+         * @brief Occluder models are rasterized into the software depth
+         * buffer to hide what is behind them, see OcclusionCuller.
+         */
+        bool getOccluder() const;
+        void setOccluder(bool occluder);
+
+        /**
+         * @brief Upload meshes as 16 byte CompactVertex rather than 32
+         * byte Vertex, trading some precision for bandwidth.
+         */
+        bool getCompactVertices() const;
+        void setCompactVertices(bool compact);
     };
 }
@@ -1,5 +1,6 @@
 #include "ModelMesh.h"
 
+#include "MeshOptimizer.h"
 #include "ModelRuntime.h"
 #include "ModelTasks.h"
 #include "Common/Logger.h"
@@ -9,6 +10,9 @@
 #include "Entity/EntityRuntime.h"
 #include "Project/ProjectRuntime.h"
 
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+
 using std::make_shared;
 
 namespace octronic::dream
@@ -31,9 +35,17 @@ namespace octronic::dream
       mVerticesCount(vertices.size()),
       mIndicesCount(indices.size()),
       mBoundingBox(bb),
+      mCompactVertices(false),
+      mVertexTransform(1.f),
+      mIndexType(GL_UNSIGNED_INT),
+      mIndexSize(sizeof(GLuint)),
       mLoaded(false)
   {
     LOG_TRACE("ModelMesh: Constructing Mesh for {}", getParent().getName());
+    ModelMeshLod full;
+    full.indexCount = indices.size();
+    mLods.push_back(full);
+
     if (mMaterial)
     {
       auto& material = mMaterial.value().get();
@@ -73,9 +85,8 @@ namespace octronic::dream
     auto& pRunt = model.getProjectRuntime();
     auto& materialCache = pRunt.getMaterialCache();
 
-    for (auto mtlWrap : materialCache.getRuntimeVector())
+    for (auto& mtl : materialCache.getRuntimeView())
     {
-     auto& mtl = mtlWrap.get();
      mtl.removeMesh(*this);
     }
   }
@@ -105,14 +116,118 @@ namespace octronic::dream
   ModelMesh::getIndices
   () const
   {
-    return mIndices;
+    auto& full = mLods.front();
+    if (mIndices.size() < full.indexCount) return mIndices;
+    return vector<GLuint>(mIndices.begin(), mIndices.begin() + full.indexCount);
+  }
+
+  // LOD =====================================================================
+
+  bool
+  ModelMesh::addLod
+  (const vector<GLuint>& indices, float screenSize)
+  {
+    if (mLoaded)
+    {
+      LOG_ERROR("ModelMesh: Cannot add a LOD to {} after it is loaded", getName());
+      return false;
+    }
+
+    if (mLods.size() >= MAX_LOD_LEVELS)
+    {
+      LOG_ERROR("ModelMesh: {} already has {} LOD levels", getName(), MAX_LOD_LEVELS);
+      return false;
+    }
+
+    if (screenSize >= mLods.back().screenSize)
+    {
+      LOG_ERROR("ModelMesh: LOD screen sizes of {} must decrease, {} >= {}",
+                getName(), screenSize, mLods.back().screenSize);
+      return false;
+    }
+
+    ModelMeshLod lod;
+    lod.screenSize = screenSize;
+    lod.indexOffset = mIndices.size();
+    lod.indexCount = indices.size();
+    mIndices.insert(mIndices.end(), indices.begin(), indices.end());
+    mIndicesCount = mIndices.size();
+    mLods.push_back(lod);
+
+    LOG_DEBUG("ModelMesh: {} LOD {} has {} triangles at screen size {}",
+              getName(), mLods.size()-1, lod.indexCount/3, screenSize);
+    return true;
+  }
+
+  bool
+  ModelMesh::addLod
+  (const vector<Vertex>& vertices, const vector<GLuint>& indices, float screenSize)
+  {
+    GLuint base = static_cast<GLuint>(mVertices.size());
+    vector<GLuint> offsetIndices(indices);
+    for (GLuint& index : offsetIndices) index += base;
+
+    if (!addLod(offsetIndices, screenSize)) return false;
+
+    mVertices.insert(mVertices.end(), vertices.begin(), vertices.end());
+    mVerticesCount = mVertices.size();
+    return true;
+  }
+
+  size_t
+  ModelMesh::getLodCount
+  ()
+  const
+  {
+    return mLods.size();
+  }
+
+  const ModelMeshLod&
+  ModelMesh::getLod
+  (size_t lod)
+  const
+  {
+    return mLods[lod < mLods.size() ? lod : mLods.size()-1];
+  }
+
+  size_t
+  ModelMesh::selectLod
+  (float screenSize)
+  const
+  {
+    size_t lod = 0;
+    while (lod+1 < mLods.size() && screenSize < mLods[lod+1].screenSize)
+    {
+      lod++;
+    }
+    return lod;
+  }
+
+  float
+  ModelMesh::getScreenSize
+  (const CameraRuntime& camera, const mat4& transform)
+  const
+  {
+    vec3 min = mBoundingBox.getMinimum();
+    vec3 max = mBoundingBox.getMaximum();
+    vec3 center = vec3(transform * vec4((min + max) * 0.5f, 1.f));
+
+    float scale = glm::max(glm::length(vec3(transform[0])),
+                  glm::max(glm::length(vec3(transform[1])), glm::length(vec3(transform[2]))));
+    float radius = glm::length(max - min) * 0.5f * scale;
+    float distance = glm::distance(camera.getTransform().getTranslation(), center);
+
+    if (distance <= radius) return 1.f;
+    // Projection [1][1] is 1/tan(fovy/2), so this is the sphere's
+    // projected diameter over the viewport height
+    return radius * camera.getProjectionMatrix()[1][1] / distance;
   }
 
   void
   ModelMesh::logRuntimes
   ()
   {
-    for (auto& runtime : getParent().getInstanceVector())
+    for (auto& runtime : getParent().getInstanceView())
     {
       LOG_DEBUG("\t\t\tRuntime for {}", runtime.get().getNameAndUuidString());
     }
@@ -134,66 +249,49 @@ namespace octronic::dream
   }
 
   void
-  ModelMesh::drawModelRuntimes
-  (CameraRuntime& camera, ShaderRuntime& shader)
+  ModelMesh::drawRuntimes
+  (ShaderRuntime& shader, const vector<reference_wrapper<EntityRuntime>>& runtimes, size_t lod)
   {
-    // TODO - Move this to grpahics component
-    mRuntimesInFrustum.clear();
-    auto runtimes = getParent().getInstanceVector();
-
-    for (auto entityWrap : runtimes)
-    {
-      auto& entity = entityWrap.get();
-      // TODO -- Per mesh Culling
-      if(camera.visibleInFrustum(mBoundingBox, entity.getTransform().getMatrix()))
-      {
-        mRuntimesInFrustum.push_back(entity);
-      }
-    }
-
-    if (mRuntimesInFrustum.empty())
+    size_t size = runtimes.size();
+    if (size == 0)
     {
-      LOG_DEBUG("ModelMesh: (Geometry) No Runtimes of {} in Frustum", getName());
+      LOG_TRACE("ModelMesh: No runtimes to draw");
       return;
     }
 
-    LOG_TRACE("ModelMesh: (Geometry) Drawing {} Runtimes of mesh {} for Geometry pass",
-              runtimes.size(),
-              getName());
+    LOG_TRACE("ModelMesh: (Geometry) Drawing {} Runtimes of mesh {} LOD {} for Geometry pass",
+              size,
+              getName(), lod);
     shader.bindVertexArray(mVAO);
-    shader.bindRuntimes(mRuntimesInFrustum);
+    shader.bindRuntimes(runtimes, mVertexTransform);
     shader.syncUniforms();
     GLCheckError();
 
-    size_t size = mRuntimesInFrustum.size();
-    if (size == 0)
-    {
-      LOG_TRACE("ModelMesh: No runtimes to draw");
-      return;
-    }
     if (size > ShaderRuntime::MAX_RUNTIMES)
     {
       LOG_TRACE("ModelMesh: (Geometry) Limiting to {}", ShaderRuntime::MAX_RUNTIMES);
       size = ShaderRuntime::MAX_RUNTIMES;
     }
 
-    size_t indices = mIndicesCount;
+    auto& level = getLod(lod);
+    size_t indices = level.indexCount;
     if (indices == 0) return;
 
     size_t tris = indices/3;
     MeshesDrawn += size;
     TrianglesDrawn += tris*size;
-    glDrawElementsInstanced(GL_TRIANGLES, indices, GL_UNSIGNED_INT, nullptr,size);
-    //renderDebugSphere(shader);
+    glDrawElementsInstanced(GL_TRIANGLES, indices, mIndexType,
+                            (GLvoid*)(level.indexOffset * mIndexSize), size);
+    //renderDebugSphere(shader, size);
     GLCheckError();
     DrawCalls++;
   }
 
   void
   ModelMesh::drawShadowPassRuntimes
-  (ShaderRuntime& shader, bool inFrustumOnly)
+  (ShaderRuntime& shader)
   {
-    auto runtimes = getParent().getInstanceVector();
+    auto& runtimes = getParent().getInstanceView();
 
     if (runtimes.empty())
     {
@@ -205,10 +303,10 @@ namespace octronic::dream
 
 
     shader.bindVertexArray(mVAO);
-    shader.bindRuntimes(inFrustumOnly ? mRuntimesInFrustum : runtimes);
+    shader.bindRuntimes(runtimes, mVertexTransform);
     shader.syncUniforms();
 
-    size_t size = (inFrustumOnly ? mRuntimesInFrustum.size() : runtimes.size());
+    size_t size = runtimes.size();
 
     if (size > ShaderRuntime::MAX_RUNTIMES)
     {
@@ -216,11 +314,12 @@ namespace octronic::dream
       LOG_TRACE("ModelMesh: (Shadow) Limiting to {}", ShaderRuntime::MAX_RUNTIMES);
     }
 
-    size_t indices = mIndicesCount;
+    // Shadows always use full detail, the shadow pass has no LOD selection
+    size_t indices = mLods.front().indexCount;
     size_t tris = indices/3;
     ShadowMeshesDrawn += size;
     ShadowTrianglesDrawn += tris*size;
-    glDrawElementsInstanced(GL_TRIANGLES, indices, GL_UNSIGNED_INT, nullptr,size);
+    glDrawElementsInstanced(GL_TRIANGLES, indices, mIndexType, nullptr,size);
     ShadowDrawCalls++;
   }
 
@@ -271,14 +370,15 @@ namespace octronic::dream
   ModelMesh::clearVertices
   ()
   {
-    mVertices.clear();
+    // Swap rather than clear so the memory is released
+    vector<Vertex>().swap(mVertices);
   }
 
   void
   ModelMesh::clearIndices
   ()
   {
-    mIndices.clear();
+    vector<GLuint>().swap(mIndices);
   }
 
   size_t
@@ -306,22 +406,57 @@ namespace octronic::dream
 
     glBindVertexArray(mVAO);
     glBindBuffer(GL_ARRAY_BUFFER, mVBO);
-    glBufferData(GL_ARRAY_BUFFER, static_cast<GLint>(getVertices().size() * sizeof(Vertex)), &getVertices()[0], GL_STATIC_DRAW);
+
+    if (mCompactVertices)
+    {
+      vector<CompactVertex> compact = compactVertices();
+      glBufferData(GL_ARRAY_BUFFER, static_cast<GLint>(compact.size() * sizeof(CompactVertex)), &compact[0], GL_STATIC_DRAW);
+      // Vertex Positions
+      glEnableVertexAttribArray(0);
+      glVertexAttribPointer(0, 3, GL_SHORT, GL_TRUE,
+                            static_cast<GLint>(sizeof(CompactVertex)), (GLvoid*)offsetof(CompactVertex, Position));
+      // Vertex Normals
+      glEnableVertexAttribArray(1);
+      glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE,
+                            static_cast<GLint>(sizeof(CompactVertex)), (GLvoid*)offsetof(CompactVertex, Normal));
+      // Vertex Texture Coords
+      glEnableVertexAttribArray(2);
+      glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE,
+                            static_cast<GLint>(sizeof(CompactVertex)), (GLvoid*)offsetof(CompactVertex, TexCoords));
+    }
+    else
+    {
+      mVertexTransform = mat4(1.f);
+      glBufferData(GL_ARRAY_BUFFER, static_cast<GLint>(mVertices.size() * sizeof(Vertex)), &mVertices[0], GL_STATIC_DRAW);
+      // Vertex Positions
+      glEnableVertexAttribArray(0);
+      glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE,
+                            static_cast<GLint>(sizeof(Vertex)), static_cast<GLvoid*>(nullptr));
+      // Vertex Normals
+      glEnableVertexAttribArray(1);
+      glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE,
+                            static_cast<GLint>(sizeof(Vertex)),(GLvoid*)offsetof(Vertex, Normal));
+      // Vertex Texture Coords
+      glEnableVertexAttribArray(2);
+      glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE,
+                            static_cast<GLint>(sizeof(Vertex)),(GLvoid*)offsetof(Vertex, TexCoords));
+    }
+
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLint>(getIndices().size() * sizeof(GLuint)),&getIndices()[0], GL_STATIC_DRAW);
-
-    // Vertex Positions
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE,
-                          static_cast<GLint>(sizeof(Vertex)), static_cast<GLvoid*>(nullptr));
-    // Vertex Normals
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE,
-                          static_cast<GLint>(sizeof(Vertex)),(GLvoid*)offsetof(Vertex, Normal));
-    // Vertex Texture Coords
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE,
-                          static_cast<GLint>(sizeof(Vertex)),(GLvoid*)offsetof(Vertex, TexCoords));
+    // Every LOD level's indices, see mLods for their ranges
+    if (mVertices.size() <= 0x10000)
+    {
+      vector<GLushort> shortIndices(mIndices.begin(), mIndices.end());
+      mIndexType = GL_UNSIGNED_SHORT;
+      mIndexSize = sizeof(GLushort);
+      glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLint>(shortIndices.size() * sizeof(GLushort)),&shortIndices[0], GL_STATIC_DRAW);
+    }
+    else
+    {
+      mIndexType = GL_UNSIGNED_INT;
+      mIndexSize = sizeof(GLuint);
+      glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLint>(mIndices.size() * sizeof(GLuint)),&mIndices[0], GL_STATIC_DRAW);
+    }
 
     glBindVertexArray(0);
 
@@ -333,11 +468,175 @@ namespace octronic::dream
     return true;
   }
 
+  // Layout ==================================================================
+
+  void
+  ModelMesh::optimize
+  ()
+  {
+    if (mLoaded || mIndices.empty()) return;
+
+    float before = MeshOptimizer::AverageCacheMissRatio(getIndices(), mVertices.size());
+
+    for (auto& lod : mLods)
+    {
+      if (lod.indexOffset + lod.indexCount > mIndices.size()) continue;
+      auto first = mIndices.begin() + lod.indexOffset;
+      vector<GLuint> range(first, first + lod.indexCount);
+      range = MeshOptimizer::OptimizeVertexCache(range, mVertices.size());
+      std::copy(range.begin(), range.end(), first);
+    }
+
+    MeshOptimizer::OptimizeVertexFetch(mVertices, mIndices);
+    mVerticesCount = mVertices.size();
+
+    LOG_DEBUG("ModelMesh: Optimized {}, ACMR {} -> {}", getName(), before,
+              MeshOptimizer::AverageCacheMissRatio(getIndices(), mVertices.size()));
+  }
+
+  vector<CompactVertex>
+  ModelMesh::compactVertices
+  ()
+  {
+    vector<CompactVertex> compact;
+    if (mVertices.empty()) return compact;
+
+    // Bounds of the vertices themselves, authored LODs may stray outside
+    // the bounding box
+    vec3 minimum = mVertices.front().Position;
+    vec3 maximum = minimum;
+    for (auto& vertex : mVertices)
+    {
+      minimum = glm::min(minimum, vec3(vertex.Position));
+      maximum = glm::max(maximum, vec3(vertex.Position));
+    }
+
+    vec3 center = (minimum + maximum) * 0.5f;
+    vec3 extent = (maximum - minimum) * 0.5f;
+    float scale = glm::max(extent.x, glm::max(extent.y, extent.z));
+    if (scale <= 0.f) scale = 1.f;
+    mVertexTransform = glm::scale(glm::translate(mat4(1.f), center), vec3(scale));
+
+    compact.resize(mVertices.size());
+    for (size_t i = 0; i < mVertices.size(); i++)
+    {
+      auto& vertex = mVertices[i];
+      auto& out = compact[i];
+
+      vec3 position = glm::clamp((vec3(vertex.Position) - center) / scale, vec3(-1.f), vec3(1.f));
+      for (int axis = 0; axis < 3; axis++)
+      {
+        out.Position[axis] = static_cast<int16_t>(std::round(position[axis] * 32767.f));
+      }
+      out.Position[3] = 0;
+
+      vec3 normal = vec3(vertex.Normal);
+      float length = glm::length(normal);
+      if (length > 0.f) normal /= length;
+      out.Normal = glm::packSnorm3x10_1x2(vec4(normal, 0.f));
+      out.TexCoords = glm::packHalf2x16(vec2(vertex.TexCoords));
+    }
+    return compact;
+  }
+
+  void
+  ModelMesh::setCompactVertices
+  (bool compact)
+  {
+    mCompactVertices = compact;
+  }
+
+  bool
+  ModelMesh::getCompactVertices
+  ()
+  const
+  {
+    return mCompactVertices;
+  }
+
+  const mat4&
+  ModelMesh::getVertexTransform
+  ()
+  const
+  {
+    return mVertexTransform;
+  }
+
+  GLenum
+  ModelMesh::getIndexType
+  ()
+  const
+  {
+    return mIndexType;
+  }
+
+  // Memory ==================================================================
+
+  size_t
+  ModelMesh::getCpuMemoryUsage
+  ()
+  const
+  {
+    return mVertices.capacity() * sizeof(Vertex) +
+        mIndices.capacity() * sizeof(GLuint) +
+        mOccluderPositions.capacity() * sizeof(vec3) +
+        mOccluderIndices.capacity() * sizeof(GLuint);
+  }
+
+  size_t
+  ModelMesh::getGpuMemoryUsage
+  ()
+  const
+  {
+    if (!mLoaded) return 0;
+    size_t vertexSize = mCompactVertices ? sizeof(CompactVertex) : sizeof(Vertex);
+    return mVerticesCount * vertexSize + mIndicesCount * mIndexSize;
+  }
+
+  // Occlusion ===============================================================
+
+  void
+  ModelMesh::keepOccluderGeometry
+  ()
+  {
+    mOccluderPositions.clear();
+    mOccluderPositions.reserve(mVertices.size());
+    for (auto& vertex : mVertices)
+    {
+      mOccluderPositions.push_back(vertex.Position);
+    }
+    mOccluderIndices = getIndices();
+  }
+
+  bool
+  ModelMesh::isOccluder
+  ()
+  const
+  {
+    return !mOccluderIndices.empty();
+  }
+
+  const vector<vec3>&
+  ModelMesh::getOccluderPositions
+  ()
+  const
+  {
+    return mOccluderPositions;
+  }
+
+  const vector<GLuint>&
+  ModelMesh::getOccluderIndices
+  ()
+  const
+  {
+    return mOccluderIndices;
+  }
+
   // renders (and builds at first invocation) a sphere
   // -------------------------------------------------
   void
   ModelMesh::renderDebugSphere
-  (ShaderRuntime& shader)
+  (ShaderRuntime& shader, size_t instances)
   {
     static unsigned int sphereVAO = 0;
     static unsigned int indexCount;
@@ -429,7 +728,7 @@ namespace octronic::dream
       glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)(5 * sizeof(float)));
     }
 
-    size_t size = mRuntimesInFrustum.size();
+    size_t size = instances;
     if (size > ShaderRuntime::MAX_RUNTIMES)
     {
       LOG_TRACE("ModelMesh: (Geometry) Limiting to {}", ShaderRuntime::MAX_RUNTIMES);
@@ -469,6 +768,7 @@ namespace octronic::dream
 
   // Statics =================================================================
 
+  const size_t ModelMesh::MAX_LOD_LEVELS = 4;
   long ModelMesh::DrawCalls = 0;
   long ModelMesh::MeshesDrawn = 0;
   long ModelMesh::TrianglesDrawn = 0;
@@ -30,9 +30,26 @@ namespace octronic::dream
   class EntityRuntime;
   class CameraRuntime;
 
+  /**
+   * @brief A level of detail, a range of the mesh's index buffer. Every
+   * level indexes the same vertex buffer.
+   */
+  struct ModelMeshLod
+  {
+    /**
+     * @brief Used once the mesh's projected height is below this fraction
+     * of the screen height.
+     */
+    float screenSize = 1.f;
+    size_t indexOffset = 0;
+    size_t indexCount = 0;
+  };
+
   class ModelMesh
   {
   public: // static
+    const static size_t MAX_LOD_LEVELS;
+
     static long DrawCalls;
     static long MeshesDrawn;
     static long TrianglesDrawn;
@@ -69,10 +86,42 @@ namespace octronic::dream
     void setName(const string& name);
 
     vector<Vertex> getVertices() const;
+    /**
+     * @brief Indices of the full detail level.
+     */
     vector<GLuint> getIndices() const;
 
-    void drawModelRuntimes(CameraRuntime& camera, ShaderRuntime& shader);
-    void drawShadowPassRuntimes(ShaderRuntime& shader, bool inFrustumOnly = false);
+    // LOD =================================================================
+    /**
+     * @brief Add a level of detail drawn with the given indices into this
+     * mesh's vertices. Levels must be added in order of decreasing
+     * screenSize, before the mesh is loaded into GL.
+     */
+    bool addLod(const vector<GLuint>& indices, float screenSize);
+    /**
+     * @brief Add an authored level of detail with its own vertices, which
+     * are appended to this mesh's vertex buffer.
+     */
+    bool addLod(const vector<Vertex>& vertices, const vector<GLuint>& indices, float screenSize);
+    size_t getLodCount() const;
+    const ModelMeshLod& getLod(size_t lod) const;
+    /**
+     * @brief The level to draw for an instance covering screenSize of the
+     * screen height.
+     */
+    size_t selectLod(float screenSize) const;
+    /**
+     * @brief Projected height of this mesh as a fraction of the screen
+     * height, for an instance with the given transform.
+     */
+    float getScreenSize(const CameraRuntime& camera, const mat4& transform) const;
+
+    /**
+     * @brief Draw the given runtimes with one instanced draw call, at most
+     * ShaderRuntime::MAX_RUNTIMES are drawn.
+     */
+    void drawRuntimes(ShaderRuntime& shader, const vector<reference_wrapper<EntityRuntime>>& runtimes, size_t lod = 0);
+    void drawShadowPassRuntimes(ShaderRuntime& shader);
 
     GLuint getVAO() const;
     void setVAO(const GLuint& vAO);
@@ -93,10 +142,60 @@ namespace octronic::dream
 
     bool getLoaded() const;
 
+    // Layout ==============================================================
+    /**
+     * @brief Reorder each level's triangles for the vertex cache and the
+     * vertices by first use. Call once every LOD is added, before loading.
+     */
+    void optimize();
+    /**
+     * @brief Upload CompactVertex instead of Vertex, takes effect when the
+     * mesh is next loaded into GL.
+     */
+    void setCompactVertices(bool compact);
+    bool getCompactVertices() const;
+    /**
+     * @brief Maps compact vertex positions back to model space, identity
+     * for full precision vertices.
+     */
+    const mat4& getVertexTransform() const;
+    /**
+     * @brief GL_UNSIGNED_SHORT when every index fits, else GL_UNSIGNED_INT.
+     */
+    GLenum getIndexType() const;
+
+    // Memory ==============================================================
+    /**
+     * @brief Bytes of vertex, index and occluder data held in RAM.
+     */
+    size_t getCpuMemoryUsage() const;
+    /**
+     * @brief Bytes of the vertex and index buffers once loaded into GL.
+     */
+    size_t getGpuMemoryUsage() const;
+
+    // Occlusion ===========================================================
+    /**
+     * @brief Keep a copy of the full detail positions and indices, which
+     * are otherwise dropped once uploaded, to rasterize as an occluder.
+     */
+    void keepOccluderGeometry();
+    bool isOccluder() const;
+    const vector<vec3>& getOccluderPositions() const;
+    const vector<GLuint>& getOccluderIndices() const;
+
     ModelRuntime& getParent();
 
   private:
-    void renderDebugSphere(ShaderRuntime& shader);
+    /**
+     * @brief Draw a unit sphere for each of the instances last bound to
+     * shader, for debugging.
+     */
+    void renderDebugSphere(ShaderRuntime& shader, size_t instances);
+    /**
+     * @brief Quantize mVertices, setting mVertexTransform to undo it.
+     */
+    vector<CompactVertex> compactVertices();
     void clearMaterialBindings();
   private:
     reference_wrapper<ModelRuntime> mParent;
@@ -107,10 +206,16 @@ namespace octronic::dream
     GLuint mIBO;
     vector<Vertex> mVertices;
     vector<GLuint> mIndices;
-    vector<reference_wrapper<EntityRuntime>> mRuntimesInFrustum;
+    vector<ModelMeshLod> mLods;
     size_t mVerticesCount;
     size_t mIndicesCount;
     BoundingBox mBoundingBox;
+    vector<vec3> mOccluderPositions;
+    vector<GLuint> mOccluderIndices;
+    bool mCompactVertices;
+    mat4 mVertexTransform;
+    GLenum mIndexType;
+    size_t mIndexSize;
     bool mLoaded;
     // Mesh Tasks
     shared_ptr<ModelInitMeshTask> mInitMeshTask;
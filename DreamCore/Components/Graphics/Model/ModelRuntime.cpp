@@ -1,6 +1,8 @@
 #include "ModelRuntime.h"
 
 #include "ModelDefinition.h"
+#include "MeshSimplifier.h"
+#include "Common/Constants.h"
 #include "Components/Cache.h"
 #include "Components/Graphics/Texture/TextureRuntime.h"
 #include "Components/Graphics/Material/MaterialRuntime.h"
@@ -11,6 +13,7 @@
 #include "Storage/StorageManager.h"
 #include "Storage/File.h"
 
+#include <cmath>
 #include <limits>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
@@ -23,6 +26,28 @@ using std::make_unique;
 
 namespace octronic::dream
 {
+  namespace
+  {
+    /**
+     * @brief Split a mesh name of the form <base>_LOD<n> into base and n,
+     * 0 for names without the suffix.
+     */
+    size_t
+    ParseLodSuffix
+    (const string& name, string& base)
+    {
+      base = name;
+      size_t pos = name.rfind(Constants::ASSET_ATTR_MODEL_LOD_MESH_SUFFIX);
+      if (pos == string::npos) return 0;
+
+      string digits = name.substr(pos + Constants::ASSET_ATTR_MODEL_LOD_MESH_SUFFIX.size());
+      if (digits.empty() || digits.find_first_not_of("0123456789") != string::npos) return 0;
+
+      base = name.substr(0, pos);
+      return std::stoul(digits);
+    }
+  }
+
   ModelRuntime::ModelRuntime
   (ProjectRuntime& runtime,
    AssetDefinition& definition)
@@ -70,7 +95,39 @@ namespace octronic::dream
 
         mGlobalInverseTransform = aiMatrix4x4ToGlm(scene->mRootNode->mTransformation.Inverse());
         mBoundingBox.setToLimits();
-        processNode(scene->mRootNode, scene);
+
+        vector<aiMesh*> meshes;
+        processNode(scene->mRootNode, meshes, scene);
+
+        // Authored levels of detail are attached after every full detail
+        // mesh exists, whatever order the file lists them in
+        vector<aiMesh*> authoredLods;
+        for (aiMesh* mesh : meshes)
+        {
+          string base;
+          if (ParseLodSuffix(string(mesh->mName.C_Str()), base) > 0)
+          {
+            authoredLods.push_back(mesh);
+          }
+          else
+          {
+            processMesh(mesh, scene);
+          }
+        }
+        processLods(authoredLods);
+
+        auto& modelDef = static_cast<ModelDefinition&>(getDefinition());
+        for (auto& mesh : mMeshes)
+        {
+          mesh->optimize();
+          mesh->setCompactVertices(modelDef.getCompactVertices());
+        }
+
+        if (modelDef.getOccluder())
+        {
+          for (auto& mesh : mMeshes) mesh->keepOccluderGeometry();
+        }
+
         mLoaded = true;
         return mLoaded;
 
@@ -83,24 +140,67 @@ namespace octronic::dream
 
   void
   ModelRuntime::processNode
-  (aiNode* node, const aiScene* scene)
+  (aiNode* node, vector<aiMesh*>& meshes, const aiScene* scene)
   {
-    // Process all the node's meshes (if any)
+    // Collect all the node's meshes (if any)
     for(GLuint i = 0; i < node->mNumMeshes; i++)
     {
-      aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-
-      processMesh(mesh, scene);
+      meshes.push_back(scene->mMeshes[node->mMeshes[i]]);
     }
     // Then do the same for each of its children
     for(GLuint i = 0; i < node->mNumChildren; i++)
     {
-      processNode(node->mChildren[i], scene);
+      processNode(node->mChildren[i], meshes, scene);
+    }
+  }
+
+  void
+  ModelRuntime::processLods
+  (const vector<aiMesh*>& authoredLods)
+  {
+    auto& modelDef = static_cast<ModelDefinition&>(getDefinition());
+    auto levels = modelDef.getLodLevels();
+
+    for (auto& mesh : mMeshes)
+    {
+      string meshBase;
+      ParseLodSuffix(mesh->getName(), meshBase);
+
+      for (size_t level = 1; level < ModelMesh::MAX_LOD_LEVELS; level++)
+      {
+        aiMesh* authored = nullptr;
+        for (aiMesh* lodMesh : authoredLods)
+        {
+          string lodBase;
+          if (ParseLodSuffix(string(lodMesh->mName.C_Str()), lodBase) == level && lodBase == meshBase)
+          {
+            authored = lodMesh;
+            break;
+          }
+        }
+
+        bool defined = level <= levels.size();
+        if (!authored && !defined) break;
+
+        // Authored levels without a definition entry halve each time
+        float screenSize = defined ? levels[level-1].screenSize : std::pow(0.5f, (float)level);
+
+        if (authored)
+        {
+          LOG_DEBUG("ModelRuntime: Using authored LOD {} for {}", level, mesh->getName());
+          mesh->addLod(ProcessVertexData(authored), ProcessIndexData(authored), screenSize);
+        }
+        else if (levels[level-1].ratio < 1.f)
+        {
+          auto indices = MeshSimplifier::Simplify(mesh->getVertices(), mesh->getIndices(), levels[level-1].ratio);
+          mesh->addLod(indices, screenSize);
+        }
+      }
     }
   }
 
   vector<Vertex>
-  ModelRuntime::processVertexData
+  ModelRuntime::ProcessVertexData
   (aiMesh* mesh)
   {
     vector<Vertex>  vertices;
@@ -149,7 +249,7 @@ namespace octronic::dream
   }
 
   vector<GLuint>
-  ModelRuntime::processIndexData
+  ModelRuntime::ProcessIndexData
   (aiMesh* mesh)
   {
     vector<GLuint> indices;
@@ -170,8 +270,8 @@ namespace octronic::dream
   ModelRuntime::processMesh
   (aiMesh* mesh, const aiScene* scene)
   {
-    vector<Vertex>  vertices = processVertexData(mesh);
-    vector<GLuint>  indices = processIndexData(mesh);
+    vector<Vertex>  vertices = ProcessVertexData(mesh);
+    vector<GLuint>  indices = ProcessIndexData(mesh);
 
     // Load any new materials
     aiMaterial* assimpMaterial = scene->mMaterials[mesh->mMaterialIndex];
@@ -240,6 +340,40 @@ namespace octronic::dream
     return  ret;
   }
 
+  PointerView<ModelMesh>
+  ModelRuntime::getMeshView
+  ()
+  const
+  {
+    return PointerView<ModelMesh>(mMeshes);
+  }
+
+  size_t
+  ModelRuntime::getCpuMemoryUsage
+  ()
+  const
+  {
+    size_t bytes = 0;
+    for (auto& mesh : mMeshes)
+    {
+      bytes += mesh->getCpuMemoryUsage();
+    }
+    return bytes;
+  }
+
+  size_t
+  ModelRuntime::getGpuMemoryUsage
+  ()
+  const
+  {
+    size_t bytes = 0;
+    for (auto& mesh : mMeshes)
+    {
+      bytes += mesh->getGpuMemoryUsage();
+    }
+    return bytes;
+  }
+
   BoundingBox
   ModelRuntime::generateBoundingBox
   (aiMesh* mesh)
@@ -3,6 +3,7 @@
 #include "ModelMesh.h"
 
 #include "Common/GLHeader.h"
+#include "Common/PointerView.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/material.h>
@@ -48,19 +49,30 @@ namespace octronic::dream
 
         vector<string> getMaterialNames() const;
         vector<reference_wrapper<ModelMesh>> getMeshes() const;
+        // Meshes without copying, for per frame iteration
+        PointerView<ModelMesh> getMeshView() const;
 
         mat4 getGlobalInverseTransform() const;
         void setGlobalInverseTransform(const mat4& globalInverseTransform);
 
         void pushTasks() override;
 
+        /**
+         * @brief Copy an assimp mesh's vertices and indices into Dream's
+         * layout.
+         */
+        static vector<Vertex> ProcessVertexData(aiMesh* mesh);
+        static vector<GLuint> ProcessIndexData(aiMesh* mesh);
+
+        size_t getCpuMemoryUsage() const override;
+        size_t getGpuMemoryUsage() const override;
+
     private: // Methods
         BoundingBox generateBoundingBox(aiMesh* mesh) const;
         void loadModel(string);
-        void processNode(aiNode*, const aiScene*);
+        void processNode(aiNode*, vector<aiMesh*>& meshes, const aiScene*);
         void processMesh(aiMesh*, const aiScene*);
-        vector<Vertex> processVertexData(aiMesh* mesh);
-        vector<GLuint> processIndexData(aiMesh* mesh);
+        void processLods(const vector<aiMesh*>& authoredLods);
         mat4 aiMatrix4x4ToGlm(const aiMatrix4x4& from) const;
 
     private:
@@ -0,0 +1,402 @@
+#include "OcclusionCuller.h"
+
+#include "Common/Logger.h"
+#include "Common/Profiler.h"
+#include "Common/WorkerPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+
+using std::min;
+using std::max;
+using std::future;
+
+namespace octronic::dream
+{
+  const unsigned int OcclusionCuller::DEFAULT_WIDTH = 256;
+  const unsigned int OcclusionCuller::DEFAULT_HEIGHT = 128;
+  const float OcclusionCuller::NEAR_W = 1e-5f;
+  const size_t OcclusionCuller::RASTERIZE_THREAD_MIN_TRIANGLES = 64;
+
+  OcclusionCuller::OcclusionCuller
+  (unsigned int width, unsigned int height)
+    : mWidth(0),
+      mHeight(0),
+      mViewProjection(1.f)
+  {
+    setResolution(width, height);
+  }
+
+  void
+  OcclusionCuller::setResolution
+  (unsigned int width, unsigned int height)
+  {
+    mWidth = max(width, 1u);
+    mHeight = max(height, 1u);
+
+    mLevels.clear();
+    mLevelWidths.clear();
+    mLevelHeights.clear();
+
+    unsigned int w = mWidth;
+    unsigned int h = mHeight;
+    while (true)
+    {
+      mLevels.emplace_back(w * h, 1.f);
+      mLevelWidths.push_back(w);
+      mLevelHeights.push_back(h);
+      if (w == 1 && h == 1) break;
+      w = (w + 1) / 2;
+      h = (h + 1) / 2;
+    }
+  }
+
+  unsigned int
+  OcclusionCuller::getWidth
+  ()
+  const
+  {
+    return mWidth;
+  }
+
+  unsigned int
+  OcclusionCuller::getHeight
+  ()
+  const
+  {
+    return mHeight;
+  }
+
+  void
+  OcclusionCuller::begin
+  (const mat4& viewProjection)
+  {
+    mViewProjection = viewProjection;
+    mTriangles.clear();
+    std::fill(mLevels[0].begin(), mLevels[0].end(), 1.f);
+  }
+
+  void
+  OcclusionCuller::addOccluder
+  (const vector<vec3>& positions, const vector<GLuint>& indices, const mat4& model)
+  {
+    mat4 mvp = mViewProjection * model;
+
+    vector<vec4> clip(positions.size());
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+      clip[i] = mvp * vec4(positions[i], 1.f);
+    }
+
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+      if (indices[i] >= clip.size() || indices[i+1] >= clip.size() || indices[i+2] >= clip.size()) continue;
+      const vec4 tri[3] = {clip[indices[i]], clip[indices[i+1]], clip[indices[i+2]]};
+      clipAndAdd(tri);
+    }
+  }
+
+  // Clip against the near plane, z >= -w, which can leave a quad
+  void
+  OcclusionCuller::clipAndAdd
+  (const vec4 clip[3])
+  {
+    float d[3];
+    int inside = 0;
+    for (int i = 0; i < 3; i++)
+    {
+      d[i] = clip[i].z + clip[i].w;
+      if (d[i] >= 0.f) inside++;
+    }
+
+    if (inside == 0) return;
+    if (inside == 3)
+    {
+      addScreenTriangle(clip[0], clip[1], clip[2]);
+      return;
+    }
+
+    vec4 polygon[4];
+    int count = 0;
+    for (int i = 0; i < 3; i++)
+    {
+      int j = (i + 1) % 3;
+      if (d[i] >= 0.f) polygon[count++] = clip[i];
+      if ((d[i] >= 0.f) != (d[j] >= 0.f))
+      {
+        float t = d[i] / (d[i] - d[j]);
+        polygon[count++] = clip[i] + (clip[j] - clip[i]) * t;
+      }
+    }
+
+    for (int i = 1; i + 1 < count; i++)
+    {
+      addScreenTriangle(polygon[0], polygon[i], polygon[i+1]);
+    }
+  }
+
+  void
+  OcclusionCuller::addScreenTriangle
+  (const vec4& a, const vec4& b, const vec4& c)
+  {
+    ScreenTriangle tri;
+    const vec4* clip[3] = {&a, &b, &c};
+    float minY = std::numeric_limits<float>::max();
+    float maxY = std::numeric_limits<float>::lowest();
+
+    for (int i = 0; i < 3; i++)
+    {
+      const vec4& p = *clip[i];
+      if (p.w < NEAR_W) return;
+      float invW = 1.f / p.w;
+      tri.v[i] = vec3((p.x * invW * 0.5f + 0.5f) * mWidth,
+                      (p.y * invW * 0.5f + 0.5f) * mHeight,
+                      p.z * invW * 0.5f + 0.5f);
+      minY = min(minY, tri.v[i].y);
+      maxY = max(maxY, tri.v[i].y);
+    }
+
+    if (maxY < 0.f || minY >= static_cast<float>(mHeight)) return;
+    tri.minY = max(0, static_cast<int>(std::floor(minY)));
+    tri.maxY = min(static_cast<int>(mHeight) - 1, static_cast<int>(std::ceil(maxY)));
+    mTriangles.push_back(tri);
+  }
+
+  void
+  OcclusionCuller::rasterize
+  (WorkerPool* workers)
+  {
+    DREAM_PROFILE_ZONE("OcclusionCuller::rasterize");
+    int height = static_cast<int>(mHeight);
+    unsigned int threads = workers == nullptr ? 1 : workers->getThreadCount() + 1;
+    threads = max(1u, min(threads, mHeight));
+
+    if (threads == 1 || mTriangles.size() < RASTERIZE_THREAD_MIN_TRIANGLES)
+    {
+      rasterizeBand(0, height);
+    }
+    else
+    {
+      // Bands share no rows, so the threads never write the same texel.
+      // The calling thread takes the first band.
+      int band = (height + threads - 1) / threads;
+      vector<future<void>> pending;
+      for (int y0 = band; y0 < height; y0 += band)
+      {
+        int y1 = min(y0 + band, height);
+        pending.push_back(workers->submit([this, y0, y1]()
+        {
+          rasterizeBand(y0, y1);
+        }));
+      }
+      rasterizeBand(0, min(band, height));
+      for (auto& part : pending) part.wait();
+    }
+
+    buildPyramid();
+    LOG_TRACE("OcclusionCuller: Rasterized {} occluder triangles", mTriangles.size());
+  }
+
+  void
+  OcclusionCuller::rasterizeBand
+  (int y0, int y1)
+  {
+    DREAM_PROFILE_ZONE("OcclusionCuller::rasterizeBand");
+    auto& depth = mLevels[0];
+    const int width = static_cast<int>(mWidth);
+
+    for (auto& tri : mTriangles)
+    {
+      if (tri.maxY < y0 || tri.minY >= y1) continue;
+
+      const vec3& v0 = tri.v[0];
+      const vec3& v1 = tri.v[1];
+      const vec3& v2 = tri.v[2];
+
+      float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+      if (std::fabs(area) < 1e-8f) continue;
+
+      // Occluders are not back face culled, wind every triangle the same way
+      const vec3& a = v0;
+      const vec3& b = area > 0.f ? v1 : v2;
+      const vec3& c = area > 0.f ? v2 : v1;
+      area = std::fabs(area);
+
+      int minX = max(0, static_cast<int>(std::floor(min(a.x, min(b.x, c.x)))));
+      int maxX = min(width - 1, static_cast<int>(std::ceil(max(a.x, max(b.x, c.x)))));
+      if (minX > maxX) continue;
+      int rowStart = max(tri.minY, y0);
+      int rowEnd = min(tri.maxY, y1 - 1);
+
+      // Edge functions step by a constant per pixel along a row
+      float e0dx = -(c.y - b.y), e1dx = -(a.y - c.y), e2dx = -(b.y - a.y);
+      float e0dy = c.x - b.x,    e1dy = a.x - c.x,    e2dy = b.x - a.x;
+
+      // Depth is linear in screen space
+      float dzdx = ((b.z - a.z) * (c.y - a.y) - (c.z - a.z) * (b.y - a.y)) / area;
+      float dzdy = ((c.z - a.z) * (b.x - a.x) - (b.z - a.z) * (c.x - a.x)) / area;
+
+      float px = minX + 0.5f;
+      for (int y = rowStart; y <= rowEnd; y++)
+      {
+        float py = y + 0.5f;
+        float w0 = e0dy * (py - b.y) + e0dx * (px - b.x);
+        float w1 = e1dy * (py - c.y) + e1dx * (px - c.x);
+        float w2 = e2dy * (py - a.y) + e2dx * (px - a.x);
+        float z = a.z + dzdx * (px - a.x) + dzdy * (py - a.y);
+
+        float* row = &depth[static_cast<size_t>(y) * width];
+        for (int x = minX; x <= maxX; x++)
+        {
+          bool inside = w0 >= 0.f && w1 >= 0.f && w2 >= 0.f;
+          float current = row[x];
+          row[x] = inside && z < current ? z : current;
+          w0 += e0dx;
+          w1 += e1dx;
+          w2 += e2dx;
+          z += dzdx;
+        }
+      }
+    }
+  }
+
+  void
+  OcclusionCuller::buildPyramid
+  ()
+  {
+    for (size_t level = 1; level < mLevels.size(); level++)
+    {
+      const auto& src = mLevels[level-1];
+      auto& dst = mLevels[level];
+      unsigned int srcW = mLevelWidths[level-1];
+      unsigned int srcH = mLevelHeights[level-1];
+      unsigned int dstW = mLevelWidths[level];
+      unsigned int dstH = mLevelHeights[level];
+
+      for (unsigned int y = 0; y < dstH; y++)
+      {
+        unsigned int sy0 = y * 2;
+        unsigned int sy1 = min(sy0 + 1, srcH - 1);
+        for (unsigned int x = 0; x < dstW; x++)
+        {
+          unsigned int sx0 = x * 2;
+          unsigned int sx1 = min(sx0 + 1, srcW - 1);
+          dst[y * dstW + x] = max(max(src[sy0 * srcW + sx0], src[sy0 * srcW + sx1]),
+                                  max(src[sy1 * srcW + sx0], src[sy1 * srcW + sx1]));
+        }
+      }
+    }
+  }
+
+  bool
+  OcclusionCuller::isVisible
+  (const vec3& minimum, const vec3& maximum)
+  const
+  {
+    return isVisible(BoundingBox(minimum, maximum), mat4(1.f));
+  }
+
+  bool
+  OcclusionCuller::isVisible
+  (const BoundingBox& box, const mat4& model)
+  const
+  {
+    vec3 bMin = box.getMinimum();
+    vec3 bMax = box.getMaximum();
+    if (bMin.x > bMax.x || bMin.y > bMax.y || bMin.z > bMax.z) return true;
+
+    mat4 mvp = mViewProjection * model;
+    float minX = std::numeric_limits<float>::max();
+    float minY = std::numeric_limits<float>::max();
+    float maxX = std::numeric_limits<float>::lowest();
+    float maxY = std::numeric_limits<float>::lowest();
+    float nearest = std::numeric_limits<float>::max();
+
+    for (int i = 0; i < 8; i++)
+    {
+      vec4 corner((i & 1) ? bMax.x : bMin.x,
+                  (i & 2) ? bMax.y : bMin.y,
+                  (i & 4) ? bMax.z : bMin.z, 1.f);
+      vec4 clip = mvp * corner;
+      // Reaches behind the camera, let the frustum decide
+      if (clip.w < NEAR_W || clip.z < -clip.w) return true;
+      float invW = 1.f / clip.w;
+      float x = (clip.x * invW * 0.5f + 0.5f) * mWidth;
+      float y = (clip.y * invW * 0.5f + 0.5f) * mHeight;
+      minX = min(minX, x);
+      maxX = max(maxX, x);
+      minY = min(minY, y);
+      maxY = max(maxY, y);
+      nearest = min(nearest, clip.z * invW * 0.5f + 0.5f);
+    }
+
+    if (maxX < 0.f || maxY < 0.f || minX >= mWidth || minY >= mHeight) return true;
+
+    int x0 = max(0, static_cast<int>(std::floor(minX)));
+    int y0 = max(0, static_cast<int>(std::floor(minY)));
+    int x1 = min(static_cast<int>(mWidth) - 1, static_cast<int>(std::floor(maxX)));
+    int y1 = min(static_cast<int>(mHeight) - 1, static_cast<int>(std::floor(maxY)));
+
+    // Coarsest level first reached where the rectangle spans 2x2 texels
+    size_t level = 0;
+    while (level + 1 < mLevels.size() &&
+           ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1))
+    {
+      level++;
+    }
+
+    const auto& hiZ = mLevels[level];
+    unsigned int levelWidth = mLevelWidths[level];
+    float farthest = 0.f;
+    for (int y = y0 >> level; y <= (y1 >> level); y++)
+    {
+      for (int x = x0 >> level; x <= (x1 >> level); x++)
+      {
+        farthest = max(farthest, hiZ[y * levelWidth + x]);
+      }
+    }
+
+    return nearest <= farthest;
+  }
+
+  size_t
+  OcclusionCuller::getOccluderTriangleCount
+  ()
+  const
+  {
+    return mTriangles.size();
+  }
+
+  size_t
+  OcclusionCuller::getLevelCount
+  ()
+  const
+  {
+    return mLevels.size();
+  }
+
+  const vector<float>&
+  OcclusionCuller::getLevel
+  (size_t level)
+  const
+  {
+    return mLevels[level];
+  }
+
+  unsigned int
+  OcclusionCuller::getLevelWidth
+  (size_t level)
+  const
+  {
+    return mLevelWidths[level];
+  }
+
+  unsigned int
+  OcclusionCuller::getLevelHeight
+  (size_t level)
+  const
+  {
+    return mLevelHeights[level];
+  }
+}
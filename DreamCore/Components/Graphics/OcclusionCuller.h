@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Common/GLHeader.h"
+#include "Entity/BoundingBox.h"
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/matrix.hpp>
+#include <vector>
+
+using glm::vec3;
+using glm::vec4;
+using glm::mat4;
+using std::vector;
+
+namespace octronic::dream
+{
+  class WorkerPool;
+
+  /**
+   * @brief Software occlusion culling against a small CPU depth buffer.
+   *
+   * Each frame the designated occluder meshes are transformed, clipped to
+   * the near plane and rasterized into a low resolution depth buffer,
+   * split into horizontal bands over worker threads. The buffer is then
+   * reduced into a Hi-Z pyramid where every texel holds the farthest
+   * depth below it. A box is hidden when its nearest projected depth is
+   * behind the farthest occluder depth over the few Hi-Z texels its
+   * screen rectangle covers.
+   *
+   * Depth is window z in [0,1], cleared to the far plane. Nothing here
+   * touches GL, so it runs and can be measured without a context.
+   */
+  class OcclusionCuller
+  {
+  public:
+    const static unsigned int DEFAULT_WIDTH;
+    const static unsigned int DEFAULT_HEIGHT;
+    /**
+     * @brief Smallest clip space w treated as in front of the camera.
+     */
+    const static float NEAR_W;
+    /**
+     * @brief Below this number of occluder triangles the depth buffer is
+     * rasterized on the calling thread.
+     */
+    const static size_t RASTERIZE_THREAD_MIN_TRIANGLES;
+
+    OcclusionCuller(unsigned int width = DEFAULT_WIDTH, unsigned int height = DEFAULT_HEIGHT);
+
+    void setResolution(unsigned int width, unsigned int height);
+    unsigned int getWidth() const;
+    unsigned int getHeight() const;
+
+    /**
+     * @brief Clear the depth buffer and occluders for a new frame.
+     */
+    void begin(const mat4& viewProjection);
+    /**
+     * @brief Queue an occluder's triangles, positions in model space.
+     */
+    void addOccluder(const vector<vec3>& positions, const vector<GLuint>& indices, const mat4& model);
+    /**
+     * @brief Rasterize the queued occluders and build the Hi-Z pyramid,
+     * sharing the bands between the calling thread and the threads of
+     * workers when one is given.
+     */
+    void rasterize(WorkerPool* workers = nullptr);
+
+    /**
+     * @brief Test a world space box, false only if it is fully hidden.
+     * Safe to call from several threads once rasterize has returned.
+     */
+    bool isVisible(const vec3& minimum, const vec3& maximum) const;
+    bool isVisible(const BoundingBox& box, const mat4& model) const;
+
+    size_t getOccluderTriangleCount() const;
+    size_t getLevelCount() const;
+    const vector<float>& getLevel(size_t level) const;
+    unsigned int getLevelWidth(size_t level) const;
+    unsigned int getLevelHeight(size_t level) const;
+
+  private:
+    struct ScreenTriangle
+    {
+      // x and y in pixels, z as window depth
+      vec3 v[3];
+      int minY;
+      int maxY;
+    };
+
+    void clipAndAdd(const vec4 clip[3]);
+    void addScreenTriangle(const vec4& a, const vec4& b, const vec4& c);
+    void rasterizeBand(int y0, int y1);
+    void buildPyramid();
+
+    unsigned int mWidth;
+    unsigned int mHeight;
+    mat4 mViewProjection;
+    vector<ScreenTriangle> mTriangles;
+    // Level 0 is the full resolution depth buffer
+    vector<vector<float>> mLevels;
+    vector<unsigned int> mLevelWidths;
+    vector<unsigned int> mLevelHeights;
+  };
+}
@@ -0,0 +1,366 @@
+#include "RenderQueue.h"
+
+#include "CameraRuntime.h"
+#include "OcclusionCuller.h"
+#include "Material/MaterialRuntime.h"
+#include "Model/ModelMesh.h"
+#include "Model/ModelRuntime.h"
+#include "Shader/ShaderRuntime.h"
+
+#include "Common/Logger.h"
+#include "Common/Profiler.h"
+#include "Common/WorkerPool.h"
+#include "Entity/EntityRuntime.h"
+#include "Math/Transform.h"
+
+#include <algorithm>
+#include <future>
+#include <glm/geometric.hpp>
+
+using std::future;
+using std::min;
+
+namespace octronic::dream
+{
+  const unsigned int RenderQueue::PASS_BITS = 4;
+  const unsigned int RenderQueue::SHADER_BITS = 10;
+  const unsigned int RenderQueue::MATERIAL_BITS = 14;
+  const unsigned int RenderQueue::MESH_BITS = 14;
+  const unsigned int RenderQueue::LOD_BITS = 2;
+  const unsigned int RenderQueue::DEPTH_BITS = 20;
+  const size_t RenderQueue::BUILD_THREAD_MIN_ENTITIES = 1024;
+
+  uint64_t
+  RenderQueue::MakeSortKey
+  (RenderPass pass, uint32_t shader, uint32_t material, uint32_t mesh, uint32_t lod, float depth)
+  {
+    // Ids wider than their field only cost extra state changes, batches
+    // are split by comparing the packet pointers rather than the key.
+    const uint64_t depthMax = (1ull << DEPTH_BITS) - 1;
+    depth = depth < 0.f ? 0.f : (depth > 1.f ? 1.f : depth);
+
+    uint64_t key = static_cast<uint64_t>(pass) & ((1ull << PASS_BITS) - 1);
+    key = (key << SHADER_BITS)   | (shader   & ((1ull << SHADER_BITS) - 1));
+    key = (key << MATERIAL_BITS) | (material & ((1ull << MATERIAL_BITS) - 1));
+    key = (key << MESH_BITS)     | (mesh     & ((1ull << MESH_BITS) - 1));
+    key = (key << LOD_BITS)      | (lod      & ((1ull << LOD_BITS) - 1));
+    key = (key << DEPTH_BITS)    | static_cast<uint64_t>(depth * depthMax);
+    return key;
+  }
+
+  void
+  RenderQueue::RadixSort
+  (vector<DrawPacket>& packets, vector<DrawPacket>& scratch)
+  {
+    const size_t count = packets.size();
+    if (count < 2) return;
+
+    scratch.resize(count);
+    vector<DrawPacket>* src = &packets;
+    vector<DrawPacket>* dst = &scratch;
+
+    for (unsigned int shift = 0; shift < 64; shift += 8)
+    {
+      size_t offsets[256] = {0};
+      for (auto& packet : *src)
+      {
+        offsets[(packet.key >> shift) & 0xFF]++;
+      }
+
+      // Every key shares this digit, nothing to reorder
+      if (offsets[(src->front().key >> shift) & 0xFF] == count) continue;
+
+      size_t total = 0;
+      for (size_t& offset : offsets)
+      {
+        size_t digitCount = offset;
+        offset = total;
+        total += digitCount;
+      }
+
+      for (auto& packet : *src)
+      {
+        (*dst)[offsets[(packet.key >> shift) & 0xFF]++] = packet;
+      }
+      std::swap(src, dst);
+    }
+
+    if (src != &packets) packets.swap(scratch);
+  }
+
+  RenderQueue::RenderQueue
+  ()
+    : mMaxDepth(1.f),
+      mOccludedCount(0)
+  {
+  }
+
+  void
+  RenderQueue::clear
+  ()
+  {
+    mPackets.clear();
+    mBatches.clear();
+    mShaderIds.clear();
+    mMaterialIds.clear();
+    mMeshIds.clear();
+    mOccludedCount = 0;
+  }
+
+  void
+  RenderQueue::build
+  (const CameraRuntime& camera,
+   const vector<reference_wrapper<EntityRuntime>>& entities,
+   WorkerPool* workers,
+   const OcclusionCuller* occlusion)
+  {
+    DREAM_PROFILE_ZONE("RenderQueue::build");
+    clear();
+    mMaxDepth = camera.getMaxDrawDistance();
+
+    if (workers == nullptr || workers->getThreadCount() == 0 ||
+        entities.size() < BUILD_THREAD_MIN_ENTITIES)
+    {
+      BuildRange(camera, entities, 0, entities.size(), occlusion, mPackets, mOccludedCount);
+      return;
+    }
+
+    // Each part fills its own vector, joined in order so the queue is
+    // the same regardless of the thread count. The calling thread builds
+    // the first part while the pool's threads build the rest.
+    unsigned int threads = workers->getThreadCount() + 1;
+    size_t chunk = (entities.size() + threads - 1) / threads;
+    vector<vector<DrawPacket>> parts(threads);
+    vector<size_t> occluded(threads, 0);
+    vector<future<void>> pending;
+
+    for (unsigned int i = 1; i < threads; i++)
+    {
+      size_t begin = i * chunk;
+      size_t end = min(begin + chunk, entities.size());
+      if (begin >= end) break;
+      auto& part = parts[i];
+      auto& partOccluded = occluded[i];
+      pending.push_back(workers->submit([&camera, &entities, begin, end, occlusion, &part, &partOccluded]()
+      {
+        BuildRange(camera, entities, begin, end, occlusion, part, partOccluded);
+      }));
+    }
+
+    BuildRange(camera, entities, 0, min(chunk, entities.size()), occlusion, parts[0], occluded[0]);
+    for (auto& part : pending) part.wait();
+
+    for (size_t i = 0; i < parts.size(); i++)
+    {
+      mPackets.insert(mPackets.end(), parts[i].begin(), parts[i].end());
+      mOccludedCount += occluded[i];
+    }
+  }
+
+  void
+  RenderQueue::BuildRange
+  (const CameraRuntime& camera,
+   const vector<reference_wrapper<EntityRuntime>>& entities,
+   size_t begin, size_t end,
+   const OcclusionCuller* occlusion,
+   vector<DrawPacket>& out, size_t& occluded)
+  {
+    DREAM_PROFILE_ZONE("RenderQueue::BuildRange");
+    vec3 cameraTranslation = camera.getTransform().getTranslation();
+
+    for (size_t i = begin; i < end; i++)
+    {
+      auto& entity = entities[i].get();
+      if (!entity.hasModelRuntime()) continue;
+
+      auto& model = entity.getModelRuntime();
+      if (!model.getLoaded()) continue;
+
+      Transform transform = entity.getTransform();
+      mat4 matrix = transform.getMatrix();
+      float depth = glm::distance(cameraTranslation, transform.getTranslation());
+
+      for (auto& mesh : model.getMeshView())
+      {
+        if (!mesh.getLoaded()) continue;
+
+        auto materialOpt = mesh.getMaterial();
+        if (!materialOpt) continue;
+
+        auto& material = materialOpt.value().get();
+        auto shaderOpt = material.getShader();
+        if (!shaderOpt) continue;
+
+        if (!camera.visibleInFrustum(mesh.getBoundingBox(), matrix)) continue;
+
+        if (occlusion && !occlusion->isVisible(mesh.getBoundingBox(), matrix))
+        {
+          occluded++;
+          continue;
+        }
+
+        size_t lod = 0;
+        if (mesh.getLodCount() > 1)
+        {
+          lod = mesh.selectLod(mesh.getScreenSize(camera, matrix));
+        }
+
+        DrawPacket packet;
+        packet.pass = RENDER_PASS_GEOMETRY;
+        packet.depth = depth;
+        packet.shader = &shaderOpt.value().get();
+        packet.material = &material;
+        packet.mesh = &mesh;
+        packet.lod = static_cast<uint8_t>(lod);
+        packet.entity = &entity;
+        out.push_back(packet);
+      }
+    }
+  }
+
+  void
+  RenderQueue::sort
+  ()
+  {
+    DREAM_PROFILE_ZONE("RenderQueue::sort");
+    assignKeys();
+    RadixSort(mPackets, mScratch);
+    buildBatches();
+    LOG_TRACE("RenderQueue: Sorted {} packets into {} batches", mPackets.size(), mBatches.size());
+  }
+
+  uint32_t
+  RenderQueue::getId
+  (unordered_map<const void*, uint32_t>& ids, const void* ptr)
+  {
+    auto itr = ids.find(ptr);
+    if (itr != ids.end()) return itr->second;
+    uint32_t id = static_cast<uint32_t>(ids.size());
+    ids.emplace(ptr, id);
+    return id;
+  }
+
+  void
+  RenderQueue::assignKeys
+  ()
+  {
+    float depthScale = mMaxDepth > 0.f ? 1.f / mMaxDepth : 0.f;
+
+    for (auto& packet : mPackets)
+    {
+      packet.key = MakeSortKey(packet.pass,
+                               getId(mShaderIds, packet.shader),
+                               getId(mMaterialIds, packet.material),
+                               getId(mMeshIds, packet.mesh),
+                               packet.lod,
+                               packet.depth * depthScale);
+    }
+  }
+
+  void
+  RenderQueue::buildBatches
+  ()
+  {
+    mBatches.clear();
+
+    for (size_t i = 0; i < mPackets.size(); i++)
+    {
+      auto& packet = mPackets[i];
+
+      if (!mBatches.empty())
+      {
+        auto& last = mBatches.back();
+        auto& first = mPackets[last.first];
+        if (first.shader == packet.shader &&
+            first.material == packet.material &&
+            first.mesh == packet.mesh &&
+            first.lod == packet.lod)
+        {
+          last.count++;
+          continue;
+        }
+      }
+
+      DrawBatch batch;
+      batch.first = i;
+      batch.count = 1;
+      mBatches.push_back(batch);
+    }
+  }
+
+  const vector<DrawPacket>&
+  RenderQueue::getPackets
+  ()
+  const
+  {
+    return mPackets;
+  }
+
+  const vector<DrawBatch>&
+  RenderQueue::getBatches
+  ()
+  const
+  {
+    return mBatches;
+  }
+
+  size_t
+  RenderQueue::countStateChanges
+  ()
+  const
+  {
+    size_t changes = 0;
+    const DrawPacket* last = nullptr;
+    for (auto& batch : mBatches)
+    {
+      auto& packet = mPackets[batch.first];
+      if (!last || last->shader != packet.shader) changes++;
+      if (!last || last->material != packet.material) changes++;
+      last = &packet;
+    }
+    return changes;
+  }
+
+  size_t
+  RenderQueue::getOccludedCount
+  ()
+  const
+  {
+    return mOccludedCount;
+  }
+
+  json
+  RenderQueue::toJson
+  ()
+  const
+  {
+    json js = json::object();
+    js["packets"] = mPackets.size();
+    js["state_changes"] = countStateChanges();
+    js["occluded"] = mOccludedCount;
+
+    json batches = json::array();
+    for (auto& batch : mBatches)
+    {
+      auto& first = mPackets[batch.first];
+      json batchJs = json::object();
+      batchJs["key"] = first.key;
+      batchJs["pass"] = static_cast<int>(first.pass);
+      batchJs["shader"] = first.shader->getName();
+      batchJs["material"] = first.material->getName();
+      batchJs["mesh"] = first.mesh->getName();
+      batchJs["lod"] = first.lod;
+
+      json entities = json::array();
+      for (size_t i = batch.first; i < batch.first + batch.count; i++)
+      {
+        auto& packet = mPackets[i];
+        entities.push_back({{"entity", packet.entity->getName()}, {"depth", packet.depth}});
+      }
+      batchJs["instances"] = entities;
+      batches.push_back(batchJs);
+    }
+    js["batches"] = batches;
+    return js;
+  }
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <json.hpp>
+
+using std::reference_wrapper;
+using std::unordered_map;
+using std::vector;
+using nlohmann::json;
+
+namespace octronic::dream
+{
+  class CameraRuntime;
+  class EntityRuntime;
+  class MaterialRuntime;
+  class ModelMesh;
+  class OcclusionCuller;
+  class WorkerPool;
+  class ShaderRuntime;
+
+  enum RenderPass
+  {
+    RENDER_PASS_GEOMETRY = 0
+  };
+
+  /**
+   * @brief A single mesh of a single visible entity. Packets hold plain
+   * pointers so they can be copied around freely while being sorted.
+   */
+  struct DrawPacket
+  {
+    uint64_t key = 0;
+    RenderPass pass = RENDER_PASS_GEOMETRY;
+    float depth = 0.f;
+    ShaderRuntime* shader = nullptr;
+    MaterialRuntime* material = nullptr;
+    ModelMesh* mesh = nullptr;
+    uint8_t lod = 0;
+    EntityRuntime* entity = nullptr;
+  };
+
+  /**
+   * @brief A run of sorted packets sharing shader, material, mesh and LOD
+   * that can be submitted as one instanced draw.
+   */
+  struct DrawBatch
+  {
+    size_t first = 0;
+    size_t count = 0;
+  };
+
+  /**
+   * @brief RenderQueue separates the geometry pass into cull, build, sort
+   * and submit stages.
+   *
+   * Each visible mesh instance becomes a DrawPacket with a 64 bit sort key.
+   * From most to least significant the key holds the pass, shader,
+   * material, mesh, LOD and quantized camera depth, so after a radix sort
+   * packets are grouped to minimise state changes and drawn front to back
+   * within each group.
+   *
+   * Only submitting touches GL, which is left to the GraphicsComponent.
+   * Everything up to that point only reads entity and camera state, so
+   * the packets can be built on worker threads and the sorted queue can
+   * be dumped with toJson and checked without a GPU.
+   */
+  class RenderQueue
+  {
+  public:
+    const static unsigned int PASS_BITS;
+    const static unsigned int SHADER_BITS;
+    const static unsigned int MATERIAL_BITS;
+    const static unsigned int MESH_BITS;
+    const static unsigned int LOD_BITS;
+    const static unsigned int DEPTH_BITS;
+    /**
+     * @brief Below this number of entities packets are built on the
+     * calling thread.
+     */
+    const static size_t BUILD_THREAD_MIN_ENTITIES;
+
+    static uint64_t MakeSortKey(RenderPass pass, uint32_t shader,
+                                uint32_t material, uint32_t mesh,
+                                uint32_t lod, float depth);
+
+    /**
+     * @brief Least significant digit radix sort of packets by key, 8 bits
+     * per pass. Passes where every key shares the same digit are skipped.
+     */
+    static void RadixSort(vector<DrawPacket>& packets, vector<DrawPacket>& scratch);
+
+    RenderQueue();
+
+    void clear();
+
+    /**
+     * @brief Cull the given entities against the camera and build a packet
+     * for every visible mesh, splitting the work between the calling
+     * thread and the threads of workers when one is given. Meshes hidden
+     * in occlusion's depth buffer are skipped when one is given.
+     */
+    void build(const CameraRuntime& camera,
+               const vector<reference_wrapper<EntityRuntime>>& entities,
+               WorkerPool* workers = nullptr,
+               const OcclusionCuller* occlusion = nullptr);
+
+    /**
+     * @brief Assign keys, sort the packets and group them into batches.
+     */
+    void sort();
+
+    const vector<DrawPacket>& getPackets() const;
+    const vector<DrawBatch>& getBatches() const;
+    size_t countStateChanges() const;
+    /**
+     * @brief Meshes inside the frustum dropped by occlusion culling in the
+     * last build.
+     */
+    size_t getOccludedCount() const;
+
+    /**
+     * @brief Describe the sorted command list, for verifying the queue
+     * without a GPU.
+     */
+    json toJson() const;
+
+  private:
+    static void BuildRange(const CameraRuntime& camera,
+                           const vector<reference_wrapper<EntityRuntime>>& entities,
+                           size_t begin, size_t end,
+                           const OcclusionCuller* occlusion,
+                           vector<DrawPacket>& out, size_t& occluded);
+    uint32_t getId(unordered_map<const void*, uint32_t>& ids, const void* ptr);
+    void assignKeys();
+    void buildBatches();
+
+  private:
+    float mMaxDepth;
+    size_t mOccludedCount;
+    vector<DrawPacket> mPackets;
+    vector<DrawPacket> mScratch;
+    vector<DrawBatch> mBatches;
+    unordered_map<const void*, uint32_t> mShaderIds;
+    unordered_map<const void*, uint32_t> mMaterialIds;
+    unordered_map<const void*, uint32_t> mMeshIds;
+  };
+}
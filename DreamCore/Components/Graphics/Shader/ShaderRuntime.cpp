@@ -46,6 +46,8 @@ namespace octronic::dream
     : SharedAssetRuntime(rt, definition),
       mShaderProgram(0),
       mNeedsRebind(true),
+      mUniformHandles{nullptr},
+      mUsesFrameData(false),
       mVertexCompilationFailed(false),
       mFragmentCompilationFailed(false),
       mLinkingFailed(false),
@@ -265,6 +267,7 @@ namespace octronic::dream
       if (getLoaded())
       {
         LOG_TRACE("ShaderRuntime: Linking successful");
+        resolveUniformHandles();
       }
     }
     return mLoaded;
@@ -284,35 +287,35 @@ namespace octronic::dream
   ShaderRuntime::setModelMatrixUniform
   (mat4 value)
   {
-    addUniform(UNIFORM_TYPE_MATRIX4, UNIFORM_MODEL_MATRIX,1, &value);
+    setUniform(UNIFORM_HANDLE_MODEL_MATRIX, &value);
   }
 
   void
   ShaderRuntime::setViewMatrixUniform
   (mat4 value)
   {
-    addUniform(UNIFORM_TYPE_MATRIX4, UNIFORM_VIEW_MATRIX,1, &value);
+    setUniform(UNIFORM_HANDLE_VIEW_MATRIX, &value);
   }
 
   void
   ShaderRuntime::setProjectionMatrixUniform
   (mat4 value)
   {
-    addUniform(UNIFORM_TYPE_MATRIX4, UNIFORM_PROJECTION_MATRIX,1, &value);
+    setUniform(UNIFORM_HANDLE_PROJECTION_MATRIX, &value);
   }
 
   void
   ShaderRuntime::setCameraPositionUniform
   (vec3 value)
   {
-    addUniform(UNIFORM_TYPE_FLOAT3, UNIFORM_CAMERA_POSITION,1, &value);
+    setUniform(UNIFORM_HANDLE_CAMERA_POSITION, &value);
   }
 
   void
   ShaderRuntime::setColorUniform
   (vec4 color)
   {
-    addUniform(UNIFORM_TYPE_FLOAT4, UNIFORM_COLOR, 1, &color);
+    setUniform(UNIFORM_HANDLE_COLOR, &color);
   }
 
 
@@ -320,41 +323,41 @@ namespace octronic::dream
   ShaderRuntime::setEquirectangularMapUniform
   (GLint map)
   {
-    addUniform(UNIFORM_TYPE_INT1, UNIFORM_EQUIRECTANGULAR_MAP, 1, &map);
+    setUniform(UNIFORM_HANDLE_EQUIRECTANGULAR_MAP, &map);
   }
 
   void
   ShaderRuntime::setEnvironmentMapUniform
   (GLint map)
   {
-    addUniform(UNIFORM_TYPE_INT1, UNIFORM_ENVIRONMENT_MAP, 1, &map);
+    setUniform(UNIFORM_HANDLE_ENVIRONMENT_MAP, &map);
   }
 
   void
   ShaderRuntime::setRoughnessUniform
   (float r)
   {
-    addUniform(UNIFORM_TYPE_FLOAT1, UNIFORM_ROUGHNESS_VALUE, 1, &r);
+    setUniform(UNIFORM_HANDLE_ROUGHNESS_VALUE, &r);
   }
 
   void ShaderRuntime::setIrradianceTextureUniform(GLuint t)
   {
     GLuint tex_id = 5;
-    addUniform(UNIFORM_TYPE_INT1, UNIFORM_IRRADIANCE_TEXTURE, 1, &tex_id);
+    setUniform(UNIFORM_HANDLE_IRRADIANCE_TEXTURE, &tex_id);
     setTexture(GL_TEXTURE5, GL_TEXTURE_CUBE_MAP, t);
   }
 
   void ShaderRuntime::setPreFilterTextureUniform(GLuint t)
   {
     GLuint tex_id = 6;
-    addUniform(UNIFORM_TYPE_INT1, UNIFORM_PREFILTER_TEXTURE, 1, &tex_id);
+    setUniform(UNIFORM_HANDLE_PREFILTER_TEXTURE, &tex_id);
     setTexture(GL_TEXTURE6, GL_TEXTURE_CUBE_MAP, t);
   }
 
   void ShaderRuntime::setBrdfLutTextureUniform(GLuint t)
   {
     GLuint tex_id = 7;
-    addUniform(UNIFORM_TYPE_INT1, UNIFORM_BRDF_LUT_TEXTURE, 1, &tex_id);
+    setUniform(UNIFORM_HANDLE_BRDF_LUT_TEXTURE, &tex_id);
     setTexture(GL_TEXTURE7, GL_TEXTURE_2D, t);
   }
 
@@ -381,7 +384,7 @@ namespace octronic::dream
     {
       if (uniform->getName() == name)
       {
-        LOG_INFO("ShaderRuntime: Updating uniform {}", uniform->getName());
+        LOG_TRACE("ShaderRuntime: Updating uniform {}", uniform->getName());
         uniform->setData(data);
         return;
       }
@@ -398,6 +401,96 @@ namespace octronic::dream
     newUniform->setLocation(location);
   }
 
+  void
+  ShaderRuntime::resolveUniformHandles
+  ()
+  {
+    struct HandleInfo
+    {
+      UniformHandle handle;
+      const char* name;
+      UniformType type;
+      size_t count;
+    };
+
+    static const HandleInfo handles[] =
+    {
+      {UNIFORM_HANDLE_MODEL_MATRIX,        UNIFORM_MODEL_MATRIX,        UNIFORM_TYPE_MATRIX4, 1},
+      {UNIFORM_HANDLE_VIEW_MATRIX,         UNIFORM_VIEW_MATRIX,         UNIFORM_TYPE_MATRIX4, 1},
+      {UNIFORM_HANDLE_PROJECTION_MATRIX,   UNIFORM_PROJECTION_MATRIX,   UNIFORM_TYPE_MATRIX4, 1},
+      {UNIFORM_HANDLE_CAMERA_POSITION,     UNIFORM_CAMERA_POSITION,     UNIFORM_TYPE_FLOAT3,  1},
+      {UNIFORM_HANDLE_COLOR,               UNIFORM_COLOR,               UNIFORM_TYPE_FLOAT4,  1},
+      {UNIFORM_HANDLE_SHADOW_TEXTURE,      UNIFORM_SHADOW_TEXTURE,      UNIFORM_TYPE_INT1,    1},
+      {UNIFORM_HANDLE_SHADOW_SPACE_MATRIX, UNIFORM_SHADOW_SPACE_MATRIX, UNIFORM_TYPE_MATRIX4, 1},
+      {UNIFORM_HANDLE_MODEL_MATRIX_ARRAY,  UNIFORM_MODEL_MATRIX_ARRAY,  UNIFORM_TYPE_MATRIX4, MAX_RUNTIMES},
+      {UNIFORM_HANDLE_MATERIAL_ALBEDO,     UNIFORM_MATERIAL_ALBEDO,     UNIFORM_TYPE_INT1,    1},
+      {UNIFORM_HANDLE_MATERIAL_NORMAL,     UNIFORM_MATERIAL_NORMAL,     UNIFORM_TYPE_INT1,    1},
+      {UNIFORM_HANDLE_MATERIAL_METALLIC,   UNIFORM_MATERIAL_METALLIC,   UNIFORM_TYPE_INT1,    1},
+      {UNIFORM_HANDLE_MATERIAL_ROUGHNESS,  UNIFORM_MATERIAL_ROUGHNESS,  UNIFORM_TYPE_INT1,    1},
+      {UNIFORM_HANDLE_MATERIAL_AO,         UNIFORM_MATERIAL_AO,         UNIFORM_TYPE_INT1,    1},
+      {UNIFORM_HANDLE_EQUIRECTANGULAR_MAP, UNIFORM_EQUIRECTANGULAR_MAP, UNIFORM_TYPE_INT1,    1},
+      {UNIFORM_HANDLE_ENVIRONMENT_MAP,     UNIFORM_ENVIRONMENT_MAP,     UNIFORM_TYPE_INT1,    1},
+      {UNIFORM_HANDLE_ROUGHNESS_VALUE,     UNIFORM_ROUGHNESS_VALUE,     UNIFORM_TYPE_FLOAT1,  1},
+      {UNIFORM_HANDLE_IRRADIANCE_TEXTURE,  UNIFORM_IRRADIANCE_TEXTURE,  UNIFORM_TYPE_INT1,    1},
+      {UNIFORM_HANDLE_PREFILTER_TEXTURE,   UNIFORM_PREFILTER_TEXTURE,   UNIFORM_TYPE_INT1,    1},
+      {UNIFORM_HANDLE_BRDF_LUT_TEXTURE,    UNIFORM_BRDF_LUT_TEXTURE,    UNIFORM_TYPE_INT1,    1},
+      {UNIFORM_HANDLE_LIGHT_POSITIONS,     UNIFORM_LIGHT_POSITIONS,     UNIFORM_TYPE_FLOAT3,  GC_LIGHT_COUNT},
+      {UNIFORM_HANDLE_LIGHT_COLORS,        UNIFORM_LIGHT_COLORS,        UNIFORM_TYPE_FLOAT3,  GC_LIGHT_COUNT},
+    };
+
+    // Large enough for the biggest handle, the model matrix array
+    static const vector<uint8_t> zero(sizeof(mat4) * MAX_RUNTIMES, 0);
+
+    deleteUniforms();
+
+    for (auto& info : handles)
+    {
+      GLint location = getUniformLocation(info.name);
+      // Not used by this shader, setUniform will skip it
+      if (location == UNIFORM_NOT_FOUND) continue;
+
+      auto& uniform = mUniformVector.emplace_back(
+        make_unique<ShaderUniform>(info.type, info.name, info.count, (void*)zero.data()));
+      uniform->setLocation(location);
+      // Nothing to upload until a value is set
+      uniform->setNeedsUpdate(false);
+      mUniformHandles[info.handle] = uniform.get();
+    }
+
+    GLuint blockIndex = glGetUniformBlockIndex(mShaderProgram, UNIFORM_BLOCK_FRAME_DATA);
+    mUsesFrameData = blockIndex != GL_INVALID_INDEX;
+    if (mUsesFrameData)
+    {
+      glUniformBlockBinding(mShaderProgram, blockIndex, FRAME_DATA_BINDING);
+      GLCheckError();
+    }
+
+    LOG_DEBUG("ShaderRuntime: Resolved {} uniform handles for {}, frame data block {}",
+              mUniformVector.size(), getNameAndUuidString(), mUsesFrameData ? "found" : "not found");
+  }
+
+  void
+  ShaderRuntime::setUniform
+  (UniformHandle handle, void* data, size_t count)
+  {
+    ShaderUniform* uniform = mUniformHandles[handle];
+    if (uniform == nullptr) return;
+
+    uniform->setData(data);
+    if (count != 0 && uniform->getCount() != count)
+    {
+      uniform->setCount(count);
+    }
+  }
+
+  bool
+  ShaderRuntime::usesFrameData
+  ()
+  const
+  {
+    return mUsesFrameData;
+  }
+
   void
   ShaderRuntime::syncUniforms
   ()
@@ -810,30 +903,32 @@ namespace octronic::dream
   {
     mUniformVector.clear();
     mUniformLocationCache.clear();
+    for (auto& handle : mUniformHandles) handle = nullptr;
+    mUsesFrameData = false;
   }
 
   void
   ShaderRuntime::setShadowTextureUniform
   (GLint shadow)
   {
-    addUniform(UNIFORM_TYPE_INT1,UNIFORM_SHADOW_TEXTURE ,1, &shadow);
+    setUniform(UNIFORM_HANDLE_SHADOW_TEXTURE, &shadow);
   }
 
   void
   ShaderRuntime::setShadowSpaceMatrixUniform
   (mat4 ssm)
   {
-    addUniform(UNIFORM_TYPE_MATRIX4, UNIFORM_SHADOW_SPACE_MATRIX, 1, & ssm);
+    setUniform(UNIFORM_HANDLE_SHADOW_SPACE_MATRIX, &ssm);
   }
 
   void ShaderRuntime::setLightPositionsUniform(vec3* v, GLuint count)
   {
-    addUniform(UNIFORM_TYPE_FLOAT3, UNIFORM_LIGHT_POSITIONS, count, (void*)v);
+    setUniform(UNIFORM_HANDLE_LIGHT_POSITIONS, (void*)v, count);
   }
 
   void ShaderRuntime::setLightColorsUniform(vec3* v, GLuint count)
   {
-    addUniform(UNIFORM_TYPE_FLOAT3, UNIFORM_LIGHT_COLORS, count, (void*)v);
+    setUniform(UNIFORM_HANDLE_LIGHT_COLORS, (void*)v, count);
   }
 
 
@@ -858,8 +953,8 @@ namespace octronic::dream
     {
       if (CurrentShaderProgram != mShaderProgram)
       {
-        LOG_INFO("ShaderRuntime: Switching Shader Program from {} to {} for {}",
-                 CurrentShaderProgram,mShaderProgram,getNameAndUuidString());
+        LOG_TRACE("ShaderRuntime: Switching Shader Program from {} to {} for {}",
+                  CurrentShaderProgram,mShaderProgram,getNameAndUuidString());
         glUseProgram(mShaderProgram);
         CurrentShaderProgram = mShaderProgram;
       }
@@ -903,9 +998,9 @@ namespace octronic::dream
         GLuint id = albedo.getTextureID();
         if (CurrentTextures[GL_TEXTURE0] != id)
         {
-          LOG_INFO("ShaderRuntime: Found Albedo Texture, binding {}",id);
+          LOG_TRACE("ShaderRuntime: Found Albedo Texture, binding {}",id);
           GLuint albedoIndex = 0;
-          addUniform(UNIFORM_TYPE_INT1, UNIFORM_MATERIAL_ALBEDO, 1, &albedoIndex);
+          setUniform(UNIFORM_HANDLE_MATERIAL_ALBEDO, &albedoIndex);
           setTexture(GL_TEXTURE0, GL_TEXTURE_2D, id);
         }
       }
@@ -920,9 +1015,9 @@ namespace octronic::dream
         GLuint id  =  normal.getTextureID();
         if (CurrentTextures[GL_TEXTURE1] != id)
         {
-          LOG_INFO("ShaderRuntime: Found Normal Texture, binding {}",id);
+          LOG_TRACE("ShaderRuntime: Found Normal Texture, binding {}",id);
           GLuint normalIndex = 1;
-          addUniform(UNIFORM_TYPE_INT1, UNIFORM_MATERIAL_NORMAL, 1, &normalIndex);
+          setUniform(UNIFORM_HANDLE_MATERIAL_NORMAL, &normalIndex);
           setTexture(GL_TEXTURE1, GL_TEXTURE_2D, id);
         }
       }
@@ -937,9 +1032,9 @@ namespace octronic::dream
         GLuint id = metallic.getTextureID();
         if (CurrentTextures[GL_TEXTURE2] != id)
         {
-          LOG_INFO("ShaderRuntime: Found Metallic Texture, binding {}",id);
+          LOG_TRACE("ShaderRuntime: Found Metallic Texture, binding {}",id);
           GLuint metallicIndex = 2;
-          addUniform(UNIFORM_TYPE_INT1, UNIFORM_MATERIAL_METALLIC, 1, &metallicIndex);
+          setUniform(UNIFORM_HANDLE_MATERIAL_METALLIC, &metallicIndex);
           setTexture(GL_TEXTURE2, GL_TEXTURE_2D, id);
         }
       }
@@ -954,9 +1049,9 @@ namespace octronic::dream
         GLuint id = roughness.getTextureID();
         if (CurrentTextures[GL_TEXTURE3] != id)
         {
-          LOG_INFO("ShaderRuntime: Found Roughness Texture, binding {}",id);
+          LOG_TRACE("ShaderRuntime: Found Roughness Texture, binding {}",id);
           GLuint roughnessIndex = 3;
-          addUniform(UNIFORM_TYPE_INT1, UNIFORM_MATERIAL_ROUGHNESS, 1, &roughnessIndex);
+          setUniform(UNIFORM_HANDLE_MATERIAL_ROUGHNESS, &roughnessIndex);
           setTexture(GL_TEXTURE3, GL_TEXTURE_2D, id);
         }
       }
@@ -971,9 +1066,9 @@ namespace octronic::dream
         GLuint id = ao.getTextureID();
         if (CurrentTextures[GL_TEXTURE4] != id)
         {
-          LOG_INFO("ShaderRuntime: Found AO Texture, binding {}",id);
+          LOG_TRACE("ShaderRuntime: Found AO Texture, binding {}",id);
           GLuint aoIndex = 4;
-          addUniform(UNIFORM_TYPE_INT1, UNIFORM_MATERIAL_AO, 1, &aoIndex);
+          setUniform(UNIFORM_HANDLE_MATERIAL_AO, &aoIndex);
           setTexture(GL_TEXTURE4, GL_TEXTURE_2D, id);
         }
       }
@@ -990,7 +1085,7 @@ namespace octronic::dream
 
   void
   ShaderRuntime::bindRuntimes
-  (const vector<reference_wrapper<EntityRuntime>>& runtimes)
+  (const vector<reference_wrapper<EntityRuntime>>& runtimes, const mat4& meshTransform)
   {
     static mat4 data[100];
     size_t nRuntimes = runtimes.size();
@@ -998,10 +1093,10 @@ namespace octronic::dream
     for (size_t i = 0; i<nRuntimes; i++)
     {
       auto& rt = runtimes[i].get();
-      data[i] = rt.getTransform().getMatrix();
+      data[i] = rt.getTransform().getMatrix() * meshTransform;
     }
 
-    addUniform(UNIFORM_TYPE_MATRIX4, UNIFORM_MODEL_MATRIX_ARRAY, nRuntimes, data);
+    setUniform(UNIFORM_HANDLE_MODEL_MATRIX_ARRAY, data, nRuntimes);
   }
 
   void
@@ -1070,6 +1165,15 @@ namespace octronic::dream
     return mVertexSource;
   }
 
+  size_t
+  ShaderRuntime::getCpuMemoryUsage
+  ()
+  const
+  {
+    return mVertexSource.capacity() + mFragmentSource.capacity() +
+        mRuntimeMatricies.capacity() * sizeof(mat4);
+  }
+
   void
   ShaderRuntime::setVertexSource
   (const string& vertexSource)
@@ -1294,6 +1398,8 @@ namespace octronic::dream
   const char* ShaderRuntime::UNIFORM_LIGHT_COLORS            = "uLightColors";
 
   const size_t ShaderRuntime::MAX_RUNTIMES = 100;
+  const char*  ShaderRuntime::UNIFORM_BLOCK_FRAME_DATA = "FrameData";
+  const GLuint ShaderRuntime::FRAME_DATA_BINDING = 0;
 
   map<GLenum,GLuint> ShaderRuntime::CurrentTextures;
   GLuint ShaderRuntime::CurrentShaderProgram = 0;
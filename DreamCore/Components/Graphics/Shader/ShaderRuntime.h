@@ -13,9 +13,11 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <unordered_map>
 
 using std::vector;
 using std::map;
+using std::unordered_map;
 using std::shared_ptr;
 using std::unique_ptr;
 using std::string;
@@ -29,6 +31,36 @@ namespace octronic::dream
     class MaterialRuntime;
     class CameraRuntime;
 
+    /**
+     * @brief Built in uniforms, resolved to a ShaderUniform once when the
+     * program is linked so setting one is an array lookup.
+     */
+    enum UniformHandle
+    {
+        UNIFORM_HANDLE_MODEL_MATRIX,
+        UNIFORM_HANDLE_VIEW_MATRIX,
+        UNIFORM_HANDLE_PROJECTION_MATRIX,
+        UNIFORM_HANDLE_CAMERA_POSITION,
+        UNIFORM_HANDLE_COLOR,
+        UNIFORM_HANDLE_SHADOW_TEXTURE,
+        UNIFORM_HANDLE_SHADOW_SPACE_MATRIX,
+        UNIFORM_HANDLE_MODEL_MATRIX_ARRAY,
+        UNIFORM_HANDLE_MATERIAL_ALBEDO,
+        UNIFORM_HANDLE_MATERIAL_NORMAL,
+        UNIFORM_HANDLE_MATERIAL_METALLIC,
+        UNIFORM_HANDLE_MATERIAL_ROUGHNESS,
+        UNIFORM_HANDLE_MATERIAL_AO,
+        UNIFORM_HANDLE_EQUIRECTANGULAR_MAP,
+        UNIFORM_HANDLE_ENVIRONMENT_MAP,
+        UNIFORM_HANDLE_ROUGHNESS_VALUE,
+        UNIFORM_HANDLE_IRRADIANCE_TEXTURE,
+        UNIFORM_HANDLE_PREFILTER_TEXTURE,
+        UNIFORM_HANDLE_BRDF_LUT_TEXTURE,
+        UNIFORM_HANDLE_LIGHT_POSITIONS,
+        UNIFORM_HANDLE_LIGHT_COLORS,
+        UNIFORM_HANDLE_COUNT
+    };
+
     class ShaderRuntime : public SharedAssetRuntime
     {
     public: // Statics =========================================================
@@ -62,6 +94,13 @@ namespace octronic::dream
         const static char* UNIFORM_LIGHT_POSITIONS;
         const static char* UNIFORM_LIGHT_COLORS;
 
+        /**
+         * @brief std140 block holding the per frame camera and light data
+         * shared by every shader, see GraphicsComponent::updateFrameData.
+         */
+        const static char*  UNIFORM_BLOCK_FRAME_DATA;
+        const static GLuint FRAME_DATA_BINDING;
+
         static map<GLenum,GLuint> CurrentTextures;
         static GLuint CurrentShaderProgram;
         static GLuint CurrentVAO;
@@ -105,6 +144,12 @@ namespace octronic::dream
         void setLightColorsUniform(vec3*, GLuint count);
         void setTexture(GLenum pos, GLenum target, GLuint texture);
 
+        /**
+         * @brief True when the program declares the FrameData block, its
+         * camera and light uniforms then come from the shared UBO.
+         */
+        bool usesFrameData() const;
+
         void syncUniforms();
 
     		bool checkUniformValue(ShaderUniform& uf);
@@ -117,7 +162,12 @@ namespace octronic::dream
         size_t countMaterials() const;
         vector<reference_wrapper<MaterialRuntime>> getMaterialsVector() const;
 
-        void bindRuntimes(const vector<reference_wrapper<EntityRuntime>>& runtimes);
+        /**
+         * @brief Upload each runtime's model matrix, post multiplied by
+         * meshTransform to place a mesh's compact vertices.
+         */
+        void bindRuntimes(const vector<reference_wrapper<EntityRuntime>>& runtimes,
+                          const mat4& meshTransform = mat4(1.f));
 
         // VAO =================================================================
         void bindVertexArray(GLuint);
@@ -136,6 +186,8 @@ namespace octronic::dream
 
         void pushTasks() override;
 
+        size_t getCpuMemoryUsage() const override;
+
         bool performFragmentCompilation();
         bool performVertexCompilation();
         bool performLinking();
@@ -154,6 +206,8 @@ namespace octronic::dream
         bool readFragmentSource();
 
         void addUniform(UniformType type, const string& name, int count, void* data);
+        void setUniform(UniformHandle handle, void* data, size_t count = 0);
+        void resolveUniformHandles();
 
         GLuint getVertexShader() const;
         void setVertexShader(const GLuint& vertexShader);
@@ -171,9 +225,11 @@ namespace octronic::dream
         bool mLinkingFailed;
 
         vector<unique_ptr<ShaderUniform>> mUniformVector;
+        ShaderUniform* mUniformHandles[UNIFORM_HANDLE_COUNT];
+        bool mUsesFrameData;
         vector<reference_wrapper<MaterialRuntime>> mMaterials;
         vector<mat4> mRuntimeMatricies;
-        map<string,GLint> mUniformLocationCache;
+        unordered_map<string,GLint> mUniformLocationCache;
         shared_ptr<ShaderCompileFragmentTask> mCompileFragmentTask;
         shared_ptr<ShaderCompileVertexTask> mCompileVertexTask;
         shared_ptr<ShaderLinkTask> mLinkTask;
@@ -0,0 +1,257 @@
+#include "SpriteBatch.h"
+
+#include "Shader/ShaderRuntime.h"
+
+#include "Common/Logger.h"
+
+#include <glm/vec4.hpp>
+
+using glm::vec4;
+
+namespace octronic::dream
+{
+  const size_t SpriteBatch::VERTICES_PER_QUAD = 4;
+  const size_t SpriteBatch::INDICES_PER_QUAD = 6;
+  const size_t SpriteBatch::INITIAL_CAPACITY = 1024;
+
+  SpriteBatch::SpriteBatch
+  ()
+    : mVAO(0),
+      mVBO(0),
+      mIBO(0),
+      mCapacity(0)
+  {
+  }
+
+  SpriteBatch::~SpriteBatch
+  ()
+  {
+    freeBuffers();
+  }
+
+  void
+  SpriteBatch::clear
+  ()
+  {
+    mItems.clear();
+    mVertices.clear();
+    mGroups.clear();
+    mItemGroups.clear();
+    mGroupIndex.clear();
+  }
+
+  void
+  SpriteBatch::add
+  (GLuint texture, const mat4& transform)
+  {
+    mItems.push_back({texture, transform});
+  }
+
+  void
+  SpriteBatch::build
+  ()
+  {
+    // Unit quad, same corners as the old per sprite triangle strip
+    static const float corners[4][4] =
+    {
+      // x      y     u    v
+      {-1.0f,  1.0f, 0.0f, 1.0f},
+      {-1.0f, -1.0f, 0.0f, 0.0f},
+      { 1.0f,  1.0f, 1.0f, 1.0f},
+      { 1.0f, -1.0f, 1.0f, 0.0f},
+    };
+
+    mGroups.clear();
+    mGroupIndex.clear();
+    mItemGroups.resize(mItems.size());
+
+    // Count quads per texture, groups in order of first use
+    for (size_t i = 0; i < mItems.size(); i++)
+    {
+      GLuint texture = mItems[i].texture;
+      auto itr = mGroupIndex.find(texture);
+      if (itr == mGroupIndex.end())
+      {
+        itr = mGroupIndex.emplace(texture, mGroups.size()).first;
+        SpriteGroup group;
+        group.texture = texture;
+        mGroups.push_back(group);
+      }
+      mItemGroups[i] = itr->second;
+      mGroups[itr->second].quadCount++;
+    }
+
+    size_t offset = 0;
+    for (auto& group : mGroups)
+    {
+      group.firstQuad = offset;
+      offset += group.quadCount;
+      // Reused as the write cursor below
+      group.quadCount = 0;
+    }
+
+    mVertices.resize(mItems.size() * VERTICES_PER_QUAD);
+
+    for (size_t i = 0; i < mItems.size(); i++)
+    {
+      auto& group = mGroups[mItemGroups[i]];
+      const mat4& m = mItems[i].transform;
+      SpriteVertex* out = &mVertices[(group.firstQuad + group.quadCount) * VERTICES_PER_QUAD];
+      group.quadCount++;
+
+      for (size_t c = 0; c < VERTICES_PER_QUAD; c++)
+      {
+        // z is 0 and w is 1, only the x, y and translation columns matter
+        vec4 p = m[0] * corners[c][0] + m[1] * corners[c][1] + m[3];
+        out[c].x = p.x;
+        out[c].y = p.y;
+        out[c].u = corners[c][2];
+        out[c].v = corners[c][3];
+      }
+    }
+  }
+
+  const vector<SpriteVertex>&
+  SpriteBatch::getVertices
+  ()
+  const
+  {
+    return mVertices;
+  }
+
+  const vector<SpriteGroup>&
+  SpriteBatch::getGroups
+  ()
+  const
+  {
+    return mGroups;
+  }
+
+  size_t
+  SpriteBatch::getQuadCount
+  ()
+  const
+  {
+    return mVertices.size() / VERTICES_PER_QUAD;
+  }
+
+  // GL ======================================================================
+
+  bool
+  SpriteBatch::setupBuffers
+  ()
+  {
+    LOG_TRACE("SpriteBatch: {}",__FUNCTION__);
+
+    glGenVertexArrays(1, &mVAO);
+    GLCheckError();
+    glGenBuffers(1, &mVBO);
+    GLCheckError();
+    glGenBuffers(1, &mIBO);
+    GLCheckError();
+
+    glBindVertexArray(mVAO);
+    GLCheckError();
+    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+    GLCheckError();
+    glEnableVertexAttribArray(0);
+    GLCheckError();
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)0);
+    GLCheckError();
+    // The element buffer binding is part of the VAO's state
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIBO);
+    GLCheckError();
+
+    bool result = resize(INITIAL_CAPACITY);
+
+    glBindVertexArray(0);
+    GLCheckError();
+    ShaderRuntime::CurrentVAO = 0;
+    return result;
+  }
+
+  void
+  SpriteBatch::freeBuffers
+  ()
+  {
+    if (mIBO > 0) glDeleteBuffers(1, &mIBO);
+    if (mVBO > 0) glDeleteBuffers(1, &mVBO);
+    if (mVAO > 0) glDeleteVertexArrays(1, &mVAO);
+    mIBO = 0;
+    mVBO = 0;
+    mVAO = 0;
+    mCapacity = 0;
+  }
+
+  bool
+  SpriteBatch::resize
+  (size_t capacity)
+  {
+    LOG_DEBUG("SpriteBatch: Resizing buffers from {} to {} quads", mCapacity, capacity);
+
+    vector<GLuint> indices(capacity * INDICES_PER_QUAD);
+    for (size_t q = 0; q < capacity; q++)
+    {
+      GLuint base = static_cast<GLuint>(q * VERTICES_PER_QUAD);
+      GLuint* out = &indices[q * INDICES_PER_QUAD];
+      out[0] = base + 0; out[1] = base + 1; out[2] = base + 2;
+      out[3] = base + 2; out[4] = base + 1; out[5] = base + 3;
+    }
+
+    // Expects mVAO to be bound
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+    GLCheckError();
+    glBufferData(GL_ARRAY_BUFFER, capacity * VERTICES_PER_QUAD * sizeof(SpriteVertex), nullptr, GL_STREAM_DRAW);
+    GLCheckError();
+    mCapacity = capacity;
+    return true;
+  }
+
+  void
+  SpriteBatch::upload
+  ()
+  {
+    size_t quads = getQuadCount();
+    if (mVAO == 0 || quads == 0) return;
+
+    ShaderRuntime::CurrentVAO = mVAO;
+    glBindVertexArray(mVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+    GLCheckError();
+
+    if (quads > mCapacity)
+    {
+      size_t capacity = mCapacity == 0 ? INITIAL_CAPACITY : mCapacity;
+      while (capacity < quads) capacity *= 2;
+      resize(capacity);
+    }
+    else
+    {
+      // Orphan last frame's storage so the driver need not wait on it
+      glBufferData(GL_ARRAY_BUFFER, mCapacity * VERTICES_PER_QUAD * sizeof(SpriteVertex), nullptr, GL_STREAM_DRAW);
+      GLCheckError();
+    }
+
+    glBufferSubData(GL_ARRAY_BUFFER, 0, mVertices.size() * sizeof(SpriteVertex), mVertices.data());
+    GLCheckError();
+  }
+
+  void
+  SpriteBatch::draw
+  (ShaderRuntime& shader)
+  {
+    if (mVAO == 0 || mGroups.empty()) return;
+
+    shader.bindVertexArray(mVAO);
+
+    for (auto& group : mGroups)
+    {
+      shader.setTexture(GL_TEXTURE0, GL_TEXTURE_2D, group.texture);
+      glDrawElements(GL_TRIANGLES,
+                     static_cast<GLsizei>(group.quadCount * INDICES_PER_QUAD),
+                     GL_UNSIGNED_INT,
+                     (void*)(group.firstQuad * INDICES_PER_QUAD * sizeof(GLuint)));
+      GLCheckError();
+    }
+  }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Common/GLHeader.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <glm/matrix.hpp>
+
+using glm::mat4;
+using std::unordered_map;
+using std::vector;
+
+namespace octronic::dream
+{
+  class ShaderRuntime;
+
+  /**
+   * @brief A sprite corner already transformed into screen space. Matches
+   * the Sprite shader's single vec4 coord attribute, xy position and zw
+   * texture coordinates.
+   */
+  struct SpriteVertex
+  {
+    float x = 0.f;
+    float y = 0.f;
+    float u = 0.f;
+    float v = 0.f;
+  };
+
+  /**
+   * @brief A run of quads sharing a texture, drawn with one call.
+   */
+  struct SpriteGroup
+  {
+    GLuint texture = 0;
+    size_t firstQuad = 0;
+    size_t quadCount = 0;
+  };
+
+  /**
+   * @brief SpriteBatch draws every sprite in a frame from one dynamic
+   * vertex buffer.
+   *
+   * Sprites are added with their texture and model matrix, build() then
+   * transforms the unit quad of each on the CPU and writes the corners
+   * grouped by texture, groups ordered by first use. upload() orphans the
+   * buffer and copies the whole frame in one call, and draw() issues one
+   * indexed draw per texture.
+   *
+   * Building does not touch GL so it can be run and measured without a
+   * context, see DreamBench.
+   */
+  class SpriteBatch
+  {
+  public:
+    const static size_t VERTICES_PER_QUAD;
+    const static size_t INDICES_PER_QUAD;
+    const static size_t INITIAL_CAPACITY;
+
+    SpriteBatch();
+    ~SpriteBatch();
+
+    SpriteBatch(const SpriteBatch&) = delete;
+    SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+    void clear();
+    void add(GLuint texture, const mat4& transform);
+
+    /**
+     * @brief Transform and group the added sprites into the vertex array.
+     */
+    void build();
+
+    const vector<SpriteVertex>& getVertices() const;
+    const vector<SpriteGroup>& getGroups() const;
+    size_t getQuadCount() const;
+
+    // GL ==================================================================
+    bool setupBuffers();
+    void freeBuffers();
+    /**
+     * @brief Copy the built vertices to the GPU, growing the buffers when
+     * the frame has more quads than they hold.
+     */
+    void upload();
+    void draw(ShaderRuntime& shader);
+
+  private:
+    struct SpriteItem
+    {
+      GLuint texture;
+      mat4 transform;
+    };
+
+    bool resize(size_t capacity);
+
+  private:
+    vector<SpriteItem> mItems;
+    vector<SpriteVertex> mVertices;
+    vector<SpriteGroup> mGroups;
+    vector<size_t> mItemGroups;
+    unordered_map<GLuint, size_t> mGroupIndex;
+    GLuint mVAO;
+    GLuint mVBO;
+    GLuint mIBO;
+    size_t mCapacity;
+  };
+}
@@ -223,6 +223,63 @@ namespace octronic::dream
     return 0;
   }
 
+  // Memory ==================================================================
+
+  size_t
+  TextureRuntime::getCpuMemoryUsage
+  ()
+  const
+  {
+    if (mRawImageData == nullptr) return 0;
+    size_t channelSize = mIsHDR ? sizeof(float) : sizeof(uint8_t);
+    return static_cast<size_t>(mWidth) * mHeight * mChannels * channelSize;
+  }
+
+  size_t
+  TextureRuntime::getGpuMemoryUsage
+  ()
+  const
+  {
+    // A full mip chain adds a third
+    auto withMips = [](size_t bytes) { return bytes + bytes / 3; };
+    // GL_RGB16F
+    const size_t halfRgb = 6;
+    size_t bytes = 0;
+
+    if (mGLTextureID != 0)
+    {
+      size_t texel = mIsHDR ? halfRgb : static_cast<size_t>(mChannels);
+      bytes += withMips(static_cast<size_t>(mWidth) * mHeight * texel);
+    }
+
+    if (mEquiToCubeTexture != 0)
+    {
+      bytes += withMips(6 * halfRgb * ENVIRONMENT_CUBE_SIZE * ENVIRONMENT_CUBE_SIZE);
+    }
+
+    if (mIrradianceMapTexture != 0)
+    {
+      bytes += 6 * halfRgb * IRRADIANCE_CUBE_SIZE * IRRADIANCE_CUBE_SIZE;
+    }
+
+    if (mPreFilterCubeMapTexture != 0)
+    {
+      bytes += withMips(6 * halfRgb * PREFILTER_CUBE_SIZE * PREFILTER_CUBE_SIZE);
+    }
+
+    // GL_RG16F LUT and the capture depth buffer are 4 bytes per texel
+    if (mBrdfLutTexture != 0)
+    {
+      bytes += 4 * BRDF_LUT_SIZE * BRDF_LUT_SIZE;
+    }
+
+    if (mCaptureRBO != 0)
+    {
+      bytes += 4 * BRDF_LUT_SIZE * BRDF_LUT_SIZE;
+    }
+    return bytes;
+  }
+
   // Loading =================================================================
 
   bool
@@ -423,7 +480,7 @@ namespace octronic::dream
       glGenRenderbuffers(1, &mCaptureRBO);
       glBindFramebuffer(GL_FRAMEBUFFER, mCaptureFBO);
       glBindRenderbuffer(GL_RENDERBUFFER, mCaptureRBO);
-      glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 512, 512);
+      glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, ENVIRONMENT_CUBE_SIZE, ENVIRONMENT_CUBE_SIZE);
       glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, mCaptureRBO);
       mRemoveFromGLTask->setCaptureBuffers(mCaptureFBO,mCaptureRBO);
     }
@@ -449,7 +506,7 @@ namespace octronic::dream
       for (unsigned int i = 0; i < 6; ++i)
       {
         // note that we store each face with 16 bit floating point values
-        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 512, 512, 0, GL_RGB, GL_FLOAT, nullptr);
+        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, ENVIRONMENT_CUBE_SIZE, ENVIRONMENT_CUBE_SIZE, 0, GL_RGB, GL_FLOAT, nullptr);
         GLCheckError();
       }
 
@@ -470,7 +527,7 @@ namespace octronic::dream
       glBindTexture(GL_TEXTURE_2D, mGLTextureID);
       GLCheckError();
 
-      glViewport(0, 0, 512, 512); // don't forget to configure the viewport to the capture dimensions.
+      glViewport(0, 0, ENVIRONMENT_CUBE_SIZE, ENVIRONMENT_CUBE_SIZE); // don't forget to configure the viewport to the capture dimensions.
       GLCheckError();
 
       glBindFramebuffer(GL_FRAMEBUFFER, mCaptureFBO);
@@ -525,7 +582,7 @@ namespace octronic::dream
 
       for (unsigned int i = 0; i < 6; ++i)
       {
-        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 32, 32, 0, GL_RGB, GL_FLOAT, nullptr);
+        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, IRRADIANCE_CUBE_SIZE, IRRADIANCE_CUBE_SIZE, 0, GL_RGB, GL_FLOAT, nullptr);
         GLCheckError();
       }
 
@@ -538,7 +595,7 @@ namespace octronic::dream
 
       glBindFramebuffer(GL_FRAMEBUFFER, mCaptureFBO);
       glBindRenderbuffer(GL_RENDERBUFFER, mCaptureRBO);
-      glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 32, 32);
+      glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, IRRADIANCE_CUBE_SIZE, IRRADIANCE_CUBE_SIZE);
       GLCheckError();
 
       // pbr: solve diffuse integral by convolution to create an irradiance (cube)map.
@@ -551,7 +608,7 @@ namespace octronic::dream
       glBindTexture(GL_TEXTURE_CUBE_MAP, mEquiToCubeTexture);
       GLCheckError();
 
-      glViewport(0, 0, 32, 32); // don't forget to configure the viewport to the capture dimensions.
+      glViewport(0, 0, IRRADIANCE_CUBE_SIZE, IRRADIANCE_CUBE_SIZE); // don't forget to configure the viewport to the capture dimensions.
       glBindFramebuffer(GL_FRAMEBUFFER, mCaptureFBO);
       GLCheckError();
 
@@ -601,7 +658,7 @@ namespace octronic::dream
 
       for (unsigned int i = 0; i < 6; ++i)
       {
-        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 128, 128, 0, GL_RGB, GL_FLOAT, nullptr);
+        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, PREFILTER_CUBE_SIZE, PREFILTER_CUBE_SIZE, 0, GL_RGB, GL_FLOAT, nullptr);
         GLCheckError();
       }
 
@@ -633,8 +690,8 @@ namespace octronic::dream
       for (unsigned int mip = 0; mip < maxMipLevels; ++mip)
       {
         // reisze framebuffer according to mip-level size.
-        unsigned int mipWidth = 128 * std::pow(0.5, mip);
-        unsigned int mipHeight = 128 * std::pow(0.5, mip);
+        unsigned int mipWidth = PREFILTER_CUBE_SIZE * std::pow(0.5, mip);
+        unsigned int mipHeight = PREFILTER_CUBE_SIZE * std::pow(0.5, mip);
         glBindRenderbuffer(GL_RENDERBUFFER, mCaptureRBO);
         glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24,
                               mipWidth, mipHeight);
@@ -687,7 +744,7 @@ namespace octronic::dream
 
       // pre-allocate enough memory for the LUT texture.
       glBindTexture(GL_TEXTURE_2D, mBrdfLutTexture);
-      glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, 512, 512, 0, GL_RG, GL_FLOAT, 0);
+      glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, BRDF_LUT_SIZE, BRDF_LUT_SIZE, 0, GL_RG, GL_FLOAT, 0);
       GLCheckError();
 
       // be sure to set wrapping mode to GL_CLAMP_TO_EDGE
@@ -700,11 +757,11 @@ namespace octronic::dream
       // then re-configure capture framebuffer object and render screen-space quad with BRDF shader.
       glBindFramebuffer(GL_FRAMEBUFFER, mCaptureFBO);
       glBindRenderbuffer(GL_RENDERBUFFER, mCaptureRBO);
-      glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 512, 512);
+      glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, BRDF_LUT_SIZE, BRDF_LUT_SIZE);
       glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mBrdfLutTexture, 0);
       GLCheckError();
 
-      glViewport(0, 0, 512, 512);
+      glViewport(0, 0, BRDF_LUT_SIZE, BRDF_LUT_SIZE);
       GLCheckError();
 
       brdfLutShader.use();
@@ -887,6 +944,11 @@ namespace octronic::dream
     glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3( 0.0f,  0.0f, -1.0f), glm::vec3(0.0f, -1.0f,  0.0f))
   };
 
+  const int TextureRuntime::ENVIRONMENT_CUBE_SIZE = 512;
+  const int TextureRuntime::IRRADIANCE_CUBE_SIZE = 32;
+  const int TextureRuntime::PREFILTER_CUBE_SIZE = 128;
+  const int TextureRuntime::BRDF_LUT_SIZE = 512;
+
   const float TextureRuntime::CubeVertices[288] =
   {
     // [ Translation(3) -- Normal(3) -- UV(2) ]
@@ -83,6 +83,15 @@ namespace octronic::dream
 
     GLuint getCubeDebugTexture();
 
+    size_t getCpuMemoryUsage() const override;
+    size_t getGpuMemoryUsage() const override;
+
+    // Sizes of the textures made for an environment texture
+    const static int ENVIRONMENT_CUBE_SIZE;
+    const static int IRRADIANCE_CUBE_SIZE;
+    const static int PREFILTER_CUBE_SIZE;
+    const static int BRDF_LUT_SIZE;
+
   private:
     CubeDebugMode mCubeDebugMode;
     bool mIsHDR;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <cstdint>
 
 using glm::vec2;
 using glm::vec3;
@@ -14,4 +15,18 @@ namespace octronic::dream
     vec2 TexCoords;
     vec3 Normal;
   };
+
+  /**
+   * @brief 16 byte vertex for meshes imported with compact vertices.
+   *
+   * Position is snorm16 relative to the mesh's bounding box centre and
+   * scaled by its largest half extent, undone by ModelMesh's vertex
+   * transform. Normal is snorm 10:10:10:2 and TexCoords two half floats.
+   */
+  struct CompactVertex
+  {
+    int16_t Position[4];
+    uint32_t Normal;
+    uint32_t TexCoords;
+  };
 }
@@ -83,13 +83,18 @@ namespace octronic::dream
     if (mProjectRuntime)
     {
       auto& time = getProjectRuntime().getTime();
-      double time_delta = time.getFrameTimeDelta()/1000.0;
+      unsigned int ticks = time.getTicksThisFrame();
 
-      LOG_TRACE("PhysicsComponent: {}", __FUNCTION__, time_delta);
+      LOG_TRACE("PhysicsComponent: {} {} ticks", __FUNCTION__, ticks);
 
-      if (time_delta > 0.0)
+      if (ticks > 0)
       {
-        mDynamicsWorld->stepSimulation(time_delta);
+        // One step per tick Time took, with no substeps, so Bullet keeps no
+        // accumulator of its own and the tick counts always agree
+        for (unsigned int i = 0; i < ticks; i++)
+        {
+          mDynamicsWorld->stepSimulation(time.getTickDelta(), 0);
+        }
         if (mDebugDrawer) mDynamicsWorld->debugDrawWorld();
         checkContactManifolds();
       }
@@ -248,9 +253,7 @@ namespace octronic::dream
   (SceneRuntime& scene,
    const btCollisionObject* collObj)
   {
-    auto flatVector = scene.getFlatVector();
-
-    for (auto& next : flatVector)
+    for (auto& next : scene.getFlatView())
     {
       auto& er = next.get();
       if (er.hasPhysicsRuntime())
@@ -66,6 +66,16 @@ _octronic_dream_sol_print(lua_State* L)
   return 0;
 }
 
+// Lua tables of EntityRuntime pointers, for the SceneRuntime spatial queries
+static std::vector<octronic::dream::EntityRuntime*>
+ToPointers(const std::vector<std::reference_wrapper<octronic::dream::EntityRuntime>>& entities)
+{
+  std::vector<octronic::dream::EntityRuntime*> result;
+  result.reserve(entities.size());
+  for (auto& entity : entities) result.push_back(&entity.get());
+  return result;
+}
+
 static const struct luaL_Reg printlib [] = {{"print", _octronic_dream_sol_print}, {nullptr, nullptr}};
 
 int _octronic_dream_sol_exception_handler
@@ -566,6 +576,12 @@ namespace octronic::dream // ===================================================
           "getCurrentFrameTime",&Time::getCurrentFrameTime,
           "getLastFrameTime",&Time::getLastFrameTime,
           "getFrameTimeDelta",&Time::getFrameTimeDelta,
+          "getFrameTimeDeltaSeconds",&Time::getFrameTimeDeltaSeconds,
+          "getFrameCount",&Time::getFrameCount,
+          "getTickCount",&Time::getTickCount,
+          "getTicksThisFrame",&Time::getTicksThisFrame,
+          "getTickDelta",&Time::getTickDelta,
+          "getTickAlpha",&Time::getTickAlpha,
           "perSecond",&Time::perSecond);
 
     auto& time = getProjectRuntime().getTime();
@@ -829,6 +845,7 @@ namespace octronic::dream // ===================================================
           "AudioRuntime",
           "getState",&AudioRuntime::getState,
           "play",&AudioRuntime::play,
+          "playVoice",&AudioRuntime::playVoice,
           "pause",&AudioRuntime::pause,
           "stop",&AudioRuntime::stop);
 
@@ -837,6 +854,11 @@ namespace octronic::dream // ===================================================
           "PLAYING", AudioStatus::AUDIO_STATUS_PLAYING,
           "PAUSED",  AudioStatus::AUDIO_STATUS_PAUSED,
           "STOPPED", AudioStatus::AUDIO_STATUS_STOPPED);
+
+    stateView.new_enum(
+          "AudioVoice",
+          "NONE",     AudioComponent::VOICE_NONE,
+          "STREAMED", AudioComponent::VOICE_STREAMED);
   }
 
   void
@@ -850,7 +872,15 @@ namespace octronic::dream // ===================================================
           sol::base_classes, sol::bases<Runtime>(),
           "getCameraRuntime",&SceneRuntime::getCameraRuntime,
           "getProjectRuntime", &SceneRuntime::getProjectRuntime,
-          "getEntityRuntimeByUuid",&SceneRuntime::getEntityRuntimeByUuid);
+          "getEntityRuntimeByUuid",&SceneRuntime::getEntityRuntimeByUuid,
+          "getEntitiesInFrustum",
+          [](SceneRuntime& sr) { return sol::as_table(ToPointers(sr.getEntitiesInFrustum(sr.getCameraRuntime().getFrustum()))); },
+          "getEntitiesInSphere",
+          [](SceneRuntime& sr, const vec3& center, float radius) { return sol::as_table(ToPointers(sr.getEntitiesInSphere(center, radius))); },
+          "getEntitiesAlongRay",
+          [](SceneRuntime& sr, const vec3& origin, const vec3& direction, float maxDistance) { return sol::as_table(ToPointers(sr.getEntitiesAlongRay(origin, direction, maxDistance))); },
+          "getNearestEntities",
+          [](SceneRuntime& sr, const vec3& point, size_t count) { return sol::as_table(ToPointers(sr.getNearestEntities(point, count))); });
   }
 
   void
@@ -1030,12 +1060,23 @@ namespace octronic::dream // ===================================================
     return mLuaState;
   }
 
+  void
+  ScriptComponent::setRandomSeed
+  (uint32_t seed)
+  {
+    if (mLuaState == nullptr) return;
+    LOG_DEBUG("ScriptComponent: Seeding math.random with {}", seed);
+    sol::state_view sView(mLuaState);
+    sol::protected_function randomSeed = sView["math"]["randomseed"];
+    randomSeed(seed);
+  }
+
   void ScriptComponent::pushTasks()
   {
     auto& scriptCache = getProjectRuntime().getScriptCache();
-    for (auto& scriptRuntime : scriptCache.getRuntimeVector())
+    for (auto& scriptRuntime : scriptCache.getRuntimeView())
     {
-      scriptRuntime.get().pushTasks();
+      scriptRuntime.pushTasks();
     }
   }
 
@@ -45,6 +45,10 @@ namespace octronic::dream
 
     void pushTasks() override;
     lua_State* getLuaState() const;
+    /**
+     * @brief Seed Lua's math.random, does nothing before init.
+     */
+    void setRandomSeed(uint32_t seed);
 
 
   private:
@@ -88,6 +88,14 @@ namespace octronic::dream
     mSource = source;
   }
 
+  size_t
+  ScriptRuntime::getCpuMemoryUsage
+  ()
+  const
+  {
+    return mSource.capacity();
+  }
+
   // Function Execution =======================================================
 
   bool
@@ -38,6 +38,8 @@ namespace octronic::dream
 
         bool hasSource() const;
 
+        size_t getCpuMemoryUsage() const override;
+
     private:
         string mSource;
     };
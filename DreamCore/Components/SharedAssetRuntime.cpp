@@ -61,6 +61,14 @@ namespace octronic::dream
     return mInstances;
   }
 
+  const vector<reference_wrapper<EntityRuntime>>&
+  SharedAssetRuntime::getInstanceView
+  ()
+  const
+  {
+    return mInstances;
+  }
+
   bool
   SharedAssetRuntime::getReloadFlag
   ()
@@ -75,4 +83,20 @@ namespace octronic::dream
   {
     mReloadFlag = reloadFlag;
   }
+
+  size_t
+  SharedAssetRuntime::getCpuMemoryUsage
+  ()
+  const
+  {
+    return 0;
+  }
+
+  size_t
+  SharedAssetRuntime::getGpuMemoryUsage
+  ()
+  const
+  {
+    return 0;
+  }
 }
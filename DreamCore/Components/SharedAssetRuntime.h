@@ -28,10 +28,22 @@ namespace octronic::dream
         void removeInstance(EntityRuntime& er);
         void removeInstanceByUuid(UuidType spriteUuid);
         vector<reference_wrapper<EntityRuntime>> getInstanceVector() const;
+        // Instances without copying, invalidated by add/removeInstance
+        const vector<reference_wrapper<EntityRuntime>>& getInstanceView() const;
 
         bool getReloadFlag() const;
         void setReloadFlag(bool reloadFlag);
 
+        /**
+         * @return Bytes of asset data this runtime holds in RAM.
+         */
+        virtual size_t getCpuMemoryUsage() const;
+
+        /**
+         * @return Estimated bytes of GL objects owned by this runtime.
+         */
+        virtual size_t getGpuMemoryUsage() const;
+
     protected:
         vector<reference_wrapper<EntityRuntime>> mInstances;
         bool mReloadFlag;
@@ -1,15 +1,28 @@
 #include "Time.h"
 
 #include "Common/Logger.h"
+#include "Common/SteadyClock.h"
 #include <iostream>
 
 namespace octronic::dream
 {
+    namespace
+    {
+        const double NANOS_PER_SECOND = 1e9;
+        const uint64_t NANOS_PER_MILLI = 1000000;
+    }
+
     Time::Time
     ()
         : mCurrentFrameTime(0),
-          mLastFrameTime(0)
+          mLastFrameTime(0),
+          mFrameCount(0),
+          mTickLength(0),
+          mTickAccumulator(0),
+          mTickCount(0),
+          mTicksThisFrame(0)
     {
+        setTickRate(DEFAULT_TICK_RATE);
     }
 
     Time::~Time
@@ -23,15 +36,42 @@ namespace octronic::dream
     ()
     {
         LOG_DEBUG( "Time: Update Called" );
+        advanceTo(SteadyClock::Now());
+    }
+
+    void
+    Time::updateFrameTime
+    (uint64_t deltaNanos)
+    {
+        LOG_DEBUG( "Time: Update Called with {} ns", deltaNanos );
+        // The first frame starts from the clock like any other run
+        advanceTo(mCurrentFrameTime == 0 ? SteadyClock::Now() : mCurrentFrameTime + deltaNanos);
+    }
+
+    void
+    Time::advanceTo
+    (uint64_t now)
+    {
         mLastFrameTime = mCurrentFrameTime;
-        mCurrentFrameTime = std::chrono::duration_cast<std::chrono::milliseconds>
-                (steady_clock::now().time_since_epoch()).count();
+        mCurrentFrameTime = now;
 
         // Ignore the huge delta on first start
         if (mLastFrameTime == 0)
         {
             mLastFrameTime = mCurrentFrameTime;
         }
+        mFrameCount++;
+
+        mTickAccumulator += getFrameTimeDeltaNanos();
+        mTicksThisFrame = static_cast<unsigned int>(mTickAccumulator / mTickLength);
+        if (mTicksThisFrame > MAX_TICKS_PER_FRAME)
+        {
+            LOG_DEBUG("Time: Dropping {} ticks", mTicksThisFrame - MAX_TICKS_PER_FRAME);
+            mTicksThisFrame = MAX_TICKS_PER_FRAME;
+            mTickAccumulator = mTickLength * MAX_TICKS_PER_FRAME;
+        }
+        mTickAccumulator -= mTickLength * mTicksThisFrame;
+        mTickCount += mTicksThisFrame;
         show();
     }
 
@@ -40,10 +80,11 @@ namespace octronic::dream
     ()
     {
         LOG_TRACE(
-                    "Time: CurrentTime: {}, LastTime: {}, DeltaTime: {}" ,
+                    "Time: CurrentTime: {}, LastTime: {}, DeltaTime: {}, Ticks: {}" ,
                     getCurrentFrameTime(),
                     getLastFrameTime(),
-                    getFrameTimeDelta()
+                    getFrameTimeDelta(),
+                    getTicksThisFrame()
                     );
     }
 
@@ -51,28 +92,56 @@ namespace octronic::dream
     Time::getCurrentFrameTime
     ()
     {
-        return mCurrentFrameTime;
+        return static_cast<long>(mCurrentFrameTime / NANOS_PER_MILLI);
     }
 
     long
     Time::getLastFrameTime
     ()
     {
-        return mLastFrameTime;
+        return static_cast<long>(mLastFrameTime / NANOS_PER_MILLI);
     }
 
-    long
+    double
     Time::getFrameTimeDelta
     ()
+    {
+        return static_cast<double>(getFrameTimeDeltaNanos()) / NANOS_PER_MILLI;
+    }
+
+    double
+    Time::getFrameTimeDeltaSeconds
+    ()
+    {
+        return static_cast<double>(getFrameTimeDeltaNanos()) / NANOS_PER_SECOND;
+    }
+
+    uint64_t
+    Time::getFrameTimeDeltaNanos
+    ()
     {
         return mCurrentFrameTime - mLastFrameTime;
     }
 
+    uint64_t
+    Time::getCurrentFrameTimeNanos
+    ()
+    {
+        return mCurrentFrameTime;
+    }
+
+    unsigned long
+    Time::getFrameCount
+    ()
+    {
+        return mFrameCount;
+    }
+
     double
     Time::perSecond
     (double value)
     {
-        double scalar = getFrameTimeDelta()/1000.0;
+        double scalar = getFrameTimeDeltaSeconds();
         double ret = value*scalar;
         LOG_TRACE("Time: Scaled by time {} to {} with {}",value,ret,scalar);
         return ret;
@@ -82,10 +151,67 @@ namespace octronic::dream
     Time::getAbsoluteTime
     ()
     {
-        return std::chrono::duration_cast<std::chrono::milliseconds>
-                (steady_clock::now().time_since_epoch()).count();
+        return static_cast<long>(SteadyClock::Now() / NANOS_PER_MILLI);
     }
 
-    const int Time::DELTA_MAX = 100;
+    // Fixed Ticks =============================================================
+
+    void
+    Time::setTickRate
+    (double ticksPerSecond)
+    {
+        if (ticksPerSecond <= 0.0)
+        {
+            LOG_ERROR("Time: Invalid tick rate {}", ticksPerSecond);
+            return;
+        }
+        mTickLength = static_cast<uint64_t>(NANOS_PER_SECOND / ticksPerSecond + 0.5);
+        if (mTickLength == 0) mTickLength = 1;
+    }
+
+    double
+    Time::getTickRate
+    ()
+    {
+        return NANOS_PER_SECOND / mTickLength;
+    }
+
+    double
+    Time::getTickDelta
+    ()
+    {
+        return mTickLength / NANOS_PER_SECOND;
+    }
+
+    unsigned long
+    Time::getTickCount
+    ()
+    {
+        return mTickCount;
+    }
+
+    unsigned int
+    Time::getTicksThisFrame
+    ()
+    {
+        return mTicksThisFrame;
+    }
+
+    double
+    Time::getTickAlpha
+    ()
+    {
+        return static_cast<double>(mTickAccumulator) / mTickLength;
+    }
 
+    void
+    Time::resetTickAccumulator
+    ()
+    {
+        mTickAccumulator = 0;
+    }
+
+    const int Time::DELTA_MAX = 100;
+    const double Time::DEFAULT_TICK_RATE = 60.0;
+    const unsigned int Time::MAX_TICKS_PER_FRAME = 8;
 }
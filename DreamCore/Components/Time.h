@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 
 using std::chrono::time_point;
 using std::chrono::steady_clock;
@@ -10,9 +11,15 @@ using std::chrono::seconds;
 namespace octronic::dream
 {
     /**
-     * @brief Manages timinng features for Dream. All times use
-     * std::steady_clock and are reported in fractions of a second.
-     * e.g. 0.34s, 2.38s etc...
+     * @brief Manages timinng features for Dream. Frame times are taken from
+     * SteadyClock and kept as whole nanoseconds, so deltas do not
+     * drift or quantize at high frame rates. Millisecond accessors are kept
+     * for scripts and scene lifetimes, deltas are reported as doubles.
+     *
+     * Time also counts fixed simulation ticks. Each frame's delta is added
+     * to an accumulator and whole ticks are taken from it, so systems that
+     * need a fixed step can run getTicksThisFrame steps of getTickDelta
+     * seconds and interpolate by getTickAlpha.
      */
     class Time
     {
@@ -28,19 +35,39 @@ namespace octronic::dream
         ~Time();
 
         /**
-         * @return Gets the time that the current frame begain
+         * @return Gets the time that the current frame begain in ms
          */
         long getCurrentFrameTime();
 
         /**
-         * @return Get the time that the last frame began
+         * @return Get the time that the last frame began in ms
          */
         long getLastFrameTime();
 
         /**
-         * @return Get the delta between this frame and the last
+         * @return Get the delta between this frame and the last in ms
          */
-        long getFrameTimeDelta();
+        double getFrameTimeDelta();
+
+        /**
+         * @return Get the delta between this frame and the last in seconds
+         */
+        double getFrameTimeDeltaSeconds();
+
+        /**
+         * @return Get the delta between this frame and the last in ns
+         */
+        uint64_t getFrameTimeDeltaNanos();
+
+        /**
+         * @return Gets the time that the current frame began in ns
+         */
+        uint64_t getCurrentFrameTimeNanos();
+
+        /**
+         * @return Number of times updateFrameTime has been called.
+         */
+        unsigned long getFrameCount();
 
         /**
          * @brief Scale the value passed by the amount of time that has passed
@@ -49,10 +76,17 @@ namespace octronic::dream
         double perSecond(double value);
 
         /**
-         * @brief Update the current and last frame time values.
+         * @brief Update the current and last frame time values and take
+         * any whole simulation ticks from the accumulator.
          */
         void updateFrameTime();
 
+        /**
+         * @brief As updateFrameTime, but the frame lasted deltaNanos rather
+         * than the time since the last call. Used to replay a recorded run.
+         */
+        void updateFrameTime(uint64_t deltaNanos);
+
         /**
          * @brief Print Debug information about the Time object's state.
          */
@@ -64,17 +98,68 @@ namespace octronic::dream
          */
         long getAbsoluteTime();
 
+        // Fixed Ticks =========================================================
+
+        /**
+         * @brief Simulation ticks per second.
+         */
+        void setTickRate(double ticksPerSecond);
+        double getTickRate();
+
+        /**
+         * @return Length of one tick in seconds.
+         */
+        double getTickDelta();
+
+        /**
+         * @return Ticks taken since the clock started.
+         */
+        unsigned long getTickCount();
+
+        /**
+         * @return Ticks taken by the last updateFrameTime.
+         */
+        unsigned int getTicksThisFrame();
+
+        /**
+         * @return Fraction of a tick left in the accumulator, for
+         * interpolating between the last two ticks.
+         */
+        double getTickAlpha();
+
+        /**
+         * @brief Drop the part tick carried from earlier frames, so the
+         * ticks that follow depend only on the deltas from here on.
+         */
+        void resetTickAccumulator();
+
         const static int DELTA_MAX;
+        const static double DEFAULT_TICK_RATE;
+        /**
+         * @brief Ticks taken in one frame at most. Time beyond this after a
+         * long frame is dropped rather than simulated.
+         */
+        const static unsigned int MAX_TICKS_PER_FRAME;
+
+    private:
+        void advanceTo(uint64_t now);
 
     private:
         /**
          * @brief Current time
          */
-        long mCurrentFrameTime;
+        uint64_t mCurrentFrameTime;
 
         /**
          * @brief Time of last frame
          */
-        long mLastFrameTime;
+        uint64_t mLastFrameTime;
+
+        unsigned long mFrameCount;
+
+        uint64_t mTickLength;
+        uint64_t mTickAccumulator;
+        unsigned long mTickCount;
+        unsigned int mTicksThisFrame;
     };
 }
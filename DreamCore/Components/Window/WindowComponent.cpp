@@ -18,6 +18,13 @@ namespace octronic::dream
     {
     }
 
+    bool
+    WindowComponent::setSwapInterval
+    (int)
+    {
+        return false;
+    }
+
     void
     WindowComponent::setWidth
     (int width)
@@ -23,6 +23,12 @@ namespace octronic::dream
       virtual void bindFrameBuffer() = 0;
       virtual GLuint getFrameBuffer() const = 0;
       virtual GLuint getDepthBuffer() const = 0;
+      /**
+       * @brief Set the number of display refreshes swapBuffers waits for,
+       * -1 for adaptive vsync.
+       * @return false when the window can not change it.
+       */
+      virtual bool setSwapInterval(int interval);
 
       void setWidth(int);
       void setHeight(int);
@@ -17,6 +17,7 @@
 #include "Components/Script/ScriptComponent.h"
 #include "TemplateEntityDefinition.h"
 #include "Scene/SceneRuntime.h"
+#include "Scene/AABBTree.h"
 #include "Scene/SceneDefinition.h"
 #include "Project/ProjectRuntime.h"
 #include "Project/ProjectDefinition.h"
@@ -42,11 +43,22 @@ namespace octronic::dream
       mFontScale(1.f),
       mScriptError(false),
       mScriptInitialised(false),
+      mSpatialProxy(AABBTree::NULL_NODE),
+      mSpatialBoundsPending(false),
       mDeleted(false)
   {
     LOG_TRACE("EntityRuntime: {}", __FUNCTION__);
   }
 
+  EntityRuntime::~EntityRuntime
+  ()
+  {
+    if (mSpatialProxy != AABBTree::NULL_NODE)
+    {
+      mSceneRuntime.get().removeSpatialProxy(*this);
+    }
+  }
+
   void
   EntityRuntime::removeAnimationRuntime
   ()
@@ -592,6 +604,10 @@ namespace octronic::dream
   (const Transform& transform)
   {
     mCurrentTransform = transform;
+    if (mSpatialProxy != AABBTree::NULL_NODE)
+    {
+      mSceneRuntime.get().updateSpatialProxy(*this);
+    }
   }
 
   Transform
@@ -691,6 +707,10 @@ namespace octronic::dream
   (const BoundingBox& boundingBox)
   {
     mBoundingBox = boundingBox;
+    if (mSpatialProxy != AABBTree::NULL_NODE)
+    {
+      mSceneRuntime.get().updateSpatialProxy(*this);
+    }
   }
 
   float
@@ -813,6 +833,21 @@ namespace octronic::dream
     mFontScale = fontScale;
   }
 
+  TextMesh&
+  EntityRuntime::getTextMesh
+  ()
+  {
+    return mTextMesh;
+  }
+
+  const TextMesh&
+  EntityRuntime::getTextMesh
+  ()
+  const
+  {
+    return mTextMesh;
+  }
+
   void EntityRuntime::setScriptError(bool e)
   {
     mScriptError = e;
@@ -900,4 +935,34 @@ namespace octronic::dream
   {
     return mProjectRuntime.get();
   }
+
+  int
+  EntityRuntime::getSpatialProxy
+  ()
+  const
+  {
+    return mSpatialProxy;
+  }
+
+  void
+  EntityRuntime::setSpatialProxy
+  (int proxy)
+  {
+    mSpatialProxy = proxy;
+  }
+
+  bool
+  EntityRuntime::getSpatialBoundsPending
+  ()
+  const
+  {
+    return mSpatialBoundsPending;
+  }
+
+  void
+  EntityRuntime::setSpatialBoundsPending
+  (bool pending)
+  {
+    mSpatialBoundsPending = pending;
+  }
 }
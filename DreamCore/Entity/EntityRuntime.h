@@ -58,6 +58,7 @@ namespace octronic::dream
 
     EntityRuntime(EntityRuntime&&) = default;
     EntityRuntime& operator=(EntityRuntime&&) = default;
+    ~EntityRuntime();
 
     void collectGarbage();
 
@@ -148,6 +149,18 @@ namespace octronic::dream
 
     void initTransform();
 
+    /**
+     * @brief Leaf of this entity in the SceneRuntime's AABBTree, or
+     * AABBTree::NULL_NODE if it has not been indexed yet.
+     */
+    int getSpatialProxy() const;
+    void setSpatialProxy(int proxy);
+    /**
+     * @brief The indexed box is a placeholder until the model loads.
+     */
+    bool getSpatialBoundsPending() const;
+    void setSpatialBoundsPending(bool pending);
+
     shared_ptr<EntityScriptCreateStateTask> getScriptCreateStateTask() const;
     shared_ptr<EntityScriptOnInitTask> getScriptOnInitTask() const;
     shared_ptr<EntityScriptOnEventTask> getScriptOnEventTask() const;
@@ -166,6 +179,9 @@ namespace octronic::dream
     float getFontScale() const;
     void setFontScale(float fontScale);
 
+    TextMesh& getTextMesh();
+    const TextMesh& getTextMesh() const;
+
     void pushTasks();
     bool allRuntimesLoaded() const;
     ProjectRuntime& getProjectRuntime() const;
@@ -191,6 +207,7 @@ namespace octronic::dream
     string mFontText;
     vec4 mFontColor;
     float mFontScale;
+    TextMesh mTextMesh;
 
     // Model
     optional<reference_wrapper<ModelRuntime>> mModelRuntime;
@@ -215,6 +232,10 @@ namespace octronic::dream
     Transform mCurrentTransform;
     BoundingBox mBoundingBox;
 
+    // Spatial Index
+    int mSpatialProxy;
+    bool mSpatialBoundsPending;
+
     // Flags
     bool mDeleted;
     vector<Event> mEventQueue;
@@ -3,6 +3,7 @@
 #include "Common/Constants.h"
 #include "Math/Transform.h"
 #include "Math/Vector.h"
+#include "Project/CompiledProject.h"
 
 #include <regex>
 
@@ -18,7 +19,9 @@ namespace octronic::dream
    const json& js)
     : Definition(js),
       mSceneDefinition(scene),
-      mParentDefinition(parent)
+      mParentDefinition(parent),
+      mCompiledRecord(nullptr),
+      mCompiledProject(nullptr)
   {
     if (mJson.find(Constants::SCENE_ENTITY_DEFINITION_CHILDREN) != mJson.end())
     {
@@ -34,6 +37,21 @@ namespace octronic::dream
   ()
   const
   {
+    if (mCompiledRecord)
+    {
+      Transform tx;
+      tx.setTranslation(vec3(mCompiledRecord->translation[0],
+                             mCompiledRecord->translation[1],
+                             mCompiledRecord->translation[2]));
+      tx.setYaw(mCompiledRecord->yaw);
+      tx.setPitch(mCompiledRecord->pitch);
+      tx.setRoll(mCompiledRecord->roll);
+      tx.setScale(vec3(mCompiledRecord->scale[0],
+                       mCompiledRecord->scale[1],
+                       mCompiledRecord->scale[2]));
+      return tx;
+    }
+
     if (mJson.find(Constants::SCENE_ENTITY_DEFINITION_TRANSFORM) == mJson.end())
     {
       return Transform();
@@ -45,6 +63,7 @@ namespace octronic::dream
   SceneEntityDefinition::setTransform
   (const Transform& tx)
   {
+    mCompiledRecord = nullptr;
     mJson[Constants::SCENE_ENTITY_DEFINITION_TRANSFORM] = tx.toJson();
   }
 
@@ -52,6 +71,8 @@ namespace octronic::dream
   ()
   const
   {
+    if (mCompiledRecord) return mCompiledRecord->templateUuid;
+
     if (mJson.find(Constants::SCENE_ENTITY_DEFINITION_TEMPLATE_UUID) == mJson.end())
     {
       return Uuid::INVALID;
@@ -62,6 +83,7 @@ namespace octronic::dream
   void
   SceneEntityDefinition::setTemplateUuid(UuidType id)
   {
+    mCompiledRecord = nullptr;
     mJson[Constants::SCENE_ENTITY_DEFINITION_TEMPLATE_UUID] = id;
   }
 
@@ -209,6 +231,7 @@ namespace octronic::dream
   SceneEntityDefinition::setFontColor
   (const vec4& color)
   {
+    mCompiledRecord = nullptr;
     mJson[Constants::SCENE_ENTITY_DEFINITION_FONT_COLOR] = Vector4::toJson(color);
   }
 
@@ -217,6 +240,12 @@ namespace octronic::dream
   ()
   const
   {
+    if (mCompiledRecord)
+    {
+      return vec4(mCompiledRecord->fontColor[0], mCompiledRecord->fontColor[1],
+                  mCompiledRecord->fontColor[2], mCompiledRecord->fontColor[3]);
+    }
+
     if (mJson.find(Constants::SCENE_ENTITY_DEFINITION_FONT_COLOR) == mJson.end())
     {
       return vec4(0.f);
@@ -228,12 +257,15 @@ namespace octronic::dream
   SceneEntityDefinition::setFontText
   (const string& text)
   {
+    mCompiledRecord = nullptr;
     mJson[Constants::SCENE_ENTITY_DEFINITION_FONT_TEXT] = text;
   }
 
   string SceneEntityDefinition::getFontText()
   const
   {
+    if (mCompiledRecord) return mCompiledProject->getString(mCompiledRecord->fontTextOffset);
+
     if (mJson.find(Constants::SCENE_ENTITY_DEFINITION_FONT_TEXT) == mJson.end())
     {
       return "";
@@ -245,6 +277,7 @@ namespace octronic::dream
   SceneEntityDefinition::setFontScale
   (float s)
   {
+    mCompiledRecord = nullptr;
     mJson[Constants::SCENE_ENTITY_DEFINITION_FONT_SCALE] = s;
   }
 
@@ -253,6 +286,8 @@ namespace octronic::dream
   ()
   const
   {
+    if (mCompiledRecord) return mCompiledRecord->fontScale;
+
     if (mJson.find(Constants::SCENE_ENTITY_DEFINITION_FONT_SCALE) == mJson.end())
     {
       return 1.f;
@@ -289,5 +324,20 @@ namespace octronic::dream
     }
     return mJson;
   }
-}
 
+  void
+  SceneEntityDefinition::setCompiledRecord
+  (const CompiledEntityRecord* record, const CompiledProject& project)
+  {
+    mCompiledRecord = record;
+    mCompiledProject = &project;
+  }
+
+  bool
+  SceneEntityDefinition::hasCompiledRecord
+  ()
+  const
+  {
+    return mCompiledRecord != nullptr;
+  }
+}
@@ -16,6 +16,8 @@ namespace octronic::dream
 {
   class SceneDefinition;
   class Transform;
+  class CompiledProject;
+  struct CompiledEntityRecord;
 
   class SceneEntityDefinition : public Definition
   {
@@ -58,9 +60,19 @@ namespace octronic::dream
 
     json getJson() override;
 
+    /**
+     * @brief Read typed fields from a compiled record rather than mJson.
+     * Setting any of the compiled fields drops the record, mJson stays
+     * the source of truth for edits.
+     */
+    void setCompiledRecord(const CompiledEntityRecord* record, const CompiledProject& project);
+    bool hasCompiledRecord() const;
+
   private:
     reference_wrapper<SceneDefinition> mSceneDefinition;
     optional<reference_wrapper<SceneEntityDefinition>> mParentDefinition;
     vector<unique_ptr<SceneEntityDefinition>> mChildDefinitions;
+    const CompiledEntityRecord* mCompiledRecord;
+    const CompiledProject* mCompiledProject;
   };
 }
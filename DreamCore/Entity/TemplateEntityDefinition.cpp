@@ -35,6 +35,13 @@ namespace octronic::dream
     return mProjectDefinition;
   }
 
+  void
+  TemplateEntityDefinition::onIdentityChanged
+  (const string&, UuidType oldUuid)
+  {
+    mProjectDefinition.get().reindexTemplateEntityDefinition(*this, oldUuid);
+  }
+
   json
   TemplateEntityDefinition::getJson
   ()
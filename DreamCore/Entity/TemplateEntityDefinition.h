@@ -39,6 +39,9 @@ namespace octronic::dream
     void setAssetDefinition(AssetType, UuidType uuid);
     map<AssetType, UuidType> getAssetDefinitionsMap() const;
 
+  protected:
+    void onIdentityChanged(const string& oldName, UuidType oldUuid) override;
+
   private:
     reference_wrapper<ProjectDefinition> mProjectDefinition;
   };
@@ -0,0 +1,231 @@
+#include "CompiledProject.h"
+
+#include "Common/Logger.h"
+#include "Math/Transform.h"
+#include "Project/ProjectDefinition.h"
+#include "Scene/SceneDefinition.h"
+#include "Entity/SceneEntityDefinition.h"
+
+#include <cstring>
+
+namespace octronic::dream
+{
+  // "DRMC"
+  const uint32_t CompiledProject::MAGIC = 0x434D5244;
+  const uint32_t CompiledProject::VERSION = 1;
+
+  CompiledProject::CompiledProject
+  (vector<uint8_t>&& data)
+    : mData(std::move(data)),
+      mValid(false),
+      mHeader(nullptr),
+      mEntityRecords(nullptr)
+  {
+    LOG_TRACE("CompiledProject: Constructing");
+
+    if (mData.size() < sizeof(CompiledProjectHeader))
+    {
+      LOG_ERROR("CompiledProject: Data is too small for a header");
+      return;
+    }
+
+    mHeader = reinterpret_cast<const CompiledProjectHeader*>(mData.data());
+
+    if (mHeader->magic != MAGIC || mHeader->version != VERSION)
+    {
+      LOG_WARN("CompiledProject: Unrecognised magic/version {}/{}", mHeader->magic, mHeader->version);
+      return;
+    }
+
+    size_t entityEnd = mHeader->entityOffset + (size_t)mHeader->entityCount * sizeof(CompiledEntityRecord);
+    size_t stringEnd = mHeader->stringOffset + (size_t)mHeader->stringSize;
+    size_t documentEnd = mHeader->documentOffset + (size_t)mHeader->documentSize;
+
+    if (entityEnd > mData.size() || stringEnd > mData.size() || documentEnd > mData.size())
+    {
+      LOG_ERROR("CompiledProject: Section out of range, file is truncated");
+      return;
+    }
+
+    if (mHeader->stringSize == 0 || mData[stringEnd-1] != '\0')
+    {
+      LOG_ERROR("CompiledProject: String table is not terminated");
+      return;
+    }
+
+    mEntityRecords = reinterpret_cast<const CompiledEntityRecord*>(&mData[mHeader->entityOffset]);
+    mEntityIndex.reserve(mHeader->entityCount);
+    for (uint32_t i = 0; i < mHeader->entityCount; i++)
+    {
+      mEntityIndex[mEntityRecords[i].uuid] = i;
+    }
+
+    mValid = true;
+  }
+
+  bool
+  CompiledProject::isValid
+  ()
+  const
+  {
+    return mValid;
+  }
+
+  uint64_t
+  CompiledProject::getSourceHash
+  ()
+  const
+  {
+    return mValid ? mHeader->sourceHash : 0;
+  }
+
+  json
+  CompiledProject::getDocument
+  ()
+  const
+  {
+    if (!mValid) return json();
+    auto begin = mData.begin() + mHeader->documentOffset;
+    return json::from_msgpack(begin, begin + mHeader->documentSize);
+  }
+
+  size_t
+  CompiledProject::countEntityRecords
+  ()
+  const
+  {
+    return mValid ? mHeader->entityCount : 0;
+  }
+
+  const CompiledEntityRecord*
+  CompiledProject::getEntityRecord
+  (UuidType uuid)
+  const
+  {
+    auto itr = mEntityIndex.find(uuid);
+    if (itr == mEntityIndex.end()) return nullptr;
+    return &mEntityRecords[itr->second];
+  }
+
+  const char*
+  CompiledProject::getString
+  (uint32_t offset)
+  const
+  {
+    if (!mValid || offset >= mHeader->stringSize) return "";
+    return reinterpret_cast<const char*>(&mData[mHeader->stringOffset + offset]);
+  }
+
+  // Compiling =================================================================
+
+  uint32_t
+  CompiledProject::AddString
+  (const string& str, vector<char>& strings)
+  {
+    uint32_t offset = static_cast<uint32_t>(strings.size());
+    strings.insert(strings.end(), str.begin(), str.end());
+    strings.push_back('\0');
+    return offset;
+  }
+
+  void
+  CompiledProject::CompileEntity
+  (SceneEntityDefinition& def,
+   vector<CompiledEntityRecord>& records,
+   vector<char>& strings)
+  {
+    CompiledEntityRecord record;
+    memset(&record, 0, sizeof(CompiledEntityRecord));
+
+    record.uuid = def.getUuid();
+    record.templateUuid = def.getTemplateUuid();
+    record.nameOffset = AddString(def.getName(), strings);
+    record.fontTextOffset = AddString(def.getFontText(), strings);
+    record.fontScale = def.getFontScale();
+
+    vec4 fontColor = def.getFontColor();
+    record.fontColor[0] = fontColor.r;
+    record.fontColor[1] = fontColor.g;
+    record.fontColor[2] = fontColor.b;
+    record.fontColor[3] = fontColor.a;
+
+    Transform tx = def.getTransform();
+    vec3 translation = tx.getTranslation();
+    vec3 scale = tx.getScale();
+    record.translation[0] = translation.x;
+    record.translation[1] = translation.y;
+    record.translation[2] = translation.z;
+    record.yaw = tx.getYaw();
+    record.pitch = tx.getPitch();
+    record.roll = tx.getRoll();
+    record.scale[0] = scale.x;
+    record.scale[1] = scale.y;
+    record.scale[2] = scale.z;
+
+    records.push_back(record);
+  }
+
+  vector<uint8_t>
+  CompiledProject::Compile
+  (ProjectDefinition& def, uint64_t sourceHash)
+  {
+    vector<CompiledEntityRecord> records;
+    vector<char> strings;
+    // Offset 0 is always the empty string
+    strings.push_back('\0');
+
+    for (auto& sceneWrapper : def.getSceneDefinitionsVector())
+    {
+      auto& root = sceneWrapper.get().getRootSceneEntityDefinition();
+      if (!root) continue;
+
+      CompileEntity(root.value(), records, strings);
+      for (auto& entity : root.value().getAllDescendants())
+      {
+        CompileEntity(entity.get(), records, strings);
+      }
+    }
+
+    vector<uint8_t> document = json::to_msgpack(def.getJson());
+
+    CompiledProjectHeader header;
+    memset(&header, 0, sizeof(CompiledProjectHeader));
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.sourceHash = sourceHash;
+    header.entityCount = static_cast<uint32_t>(records.size());
+    header.entityOffset = sizeof(CompiledProjectHeader);
+    header.stringOffset = header.entityOffset + header.entityCount * sizeof(CompiledEntityRecord);
+    header.stringSize = static_cast<uint32_t>(strings.size());
+    header.documentOffset = header.stringOffset + header.stringSize;
+    header.documentSize = static_cast<uint32_t>(document.size());
+
+    vector<uint8_t> data(header.documentOffset + header.documentSize);
+    memcpy(data.data(), &header, sizeof(CompiledProjectHeader));
+    if (!records.empty())
+    {
+      memcpy(data.data() + header.entityOffset, records.data(), records.size() * sizeof(CompiledEntityRecord));
+    }
+    memcpy(data.data() + header.stringOffset, strings.data(), strings.size());
+    if (!document.empty())
+    {
+      memcpy(data.data() + header.documentOffset, document.data(), document.size());
+    }
+
+    LOG_DEBUG("CompiledProject: Compiled {} entities into {} bytes", records.size(), data.size());
+    return data;
+  }
+
+  uint64_t
+  CompiledProject::HashString
+  (const string& str)
+  {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : str)
+    {
+      hash ^= c;
+      hash *= 0x100000001b3ULL;
+    }
+    return hash;
+  }
+}
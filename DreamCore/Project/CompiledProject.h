@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Common/Uuid.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <json.hpp>
+
+using std::string;
+using std::vector;
+using std::unordered_map;
+using nlohmann::json;
+
+namespace octronic::dream
+{
+  class ProjectDefinition;
+  class SceneEntityDefinition;
+
+  /**
+   * @brief Fixed size header at the start of a compiled project file. All
+   * offsets are in bytes from the start of the file.
+   */
+  struct __attribute__ ((packed)) CompiledProjectHeader
+  {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sourceHash;
+    uint32_t entityCount;
+    uint32_t entityOffset;
+    uint32_t stringOffset;
+    uint32_t stringSize;
+    uint32_t documentOffset;
+    uint32_t documentSize;
+  };
+
+  /**
+   * @brief Typed copy of the fields of a SceneEntityDefinition that the
+   * runtime reads when creating an EntityRuntime. Strings are offsets into
+   * the string table.
+   */
+  struct __attribute__ ((packed)) CompiledEntityRecord
+  {
+    UuidType uuid;
+    UuidType templateUuid;
+    uint32_t nameOffset;
+    uint32_t fontTextOffset;
+    float    fontScale;
+    float    fontColor[4];
+    float    translation[3];
+    float    yaw;
+    float    pitch;
+    float    roll;
+    float    scale[3];
+  };
+
+  /**
+   * @brief CompiledProject is the binary form of a project written next to
+   * the project's JSON file.
+   *
+   * The project document is stored as MessagePack, which decodes much faster
+   * than the JSON text, and every SceneEntityDefinition is flattened into a
+   * CompiledEntityRecord so its getters can read typed fields directly. The
+   * JSON file remains the editable source, sourceHash is the hash of the
+   * JSON text the compiled file was built from so stale files are ignored.
+   */
+  class CompiledProject
+  {
+  public:
+    static const uint32_t MAGIC;
+    static const uint32_t VERSION;
+
+    /**
+     * @brief Take ownership of the compiled file's data and validate it.
+     */
+    CompiledProject(vector<uint8_t>&& data);
+
+    CompiledProject(const CompiledProject&) = delete;
+    CompiledProject& operator=(const CompiledProject&) = delete;
+
+    bool isValid() const;
+    uint64_t getSourceHash() const;
+
+    json getDocument() const;
+
+    size_t countEntityRecords() const;
+    const CompiledEntityRecord* getEntityRecord(UuidType uuid) const;
+    const char* getString(uint32_t offset) const;
+
+    /**
+     * @brief Flatten the project definition into compiled file data.
+     * @param sourceHash Hash of the JSON text the definition was saved as.
+     */
+    static vector<uint8_t> Compile(ProjectDefinition& def, uint64_t sourceHash);
+
+    /**
+     * @brief 64 bit FNV-1a hash, used to match a compiled file to its JSON.
+     */
+    static uint64_t HashString(const string& str);
+
+  private:
+    static void CompileEntity(SceneEntityDefinition& def,
+                              vector<CompiledEntityRecord>& records,
+                              vector<char>& strings);
+    static uint32_t AddString(const string& str, vector<char>& strings);
+
+  private:
+    vector<uint8_t> mData;
+    bool mValid;
+    const CompiledProjectHeader* mHeader;
+    const CompiledEntityRecord* mEntityRecords;
+    unordered_map<UuidType, uint32_t> mEntityIndex;
+  };
+}
@@ -18,7 +18,9 @@ namespace octronic::dream
     : mWindowComponent(wc),
       mAudioComponent(ac),
       mStorageManager(sm),
-      mProjectDirectory(std::in_place, sm, base_dir)
+      mProjectDirectory(std::in_place, sm, base_dir),
+      mSimulationRate(Time::DEFAULT_TICK_RATE),
+      mSwapInterval(0)
   {
     LOG_TRACE("Project: Constructing");
   }
@@ -43,6 +45,8 @@ namespace octronic::dream
             getWindowComponent(),
             getAudioComponent());
 
+      mProjectRuntime.value().getTime().setTickRate(mSimulationRate);
+
       if (mProjectRuntime.value().loadFromDefinition())
       {
         return mProjectRuntime.value();
@@ -77,6 +81,9 @@ namespace octronic::dream
   void
   ProjectContext::step()
   {
+    applySwapInterval();
+    mFramePacer.waitForNextFrame();
+
     if (mProjectRuntime)
     {
       mProjectRuntime.value().step();
@@ -105,6 +112,54 @@ namespace octronic::dream
     }
   }
 
+  FramePacer&
+  ProjectContext::getFramePacer
+  ()
+  {
+    return mFramePacer;
+  }
+
+  void
+  ProjectContext::setSimulationRate
+  (double ticksPerSecond)
+  {
+    if (ticksPerSecond <= 0.0)
+    {
+      LOG_ERROR("ProjectContext: Invalid simulation rate {}", ticksPerSecond);
+      return;
+    }
+    mSimulationRate = ticksPerSecond;
+    if (mProjectRuntime)
+    {
+      mProjectRuntime.value().getTime().setTickRate(mSimulationRate);
+    }
+  }
+
+  double
+  ProjectContext::getSimulationRate
+  ()
+  const
+  {
+    return mSimulationRate;
+  }
+
+  void
+  ProjectContext::applySwapInterval
+  ()
+  {
+    // Windows start with their own interval, only change it once the
+    // pacing mode asks for something else
+    int interval = mFramePacer.getSwapInterval();
+    if (interval == mSwapInterval) return;
+
+    // A window that refuses, or does not exist yet, is asked again next step
+    if (getWindowComponent().setSwapInterval(interval))
+    {
+      LOG_DEBUG("ProjectContext: Swap interval set to {}", interval);
+      mSwapInterval = interval;
+    }
+  }
+
   StorageManager&
   ProjectContext::getStorageManager()
   const
@@ -141,7 +196,16 @@ namespace octronic::dream
     if (mProjectDirectory)
     {
       auto& pDir = mProjectDirectory.value();
-      mProjectDefinition.emplace(pDir.readProjectDefinition());
+      auto compiled = pDir.readCompiledProject();
+      if (compiled)
+      {
+        mProjectDefinition.emplace(compiled->getDocument());
+        mProjectDefinition.value().setCompiledProject(compiled);
+      }
+      else
+      {
+        mProjectDefinition.emplace(pDir.readProjectDefinition());
+      }
 
       if (mProjectDefinition)
       {
@@ -4,6 +4,7 @@
 #include "Project/ProjectDirectory.h"
 #include "Project/ProjectDefinition.h"
 #include "Storage/StorageManager.h"
+#include "Components/FramePacer.h"
 
 #include <memory>
 #include <string>
@@ -61,8 +62,24 @@ namespace octronic::dream
     bool getShouldClose() const;
 
     void loadProject();
+
+    /**
+     * @brief Wait for the frame pacer, then step the project runtime.
+     */
     void step();
 
+    FramePacer& getFramePacer();
+
+    /**
+     * @brief Fixed simulation ticks per second, independent of the frame
+     * rate. Applied to the runtime's Time.
+     */
+    void setSimulationRate(double ticksPerSecond);
+    double getSimulationRate() const;
+
+  private:
+    void applySwapInterval();
+
   private:
     reference_wrapper<WindowComponent> mWindowComponent;
     reference_wrapper<AudioComponent>  mAudioComponent;
@@ -71,5 +88,9 @@ namespace octronic::dream
     optional<ProjectDirectory>  mProjectDirectory;
     optional<ProjectDefinition> mProjectDefinition;
     optional<ProjectRuntime>    mProjectRuntime;
+
+    FramePacer mFramePacer;
+    double mSimulationRate;
+    int mSwapInterval;
   };
 }
@@ -11,7 +11,8 @@ namespace octronic::dream
 
   ProjectDefinition::ProjectDefinition
   (const json& data)
-    : Definition(data)
+    : Definition(data),
+      mAssetDefinitionIndices(ASSET_TYPE_ENUM_NONE)
   {
     LOG_TRACE("ProjectDefinition: Constructing from JSON {}", getNameAndUuidString());
     loadAllAssetDefinitions();
@@ -102,6 +103,9 @@ namespace octronic::dream
   ProjectDefinition::removeAssetDefinitionByUuid
   (AssetType type, UuidType id)
   {
+    auto def = getAssetDefinitionByUuid(type, id);
+    if (def) unindexAssetDefinition(def.value().get(), def.value().get().getName(), id);
+
     switch(type)
     {
       case ASSET_TYPE_ENUM_ANIMATION:
@@ -199,183 +203,25 @@ namespace octronic::dream
   ProjectDefinition::getAssetDefinitionByName
   (AssetType type, const string& name)
   {
-    switch(type)
-    {
-      case ASSET_TYPE_ENUM_ANIMATION:
-      {
-        auto itr = find_if(
-              mAnimationDefinitions.begin(), mAnimationDefinitions.end(),
-              [&](unique_ptr<AnimationDefinition>& next) {return next->getName().compare(name) == 0;});
-        if (itr!=mAnimationDefinitions.end()) return *(*itr);
-        break;
-      }
-      case ASSET_TYPE_ENUM_AUDIO:
-      {
-        auto itr = find_if(
-              mAudioDefinitions.begin(), mAudioDefinitions.end(),
-              [&](unique_ptr<AudioDefinition>& next) {return next->getName().compare(name) == 0;} );
-        if (itr!=mAudioDefinitions.end()) return *(*itr);
-        break;
-      }
-      case ASSET_TYPE_ENUM_FONT:
-      {
-        auto itr = find_if(
-              mFontDefinitions.begin(), mFontDefinitions.end(),
-              [&](unique_ptr<FontDefinition>& next) {return next->getName().compare(name) == 0;} );
-        if (itr!=mFontDefinitions.end()) return *(*itr);
-        break;
-      }
-      case ASSET_TYPE_ENUM_MATERIAL:
-      {
-        auto itr = find_if
-            (mMaterialDefinitions.begin(), mMaterialDefinitions.end(),
-             [&](unique_ptr<MaterialDefinition>& next) {return next->getName().compare(name) == 0;} );
-        if (itr!=mMaterialDefinitions.end()) return *(*itr);
-        break;
-      }
-      case ASSET_TYPE_ENUM_MODEL:
-      {
-        auto itr = find_if(
-              mModelDefinitions.begin(), mModelDefinitions.end(),
-              [&](unique_ptr<ModelDefinition>& next) {return next->getName().compare(name) == 0;} );
-        if (itr!=mModelDefinitions.end()) return *(*itr);
-        break;
-      }
-      case ASSET_TYPE_ENUM_PATH:
-      {
-        auto itr = find_if(
-              mPathDefinitions.begin(), mPathDefinitions.end(),
-              [&](unique_ptr<PathDefinition>& next) {return next->getName().compare(name) == 0;} );
-        if (itr!=mPathDefinitions.end()) return *(*itr);
-        break;
-      }
-      case ASSET_TYPE_ENUM_PHYSICS:
-      {
-        auto itr = find_if(
-              mPhysicsDefinitions.begin(), mPhysicsDefinitions.end(),
-              [&](unique_ptr<PhysicsDefinition>& next) {return next->getName().compare(name) == 0;});
-        if (itr!=mPhysicsDefinitions.end()) return *(*itr);
-        break;
-      }
-      case ASSET_TYPE_ENUM_SCRIPT:
-      {
-        auto itr = find_if(
-              mScriptDefinitions.begin(), mScriptDefinitions.end(),
-              [&](unique_ptr<ScriptDefinition>& next) {return next->getName().compare(name) == 0;} );
-        if (itr!=mScriptDefinitions.end()) return *(*itr);
-        break;
-      }
-      case ASSET_TYPE_ENUM_SHADER:
-      {
-        auto itr = find_if(
-              mShaderDefinitions.begin(), mShaderDefinitions.end(),
-              [&](unique_ptr<ShaderDefinition>& next) {return next->getName().compare(name) == 0;} );
-        if (itr!=mShaderDefinitions.end())return *(*itr);
-        break;
-      }
-      case ASSET_TYPE_ENUM_TEXTURE:
-      {
-        auto itr = find_if(
-              mTextureDefinitions.begin(), mTextureDefinitions.end(),
-              [&](unique_ptr<TextureDefinition>& next) {return next->getName().compare(name) == 0;});
-        if (itr!=mTextureDefinitions.end()) return *(*itr);
-        break;
-      }
-      case ASSET_TYPE_ENUM_NONE:
-        break;
-    }
-    throw std::exception();
+    if (type == ASSET_TYPE_ENUM_NONE) return std::nullopt;
+
+    auto& index = mAssetDefinitionIndices[type].byName;
+    auto itr = index.find(name);
+    if (itr != index.end()) return *itr->second;
+
+    return std::nullopt;
   }
 
   optional<reference_wrapper<AssetDefinition>>
   ProjectDefinition::getAssetDefinitionByUuid
   (AssetType type, UuidType id)
   {
-    switch(type)
-    {
-      case ASSET_TYPE_ENUM_ANIMATION:
-      {
-        auto itr = find_if(
-              mAnimationDefinitions.begin(), mAnimationDefinitions.end(),
-              [&](unique_ptr<AnimationDefinition>& next) {return next->getUuid() == id;});
-        if (itr!=mAnimationDefinitions.end()) return *(*itr);
-        break;
-      }
-      case ASSET_TYPE_ENUM_AUDIO:
-      {
-        auto itr = find_if(
-              mAudioDefinitions.begin(), mAudioDefinitions.end(),
-              [&](unique_ptr<AudioDefinition>& next) {return next->getUuid() == id;} );
-        if (itr!=mAudioDefinitions.end()) return *(*itr);
-        break;
-      }
-      case ASSET_TYPE_ENUM_FONT:
-      {
-        auto itr = find_if(
-              mFontDefinitions.begin(), mFontDefinitions.end(),
-              [&](unique_ptr<FontDefinition>& next) {return next->getUuid() == id;} );
-        if (itr!=mFontDefinitions.end()) return *(*itr);
-        break;
-      }
-      case ASSET_TYPE_ENUM_MATERIAL:
-      {
-        auto itr = find_if
-            (mMaterialDefinitions.begin(), mMaterialDefinitions.end(),
-             [&](unique_ptr<MaterialDefinition>& next) {return next->getUuid() == id;} );
-        if (itr!=mMaterialDefinitions.end()) return *(*itr);
-        break;
-      }
-      case ASSET_TYPE_ENUM_MODEL:
-      {
-        auto itr = find_if(
-              mModelDefinitions.begin(), mModelDefinitions.end(),
-              [&](unique_ptr<ModelDefinition>& next) {return next->getUuid() == id;} );
-        if (itr!=mModelDefinitions.end()) return *(*itr);
-        break;
-      }
-      case ASSET_TYPE_ENUM_PATH:
-      {
-        auto itr = find_if(
-              mPathDefinitions.begin(), mPathDefinitions.end(),
-              [&](unique_ptr<PathDefinition>& next) {return next->getUuid() == id;} );
-        if (itr!=mPathDefinitions.end()) return *(*itr);
-        break;
-      }
-      case ASSET_TYPE_ENUM_PHYSICS:
-      {
-        auto itr = find_if(
-              mPhysicsDefinitions.begin(), mPhysicsDefinitions.end(),
-              [&](unique_ptr<PhysicsDefinition>& next) {return next->getUuid() == id;});
-        if (itr!=mPhysicsDefinitions.end()) return *(*itr);
-        break;
-      }
-      case ASSET_TYPE_ENUM_SCRIPT:
-      {
-        auto itr = find_if(
-              mScriptDefinitions.begin(), mScriptDefinitions.end(),
-              [&](unique_ptr<ScriptDefinition>& next) {return next->getUuid() == id;} );
-        if (itr!=mScriptDefinitions.end()) return *(*itr);
-        break;
-      }
-      case ASSET_TYPE_ENUM_SHADER:
-      {
-        auto itr = find_if(
-              mShaderDefinitions.begin(), mShaderDefinitions.end(),
-              [&](unique_ptr<ShaderDefinition>& next) {return next->getUuid() == id;} );
-        if (itr!=mShaderDefinitions.end())return *(*itr);
-        break;
-      }
-      case ASSET_TYPE_ENUM_TEXTURE:
-      {
-        auto itr = find_if(
-              mTextureDefinitions.begin(), mTextureDefinitions.end(),
-              [&](unique_ptr<TextureDefinition>& next) {return next->getUuid() == id;});
-        if (itr!=mTextureDefinitions.end()) return *(*itr);
-        break;
-      }
-      case ASSET_TYPE_ENUM_NONE:
-        break;
-    }
+    if (type == ASSET_TYPE_ENUM_NONE || id == Uuid::INVALID) return std::nullopt;
+
+    auto& index = mAssetDefinitionIndices[type].byUuid;
+    auto itr = index.find(id);
+    if (itr != index.end()) return *itr->second;
+
     return std::nullopt;
   }
 
@@ -436,32 +282,48 @@ namespace octronic::dream
     assetDefinitionJs[Constants::ASSET_TYPE] = AssetTypeHelper::GetAssetTypeStringFromTypeEnum(type);
     assetDefinitionJs[Constants::ASSET_FORMAT] = defaultFormat;
 
+    AssetDefinition* def = nullptr;
+
     switch(type)
     {
       case ASSET_TYPE_ENUM_ANIMATION:
-        return *mAnimationDefinitions.emplace_back(make_unique<AnimationDefinition>(*this, assetDefinitionJs));
+        def = mAnimationDefinitions.emplace_back(make_unique<AnimationDefinition>(*this, assetDefinitionJs)).get();
+        break;
       case ASSET_TYPE_ENUM_AUDIO:
-        return *mAudioDefinitions.emplace_back(make_unique<AudioDefinition>(*this, assetDefinitionJs));
+        def = mAudioDefinitions.emplace_back(make_unique<AudioDefinition>(*this, assetDefinitionJs)).get();
+        break;
       case ASSET_TYPE_ENUM_FONT:
-        return *mFontDefinitions.emplace_back(make_unique<FontDefinition>(*this, assetDefinitionJs));
+        def = mFontDefinitions.emplace_back(make_unique<FontDefinition>(*this, assetDefinitionJs)).get();
+        break;
       case ASSET_TYPE_ENUM_MATERIAL:
-        return *mMaterialDefinitions.emplace_back(make_unique<MaterialDefinition>(*this, assetDefinitionJs));
+        def = mMaterialDefinitions.emplace_back(make_unique<MaterialDefinition>(*this, assetDefinitionJs)).get();
+        break;
       case ASSET_TYPE_ENUM_MODEL:
-        return *mModelDefinitions.emplace_back(make_unique<ModelDefinition>(*this, assetDefinitionJs));
+        def = mModelDefinitions.emplace_back(make_unique<ModelDefinition>(*this, assetDefinitionJs)).get();
+        break;
       case ASSET_TYPE_ENUM_PATH:
-        return *mPathDefinitions.emplace_back(make_unique<PathDefinition>(*this, assetDefinitionJs));
+        def = mPathDefinitions.emplace_back(make_unique<PathDefinition>(*this, assetDefinitionJs)).get();
+        break;
       case ASSET_TYPE_ENUM_PHYSICS:
-        return *mPhysicsDefinitions.emplace_back(make_unique<PhysicsDefinition>(*this, assetDefinitionJs));
+        def = mPhysicsDefinitions.emplace_back(make_unique<PhysicsDefinition>(*this, assetDefinitionJs)).get();
+        break;
       case ASSET_TYPE_ENUM_SCRIPT:
-        return *mScriptDefinitions.emplace_back(make_unique<ScriptDefinition>(*this, assetDefinitionJs));
+        def = mScriptDefinitions.emplace_back(make_unique<ScriptDefinition>(*this, assetDefinitionJs)).get();
+        break;
       case ASSET_TYPE_ENUM_SHADER:
-        return *mShaderDefinitions.emplace_back(make_unique<ShaderDefinition>(*this, assetDefinitionJs));
+        def = mShaderDefinitions.emplace_back(make_unique<ShaderDefinition>(*this, assetDefinitionJs)).get();
+        break;
       case ASSET_TYPE_ENUM_TEXTURE:
-        return *mTextureDefinitions.emplace_back(make_unique<TextureDefinition>(*this, assetDefinitionJs));
+        def = mTextureDefinitions.emplace_back(make_unique<TextureDefinition>(*this, assetDefinitionJs)).get();
+        break;
       case ASSET_TYPE_ENUM_NONE:
         break;
     }
-    throw std::exception();
+
+    if (def == nullptr) throw std::exception();
+
+    indexAssetDefinition(*def);
+    return *def;
   }
 
   void
@@ -478,6 +340,12 @@ namespace octronic::dream
     mScriptDefinitions.clear();
     mShaderDefinitions.clear();
     mTextureDefinitions.clear();
+
+    for (auto& index : mAssetDefinitionIndices)
+    {
+      index.byUuid.clear();
+      index.byName.clear();
+    }
   }
 
   int
@@ -710,41 +578,45 @@ namespace octronic::dream
     auto typeStr = assetDefinitionJs[Constants::ASSET_TYPE];
     auto type = AssetTypeHelper::GetAssetTypeEnumFromString(typeStr);
 
+    AssetDefinition* def = nullptr;
+
     switch(type)
     {
       case ASSET_TYPE_ENUM_ANIMATION:
-        mAnimationDefinitions.emplace_back(make_unique<AnimationDefinition>(*this, assetDefinitionJs));
+        def = mAnimationDefinitions.emplace_back(make_unique<AnimationDefinition>(*this, assetDefinitionJs)).get();
         break;
       case ASSET_TYPE_ENUM_AUDIO:
-        mAudioDefinitions.emplace_back(make_unique<AudioDefinition>(*this, assetDefinitionJs));
+        def = mAudioDefinitions.emplace_back(make_unique<AudioDefinition>(*this, assetDefinitionJs)).get();
         break;
       case ASSET_TYPE_ENUM_FONT:
-        mFontDefinitions.emplace_back(make_unique<FontDefinition>(*this, assetDefinitionJs));
+        def = mFontDefinitions.emplace_back(make_unique<FontDefinition>(*this, assetDefinitionJs)).get();
         break;
       case ASSET_TYPE_ENUM_MATERIAL:
-        mMaterialDefinitions.emplace_back(make_unique<MaterialDefinition>(*this, assetDefinitionJs));
+        def = mMaterialDefinitions.emplace_back(make_unique<MaterialDefinition>(*this, assetDefinitionJs)).get();
         break;
       case ASSET_TYPE_ENUM_MODEL:
-        mModelDefinitions.emplace_back(make_unique<ModelDefinition>(*this, assetDefinitionJs));
+        def = mModelDefinitions.emplace_back(make_unique<ModelDefinition>(*this, assetDefinitionJs)).get();
         break;
       case ASSET_TYPE_ENUM_PATH:
-        mPathDefinitions.emplace_back(make_unique<PathDefinition>(*this, assetDefinitionJs));
+        def = mPathDefinitions.emplace_back(make_unique<PathDefinition>(*this, assetDefinitionJs)).get();
         break;
       case ASSET_TYPE_ENUM_PHYSICS:
-        mPhysicsDefinitions.emplace_back(make_unique<PhysicsDefinition>(*this, assetDefinitionJs));
+        def = mPhysicsDefinitions.emplace_back(make_unique<PhysicsDefinition>(*this, assetDefinitionJs)).get();
         break;
       case ASSET_TYPE_ENUM_SCRIPT:
-        mScriptDefinitions.emplace_back(make_unique<ScriptDefinition>(*this, assetDefinitionJs));
+        def = mScriptDefinitions.emplace_back(make_unique<ScriptDefinition>(*this, assetDefinitionJs)).get();
         break;
       case ASSET_TYPE_ENUM_SHADER:
-        mShaderDefinitions.emplace_back(make_unique<ShaderDefinition>(*this, assetDefinitionJs));
+        def = mShaderDefinitions.emplace_back(make_unique<ShaderDefinition>(*this, assetDefinitionJs)).get();
         break;
       case ASSET_TYPE_ENUM_TEXTURE:
-        mTextureDefinitions.emplace_back(make_unique<TextureDefinition>(*this, assetDefinitionJs));
+        def = mTextureDefinitions.emplace_back(make_unique<TextureDefinition>(*this, assetDefinitionJs)).get();
         break;
       case ASSET_TYPE_ENUM_NONE:
         break;
     }
+
+    if (def != nullptr) indexAssetDefinition(*def);
   }
 
   // Scenes ====================================================================
@@ -915,7 +787,9 @@ namespace octronic::dream
     json defJson;
     defJson[Constants::NAME] = Constants::TEMPLATE_ENTITY_DEFAULT_NAME;
     defJson[Constants::UUID] = Uuid::RandomUuid();
-    return *mTemplateEntityDefinitions.emplace_back(make_unique<TemplateEntityDefinition>(*this,defJson));
+    auto& def = *mTemplateEntityDefinitions.emplace_back(make_unique<TemplateEntityDefinition>(*this,defJson));
+    mTemplateEntityDefinitionIndex.emplace(def.getUuid(), &def);
+    return def;
   }
 
   // Template Entity ===========================================================
@@ -960,7 +834,8 @@ namespace octronic::dream
 
     for (auto& entityJs : mJson[Constants::PROJECT_TEMPLATE_ENTITIES_ARRAY])
     {
-      mTemplateEntityDefinitions.emplace_back(make_unique<TemplateEntityDefinition>(*this, entityJs));
+      auto& def = *mTemplateEntityDefinitions.emplace_back(make_unique<TemplateEntityDefinition>(*this, entityJs));
+      mTemplateEntityDefinitionIndex.emplace(def.getUuid(), &def);
     }
   }
 
@@ -968,12 +843,10 @@ namespace octronic::dream
   ProjectDefinition::getTemplateEntityDefinitionByUuid
   (UuidType uuid)
   {
-    auto itr = find_if(mTemplateEntityDefinitions.begin(),
-                       mTemplateEntityDefinitions.end(),
-                       [&](unique_ptr<TemplateEntityDefinition>& next)
-    { return next->getUuid() == uuid; });
+    if (uuid == Uuid::INVALID) return std::nullopt;
 
-    if (itr != mTemplateEntityDefinitions.end()) return *(*itr);
+    auto itr = mTemplateEntityDefinitionIndex.find(uuid);
+    if (itr != mTemplateEntityDefinitionIndex.end()) return *itr->second;
 
     return std::nullopt;
   }
@@ -987,7 +860,15 @@ namespace octronic::dream
               [&](unique_ptr<TemplateEntityDefinition>& next)
     { return next->getUuid() == id; });
 
-    if (itr != mTemplateEntityDefinitions.end()) mTemplateEntityDefinitions.erase(itr);
+    if (itr != mTemplateEntityDefinitions.end())
+    {
+      auto idx = mTemplateEntityDefinitionIndex.find(id);
+      if (idx != mTemplateEntityDefinitionIndex.end() && idx->second == itr->get())
+      {
+        mTemplateEntityDefinitionIndex.erase(idx);
+      }
+      mTemplateEntityDefinitions.erase(itr);
+    }
 
   }
 
@@ -1020,5 +901,104 @@ namespace octronic::dream
     }
     throw std::exception();
   }
-}
 
+  // Indices ===================================================================
+
+  void
+  ProjectDefinition::indexAssetDefinition
+  (AssetDefinition& def)
+  {
+    auto type = def.getAssetType();
+    if (type == ASSET_TYPE_ENUM_NONE) return;
+
+    // Keep the first definition with a given uuid, as a linear search would
+    auto& index = mAssetDefinitionIndices[type];
+    index.byUuid.emplace(def.getUuid(), &def);
+    index.byName.emplace(def.getName(), &def);
+  }
+
+  void
+  ProjectDefinition::unindexAssetDefinition
+  (AssetDefinition& def, const string& name, UuidType uuid)
+  {
+    auto type = def.getAssetType();
+    if (type == ASSET_TYPE_ENUM_NONE) return;
+
+    auto& index = mAssetDefinitionIndices[type];
+    auto uuidItr = index.byUuid.find(uuid);
+    if (uuidItr != index.byUuid.end() && uuidItr->second == &def)
+    {
+      index.byUuid.erase(uuidItr);
+    }
+
+    auto range = index.byName.equal_range(name);
+    for (auto itr = range.first; itr != range.second; itr++)
+    {
+      if (itr->second == &def)
+      {
+        index.byName.erase(itr);
+        break;
+      }
+    }
+  }
+
+  void
+  ProjectDefinition::reindexAssetDefinition
+  (AssetDefinition& def, const string& oldName, UuidType oldUuid)
+  {
+    unindexAssetDefinition(def, oldName, oldUuid);
+    indexAssetDefinition(def);
+  }
+
+  void
+  ProjectDefinition::reindexTemplateEntityDefinition
+  (TemplateEntityDefinition& def, UuidType oldUuid)
+  {
+    auto itr = mTemplateEntityDefinitionIndex.find(oldUuid);
+    if (itr != mTemplateEntityDefinitionIndex.end() && itr->second == &def)
+    {
+      mTemplateEntityDefinitionIndex.erase(itr);
+    }
+    mTemplateEntityDefinitionIndex.emplace(def.getUuid(), &def);
+  }
+
+  // Compiled ==================================================================
+
+  void
+  ProjectDefinition::setCompiledProject
+  (const shared_ptr<CompiledProject>& compiled)
+  {
+    mCompiledProject = compiled;
+    if (!mCompiledProject) return;
+
+    size_t matched = 0;
+    for (auto& scene : mSceneDefinitions)
+    {
+      auto& root = scene->getRootSceneEntityDefinition();
+      if (!root) continue;
+
+      auto entities = root.value().getAllDescendants();
+      entities.push_back(root.value());
+
+      for (auto& entityWrapper : entities)
+      {
+        auto& entity = entityWrapper.get();
+        auto record = mCompiledProject->getEntityRecord(entity.getUuid());
+        if (record)
+        {
+          entity.setCompiledRecord(record, *mCompiledProject);
+          matched++;
+        }
+      }
+    }
+    LOG_DEBUG("ProjectDefinition: Matched {} compiled entity records", matched);
+  }
+
+  shared_ptr<CompiledProject>
+  ProjectDefinition::getCompiledProject
+  ()
+  const
+  {
+    return mCompiledProject;
+  }
+}
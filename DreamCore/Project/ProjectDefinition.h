@@ -15,19 +15,36 @@
 #include "Scene/SceneDefinition.h"
 #include "Entity/TemplateEntityDefinition.h"
 
+#include "Project/CompiledProject.h"
+
 #include <memory>
 #include <vector>
+#include <unordered_map>
 
 using std::string;
 using std::vector;
 using std::function;
 using std::reference_wrapper;
 using std::unique_ptr;
+using std::shared_ptr;
+using std::unordered_map;
+using std::unordered_multimap;
 
 namespace octronic::dream
 {
   class ProjectContext;
 
+  /**
+   * @brief Hash indices over the AssetDefinitions of one AssetType, kept
+   * current as definitions are created, removed, renamed or given a new
+   * uuid. Names need not be unique, so one name can map to many.
+   */
+  struct AssetDefinitionIndex
+  {
+    unordered_map<UuidType, AssetDefinition*> byUuid;
+    unordered_multimap<string, AssetDefinition*> byName;
+  };
+
   class ProjectDefinition : public Definition
   {
   public:
@@ -48,6 +65,11 @@ namespace octronic::dream
     void removeAssetDefinitionByUuid(AssetType, UuidType);
     void removeAssetDefinition(AssetDefinition& assetDef);
     void removeAllAssetDefinitions();
+    /**
+     * @brief Move an AssetDefinition from the index entries under its old
+     * name and uuid to its current ones.
+     */
+    void reindexAssetDefinition(AssetDefinition& def, const string& oldName, UuidType oldUuid);
 
     // Scenes ==============================================================
 
@@ -75,14 +97,30 @@ namespace octronic::dream
     vector<reference_wrapper<TemplateEntityDefinition>> getTemplateEntityDefinitionsVector() const;
     int getTemplateEntityDefinitionIndex(TemplateEntityDefinition& def);
     TemplateEntityDefinition& getTemplateEntityDefinitionAtIndex(int index);
+    /**
+     * @brief Move a TemplateEntityDefinition from the index entry under its
+     * old uuid to its current one.
+     */
+    void reindexTemplateEntityDefinition(TemplateEntityDefinition& def, UuidType oldUuid);
 
     json getJson() override;
 
+    // Compiled ============================================================
+
+    /**
+     * @brief Point the scene entity definitions at their compiled records.
+     * The CompiledProject is kept alive for as long as the definition.
+     */
+    void setCompiledProject(const shared_ptr<CompiledProject>& compiled);
+    shared_ptr<CompiledProject> getCompiledProject() const;
+
   private:
     void loadAllSceneDefinitions();
     void loadAllAssetDefinitions();
     void loadTemplateEntityDefinitions();
     void loadSingleAssetDefinition(const json& assetDefinition);
+    void indexAssetDefinition(AssetDefinition& def);
+    void unindexAssetDefinition(AssetDefinition& def, const string& name, UuidType uuid);
 
   private:
     // Scenes
@@ -100,5 +138,10 @@ namespace octronic::dream
     vector<unique_ptr<ScriptDefinition>> mScriptDefinitions;
     vector<unique_ptr<ShaderDefinition>> mShaderDefinitions;
     vector<unique_ptr<TextureDefinition>> mTextureDefinitions;
+    // Indices, one per AssetType
+    vector<AssetDefinitionIndex> mAssetDefinitionIndices;
+    unordered_map<UuidType, TemplateEntityDefinition*> mTemplateEntityDefinitionIndex;
+    // Compiled
+    shared_ptr<CompiledProject> mCompiledProject;
   };
 }
@@ -219,9 +219,91 @@ namespace octronic::dream
     auto& f = sm.openFile(path);
     bool retval = f.writeString(jsonStr);
     sm.closeFile(f);
+
+    if (retval && !writeCompiledProject(pDef, jsonStr))
+    {
+      LOG_WARN("ProjectDirectory: Saved project but could not compile it");
+    }
     return retval;
   }
 
+  bool
+  ProjectDirectory::compileProject
+  (ProjectDefinition& pDef)
+  const
+  {
+    auto jsonStr = pDef.getJson().dump(1);
+    return writeCompiledProject(pDef, jsonStr);
+  }
+
+  bool
+  ProjectDirectory::writeCompiledProject
+  (ProjectDefinition& pDef, const string& jsonStr)
+  const
+  {
+    auto data = CompiledProject::Compile(pDef, CompiledProject::HashString(jsonStr));
+    auto path = getCompiledProjectFilePath(pDef);
+    auto& sm = mStorageManager.get();
+    auto& f = sm.openFile(path);
+    bool retval = f.writeBinary(data);
+    sm.closeFile(f);
+    return retval;
+  }
+
+  string
+  ProjectDirectory::getCompiledProjectFilePath
+  (ProjectDefinition& pDef)
+  const
+  {
+    stringstream ss;
+    ss << mBasePath
+       << Constants::DIRECTORY_PATH_SEP
+       << pDef.getUuid()
+       << Constants::PROJECT_COMPILED_FILE_EXTENSION;
+    return ss.str();
+  }
+
+  shared_ptr<CompiledProject>
+  ProjectDirectory::readCompiledProject
+  ()
+  const
+  {
+    auto& sm = mStorageManager.get();
+    auto projectName = findProjectFileInDirectory(true);
+    if (projectName.empty()) return nullptr;
+
+    stringstream jsonPath, compiledPath;
+    jsonPath << mBasePath << Constants::DIRECTORY_PATH_SEP
+             << projectName << Constants::PROJECT_FILE_EXTENSION;
+    compiledPath << mBasePath << Constants::DIRECTORY_PATH_SEP
+                 << projectName << Constants::PROJECT_COMPILED_FILE_EXTENSION;
+
+    auto& compiledFile = sm.openFile(compiledPath.str());
+    if (!compiledFile.exists() || !compiledFile.readBinary())
+    {
+      sm.closeFile(compiledFile);
+      return nullptr;
+    }
+    auto compiled = make_shared<CompiledProject>(std::move(compiledFile.getBinaryData()));
+    sm.closeFile(compiledFile);
+
+    if (!compiled->isValid()) return nullptr;
+
+    // Hashing the text is far cheaper than parsing it
+    auto& jsonFile = sm.openFile(jsonPath.str());
+    uint64_t hash = CompiledProject::HashString(jsonFile.readString());
+    sm.closeFile(jsonFile);
+
+    if (hash != compiled->getSourceHash())
+    {
+      LOG_INFO("ProjectDirectory: Compiled project is out of date, using {}", jsonPath.str());
+      return nullptr;
+    }
+
+    LOG_DEBUG("ProjectDirectory: Using compiled project {}", compiledPath.str());
+    return compiled;
+  }
+
   string
   ProjectDirectory::getProjectFilePath
   (ProjectDefinition& pDef)
@@ -6,6 +6,7 @@
 
 #include "Common/Uuid.h"
 #include "Common/AssetType.h"
+#include "Project/CompiledProject.h"
 
 #include "Storage/StorageManager.h"
 #include "Storage/File.h"
@@ -15,6 +16,7 @@
 
 using std::string;
 using std::vector;
+using std::shared_ptr;
 using nlohmann::json;
 
 namespace octronic::dream
@@ -115,6 +117,25 @@ namespace octronic::dream
     json
     readProjectDefinition() const;
 
+    /**
+     * @brief Write the compiled binary form of the project next to its
+     * JSON file. saveProject does this automatically.
+     */
+    bool
+    compileProject
+    (ProjectDefinition& pDef) const;
+
+    string
+    getCompiledProjectFilePath
+    (ProjectDefinition& pDef) const;
+
+    /**
+     * @return The compiled project if one exists and was built from the
+     * current JSON file, otherwise nullptr.
+     */
+    shared_ptr<CompiledProject>
+    readCompiledProject() const;
+
     json
     createProjectDefinition() const;
 
@@ -133,6 +154,10 @@ namespace octronic::dream
     selfCreateProjectDirectory
     ();
 
+    bool
+    writeCompiledProject
+    (ProjectDefinition& pDef, const string& jsonStr) const;
+
   private:
     string mBasePath;
     reference_wrapper<StorageManager> mStorageManager;
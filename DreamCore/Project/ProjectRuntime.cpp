@@ -4,6 +4,10 @@
 #include "ProjectDirectory.h"
 
 #include "Common/Logger.h"
+#include "Common/GLDispatch.h"
+#include "Common/Profiler.h"
+#include "Common/AllocationTracker.h"
+#include "Common/SteadyClock.h"
 
 #include "Scene/SceneRuntime.h"
 #include "Scene/SceneDefinition.h"
@@ -20,6 +24,8 @@
 #include "Components/Graphics/Model/ModelMesh.h"
 #include "Components/Window/WindowComponent.h"
 
+#include <random>
+
 using std::make_shared;
 using std::make_unique;
 using std::static_pointer_cast;
@@ -51,10 +57,11 @@ namespace octronic::dream
       mShaderCache(*this, static_cast<ProjectDefinition&>(getDefinition()),mProjectDirectory),
       mTextureCache(*this, static_cast<ProjectDefinition&>(getDefinition()),mProjectDirectory),
       mTaskQueue("ProjectTaskQueue"),
-      mDestructionTaskQueue("ProjectDestructionTaskQueue")
+      mDestructionTaskQueue("ProjectDestructionTaskQueue"),
+      mLastFrameStart(0),
+      mRandomSeed(std::random_device()())
   {
     LOG_DEBUG( "ProjectRuntime: Constructing" );
-    mFrameDurationHistory.resize(MaxFrameCount);
   }
 
 
@@ -179,6 +186,7 @@ namespace octronic::dream
       LOG_ERROR( "ProjectRuntime: Unable to initialise Script Engine." );
       return false;
     }
+    mScriptComponent.setRandomSeed(mRandomSeed);
     return true;
   }
 
@@ -210,12 +218,28 @@ namespace octronic::dream
 
   void ProjectRuntime::pushComponentTasks()
   {
+    DREAM_PROFILE_ZONE("ProjectRuntime::pushComponentTasks");
     // Maintain this order
-    mWindowComponent.get().pushTasks();
-    mInputComponent.pushTasks();
-    mAudioComponent.get().pushTasks();
-    mPhysicsComponent.pushTasks();
-    mScriptComponent.pushTasks();
+    {
+      DREAM_PROFILE_ZONE("WindowComponent::pushTasks");
+      mWindowComponent.get().pushTasks();
+    }
+    {
+      DREAM_PROFILE_ZONE("InputComponent::pushTasks");
+      mInputComponent.pushTasks();
+    }
+    {
+      DREAM_PROFILE_ZONE("AudioComponent::pushTasks");
+      mAudioComponent.get().pushTasks();
+    }
+    {
+      DREAM_PROFILE_ZONE("PhysicsComponent::pushTasks");
+      mPhysicsComponent.pushTasks();
+    }
+    {
+      DREAM_PROFILE_ZONE("ScriptComponent::pushTasks");
+      mScriptComponent.pushTasks();
+    }
     mGraphicsComponent.pushTasks();
   }
 
@@ -225,6 +249,48 @@ namespace octronic::dream
   {
     LOG_TRACE("\n\n=========================[ Update Started ]=========================\n\n");
 
+    DREAM_PROFILE_FRAME();
+    AllocationTracker::MarkFrame();
+    DREAM_PROFILE_ZONE("ProjectRuntime::step");
+
+    // Wall clock rather than Time, so a replay reports how long its
+    // frames really took
+    uint64_t frameStart = SteadyClock::Now();
+    if (mLastFrameStart != 0)
+    {
+      mFrameStats.record(FRAME_STAT_FRAME_TIME, frameStart - mLastFrameStart);
+    }
+    mLastFrameStart = frameStart;
+
+    // Only steps with an active scene are logged, as loading takes a
+    // different number of frames from run to run. The first logged step
+    // drops the part tick left by loading for the same reason.
+    bool logged = hasActiveSceneRuntime();
+
+    // Time runs whether or not a scene is active
+    if (mReplayPlayer && logged)
+    {
+      if (mReplayPlayer->getFrameCount() == 0) mTime.resetTickAccumulator();
+      uint64_t delta = 0;
+      // Past the end of the log input is held and time stands still
+      if (!mReplayPlayer->readFrame(mInputComponent, delta)) delta = 0;
+      mTime.updateFrameTime(delta);
+    }
+    else
+    {
+      if (mReplayRecorder && logged && mReplayRecorder->getFrameCount() == 0)
+      {
+        mTime.resetTickAccumulator();
+      }
+      mTime.updateFrameTime();
+    }
+
+    if (mReplayRecorder && logged)
+    {
+      mReplayRecorder->writeFrame(mTime.getFrameTimeDeltaNanos(), mInputComponent);
+    }
+
+    uint64_t phaseStart = SteadyClock::Now();
     pushComponentTasks();
 
     for (auto& rt_ptr : mSceneRuntimeVector)
@@ -249,13 +315,11 @@ namespace octronic::dream
         }
         case SceneState::SCENE_STATE_ACTIVE:
         {
-          mTime.updateFrameTime();
-          mFrameDurationHistory.push_back(1000.0f/mTime.getFrameTimeDelta());
-          if (mFrameDurationHistory.size() > MaxFrameCount) mFrameDurationHistory.pop_front();
-
+          DREAM_PROFILE_ZONE("SceneRuntime::update");
           auto& camera = rt.getCameraRuntime();
           camera.update();
           rt.updateFlatVector();
+          rt.updateSpatialIndex();
           rt.createSceneTasks();
 
           rt.collectGarbage();
@@ -289,12 +353,30 @@ namespace octronic::dream
     }
 
     ModelMesh::ClearCounters();
+    GLDispatch::ClearCounters();
     ShaderRuntime::InvalidateState();
 
+    uint64_t phaseEnd = SteadyClock::Now();
+    mFrameStats.record(FRAME_STAT_UPDATE_TIME, phaseEnd - phaseStart);
+    phaseStart = phaseEnd;
+
+    mFrameStats.record(FRAME_STAT_TASKS, mTaskQueue.getTaskCount());
     mTaskQueue.executeQueue();
+
+    phaseEnd = SteadyClock::Now();
+    mFrameStats.record(FRAME_STAT_TASK_TIME, phaseEnd - phaseStart);
+    phaseStart = phaseEnd;
+
     auto& gfxQueue = mGraphicsComponent.getTaskQueue();
+    mFrameStats.record(FRAME_STAT_GRAPHICS_TASKS, gfxQueue.getTaskCount());
     gfxQueue.executeQueue();
 
+    phaseEnd = SteadyClock::Now();
+    mFrameStats.record(FRAME_STAT_GRAPHICS_TIME, phaseEnd - phaseStart);
+    mFrameStats.record(FRAME_STAT_DRAW_CALLS, ModelMesh::DrawCalls + ModelMesh::ShadowDrawCalls);
+    mFrameStats.record(FRAME_STAT_UPLOAD_BYTES, GLDispatch::GetCounters().bytesUploaded);
+    phaseStart = phaseEnd;
+
     mDestructionTaskQueue.executeQueue();
     auto& gfxDestQueue = mGraphicsComponent.getDestructionTaskQueue();
     gfxDestQueue.executeQueue();
@@ -307,6 +389,9 @@ namespace octronic::dream
     }
     mSceneRuntimesToRemove.clear();
 
+    mFrameStats.record(FRAME_STAT_DESTRUCTION_TIME, SteadyClock::Now() - phaseStart);
+    mFrameStats.endFrame();
+
     LOG_TRACE("\n\n=========================[ Update Complete ]=========================\n\n");
   }
 
@@ -366,6 +451,29 @@ namespace octronic::dream
     return mTextureCache;
   }
 
+  vector<CacheMemoryUsage>
+  ProjectRuntime::getCacheMemoryUsage
+  ()
+  const
+  {
+    vector<CacheMemoryUsage> usage =
+    {
+      mAudioCache.getMemoryUsage(),
+      mFontCache.getMemoryUsage(),
+      mMaterialCache.getMemoryUsage(),
+      mModelCache.getMemoryUsage(),
+      mScriptCache.getMemoryUsage(),
+      mShaderCache.getMemoryUsage(),
+      mTextureCache.getMemoryUsage()
+    };
+    const char* names[] = {"Audio", "Font", "Material", "Model", "Script", "Shader", "Texture"};
+    for (size_t i = 0; i < usage.size(); i++)
+    {
+      usage[i].name = names[i];
+    }
+    return usage;
+  }
+
   ScriptCache&
   ProjectRuntime::getScriptCache
   ()
@@ -416,23 +524,107 @@ namespace octronic::dream
     return false;
   }
 
-  deque<float>
-  ProjectRuntime::getFrameDurationHistory
+  const FrameStats&
+  ProjectRuntime::getFrameStats
   () const
   {
-    return mFrameDurationHistory;
+    return mFrameStats;
   }
 
   float
   ProjectRuntime::getAverageFramerate
+  () const
+  {
+    return mFrameStats.getAverageFrameRate();
+  }
+
+  // Replay ==================================================================
+
+  bool
+  ProjectRuntime::startRecording
+  (const string& path)
+  {
+    ReplayHeader header;
+    header.randomSeed = mRandomSeed;
+    header.tickRate = mTime.getTickRate();
+
+    auto recorder = make_unique<ReplayRecorder>();
+    if (!recorder->open(mStorageManager.get(), path, header))
+    {
+      return false;
+    }
+    mReplayRecorder = std::move(recorder);
+    return true;
+  }
+
+  void
+  ProjectRuntime::stopRecording
   ()
   {
-    float f = 0.0;
-    for (const auto& dur : mFrameDurationHistory)
+    mReplayRecorder.reset();
+  }
+
+  bool
+  ProjectRuntime::isRecording
+  () const
+  {
+    return mReplayRecorder != nullptr;
+  }
+
+  bool
+  ProjectRuntime::startReplay
+  (const string& path)
+  {
+    auto player = make_unique<ReplayPlayer>();
+    if (!player->open(mStorageManager.get(), path))
     {
-      f += dur;
+      return false;
     }
-    return f/MaxFrameCount;
+
+    auto& header = player->getHeader();
+    setRandomSeed(header.randomSeed);
+    if (header.tickRate > 0.0)
+    {
+      mTime.setTickRate(header.tickRate);
+    }
+    mReplayPlayer = std::move(player);
+    return true;
+  }
+
+  bool
+  ProjectRuntime::isReplaying
+  () const
+  {
+    return mReplayPlayer != nullptr;
+  }
+
+  bool
+  ProjectRuntime::isReplayFinished
+  () const
+  {
+    return mReplayPlayer != nullptr && mReplayPlayer->isFinished();
+  }
+
+  bool
+  ProjectRuntime::hasReplayFrames
+  () const
+  {
+    return mReplayPlayer != nullptr && mReplayPlayer->hasNextFrame();
+  }
+
+  uint32_t
+  ProjectRuntime::getRandomSeed
+  () const
+  {
+    return mRandomSeed;
+  }
+
+  void
+  ProjectRuntime::setRandomSeed
+  (uint32_t seed)
+  {
+    mRandomSeed = seed;
+    mScriptComponent.setRandomSeed(seed);
   }
 
   TaskQueue<Task>&
@@ -592,6 +784,4 @@ namespace octronic::dream
   {
     return mProjectDirectory;
   }
-
-  unsigned int ProjectRuntime::MaxFrameCount = 100;
 }
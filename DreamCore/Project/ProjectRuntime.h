@@ -4,6 +4,7 @@
 #include "Base/Runtime.h"
 // Time
 #include "Components/Time.h"
+#include "Components/FrameStats.h"
 // Audio
 #include "Components/Audio/AudioComponent.h"
 #include "Components/Audio/AudioDefinition.h"
@@ -33,15 +34,15 @@
 #include "Task/TaskQueue.h"
 // Cache
 #include "Components/Cache.h"
+// Replay
+#include "Project/ReplayLog.h"
 // STD
 #include <string>
 #include <vector>
-#include <deque>
 #include <memory>
 // Using
 using std::string;
 using std::vector;
-using std::deque;
 
 namespace octronic::dream
 {
@@ -65,8 +66,6 @@ namespace octronic::dream
   // Class Declaration
   class ProjectRuntime : public Runtime
   {
-  public: // Public Variables
-    static unsigned int MaxFrameCount;
   public: // Public Functions
     ProjectRuntime(ProjectDefinition& definition, ProjectDirectory& directory,
                    StorageManager& sm, WindowComponent& wc, AudioComponent& ac);
@@ -104,6 +103,11 @@ namespace octronic::dream
     TextureCache&  getTextureCache();
     bool initCaches();
     void clearAllCaches();
+    /**
+     * @brief Snapshot of the memory held by each Cache, one entry per
+     * Cache in alphabetical order.
+     */
+    vector<CacheMemoryUsage> getCacheMemoryUsage() const;
     // Scenes ==============================================================
     SceneRuntime& createSceneRuntime(SceneDefinition&);
     optional<reference_wrapper<SceneRuntime>> getActiveSceneRuntime() const;
@@ -115,8 +119,37 @@ namespace octronic::dream
     bool hasSceneRuntime(UuidType uuid) const;
     bool hasLoadedScenes() const;
     // Frames ==============================================================
-    deque<float> getFrameDurationHistory() const;
-    float getAverageFramerate();
+    const FrameStats& getFrameStats() const;
+    float getAverageFramerate() const;
+    // Replay ==============================================================
+    /**
+     * @brief Write the input and delta of each step taken with an active
+     * scene to path with the random seed, see ReplayRecorder. Start before
+     * the first step so a replay sees the same random numbers.
+     */
+    bool startRecording(const string& path);
+    void stopRecording();
+    bool isRecording() const;
+    /**
+     * @brief Drive each step taken with an active scene from the log at
+     * path rather than the window's input and the clock, see ReplayPlayer.
+     * Steps while the scene loads use the clock, so however many of them
+     * a run takes the log's first frame lands on the first active step.
+     * Applies the log's random seed and tick rate, call before the first
+     * step.
+     */
+    bool startReplay(const string& path);
+    bool isReplaying() const;
+    bool isReplayFinished() const;
+    /**
+     * @brief True while the replay has frames left for later steps.
+     */
+    bool hasReplayFrames() const;
+    /**
+     * @brief Seed for Lua's math.random, random unless set or replayed.
+     */
+    uint32_t getRandomSeed() const;
+    void setRandomSeed(uint32_t seed);
 
   private: // Member Functions
     bool initAudioComponent();
@@ -154,6 +187,11 @@ namespace octronic::dream
     TaskQueue<Task>            mTaskQueue;
     TaskQueue<DestructionTask> mDestructionTaskQueue;
     // Frames
-    deque<float> mFrameDurationHistory;
+    FrameStats mFrameStats;
+    uint64_t mLastFrameStart;
+    // Replay
+    uint32_t mRandomSeed;
+    unique_ptr<ReplayRecorder> mReplayRecorder;
+    unique_ptr<ReplayPlayer> mReplayPlayer;
   };
 }
@@ -0,0 +1,512 @@
+#include "ReplayLog.h"
+
+#include "Common/Logger.h"
+#include "Components/Input/InputComponent.h"
+#include "Storage/StorageManager.h"
+#include "Storage/File.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace octronic::dream
+{
+  namespace
+  {
+    const char REPLAY_MAGIC[4] = {'D','R','P','L'};
+    const uint32_t REPLAY_VERSION = 1;
+    // Magic, version, seed and tick rate
+    const size_t REPLAY_HEADER_SIZE = sizeof(REPLAY_MAGIC) + 4 + 4 + 8;
+    // Pending frames are appended to the log once they reach this size
+    const size_t REPLAY_FLUSH_SIZE = 4096;
+
+    const uint8_t FRAME_KEYBOARD = 1 << 0;
+    const uint8_t FRAME_MOUSE    = 1 << 1;
+    const uint8_t FRAME_JOYSTICK = 1 << 2;
+
+    // Sizes the window components pass to setKeysPressed/setButtonsPressed
+    const unsigned int KEYBOARD_KEYS = 512;
+    const unsigned int MOUSE_BUTTONS = 5;
+    // Size of JoystickState's axis and button arrays
+    const int JOYSTICK_MAX_DATA = 32;
+    const size_t JOYSTICK_MAX_NAME = 255;
+    // Largest section, a joystick with a full name
+    const size_t MAX_SECTION_SIZE = 3 + JOYSTICK_MAX_DATA * 5 + 1 + JOYSTICK_MAX_NAME;
+
+    void
+    PutU32
+    (vector<uint8_t>& out, uint32_t value)
+    {
+      for (int i = 0; i < 4; i++) out.push_back((value >> (i * 8)) & 0xFF);
+    }
+
+    void
+    PutU64
+    (vector<uint8_t>& out, uint64_t value)
+    {
+      for (int i = 0; i < 8; i++) out.push_back((value >> (i * 8)) & 0xFF);
+    }
+
+    void
+    PutFloat
+    (vector<uint8_t>& out, float value)
+    {
+      uint32_t bits;
+      memcpy(&bits, &value, sizeof(bits));
+      PutU32(out, bits);
+    }
+
+    void
+    PutVarint
+    (vector<uint8_t>& out, uint64_t value)
+    {
+      while (value >= 0x80)
+      {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+      }
+      out.push_back(static_cast<uint8_t>(value));
+    }
+
+    uint32_t
+    GetU32
+    (const uint8_t* in)
+    {
+      uint32_t value = 0;
+      for (int i = 0; i < 4; i++) value |= static_cast<uint32_t>(in[i]) << (i * 8);
+      return value;
+    }
+
+    uint64_t
+    GetU64
+    (const uint8_t* in)
+    {
+      uint64_t value = 0;
+      for (int i = 0; i < 8; i++) value |= static_cast<uint64_t>(in[i]) << (i * 8);
+      return value;
+    }
+
+    float
+    GetFloat
+    (const uint8_t* in)
+    {
+      uint32_t bits = GetU32(in);
+      float value;
+      memcpy(&value, &bits, sizeof(value));
+      return value;
+    }
+
+    bool
+    GetVarint
+    (const vector<uint8_t>& in, size_t& offset, uint64_t& value)
+    {
+      value = 0;
+      for (int shift = 0; shift < 64; shift += 7)
+      {
+        if (offset >= in.size()) return false;
+        uint8_t byte = in[offset++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+      }
+      return false;
+    }
+
+    // Section encodings ===================================================
+
+    void
+    EncodeKeyboard
+    (vector<uint8_t>& out, KeyboardState& keyboard)
+    {
+      out.assign(KEYBOARD_KEYS / 8, 0);
+      for (unsigned int key = 0; key < KEYBOARD_KEYS; key++)
+      {
+        if (keyboard.isKeyPressed(key)) out[key / 8] |= 1 << (key % 8);
+      }
+    }
+
+    void
+    DecodeKeyboard
+    (const vector<uint8_t>& in, KeyboardState& keyboard)
+    {
+      bool keys[KEYBOARD_KEYS];
+      for (unsigned int key = 0; key < KEYBOARD_KEYS; key++)
+      {
+        keys[key] = (in[key / 8] >> (key % 8)) & 1;
+      }
+      keyboard.setKeysPressed(keys, KEYBOARD_KEYS);
+    }
+
+    void
+    EncodeMouse
+    (vector<uint8_t>& out, const MouseState& mouse)
+    {
+      out.clear();
+      PutFloat(out, mouse.getPosX());
+      PutFloat(out, mouse.getPosY());
+      PutFloat(out, mouse.getScrollX());
+      PutFloat(out, mouse.getScrollY());
+      uint8_t buttons = 0;
+      for (unsigned int button = 0; button < MOUSE_BUTTONS; button++)
+      {
+        if (mouse.isButtonPressed(button)) buttons |= 1 << button;
+      }
+      out.push_back(buttons);
+    }
+
+    void
+    DecodeMouse
+    (const vector<uint8_t>& in, MouseState& mouse)
+    {
+      mouse.setPosX(GetFloat(&in[0]));
+      mouse.setPosY(GetFloat(&in[4]));
+      mouse.setScrollX(GetFloat(&in[8]));
+      mouse.setScrollY(GetFloat(&in[12]));
+      bool buttons[MOUSE_BUTTONS];
+      for (unsigned int button = 0; button < MOUSE_BUTTONS; button++)
+      {
+        buttons[button] = (in[16] >> button) & 1;
+      }
+      mouse.setButtonsPressed(buttons, MOUSE_BUTTONS);
+    }
+
+    void
+    EncodeJoystick
+    (vector<uint8_t>& out, JoystickState& joystick, int joystickCount)
+    {
+      out.clear();
+      int axes = std::clamp(joystick.getAxisCount(), 0, JOYSTICK_MAX_DATA);
+      int buttons = std::clamp(joystick.getButtonCount(), 0, JOYSTICK_MAX_DATA);
+      string name = joystick.getName().substr(0, JOYSTICK_MAX_NAME);
+
+      out.push_back(static_cast<uint8_t>(std::clamp(joystickCount, 0, 255)));
+      out.push_back(static_cast<uint8_t>(axes));
+      out.push_back(static_cast<uint8_t>(buttons));
+      for (int i = 0; i < axes; i++) PutFloat(out, joystick.getAxisData(i));
+      for (int i = 0; i < buttons; i++) out.push_back(joystick.getButtonData(i) ? 1 : 0);
+      out.push_back(static_cast<uint8_t>(name.size()));
+      out.insert(out.end(), name.begin(), name.end());
+    }
+
+    bool
+    DecodeJoystick
+    (const vector<uint8_t>& in, JoystickState& joystick, int& joystickCount)
+    {
+      if (in.size() < 3) return false;
+      int axes = in[1];
+      int buttons = in[2];
+      size_t nameOffset = 3 + axes * 4 + buttons;
+      if (axes > JOYSTICK_MAX_DATA || buttons > JOYSTICK_MAX_DATA || in.size() < nameOffset + 1) return false;
+      size_t nameSize = in[nameOffset];
+      if (in.size() != nameOffset + 1 + nameSize) return false;
+
+      joystickCount = in[0];
+      joystick.setAxisCount(axes);
+      joystick.setButtonCount(buttons);
+      for (int i = 0; i < axes; i++) joystick.setAxisData(i, GetFloat(&in[3 + i * 4]));
+      for (int i = 0; i < buttons; i++) joystick.setButtonData(i, in[3 + axes * 4 + i] != 0);
+      joystick.setName(string(in.begin() + nameOffset + 1, in.end()));
+      return true;
+    }
+
+    /**
+     * @brief Append section to frame with its size when it differs from
+     * last, which then holds it.
+     */
+    bool
+    WriteSectionIfChanged
+    (vector<uint8_t>& frame, const vector<uint8_t>& section, vector<uint8_t>& last)
+    {
+      if (section == last) return false;
+      PutVarint(frame, section.size());
+      frame.insert(frame.end(), section.begin(), section.end());
+      last = section;
+      return true;
+    }
+  }
+
+  // ReplayRecorder ==========================================================
+
+  ReplayRecorder::ReplayRecorder
+  ()
+    : mStorageManager(nullptr),
+      mFile(nullptr),
+      mFrameCount(0)
+  {
+  }
+
+  ReplayRecorder::~ReplayRecorder
+  ()
+  {
+    close();
+  }
+
+  bool
+  ReplayRecorder::open
+  (StorageManager& storage, const string& path, const ReplayHeader& header)
+  {
+    close();
+
+    vector<uint8_t> bytes(REPLAY_MAGIC, REPLAY_MAGIC + sizeof(REPLAY_MAGIC));
+    PutU32(bytes, REPLAY_VERSION);
+    PutU32(bytes, header.randomSeed);
+    uint64_t tickRateBits;
+    memcpy(&tickRateBits, &header.tickRate, sizeof(tickRateBits));
+    PutU64(bytes, tickRateBits);
+
+    // Replaces any existing log, frames are appended after it
+    auto& file = storage.openFile(path);
+    if (!file.writeBinary(bytes))
+    {
+      LOG_ERROR("ReplayRecorder: Unable to write header to {}", path);
+      storage.closeFile(file);
+      return false;
+    }
+
+    mStorageManager = &storage;
+    mFile = &file;
+    mPath = path;
+    mFrameCount = 0;
+    mPending.clear();
+    mLastKeyboard.clear();
+    mLastMouse.clear();
+    mLastJoystick.clear();
+
+    LOG_INFO("ReplayRecorder: Recording to {}, seed {}", path, header.randomSeed);
+    return true;
+  }
+
+  void
+  ReplayRecorder::close
+  ()
+  {
+    if (mFile == nullptr) return;
+
+    if (!flush())
+    {
+      LOG_ERROR("ReplayRecorder: Unable to write the last frames to {}", mPath);
+    }
+    mStorageManager->closeFile(*mFile);
+    mStorageManager = nullptr;
+    mFile = nullptr;
+    LOG_INFO("ReplayRecorder: Wrote {} frames to {}", mFrameCount, mPath);
+  }
+
+  bool
+  ReplayRecorder::flush
+  ()
+  {
+    if (mPending.empty()) return true;
+    bool written = mFile->appendBinary(mPending);
+    mPending.clear();
+    return written;
+  }
+
+  bool
+  ReplayRecorder::isOpen
+  ()
+  const
+  {
+    return mFile != nullptr;
+  }
+
+  void
+  ReplayRecorder::writeFrame
+  (uint64_t deltaNanos, InputComponent& input)
+  {
+    if (mFile == nullptr) return;
+
+    // Flags are filled in once the changed sections are known
+    mFrame.assign(1, 0);
+    PutVarint(mFrame, deltaNanos);
+
+    EncodeKeyboard(mSection, input.getKeyboardState());
+    if (WriteSectionIfChanged(mFrame, mSection, mLastKeyboard)) mFrame[0] |= FRAME_KEYBOARD;
+
+    EncodeMouse(mSection, input.getMouseState());
+    if (WriteSectionIfChanged(mFrame, mSection, mLastMouse)) mFrame[0] |= FRAME_MOUSE;
+
+    EncodeJoystick(mSection, input.getJoystickState(), input.getJoystickCount());
+    if (WriteSectionIfChanged(mFrame, mSection, mLastJoystick)) mFrame[0] |= FRAME_JOYSTICK;
+
+    mPending.insert(mPending.end(), mFrame.begin(), mFrame.end());
+    mFrameCount++;
+
+    if (mPending.size() >= REPLAY_FLUSH_SIZE && !flush())
+    {
+      LOG_ERROR("ReplayRecorder: Write to {} failed, recording stopped", mPath);
+      close();
+    }
+  }
+
+  uint64_t
+  ReplayRecorder::getFrameCount
+  ()
+  const
+  {
+    return mFrameCount;
+  }
+
+  // ReplayPlayer ============================================================
+
+  ReplayPlayer::ReplayPlayer
+  ()
+    : mOffset(0),
+      mFinished(true),
+      mFrameCount(0),
+      mJoystickCount(0)
+  {
+  }
+
+  bool
+  ReplayPlayer::open
+  (StorageManager& storage, const string& path)
+  {
+    mFinished = true;
+    mLog.clear();
+    mOffset = 0;
+
+    auto& file = storage.openFile(path);
+    bool read = file.readBinary();
+    if (read) mLog = file.getBinaryData();
+    storage.closeFile(file);
+
+    if (!read)
+    {
+      LOG_ERROR("ReplayPlayer: Unable to open {}", path);
+      return false;
+    }
+
+    mPath = path;
+    if (mLog.size() < REPLAY_HEADER_SIZE ||
+        memcmp(mLog.data(), REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0)
+    {
+      LOG_ERROR("ReplayPlayer: {} is not a replay log", path);
+      mLog.clear();
+      return false;
+    }
+
+    uint32_t version = GetU32(&mLog[4]);
+    if (version != REPLAY_VERSION)
+    {
+      LOG_ERROR("ReplayPlayer: {} has version {}, expected {}", path, version, REPLAY_VERSION);
+      mLog.clear();
+      return false;
+    }
+
+    mHeader.randomSeed = GetU32(&mLog[8]);
+    uint64_t tickRateBits = GetU64(&mLog[12]);
+    memcpy(&mHeader.tickRate, &tickRateBits, sizeof(mHeader.tickRate));
+
+    mOffset = REPLAY_HEADER_SIZE;
+    mFinished = false;
+    mFrameCount = 0;
+    mKeyboardState = KeyboardState();
+    mMouseState = MouseState();
+    mJoystickState = JoystickState();
+    mJoystickCount = 0;
+
+    LOG_INFO("ReplayPlayer: Replaying {}, seed {}", path, mHeader.randomSeed);
+    return true;
+  }
+
+  const ReplayHeader&
+  ReplayPlayer::getHeader
+  ()
+  const
+  {
+    return mHeader;
+  }
+
+  bool
+  ReplayPlayer::readSection
+  (size_t size, vector<uint8_t>& out)
+  {
+    uint64_t recorded;
+    if (!GetVarint(mLog, mOffset, recorded) || recorded > MAX_SECTION_SIZE) return false;
+    // A size of 0 takes any length
+    if (size != 0 && recorded != size) return false;
+    if (recorded > mLog.size() - mOffset) return false;
+    out.assign(mLog.begin() + mOffset, mLog.begin() + mOffset + recorded);
+    mOffset += recorded;
+    return true;
+  }
+
+  bool
+  ReplayPlayer::readFrame
+  (InputComponent& input, uint64_t& deltaNanos)
+  {
+    if (mFinished) return false;
+
+    if (mOffset >= mLog.size())
+    {
+      LOG_INFO("ReplayPlayer: Finished {} after {} frames", mPath, mFrameCount);
+      mFinished = true;
+      return false;
+    }
+
+    uint8_t flags = mLog[mOffset++];
+    bool valid = GetVarint(mLog, mOffset, deltaNanos);
+
+    if (valid && (flags & FRAME_KEYBOARD))
+    {
+      valid = readSection(KEYBOARD_KEYS / 8, mSection);
+      if (valid) DecodeKeyboard(mSection, mKeyboardState);
+    }
+
+    if (valid && (flags & FRAME_MOUSE))
+    {
+      valid = readSection(4 * 4 + 1, mSection);
+      if (valid) DecodeMouse(mSection, mMouseState);
+    }
+
+    if (valid && (flags & FRAME_JOYSTICK))
+    {
+      // Variable size, checked by DecodeJoystick
+      valid = readSection(0, mSection) && DecodeJoystick(mSection, mJoystickState, mJoystickCount);
+    }
+
+    if (!valid)
+    {
+      LOG_ERROR("ReplayPlayer: {} is damaged at frame {}, stopping", mPath, mFrameCount);
+      mFinished = true;
+      return false;
+    }
+
+    input.setKeyboardState(mKeyboardState);
+    input.setMouseState(mMouseState);
+    input.setJoystickState(mJoystickState);
+    input.setJoystickCount(mJoystickCount);
+    mFrameCount++;
+    return true;
+  }
+
+  bool
+  ReplayPlayer::hasNextFrame
+  ()
+  {
+    if (mFinished) return false;
+
+    if (mOffset >= mLog.size())
+    {
+      LOG_INFO("ReplayPlayer: Finished {} after {} frames", mPath, mFrameCount);
+      mFinished = true;
+      return false;
+    }
+    return true;
+  }
+
+  bool
+  ReplayPlayer::isFinished
+  ()
+  const
+  {
+    return mFinished;
+  }
+
+  uint64_t
+  ReplayPlayer::getFrameCount
+  ()
+  const
+  {
+    return mFrameCount;
+  }
+}
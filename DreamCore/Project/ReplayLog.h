@@ -0,0 +1,122 @@
+#pragma once
+
+#include "Components/Input/KeyboardState.h"
+#include "Components/Input/MouseState.h"
+#include "Components/Input/JoystickState.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+namespace octronic::dream
+{
+  class InputComponent;
+  class StorageManager;
+  class File;
+
+  /**
+   * @brief Header of a replay log, what a run needs besides its input to
+   * behave the same way again.
+   */
+  struct ReplayHeader
+  {
+    uint32_t randomSeed = 0;
+    double tickRate = 0.0;
+  };
+
+  /**
+   * @brief Writes the input and frame delta of each ProjectRuntime::step
+   * to a binary log that ReplayPlayer can feed back.
+   *
+   * After the header, each frame is a byte of flags, the delta in ns as a
+   * varint, then only the keyboard, mouse and joystick states that changed
+   * since the last frame. A frame with no new input costs two or three
+   * bytes. Values are little endian.
+   *
+   * Frames are buffered and appended to the File in blocks, so a long
+   * recording doesn't hold the whole log in memory.
+   */
+  class ReplayRecorder
+  {
+  public:
+    ReplayRecorder();
+    ~ReplayRecorder();
+
+    ReplayRecorder(const ReplayRecorder&) = delete;
+    ReplayRecorder& operator=(const ReplayRecorder&) = delete;
+
+    bool open(StorageManager& storage, const string& path, const ReplayHeader& header);
+    void close();
+    bool isOpen() const;
+
+    void writeFrame(uint64_t deltaNanos, InputComponent& input);
+    uint64_t getFrameCount() const;
+
+  private:
+    bool flush();
+
+  private:
+    StorageManager* mStorageManager;
+    File* mFile;
+    string mPath;
+    uint64_t mFrameCount;
+    // Frames not yet appended to mFile
+    vector<uint8_t> mPending;
+    vector<uint8_t> mFrame;
+    vector<uint8_t> mSection;
+    // Last written encoding of each input state, empty until written
+    vector<uint8_t> mLastKeyboard;
+    vector<uint8_t> mLastMouse;
+    vector<uint8_t> mLastJoystick;
+  };
+
+  /**
+   * @brief Reads a log written by ReplayRecorder one frame at a time,
+   * applying each frame's input to an InputComponent. The log is read
+   * whole when opened.
+   */
+  class ReplayPlayer
+  {
+  public:
+    ReplayPlayer();
+
+    ReplayPlayer(const ReplayPlayer&) = delete;
+    ReplayPlayer& operator=(const ReplayPlayer&) = delete;
+
+    bool open(StorageManager& storage, const string& path);
+    const ReplayHeader& getHeader() const;
+
+    /**
+     * @brief Apply the next frame's input and give its delta.
+     * @return False once every frame has been read, or the log is damaged.
+     */
+    bool readFrame(InputComponent& input, uint64_t& deltaNanos);
+    /**
+     * @brief True while another frame is left to read, without reading it.
+     */
+    bool hasNextFrame();
+    bool isFinished() const;
+    uint64_t getFrameCount() const;
+
+  private:
+    bool readSection(size_t size, vector<uint8_t>& out);
+
+  private:
+    vector<uint8_t> mLog;
+    // Read position in mLog
+    size_t mOffset;
+    string mPath;
+    ReplayHeader mHeader;
+    bool mFinished;
+    uint64_t mFrameCount;
+    vector<uint8_t> mSection;
+    // Input as of the last frame read, sections not in a frame carry over
+    KeyboardState mKeyboardState;
+    MouseState mMouseState;
+    JoystickState mJoystickState;
+    int mJoystickCount;
+  };
+}
@@ -0,0 +1,610 @@
+#include "AABBTree.h"
+
+#include "Components/Graphics/Frustum.h"
+#include "Common/Logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+using std::max;
+using std::min;
+using std::pair;
+using std::priority_queue;
+using std::numeric_limits;
+using glm::clamp;
+using glm::dot;
+
+namespace octronic::dream
+{
+  const int AABBTree::NULL_NODE = -1;
+  const float AABBTree::FAT_MARGIN = 0.1f;
+
+  namespace
+  {
+    float
+    HalfSurfaceArea
+    (const vec3& minimum, const vec3& maximum)
+    {
+      vec3 d = maximum - minimum;
+      return d.x * d.y + d.y * d.z + d.z * d.x;
+    }
+
+    bool
+    Contains
+    (const vec3& outerMin, const vec3& outerMax, const vec3& innerMin, const vec3& innerMax)
+    {
+      return outerMin.x <= innerMin.x && outerMin.y <= innerMin.y && outerMin.z <= innerMin.z &&
+             outerMax.x >= innerMax.x && outerMax.y >= innerMax.y && outerMax.z >= innerMax.z;
+    }
+
+    float
+    DistanceSquared
+    (const vec3& point, const vec3& minimum, const vec3& maximum)
+    {
+      vec3 d = point - clamp(point, minimum, maximum);
+      return dot(d, d);
+    }
+
+    // Slab test, distance is where the ray enters the box, 0 from inside
+    bool
+    RayHitsBox
+    (const vec3& origin, const vec3& direction, float maxDistance,
+     const vec3& minimum, const vec3& maximum, float& distance)
+    {
+      float tMin = 0.f;
+      float tMax = maxDistance;
+      for (int axis = 0; axis < 3; axis++)
+      {
+        if (std::fabs(direction[axis]) < numeric_limits<float>::epsilon())
+        {
+          if (origin[axis] < minimum[axis] || origin[axis] > maximum[axis]) return false;
+          continue;
+        }
+        float inv = 1.f / direction[axis];
+        float t0 = (minimum[axis] - origin[axis]) * inv;
+        float t1 = (maximum[axis] - origin[axis]) * inv;
+        if (t0 > t1) std::swap(t0, t1);
+        tMin = max(tMin, t0);
+        tMax = min(tMax, t1);
+        if (tMin > tMax) return false;
+      }
+      distance = tMin;
+      return true;
+    }
+  }
+
+  AABBTree::AABBTree
+  ()
+    : mRoot(NULL_NODE),
+      mFreeList(NULL_NODE),
+      mProxyCount(0)
+  {
+  }
+
+  int
+  AABBTree::insert
+  (EntityRuntime* entity, const vec3& minimum, const vec3& maximum)
+  {
+    int leaf = allocateNode();
+    auto& node = mNodes[leaf];
+    node.tightMinimum = minimum;
+    node.tightMaximum = maximum;
+    node.minimum = minimum - vec3(FAT_MARGIN);
+    node.maximum = maximum + vec3(FAT_MARGIN);
+    node.height = 0;
+    node.entity = entity;
+    insertLeaf(leaf);
+    mProxyCount++;
+    return leaf;
+  }
+
+  void
+  AABBTree::remove
+  (int proxy)
+  {
+    if (proxy < 0 || proxy >= static_cast<int>(mNodes.size()) || !mNodes[proxy].isLeaf()) return;
+    removeLeaf(proxy);
+    freeNode(proxy);
+    mProxyCount--;
+  }
+
+  bool
+  AABBTree::move
+  (int proxy, const vec3& minimum, const vec3& maximum)
+  {
+    auto& node = mNodes[proxy];
+    node.tightMinimum = minimum;
+    node.tightMaximum = maximum;
+
+    vec3 fatMinimum = minimum - vec3(FAT_MARGIN);
+    vec3 fatMaximum = maximum + vec3(FAT_MARGIN);
+
+    // Still inside the fat box, and the fat box has not grown loose
+    vec3 hugeMinimum = minimum - vec3(4.f * FAT_MARGIN);
+    vec3 hugeMaximum = maximum + vec3(4.f * FAT_MARGIN);
+    if (Contains(node.minimum, node.maximum, minimum, maximum) &&
+        Contains(hugeMinimum, hugeMaximum, node.minimum, node.maximum))
+    {
+      return false;
+    }
+
+    removeLeaf(proxy);
+    mNodes[proxy].minimum = fatMinimum;
+    mNodes[proxy].maximum = fatMaximum;
+    insertLeaf(proxy);
+    return true;
+  }
+
+  void
+  AABBTree::clear
+  ()
+  {
+    mNodes.clear();
+    mRoot = NULL_NODE;
+    mFreeList = NULL_NODE;
+    mProxyCount = 0;
+  }
+
+  EntityRuntime*
+  AABBTree::getEntity
+  (int proxy)
+  const
+  {
+    if (proxy < 0 || proxy >= static_cast<int>(mNodes.size())) return nullptr;
+    return mNodes[proxy].entity;
+  }
+
+  size_t
+  AABBTree::getProxyCount
+  ()
+  const
+  {
+    return mProxyCount;
+  }
+
+  int
+  AABBTree::getHeight
+  ()
+  const
+  {
+    return mRoot == NULL_NODE ? 0 : mNodes[mRoot].height;
+  }
+
+  // Queries =================================================================
+
+  void
+  AABBTree::queryFrustum
+  (const Frustum& frustum, vector<EntityRuntime*>& out)
+  const
+  {
+    if (mRoot == NULL_NODE) return;
+
+    // Kept per thread, this runs every frame on the render path
+    thread_local vector<int> stack;
+    stack.clear();
+    stack.push_back(mRoot);
+
+    while (!stack.empty())
+    {
+      int index = stack.back();
+      stack.pop_back();
+      auto& node = mNodes[index];
+
+      if (node.isLeaf())
+      {
+        if (frustum.testIntersection(node.tightMinimum, node.tightMaximum) != Frustum::TEST_OUTSIDE)
+        {
+          out.push_back(node.entity);
+        }
+        continue;
+      }
+
+      switch (frustum.testIntersection(node.minimum, node.maximum))
+      {
+        case Frustum::TEST_OUTSIDE:
+          break;
+        case Frustum::TEST_INSIDE:
+          collectLeaves(index, out);
+          break;
+        case Frustum::TEST_INTERSECT:
+          stack.push_back(node.right);
+          stack.push_back(node.left);
+          break;
+      }
+    }
+  }
+
+  void
+  AABBTree::querySphere
+  (const vec3& center, float radius, vector<EntityRuntime*>& out)
+  const
+  {
+    if (mRoot == NULL_NODE) return;
+
+    float radiusSquared = radius * radius;
+    vector<int> stack;
+    stack.reserve(64);
+    stack.push_back(mRoot);
+
+    while (!stack.empty())
+    {
+      auto& node = mNodes[stack.back()];
+      stack.pop_back();
+
+      if (node.isLeaf())
+      {
+        if (DistanceSquared(center, node.tightMinimum, node.tightMaximum) <= radiusSquared)
+        {
+          out.push_back(node.entity);
+        }
+      }
+      else if (DistanceSquared(center, node.minimum, node.maximum) <= radiusSquared)
+      {
+        stack.push_back(node.right);
+        stack.push_back(node.left);
+      }
+    }
+  }
+
+  void
+  AABBTree::queryRay
+  (const vec3& origin, const vec3& direction, float maxDistance,
+   vector<AABBTreeRayHit>& out)
+  const
+  {
+    if (mRoot == NULL_NODE) return;
+
+    size_t first = out.size();
+    vector<int> stack;
+    stack.reserve(64);
+    stack.push_back(mRoot);
+
+    while (!stack.empty())
+    {
+      auto& node = mNodes[stack.back()];
+      stack.pop_back();
+      float distance = 0.f;
+
+      if (node.isLeaf())
+      {
+        if (RayHitsBox(origin, direction, maxDistance, node.tightMinimum, node.tightMaximum, distance))
+        {
+          out.push_back({node.entity, distance});
+        }
+      }
+      else if (RayHitsBox(origin, direction, maxDistance, node.minimum, node.maximum, distance))
+      {
+        stack.push_back(node.right);
+        stack.push_back(node.left);
+      }
+    }
+
+    std::stable_sort(out.begin() + first, out.end(),
+                     [](const AABBTreeRayHit& a, const AABBTreeRayHit& b)
+    { return a.distance < b.distance; });
+  }
+
+  void
+  AABBTree::queryNearest
+  (const vec3& point, size_t k, vector<EntityRuntime*>& out)
+  const
+  {
+    if (mRoot == NULL_NODE || k == 0) return;
+
+    // Best first: every queued distance is a lower bound for the leaves
+    // below it, so a leaf at the front is the next nearest
+    using Entry = pair<float, int>;
+    priority_queue<Entry, vector<Entry>, std::greater<Entry>> queue;
+    queue.push({DistanceSquared(point, mNodes[mRoot].minimum, mNodes[mRoot].maximum), mRoot});
+
+    size_t found = 0;
+    while (!queue.empty() && found < k)
+    {
+      int index = queue.top().second;
+      queue.pop();
+      auto& node = mNodes[index];
+
+      if (node.isLeaf())
+      {
+        out.push_back(node.entity);
+        found++;
+        continue;
+      }
+
+      for (int child : {node.left, node.right})
+      {
+        auto& c = mNodes[child];
+        float distance = c.isLeaf() ?
+              DistanceSquared(point, c.tightMinimum, c.tightMaximum) :
+              DistanceSquared(point, c.minimum, c.maximum);
+        queue.push({distance, child});
+      }
+    }
+  }
+
+  // Tree maintenance ========================================================
+
+  int
+  AABBTree::allocateNode
+  ()
+  {
+    if (mFreeList == NULL_NODE)
+    {
+      mNodes.emplace_back();
+      return static_cast<int>(mNodes.size() - 1);
+    }
+
+    int index = mFreeList;
+    mFreeList = mNodes[index].parent;
+    mNodes[index] = Node();
+    return index;
+  }
+
+  void
+  AABBTree::freeNode
+  (int index)
+  {
+    auto& node = mNodes[index];
+    node.parent = mFreeList;
+    node.left = NULL_NODE;
+    node.right = NULL_NODE;
+    node.height = -1;
+    node.entity = nullptr;
+    mFreeList = index;
+  }
+
+  void
+  AABBTree::insertLeaf
+  (int leaf)
+  {
+    if (mRoot == NULL_NODE)
+    {
+      mRoot = leaf;
+      mNodes[leaf].parent = NULL_NODE;
+      return;
+    }
+
+    const vec3 leafMinimum = mNodes[leaf].minimum;
+    const vec3 leafMaximum = mNodes[leaf].maximum;
+
+    // Descend towards the sibling that grows the tree's area the least
+    int index = mRoot;
+    while (!mNodes[index].isLeaf())
+    {
+      auto& node = mNodes[index];
+      float area = HalfSurfaceArea(node.minimum, node.maximum);
+      float combinedArea = HalfSurfaceArea(glm::min(node.minimum, leafMinimum), glm::max(node.maximum, leafMaximum));
+
+      // Cost of a new parent for this node and the leaf
+      float cost = 2.f * combinedArea;
+      // Cost pushed down onto every ancestor of a deeper sibling
+      float inheritance = 2.f * (combinedArea - area);
+
+      auto descendCost = [&](int child)
+      {
+        auto& c = mNodes[child];
+        float grown = HalfSurfaceArea(glm::min(c.minimum, leafMinimum), glm::max(c.maximum, leafMaximum));
+        return c.isLeaf() ? grown + inheritance : grown - HalfSurfaceArea(c.minimum, c.maximum) + inheritance;
+      };
+
+      float leftCost = descendCost(node.left);
+      float rightCost = descendCost(node.right);
+
+      if (cost < leftCost && cost < rightCost) break;
+      index = leftCost < rightCost ? node.left : node.right;
+    }
+
+    int sibling = index;
+    int oldParent = mNodes[sibling].parent;
+    int newParent = allocateNode();
+
+    auto& parent = mNodes[newParent];
+    parent.parent = oldParent;
+    parent.minimum = glm::min(mNodes[sibling].minimum, leafMinimum);
+    parent.maximum = glm::max(mNodes[sibling].maximum, leafMaximum);
+    parent.height = mNodes[sibling].height + 1;
+    parent.left = sibling;
+    parent.right = leaf;
+
+    if (oldParent != NULL_NODE)
+    {
+      if (mNodes[oldParent].left == sibling) mNodes[oldParent].left = newParent;
+      else mNodes[oldParent].right = newParent;
+    }
+    else
+    {
+      mRoot = newParent;
+    }
+
+    mNodes[sibling].parent = newParent;
+    mNodes[leaf].parent = newParent;
+
+    refitUpwards(newParent);
+  }
+
+  void
+  AABBTree::removeLeaf
+  (int leaf)
+  {
+    if (leaf == mRoot)
+    {
+      mRoot = NULL_NODE;
+      return;
+    }
+
+    int parent = mNodes[leaf].parent;
+    int grandParent = mNodes[parent].parent;
+    int sibling = mNodes[parent].left == leaf ? mNodes[parent].right : mNodes[parent].left;
+
+    if (grandParent != NULL_NODE)
+    {
+      if (mNodes[grandParent].left == parent) mNodes[grandParent].left = sibling;
+      else mNodes[grandParent].right = sibling;
+      mNodes[sibling].parent = grandParent;
+      freeNode(parent);
+      refitUpwards(grandParent);
+    }
+    else
+    {
+      mRoot = sibling;
+      mNodes[sibling].parent = NULL_NODE;
+      freeNode(parent);
+    }
+  }
+
+  void
+  AABBTree::refitUpwards
+  (int index)
+  {
+    while (index != NULL_NODE)
+    {
+      index = balance(index);
+
+      auto& node = mNodes[index];
+      auto& left = mNodes[node.left];
+      auto& right = mNodes[node.right];
+      node.height = 1 + max(left.height, right.height);
+      node.minimum = glm::min(left.minimum, right.minimum);
+      node.maximum = glm::max(left.maximum, right.maximum);
+
+      index = node.parent;
+    }
+  }
+
+  // Rotate the taller grandchild up when the children's heights differ by
+  // more than one. Returns the node now in index's place.
+  int
+  AABBTree::balance
+  (int iA)
+  {
+    auto& A = mNodes[iA];
+    if (A.isLeaf() || A.height < 2) return iA;
+
+    int iB = A.left;
+    int iC = A.right;
+    auto& B = mNodes[iB];
+    auto& C = mNodes[iC];
+    int difference = C.height - B.height;
+
+    auto replaceChild = [&](int parent, int from, int to)
+    {
+      if (parent == NULL_NODE)
+      {
+        mRoot = to;
+        return;
+      }
+      if (mNodes[parent].left == from) mNodes[parent].left = to;
+      else mNodes[parent].right = to;
+    };
+
+    // Rotate C up
+    if (difference > 1)
+    {
+      int iF = C.left;
+      int iG = C.right;
+      auto& F = mNodes[iF];
+      auto& G = mNodes[iG];
+
+      C.left = iA;
+      C.parent = A.parent;
+      A.parent = iC;
+      replaceChild(C.parent, iA, iC);
+
+      if (F.height > G.height)
+      {
+        C.right = iF;
+        A.right = iG;
+        G.parent = iA;
+        A.minimum = glm::min(B.minimum, G.minimum);
+        A.maximum = glm::max(B.maximum, G.maximum);
+        C.minimum = glm::min(A.minimum, F.minimum);
+        C.maximum = glm::max(A.maximum, F.maximum);
+        A.height = 1 + max(B.height, G.height);
+        C.height = 1 + max(A.height, F.height);
+      }
+      else
+      {
+        C.right = iG;
+        A.right = iF;
+        F.parent = iA;
+        A.minimum = glm::min(B.minimum, F.minimum);
+        A.maximum = glm::max(B.maximum, F.maximum);
+        C.minimum = glm::min(A.minimum, G.minimum);
+        C.maximum = glm::max(A.maximum, G.maximum);
+        A.height = 1 + max(B.height, F.height);
+        C.height = 1 + max(A.height, G.height);
+      }
+      return iC;
+    }
+
+    // Rotate B up
+    if (difference < -1)
+    {
+      int iD = B.left;
+      int iE = B.right;
+      auto& D = mNodes[iD];
+      auto& E = mNodes[iE];
+
+      B.left = iA;
+      B.parent = A.parent;
+      A.parent = iB;
+      replaceChild(B.parent, iA, iB);
+
+      if (D.height > E.height)
+      {
+        B.right = iD;
+        A.left = iE;
+        E.parent = iA;
+        A.minimum = glm::min(C.minimum, E.minimum);
+        A.maximum = glm::max(C.maximum, E.maximum);
+        B.minimum = glm::min(A.minimum, D.minimum);
+        B.maximum = glm::max(A.maximum, D.maximum);
+        A.height = 1 + max(C.height, E.height);
+        B.height = 1 + max(A.height, D.height);
+      }
+      else
+      {
+        B.right = iE;
+        A.left = iD;
+        D.parent = iA;
+        A.minimum = glm::min(C.minimum, D.minimum);
+        A.maximum = glm::max(C.maximum, D.maximum);
+        B.minimum = glm::min(A.minimum, E.minimum);
+        B.maximum = glm::max(A.maximum, E.maximum);
+        A.height = 1 + max(C.height, D.height);
+        B.height = 1 + max(A.height, E.height);
+      }
+      return iB;
+    }
+
+    return iA;
+  }
+
+  void
+  AABBTree::collectLeaves
+  (int index, vector<EntityRuntime*>& out)
+  const
+  {
+    thread_local vector<int> stack;
+    stack.clear();
+    stack.push_back(index);
+    while (!stack.empty())
+    {
+      auto& node = mNodes[stack.back()];
+      stack.pop_back();
+      if (node.isLeaf())
+      {
+        out.push_back(node.entity);
+      }
+      else
+      {
+        stack.push_back(node.right);
+        stack.push_back(node.left);
+      }
+    }
+  }
+}
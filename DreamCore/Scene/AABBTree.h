@@ -0,0 +1,114 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+#include <vector>
+
+using glm::vec3;
+using std::vector;
+
+namespace octronic::dream
+{
+  class EntityRuntime;
+  class Frustum;
+
+  struct AABBTreeRayHit
+  {
+    EntityRuntime* entity = nullptr;
+    float distance = 0.f;
+  };
+
+  /**
+   * @brief Dynamic bounding volume hierarchy over the entities of a scene.
+   *
+   * Each entity is a leaf holding its world space box. Leaves are stored
+   * fattened by FAT_MARGIN so small movements leave the tree untouched,
+   * and a leaf is only reinserted once its box leaves the fat one. Insertion
+   * picks the sibling by surface area cost and rotations keep the tree
+   * balanced, so queries visit O(log n) nodes for a compact result.
+   *
+   * Nodes live in one pool with a free list, proxy ids are indices into
+   * it and stay valid until the proxy is removed.
+   */
+  class AABBTree
+  {
+  public:
+    const static int NULL_NODE;
+    /**
+     * @brief Distance each leaf's box is grown by on every side.
+     */
+    const static float FAT_MARGIN;
+
+    AABBTree();
+
+    /**
+     * @brief Add an entity with the given world space box.
+     * @return Proxy id used to move or remove the entity.
+     */
+    int insert(EntityRuntime* entity, const vec3& minimum, const vec3& maximum);
+    void remove(int proxy);
+    /**
+     * @brief Update a proxy's box.
+     * @return true if the leaf had to be reinserted.
+     */
+    bool move(int proxy, const vec3& minimum, const vec3& maximum);
+    void clear();
+
+    EntityRuntime* getEntity(int proxy) const;
+    size_t getProxyCount() const;
+    int getHeight() const;
+
+    /**
+     * @brief Entities whose box is not fully outside the frustum. Whole
+     * subtrees inside the frustum are taken without testing their leaves.
+     */
+    void queryFrustum(const Frustum& frustum, vector<EntityRuntime*>& out) const;
+    /**
+     * @brief Entities whose box touches the sphere.
+     */
+    void querySphere(const vec3& center, float radius, vector<EntityRuntime*>& out) const;
+    /**
+     * @brief Entities whose box the ray enters within maxDistance, nearest
+     * first. direction need not be normalised, distances are in units of
+     * its length.
+     */
+    void queryRay(const vec3& origin, const vec3& direction, float maxDistance,
+                  vector<AABBTreeRayHit>& out) const;
+    /**
+     * @brief Up to k entities nearest the point, measured to their box,
+     * nearest first.
+     */
+    void queryNearest(const vec3& point, size_t k, vector<EntityRuntime*>& out) const;
+
+  private:
+    struct Node
+    {
+      // Fat box for internal nodes and the search, tight box for leaves
+      vec3 minimum;
+      vec3 maximum;
+      vec3 tightMinimum;
+      vec3 tightMaximum;
+      // Parent, or next free node while in the free list
+      int parent = NULL_NODE;
+      int left = NULL_NODE;
+      int right = NULL_NODE;
+      // Leaves are 0, free nodes -1
+      int height = -1;
+      EntityRuntime* entity = nullptr;
+
+      bool isLeaf() const { return left == NULL_NODE; }
+    };
+
+    int allocateNode();
+    void freeNode(int node);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    int balance(int node);
+    void refitUpwards(int node);
+    void collectLeaves(int node, vector<EntityRuntime*>& out) const;
+
+    vector<Node> mNodes;
+    int mRoot;
+    int mFreeList;
+    size_t mProxyCount;
+  };
+}
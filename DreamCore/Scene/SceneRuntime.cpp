@@ -33,6 +33,54 @@ using std::nullopt;
 
 namespace octronic::dream
 {
+  namespace
+  {
+    // World space box around the entity's bounds, or its position while it
+    // has none. pending is set while a model is still to be loaded.
+    void
+    WorldBounds
+    (const EntityRuntime& er, vec3& minimum, vec3& maximum, bool& pending)
+    {
+      mat4 m = er.getTransform().getMatrix();
+      vec3 translation(m[3]);
+      minimum = translation;
+      maximum = translation;
+      pending = false;
+
+      if (er.hasModelRuntime() && !er.getModelRuntime().getLoaded())
+      {
+        pending = true;
+        return;
+      }
+
+      BoundingBox bb = er.getBoundingBox();
+      vec3 bbMin = bb.getMinimum();
+      vec3 bbMax = bb.getMaximum();
+      if (bbMin.x > bbMax.x || bbMin.y > bbMax.y || bbMin.z > bbMax.z) return;
+
+      // Transform the centre, and the extent by the absolute basis so the
+      // box stays conservative under rotation and scale
+      vec3 center = (bbMin + bbMax) * 0.5f;
+      vec3 extent = (bbMax - bbMin) * 0.5f;
+      vec3 worldCenter = vec3(m * vec4(center, 1.f));
+      vec3 worldExtent = glm::abs(vec3(m[0])) * extent.x +
+                         glm::abs(vec3(m[1])) * extent.y +
+                         glm::abs(vec3(m[2])) * extent.z;
+      minimum = worldCenter - worldExtent;
+      maximum = worldCenter + worldExtent;
+    }
+
+    vector<reference_wrapper<EntityRuntime>>
+    ToReferences
+    (const vector<EntityRuntime*>& entities)
+    {
+      vector<reference_wrapper<EntityRuntime>> result;
+      result.reserve(entities.size());
+      for (auto* entity : entities) result.push_back(*entity);
+      return result;
+    }
+  }
+
   SceneRuntime::SceneRuntime
   (ProjectRuntime& project,
    SceneDefinition& sd)
@@ -435,7 +483,7 @@ namespace octronic::dream
     auto& pr = getProjectRuntime();
     auto& time = pr.getTime();
 
-    long timeDelta = time.getFrameTimeDelta();
+    double timeDelta = time.getFrameTimeDelta();
 
     if (timeDelta <= Time::DELTA_MAX)
     {
@@ -498,4 +546,118 @@ namespace octronic::dream
   {
     return mFlatVector;
   }
+
+  const vector<reference_wrapper<EntityRuntime>>&
+  SceneRuntime::getFlatView
+  () const
+  {
+    return mFlatVector;
+  }
+
+  // Spatial Index ===========================================================
+
+  void
+  SceneRuntime::updateSpatialIndex
+  ()
+  {
+    for (auto& erRef : mFlatVector)
+    {
+      auto& er = erRef.get();
+      if (er.getSpatialProxy() == AABBTree::NULL_NODE)
+      {
+        vec3 minimum, maximum;
+        bool pending;
+        WorldBounds(er, minimum, maximum, pending);
+        er.setSpatialProxy(mSpatialIndex.insert(&er, minimum, maximum));
+        er.setSpatialBoundsPending(pending);
+      }
+      else if (er.getSpatialBoundsPending())
+      {
+        updateSpatialProxy(er);
+      }
+    }
+  }
+
+  void
+  SceneRuntime::updateSpatialProxy
+  (EntityRuntime& er)
+  {
+    vec3 minimum, maximum;
+    bool pending;
+    WorldBounds(er, minimum, maximum, pending);
+    mSpatialIndex.move(er.getSpatialProxy(), minimum, maximum);
+    er.setSpatialBoundsPending(pending);
+  }
+
+  void
+  SceneRuntime::removeSpatialProxy
+  (EntityRuntime& er)
+  {
+    int proxy = er.getSpatialProxy();
+    if (mSpatialIndex.getEntity(proxy) == &er)
+    {
+      mSpatialIndex.remove(proxy);
+    }
+    er.setSpatialProxy(AABBTree::NULL_NODE);
+  }
+
+  const AABBTree&
+  SceneRuntime::getSpatialIndex
+  ()
+  const
+  {
+    return mSpatialIndex;
+  }
+
+  vector<reference_wrapper<EntityRuntime>>
+  SceneRuntime::getEntitiesInFrustum
+  (const Frustum& frustum)
+  const
+  {
+    vector<EntityRuntime*> entities;
+    mSpatialIndex.queryFrustum(frustum, entities);
+    return ToReferences(entities);
+  }
+
+  void
+  SceneRuntime::getEntitiesInFrustum
+  (const Frustum& frustum, vector<EntityRuntime*>& out)
+  const
+  {
+    out.clear();
+    mSpatialIndex.queryFrustum(frustum, out);
+  }
+
+  vector<reference_wrapper<EntityRuntime>>
+  SceneRuntime::getEntitiesInSphere
+  (const vec3& center, float radius)
+  const
+  {
+    vector<EntityRuntime*> entities;
+    mSpatialIndex.querySphere(center, radius, entities);
+    return ToReferences(entities);
+  }
+
+  vector<reference_wrapper<EntityRuntime>>
+  SceneRuntime::getEntitiesAlongRay
+  (const vec3& origin, const vec3& direction, float maxDistance)
+  const
+  {
+    vector<AABBTreeRayHit> hits;
+    mSpatialIndex.queryRay(origin, direction, maxDistance, hits);
+    vector<reference_wrapper<EntityRuntime>> result;
+    result.reserve(hits.size());
+    for (auto& hit : hits) result.push_back(*hit.entity);
+    return result;
+  }
+
+  vector<reference_wrapper<EntityRuntime>>
+  SceneRuntime::getNearestEntities
+  (const vec3& point, size_t count)
+  const
+  {
+    vector<EntityRuntime*> entities;
+    mSpatialIndex.queryNearest(point, count, entities);
+    return ToReferences(entities);
+  }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "SceneState.h"
+#include "AABBTree.h"
 
 #include "Common/AssetType.h"
 #include "Base/DeferredLoadRuntime.h"
@@ -79,6 +80,11 @@ namespace octronic::dream
     vector<reference_wrapper<AssetRuntime>>  getAssetRuntimes(AssetType) const;
     vector<reference_wrapper<EntityRuntime>> getEntitiesWithRuntimeOf(AssetDefinition& def) const;
     vector<reference_wrapper<EntityRuntime>> getFlatVector() const;
+    /**
+     * @return Every entity in the scene without copying, invalidated when
+     * entities are added or removed.
+     */
+    const vector<reference_wrapper<EntityRuntime>>& getFlatView() const;
 
     /**
          * @return Gets the nearest Entity to the Camera's position excluding
@@ -95,6 +101,35 @@ namespace octronic::dream
 
     void updateFlatVector();
 
+    // Spatial Index =======================================================
+
+    /**
+     * @brief Index entities new to the scenegraph and refresh the boxes of
+     * models that have finished loading since they were indexed. Movement
+     * is picked up as it happens through EntityRuntime::setTransform.
+     */
+    void updateSpatialIndex();
+    void updateSpatialProxy(EntityRuntime& entity);
+    void removeSpatialProxy(EntityRuntime& entity);
+    const AABBTree& getSpatialIndex() const;
+
+    vector<reference_wrapper<EntityRuntime>> getEntitiesInFrustum(const Frustum& frustum) const;
+    /**
+     * @brief Replace the contents of out with the entities in frustum. out
+     * keeps its capacity, so a caller that reuses it does not allocate once
+     * it has grown to fit.
+     */
+    void getEntitiesInFrustum(const Frustum& frustum, vector<EntityRuntime*>& out) const;
+    vector<reference_wrapper<EntityRuntime>> getEntitiesInSphere(const vec3& center, float radius) const;
+    /**
+     * @return Entities whose bounds the ray enters, nearest first.
+     */
+    vector<reference_wrapper<EntityRuntime>> getEntitiesAlongRay(const vec3& origin, const vec3& direction, float maxDistance) const;
+    /**
+     * @return Up to count entities nearest the point, nearest first.
+     */
+    vector<reference_wrapper<EntityRuntime>> getNearestEntities(const vec3& point, size_t count) const;
+
   protected:
     void updateLifetime();
     void createAllAssetRuntimes();
@@ -104,6 +139,8 @@ namespace octronic::dream
     SceneState mState;
     vec4 mClearColor;
     vector<reference_wrapper<EntityRuntime>> mEntityRuntimeCleanUpQueue;
+    // Declared before the entities so it outlives their destructors
+    AABBTree mSpatialIndex;
     optional<EntityRuntime> mRootEntityRuntime;
     vector<reference_wrapper<EntityRuntime>> mFlatVector;
     optional<reference_wrapper<ShaderRuntime>> mShadowPassShader;
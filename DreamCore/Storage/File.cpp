@@ -106,7 +106,22 @@ namespace octronic::dream
     if (mPath.empty()) return false;
 
     auto file = fopen(mPath.c_str(),"wb");
-    auto bytesWritten = fwrite(&data[0],sizeof(char),data.size(),file);
+    if (file == nullptr) return false;
+    auto bytesWritten = fwrite(data.data(),sizeof(char),data.size(),file);
+    fclose(file);
+    return bytesWritten == data.size();
+  }
+
+  bool
+  File::appendBinary
+  (const vector<uint8_t>& data)
+  const
+  {
+    if (mPath.empty()) return false;
+
+    auto file = fopen(mPath.c_str(),"ab");
+    if (file == nullptr) return false;
+    auto bytesWritten = fwrite(data.data(),sizeof(char),data.size(),file);
     fclose(file);
     return bytesWritten == data.size();
   }
@@ -32,6 +32,7 @@ namespace octronic::dream
     virtual bool readBinary();
     vector<uint8_t>& getBinaryData();
     virtual bool writeBinary(const vector<uint8_t>& data) const;
+    virtual bool appendBinary(const vector<uint8_t>& data) const;
 
     bool deleteFile() const;
     virtual bool exists() const;
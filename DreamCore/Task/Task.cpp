@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <sstream>
 #include "Common/Logger.h"
+#include "Common/Profiler.h"
 
 using std::find;
 using std::stringstream;
@@ -21,6 +22,7 @@ namespace octronic::dream
     : mProjectRuntime(pr),
       mID(TaskIDGenerator++),
       mName(taskName),
+      mProfilerName(Profiler::Intern(taskName)),
       mState(TASK_STATE_QUEUED)
   {
     mID = taskIDGenerator();
@@ -52,6 +54,21 @@ namespace octronic::dream
     return mName;
   }
 
+  const char*
+  Task::getProfilerName
+  ()
+  const
+  {
+    return mProfilerName;
+  }
+
+  void
+  Task::setProfilerName
+  (const string& name)
+  {
+    mProfilerName = Profiler::Intern(name);
+  }
+
   void
   Task::setState
   (const TaskState& s)
@@ -44,6 +44,10 @@ namespace octronic::dream
     int getID() const;
     string getName() const;
     virtual string getNameAndIDString() const;
+    /**
+     * @brief Interned name this task's profiler zone is recorded under.
+     */
+    const char* getProfilerName() const;
 
     void setState(const TaskState& s);
     TaskState getState() const;
@@ -56,11 +60,13 @@ namespace octronic::dream
 
   protected:
     ProjectRuntime& getProjectRuntime() const;
+    void setProfilerName(const string& name);
   private:
     reference_wrapper<ProjectRuntime> mProjectRuntime;
 
     int mID;
     string mName;
+    const char* mProfilerName;
     TaskState mState;
   };
 
@@ -52,6 +52,7 @@ namespace octronic::dream
   private:
     vector<shared_ptr<TaskType>> mQueue;
     string mClassName;
+    const char* mProfilerName;
   };
 }
 
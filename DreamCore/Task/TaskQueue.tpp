@@ -3,13 +3,15 @@
 #include "TaskState.h"
 #include "TaskQueue.h"
 #include "Common/Logger.h"
+#include "Common/Profiler.h"
 
 namespace octronic::dream
 {
   template <typename TaskType>
   TaskQueue<TaskType>::TaskQueue
   (const string& className)
-    : mClassName(className)
+    : mClassName(className),
+      mProfilerName(Profiler::Intern(className + "::executeQueue"))
   {
 
   }
@@ -36,6 +38,7 @@ namespace octronic::dream
   TaskQueue<TaskType>::executeQueue
   ()
   {
+    DREAM_PROFILE_ZONE(mProfilerName);
     vector<shared_ptr<TaskType>> completed;
 
     // Process the task queue ==========================================
@@ -44,7 +47,7 @@ namespace octronic::dream
     for (auto itr = mQueue.begin(); itr != mQueue.end(); itr++)
     {
       shared_ptr<TaskType> task = (*itr);
-      LOG_INFO("{}: Processing task {}", mClassName, task->getNameAndIDString());
+      LOG_TRACE("{}: Processing task {}", mClassName, task->getNameAndIDString());
 
       if (task->hasState(TASK_STATE_QUEUED) || task->hasState(TASK_STATE_DEFERRED))
       {
@@ -52,7 +55,10 @@ namespace octronic::dream
                   task->getNameAndIDString());
 
         // try execution
-        task->execute();
+        {
+          DREAM_PROFILE_ZONE(task->getProfilerName());
+          task->execute();
+        }
 
         if (task->hasState(TASK_STATE_COMPLETED))
         {
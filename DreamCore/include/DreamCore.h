@@ -5,6 +5,12 @@
 #include "Common/Constants.h"
 #include "Common/Logger.h"
 #include "Common/GLHeader.h"
+#include "Common/GLDispatch.h"
+#include "Common/Profiler.h"
+#include "Common/AllocationTracker.h"
+#include "Common/PointerView.h"
+#include "Common/WorkerPool.h"
+#include "Common/SteadyClock.h"
 
 // Animation
 #include "Components/Animation/AnimationDefinition.h"
@@ -15,12 +21,16 @@
 #include "Components/Audio/AudioRuntime.h"
 #include "Components/Audio/AudioDefinition.h"
 #include "Components/Audio/AudioComponent.h"
+#include "Components/Audio/AudioVoice.h"
 #include "Components/Audio/AudioLoader.h"
 #include "Components/Audio/OggLoader.h"
 #include "Components/Audio/WavLoader.h"
 
 // Graphics
 #include "Components/Graphics/GraphicsComponent.h"
+#include "Components/Graphics/RenderQueue.h"
+#include "Components/Graphics/SpriteBatch.h"
+#include "Components/Graphics/OcclusionCuller.h"
 
 #include "Components/Graphics/Shader/ShaderDefinition.h"
 #include "Components/Graphics/Shader/ShaderRuntime.h"
@@ -66,6 +76,7 @@
 // Scene
 #include "Scene/SceneDefinition.h"
 #include "Scene/SceneRuntime.h"
+#include "Scene/AABBTree.h"
 #include "Entity/TemplateEntityDefinition.h"
 #include "Entity/SceneEntityDefinition.h"
 #include "Entity/EntityRuntime.h"
@@ -75,6 +86,8 @@
 #include "Project/ProjectDefinition.h"
 #include "Project/ProjectRuntime.h"
 #include "Project/ProjectContext.h"
+#include "Project/CompiledProject.h"
+#include "Project/ReplayLog.h"
 
 // Task Manager
 #include "Task/Task.h"
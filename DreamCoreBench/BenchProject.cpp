@@ -0,0 +1,74 @@
+#include "BenchProject.h"
+
+#include <filesystem>
+#include <random>
+#include <stdexcept>
+
+using std::runtime_error;
+using octronic::dream::headless::HEADLESS_CONTEXT_NULL;
+
+namespace octronic::dream::bench
+{
+  BenchProject&
+  BenchProject::Get
+  ()
+  {
+    static BenchProject project;
+    return project;
+  }
+
+  BenchProject::BenchProject
+  ()
+    : mWindowComponent(HEADLESS_CONTEXT_NULL)
+  {
+    std::random_device random;
+    auto path = std::filesystem::temp_directory_path() / ("DreamCoreBench-" + std::to_string(random()));
+    std::filesystem::create_directories(path);
+    mDirectory = path.string();
+
+    if (!mWindowComponent.init())
+    {
+      throw runtime_error("BenchProject: Unable to init headless window");
+    }
+
+    if (!mAudioComponent.init())
+    {
+      throw runtime_error("BenchProject: Unable to init null audio");
+    }
+
+    mContext.emplace(mWindowComponent, mAudioComponent, mStorageManager, mDirectory);
+    if (!mContext.value().newProject(mDirectory))
+    {
+      throw runtime_error("BenchProject: Unable to create project in " + mDirectory);
+    }
+  }
+
+  BenchProject::~BenchProject
+  ()
+  {
+    mContext.reset();
+    std::error_code error;
+    std::filesystem::remove_all(mDirectory, error);
+  }
+
+  ProjectRuntime&
+  BenchProject::getProjectRuntime
+  ()
+  {
+    return mContext.value().getProjectRuntime().value();
+  }
+
+  ProjectDefinition&
+  BenchProject::getProjectDefinition
+  ()
+  {
+    return mContext.value().getProjectDefinition().value();
+  }
+
+  ProjectDirectory&
+  BenchProject::getProjectDirectory
+  ()
+  {
+    return mContext.value().getProjectDirectory().value();
+  }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <DreamCore.h>
+#include <HeadlessWindowComponent.h>
+#include <NullAudioComponent.h>
+
+#include <optional>
+#include <string>
+
+using std::optional;
+using std::string;
+
+namespace octronic::dream::bench
+{
+  /**
+   * @brief An empty project in a temporary directory with a ProjectRuntime
+   * on the null GL backend and null audio, for benchmarks of code that
+   * needs a runtime to exist. Created on first use and shared by every
+   * benchmark in the process.
+   */
+  class BenchProject
+  {
+  public:
+    static BenchProject& Get();
+
+    ProjectRuntime& getProjectRuntime();
+    ProjectDefinition& getProjectDefinition();
+    ProjectDirectory& getProjectDirectory();
+
+    BenchProject(const BenchProject&) = delete;
+    BenchProject& operator=(const BenchProject&) = delete;
+
+  private:
+    BenchProject();
+    ~BenchProject();
+
+  private:
+    string mDirectory;
+    StorageManager mStorageManager;
+    headless::HeadlessWindowComponent mWindowComponent;
+    headless::NullAudioComponent mAudioComponent;
+    optional<ProjectContext> mContext;
+  };
+}
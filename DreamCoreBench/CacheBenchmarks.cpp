@@ -0,0 +1,65 @@
+#include "BenchProject.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using std::vector;
+using std::reference_wrapper;
+
+namespace octronic::dream::bench
+{
+  namespace
+  {
+    // getRuntime searches linearly, so a full pass is quadratic
+    const int64_t MAX_CACHE_RUNTIMES = 1<<14;
+
+    /**
+     * @brief Script definitions shared by every size, created once since
+     * the ProjectDefinition keeps them.
+     */
+    vector<reference_wrapper<ScriptDefinition>>&
+    GetScriptDefinitions
+    ()
+    {
+      static vector<reference_wrapper<ScriptDefinition>> definitions;
+      if (definitions.empty())
+      {
+        auto& projectDefinition = BenchProject::Get().getProjectDefinition();
+        for (int64_t i = 0; i < MAX_CACHE_RUNTIMES; i++)
+        {
+          definitions.push_back(static_cast<ScriptDefinition&>(
+            projectDefinition.createAssetDefinition(ASSET_TYPE_ENUM_SCRIPT)));
+        }
+      }
+      return definitions;
+    }
+  }
+
+  void
+  BM_CacheGetRuntime
+  (benchmark::State& state)
+  {
+    auto& project = BenchProject::Get();
+    auto& definitions = GetScriptDefinitions();
+    size_t count = state.range(0);
+
+    // Runtimes are constructed on the first pass, later passes only look up
+    ScriptCache cache(project.getProjectRuntime(), project.getProjectDefinition(), project.getProjectDirectory());
+    for (size_t i = 0; i < count; i++)
+    {
+      cache.getRuntime(definitions[i]);
+    }
+
+    for (auto _ : state)
+    {
+      for (size_t i = 0; i < count; i++)
+      {
+        auto& runtime = cache.getRuntime(definitions[i]);
+        benchmark::DoNotOptimize(&runtime);
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+  }
+  BENCHMARK(BM_CacheGetRuntime)->RangeMultiplier(2)->Range(1<<10, MAX_CACHE_RUNTIMES);
+}
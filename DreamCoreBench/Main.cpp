@@ -0,0 +1,27 @@
+#include <DreamCore.h>
+#include <benchmark/benchmark.h>
+
+// Microbenchmarks for DreamCore's per frame kernels, see DreamBench for
+// whole scene runs. Takes the usual Google Benchmark arguments, e.g.
+//
+//   DreamCoreBench --benchmark_filter=Frustum --benchmark_out=run.json
+//
+// and the DreamCoreBench_baseline target records baseline.json to compare
+// runs against.
+
+int
+main
+(int argc, char** argv)
+{
+  LOG_LEVEL(LOG_LEVEL_ERROR);
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+  {
+    return 1;
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,133 @@
+#include <DreamCore.h>
+#include <Math/Transform.h>
+#include <Entity/BoundingBox.h>
+#include <Components/Graphics/Frustum.h>
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+#include <glm/gtc/matrix_transform.hpp>
+
+using std::vector;
+using std::mt19937;
+using std::uniform_real_distribution;
+using glm::translate;
+using glm::perspective;
+using glm::lookAt;
+using glm::radians;
+
+namespace octronic::dream::bench
+{
+  namespace
+  {
+    vector<Transform>
+    RandomTransforms
+    (size_t count)
+    {
+      mt19937 rng(1234);
+      uniform_real_distribution<float> position(-100.f, 100.f);
+      uniform_real_distribution<float> angle(-3.14f, 3.14f);
+      uniform_real_distribution<float> scale(0.5f, 2.f);
+
+      vector<Transform> transforms(count);
+      for (auto& transform : transforms)
+      {
+        transform.setTranslation(vec3(position(rng), position(rng), position(rng)));
+        transform.setYaw(angle(rng));
+        transform.setPitch(angle(rng));
+        transform.setRoll(angle(rng));
+        transform.setScale(vec3(scale(rng)));
+      }
+      return transforms;
+    }
+
+    vector<BoundingBox>
+    RandomBoxes
+    (size_t count)
+    {
+      mt19937 rng(1234);
+      uniform_real_distribution<float> position(-100.f, 100.f);
+      uniform_real_distribution<float> size(0.25f, 4.f);
+
+      vector<BoundingBox> boxes;
+      boxes.reserve(count);
+      for (size_t i = 0; i < count; i++)
+      {
+        vec3 minimum(position(rng), position(rng), position(rng));
+        boxes.emplace_back(minimum, minimum + vec3(size(rng), size(rng), size(rng)));
+      }
+      return boxes;
+    }
+  }
+
+  void
+  BM_TransformGetMatrix
+  (benchmark::State& state)
+  {
+    auto transforms = RandomTransforms(state.range(0));
+    for (auto _ : state)
+    {
+      for (auto& transform : transforms)
+      {
+        mat4 matrix = transform.getMatrix();
+        benchmark::DoNotOptimize(matrix);
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+  BENCHMARK(BM_TransformGetMatrix)->RangeMultiplier(8)->Range(1<<10, 1<<20);
+
+  void
+  BM_BoundingBoxIntegrate
+  (benchmark::State& state)
+  {
+    auto boxes = RandomBoxes(state.range(0));
+    for (auto _ : state)
+    {
+      BoundingBox bounds;
+      for (auto& box : boxes)
+      {
+        bounds.integrate(box);
+      }
+      benchmark::DoNotOptimize(bounds);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+  BENCHMARK(BM_BoundingBoxIntegrate)->RangeMultiplier(8)->Range(1<<10, 1<<20);
+
+  void
+  BM_FrustumTestIntersection
+  (benchmark::State& state)
+  {
+    // Camera at the origin looking down -z, roughly half the boxes are
+    // inside, so both early outs and full tests are measured
+    Frustum frustum;
+    frustum.updatePlanes(
+      lookAt(vec3(0.f), vec3(0.f, 0.f, -1.f), vec3(0.f, 1.f, 0.f)),
+      perspective(radians(90.f), 16.f/9.f, 0.1f, 200.f));
+
+    auto boxes = RandomBoxes(state.range(0));
+    auto transforms = RandomTransforms(state.range(0));
+    vector<mat4> matrices;
+    matrices.reserve(transforms.size());
+    for (auto& transform : transforms)
+    {
+      matrices.push_back(transform.getMatrix());
+    }
+
+    for (auto _ : state)
+    {
+      size_t visible = 0;
+      for (size_t i = 0; i < boxes.size(); i++)
+      {
+        if (frustum.testIntersection(matrices[i], boxes[i]) != Frustum::TEST_OUTSIDE)
+        {
+          visible++;
+        }
+      }
+      benchmark::DoNotOptimize(visible);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+  BENCHMARK(BM_FrustumTestIntersection)->RangeMultiplier(8)->Range(1<<10, 1<<20);
+}
@@ -0,0 +1,82 @@
+#include <DreamCore.h>
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <assimp/mesh.h>
+
+using std::unique_ptr;
+using std::make_unique;
+using std::mt19937;
+using std::uniform_real_distribution;
+
+namespace octronic::dream::bench
+{
+  namespace
+  {
+    /**
+     * @brief A triangle list with positions, normals and one set of texture
+     * coordinates, as assimp would import it. aiMesh frees the arrays.
+     */
+    unique_ptr<aiMesh>
+    CreateMesh
+    (unsigned int vertices)
+    {
+      mt19937 rng(1234);
+      uniform_real_distribution<float> value(-1.f, 1.f);
+
+      auto mesh = make_unique<aiMesh>();
+      mesh->mNumVertices = vertices;
+      mesh->mVertices = new aiVector3D[vertices];
+      mesh->mNormals = new aiVector3D[vertices];
+      mesh->mTextureCoords[0] = new aiVector3D[vertices];
+      mesh->mNumUVComponents[0] = 2;
+
+      for (unsigned int i = 0; i < vertices; i++)
+      {
+        mesh->mVertices[i] = aiVector3D(value(rng), value(rng), value(rng));
+        mesh->mNormals[i] = aiVector3D(value(rng), value(rng), value(rng)).Normalize();
+        mesh->mTextureCoords[0][i] = aiVector3D(value(rng), value(rng), 0.f);
+      }
+
+      mesh->mNumFaces = vertices / 3;
+      mesh->mFaces = new aiFace[mesh->mNumFaces];
+      for (unsigned int i = 0; i < mesh->mNumFaces; i++)
+      {
+        auto& face = mesh->mFaces[i];
+        face.mNumIndices = 3;
+        face.mIndices = new unsigned int[3] {i*3, i*3+1, i*3+2};
+      }
+      return mesh;
+    }
+  }
+
+  void
+  BM_ModelProcessVertexData
+  (benchmark::State& state)
+  {
+    auto mesh = CreateMesh(state.range(0));
+    for (auto _ : state)
+    {
+      auto vertices = ModelRuntime::ProcessVertexData(mesh.get());
+      benchmark::DoNotOptimize(vertices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(Vertex));
+  }
+  BENCHMARK(BM_ModelProcessVertexData)->RangeMultiplier(8)->Range(1<<10, 1<<20);
+
+  void
+  BM_ModelProcessIndexData
+  (benchmark::State& state)
+  {
+    auto mesh = CreateMesh(state.range(0));
+    for (auto _ : state)
+    {
+      auto indices = ModelRuntime::ProcessIndexData(mesh.get());
+      benchmark::DoNotOptimize(indices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * mesh->mNumFaces * 3);
+  }
+  BENCHMARK(BM_ModelProcessIndexData)->RangeMultiplier(8)->Range(1<<10, 1<<20);
+}
@@ -0,0 +1,70 @@
+#include "BenchProject.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+using std::vector;
+using std::mt19937;
+using std::uniform_real_distribution;
+
+namespace octronic::dream::bench
+{
+  namespace
+  {
+    /**
+     * @brief Resolves its uniform handles without compiling a program, the
+     * null GL backend finds every uniform.
+     */
+    class BenchShaderRuntime : public ShaderRuntime
+    {
+    public:
+      BenchShaderRuntime(ProjectRuntime& projectRuntime, ShaderDefinition& definition)
+        : ShaderRuntime(projectRuntime, definition)
+      {
+        resolveUniformHandles();
+      }
+    };
+
+    ShaderDefinition&
+    GetShaderDefinition
+    ()
+    {
+      static auto& definition = static_cast<ShaderDefinition&>(
+        BenchProject::Get().getProjectDefinition().createAssetDefinition(ASSET_TYPE_ENUM_SHADER));
+      return definition;
+    }
+  }
+
+  void
+  BM_ShaderSyncUniforms
+  (benchmark::State& state)
+  {
+    // One draw per value, as GraphicsComponent sets a model matrix and
+    // color before each mesh
+    mt19937 rng(1234);
+    uniform_real_distribution<float> value(0.f, 1.f);
+    vector<mat4> matrices(state.range(0));
+    vector<vec4> colors(state.range(0));
+    for (size_t i = 0; i < matrices.size(); i++)
+    {
+      matrices[i] = mat4(value(rng));
+      colors[i] = vec4(value(rng), value(rng), value(rng), 1.f);
+    }
+
+    BenchShaderRuntime shader(BenchProject::Get().getProjectRuntime(), GetShaderDefinition());
+
+    for (auto _ : state)
+    {
+      for (size_t i = 0; i < matrices.size(); i++)
+      {
+        shader.setModelMatrixUniform(matrices[i]);
+        shader.setColorUniform(colors[i]);
+        shader.syncUniforms();
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+  BENCHMARK(BM_ShaderSyncUniforms)->RangeMultiplier(8)->Range(1<<10, 1<<20);
+}
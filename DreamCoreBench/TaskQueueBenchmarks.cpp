@@ -0,0 +1,61 @@
+#include "BenchProject.h"
+
+#include <benchmark/benchmark.h>
+#include <Task/TaskQueue.h>
+
+#include <memory>
+#include <vector>
+
+using std::vector;
+using std::shared_ptr;
+using std::make_shared;
+
+namespace octronic::dream::bench
+{
+  namespace
+  {
+    // pushTask checks for duplicates linearly, so filling a queue is quadratic
+    const int64_t MAX_QUEUED_TASKS = 1<<14;
+
+    class NoopTask : public Task
+    {
+    public:
+      NoopTask(ProjectRuntime& projectRuntime)
+        : Task(projectRuntime, "NoopTask")
+      {
+      }
+
+      void execute() override
+      {
+        setState(TASK_STATE_COMPLETED);
+      }
+    };
+  }
+
+  void
+  BM_TaskQueuePushExecute
+  (benchmark::State& state)
+  {
+    auto& projectRuntime = BenchProject::Get().getProjectRuntime();
+
+    // Tasks are requeued each iteration so only push and execute are timed
+    vector<shared_ptr<Task>> tasks;
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+      tasks.push_back(make_shared<NoopTask>(projectRuntime));
+    }
+
+    TaskQueue<Task> queue("BenchTaskQueue");
+    for (auto _ : state)
+    {
+      for (auto& task : tasks)
+      {
+        queue.pushTask(task);
+      }
+      queue.executeQueue();
+      benchmark::DoNotOptimize(queue.getTaskCount());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+  BENCHMARK(BM_TaskQueuePushExecute)->RangeMultiplier(2)->Range(1<<10, MAX_QUEUED_TASKS);
+}
@@ -226,6 +226,24 @@ namespace octronic::dream::glfw
         if (mWindow != nullptr) glfwSwapBuffers(mWindow);
     }
 
+    bool
+    GLFWWindowComponent::setSwapInterval
+    (int interval)
+    {
+        if (mWindow == nullptr) return false;
+
+        // Negative intervals need the swap_control_tear extensions
+        if (interval < 0 &&
+            !glfwExtensionSupported("WGL_EXT_swap_control_tear") &&
+            !glfwExtensionSupported("GLX_EXT_swap_control_tear"))
+        {
+            LOG_INFO("GLFWWindowComponent: Adaptive vsync not supported, using vsync");
+            interval = 1;
+        }
+        glfwSwapInterval(interval);
+        return true;
+    }
+
     // These members are static so they can be accessed by GLFW Callbacks;
     bool  GLFWWindowComponent::WindowSizeChanged = false;
     bool  GLFWWindowComponent::MouseButtonsDown[5] = {false};
@@ -34,6 +34,7 @@ namespace octronic::dream::glfw
         void bindFrameBuffer() override;
         GLuint getFrameBuffer() const override;
         GLuint getDepthBuffer() const override;
+        bool setSwapInterval(int interval) override;
         void drawImGui();
         void drawGLWidgets();
         void pushTasks() override;
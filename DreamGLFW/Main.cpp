@@ -13,6 +13,7 @@
 // Using
 
 using std::stoi;
+using std::stod;
 using octronic::dream::ProjectContext;
 using octronic::dream::WindowComponent;
 using octronic::dream::MouseState;
@@ -23,12 +24,20 @@ using octronic::dream::open_al::OpenALAudioComponent;
 using octronic::dream::glfw::GLFWWindowComponent;
 using octronic::dream::glfw::DefaultPrintListener;
 
+#ifdef DREAM_TRACK_ALLOCATIONS
+DREAM_ALLOCATION_HOOK()
+#endif
+
 // Global variables
 
 string _option_project_dir;
 string _option_logLevel = "off";
 int    _option_width = 0;
 int    _option_height = 0;
+string _option_vsync = "adaptive";
+double _option_fps = 0.0;
+double _option_sim_rate = 0.0;
+string _option_record;
 
 // Global Functions
 
@@ -48,7 +57,7 @@ void parseArguments(int argc, char** argv)
   {
     if (string(argv[i]) == "-l")
     {
-      if (argc >= i+1)
+      if (argc > i+1)
       {
         _option_logLevel = string(argv[i+1]);
       }
@@ -60,7 +69,7 @@ void parseArguments(int argc, char** argv)
     }
     else if (string(argv[i]) == "-p")
     {
-      if (argc >= i+1)
+      if (argc > i+1)
       {
         _option_project_dir = string(argv[i+1]);
       }
@@ -71,7 +80,7 @@ void parseArguments(int argc, char** argv)
     }
     else if (string(argv[i]) == "-w")
     {
-      if (argc >= i+1)
+      if (argc > i+1)
       {
         _option_width = stoi(argv[i+1]);
       }
@@ -82,7 +91,7 @@ void parseArguments(int argc, char** argv)
     }
     else if (string(argv[i]) == "-h")
     {
-      if (argc >= i+1)
+      if (argc > i+1)
       {
         _option_height = stoi(argv[i+1]);
       }
@@ -91,16 +100,91 @@ void parseArguments(int argc, char** argv)
         LOG_ERROR("Main: Height argument not found");
       }
     }
+    else if (string(argv[i]) == "-v")
+    {
+      if (argc > i+1)
+      {
+        _option_vsync = string(argv[i+1]);
+      }
+      else
+      {
+        LOG_ERROR("Main: VSync argument not found");
+      }
+    }
+    else if (string(argv[i]) == "-f")
+    {
+      if (argc > i+1)
+      {
+        _option_fps = stod(argv[i+1]);
+      }
+      else
+      {
+        LOG_ERROR("Main: Frame rate argument not found");
+      }
+    }
+    else if (string(argv[i]) == "-s")
+    {
+      if (argc > i+1)
+      {
+        _option_sim_rate = stod(argv[i+1]);
+      }
+      else
+      {
+        LOG_ERROR("Main: Simulation rate argument not found");
+      }
+    }
+    else if (string(argv[i]) == "-r")
+    {
+      if (argc > i+1)
+      {
+        _option_record = string(argv[i+1]);
+      }
+      else
+      {
+        LOG_ERROR("Main: Replay log argument not found");
+      }
+    }
   }
 }
 
 void setupLogger()
 {
+  // Keep logging off the main loop
+  LOG_ASYNC(8192);
   LOG_LEVEL(spdlog::level::from_str(_option_logLevel));
   LOG_ERROR("Main: Using log level {}", _option_logLevel);
   LOG_PATTERN("[%H:%M:%S]%l: %v");
 }
 
+void setupFramePacing(ProjectContext& context)
+{
+  auto& pacer = context.getFramePacer();
+
+  // A frame rate limit takes over from vsync
+  if (_option_fps > 0.0)
+  {
+    pacer.setMode(octronic::dream::FRAME_PACING_LIMITED);
+    pacer.setTargetFrameRate(_option_fps);
+  }
+  else if (_option_vsync == "on")
+  {
+    pacer.setMode(octronic::dream::FRAME_PACING_VSYNC);
+  }
+  else if (_option_vsync == "off")
+  {
+    pacer.setMode(octronic::dream::FRAME_PACING_UNLIMITED);
+  }
+  else
+  {
+    pacer.setMode(octronic::dream::FRAME_PACING_ADAPTIVE_VSYNC);
+  }
+
+  if (_option_sim_rate > 0.0)
+  {
+    context.setSimulationRate(_option_sim_rate);
+  }
+}
+
 void handleInput(ProjectContext(& context))
 {
   auto& projectRuntimeOpt = context.getProjectRuntime();
@@ -161,11 +245,8 @@ void handleInput(ProjectContext(& context))
 
 // Entry Point
 
-int main(int argc,char** argv)
+int run()
 {
-  parseArguments(argc, argv);
-  setupLogger();
-
   LOG_INFO("DreamGLFW: Starting...");
 
   StorageManager storageMan;
@@ -181,9 +262,18 @@ int main(int argc,char** argv)
 
   ProjectContext context(windowComp,audioComp,storageMan,_option_project_dir);
   context.addPrintListener(pl);
+  setupFramePacing(context);
 
   if (context.openFromPath())
   {
+    // Replay the log with DreamBench -p <project> -y <log>
+    if (!_option_record.empty() &&
+        !context.getProjectRuntime().value().startRecording(_option_record))
+    {
+      LOG_ERROR("Main: Unable to record to {}", _option_record);
+      return 3;
+    }
+
     auto& wc = context.getWindowComponent();
     while (!wc.shouldClose())
     {
@@ -193,6 +283,17 @@ int main(int argc,char** argv)
       wc.swapBuffers();
     }
   }
+  return 0;
+}
+
+int main(int argc,char** argv)
+{
+  parseArguments(argc, argv);
+  setupLogger();
+  // Everything that logs is destroyed by the time run returns
+  int result = run();
+  LOG_SHUTDOWN();
+  return result;
 }
 
 
@@ -0,0 +1,413 @@
+#include "HeadlessWindowComponent.h"
+
+#if defined(DREAM_HEADLESS_EGL)
+#include <EGL/eglext.h>
+#endif
+
+#include <cstring>
+
+using octronic::dream::GLDispatch;
+using octronic::dream::GL_DISPATCH_NULL;
+using octronic::dream::File;
+
+namespace octronic::dream::headless
+{
+    const int HeadlessWindowComponent::DEFAULT_WIDTH = 1280;
+    const int HeadlessWindowComponent::DEFAULT_HEIGHT = 720;
+
+    HeadlessWindowComponent::HeadlessWindowComponent
+    (HeadlessContextType type)
+        : WindowComponent(),
+          mContextType(type),
+          mFallbackToNull(true),
+          mFBO(0),
+          mTexture(0),
+          mDepthBuffer(0),
+          mFrameBufferWidth(0),
+          mFrameBufferHeight(0),
+          mFrameCount(0),
+          mMaxFrames(0)
+#if defined(DREAM_HEADLESS_EGL)
+        , mDisplay(EGL_NO_DISPLAY),
+          mContext(EGL_NO_CONTEXT)
+#endif
+    {
+        LOG_INFO("HeadlessWindowComponent: Constructing");
+        mName = "Dream Headless";
+        mWidth = DEFAULT_WIDTH;
+        mHeight = DEFAULT_HEIGHT;
+    }
+
+    HeadlessWindowComponent::~HeadlessWindowComponent
+    ()
+    {
+        LOG_INFO("HeadlessWindowComponent: Destructing");
+        freeFrameBuffer();
+        freeEGL();
+    }
+
+    bool
+    HeadlessWindowComponent::init
+    ()
+    {
+        if (mWidth <= 0)  mWidth = DEFAULT_WIDTH;
+        if (mHeight <= 0) mHeight = DEFAULT_HEIGHT;
+
+        if (mContextType == HEADLESS_CONTEXT_EGL && !initEGL())
+        {
+            if (!mFallbackToNull)
+            {
+                LOG_ERROR("HeadlessWindowComponent: Unable to create an EGL context");
+                return false;
+            }
+            LOG_WARN("HeadlessWindowComponent: Unable to create an EGL context, using the null GL backend");
+            mContextType = HEADLESS_CONTEXT_NULL;
+        }
+
+        if (mContextType == HEADLESS_CONTEXT_NULL)
+        {
+            if (!GLDispatch::InstallBackend(GL_DISPATCH_NULL)) return false;
+        }
+
+        return initFrameBuffer();
+    }
+
+    bool
+    HeadlessWindowComponent::initEGL
+    ()
+    {
+#if defined(DREAM_HEADLESS_EGL)
+        LOG_DEBUG("HeadlessWindowComponent: Initialising EGL");
+
+        // Prefer Mesa's surfaceless platform, it needs neither X nor a DRM
+        // device, then fall back to whatever the default display is.
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+                    eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+        if (getPlatformDisplay)
+        {
+            mDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        }
+
+        if (mDisplay == EGL_NO_DISPLAY)
+        {
+            mDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        }
+
+        EGLint major = 0, minor = 0;
+        if (mDisplay == EGL_NO_DISPLAY || !eglInitialize(mDisplay, &major, &minor))
+        {
+            LOG_ERROR("HeadlessWindowComponent: Unable to initialise an EGL display");
+            mDisplay = EGL_NO_DISPLAY;
+            return false;
+        }
+        LOG_DEBUG("HeadlessWindowComponent: EGL version {}.{}", major, minor);
+
+        const char* extensions = eglQueryString(mDisplay, EGL_EXTENSIONS);
+        if (!extensions || !strstr(extensions, "EGL_KHR_surfaceless_context"))
+        {
+            LOG_ERROR("HeadlessWindowComponent: EGL_KHR_surfaceless_context is not supported");
+            freeEGL();
+            return false;
+        }
+
+        const EGLint configAttributes[] =
+        {
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_NONE
+        };
+
+        EGLConfig config;
+        EGLint numConfigs = 0;
+        if (!eglChooseConfig(mDisplay, configAttributes, &config, 1, &numConfigs) || numConfigs == 0)
+        {
+            LOG_ERROR("HeadlessWindowComponent: No EGL config supports desktop OpenGL");
+            freeEGL();
+            return false;
+        }
+
+        if (!eglBindAPI(EGL_OPENGL_API))
+        {
+            LOG_ERROR("HeadlessWindowComponent: Unable to bind the OpenGL API");
+            freeEGL();
+            return false;
+        }
+
+        // Match the context GLFWWindowComponent asks for
+        const EGLint contextAttributes[] =
+        {
+            EGL_CONTEXT_MAJOR_VERSION, 3,
+            EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE
+        };
+
+        mContext = eglCreateContext(mDisplay, config, EGL_NO_CONTEXT, contextAttributes);
+        if (mContext == EGL_NO_CONTEXT)
+        {
+            LOG_ERROR("HeadlessWindowComponent: Unable to create an OpenGL 3.3 core context");
+            freeEGL();
+            return false;
+        }
+
+        if (!eglMakeCurrent(mDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, mContext))
+        {
+            LOG_ERROR("HeadlessWindowComponent: Unable to make the EGL context current");
+            freeEGL();
+            return false;
+        }
+
+        if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress))
+        {
+            LOG_ERROR("HeadlessWindowComponent: Error initialising GLAD!");
+            freeEGL();
+            return false;
+        }
+
+        GLCheckError();
+
+        LOG_DEBUG("HeadlessWindowComponent: OpenGL Version {}, Shader Version {}, Renderer {}",
+                  glGetString(GL_VERSION),
+                  glGetString(GL_SHADING_LANGUAGE_VERSION),
+                  glGetString(GL_RENDERER));
+        return true;
+#else
+        LOG_ERROR("HeadlessWindowComponent: Built without EGL support");
+        return false;
+#endif
+    }
+
+    void
+    HeadlessWindowComponent::freeEGL
+    ()
+    {
+#if defined(DREAM_HEADLESS_EGL)
+        if (mDisplay == EGL_NO_DISPLAY) return;
+
+        eglMakeCurrent(mDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (mContext != EGL_NO_CONTEXT)
+        {
+            eglDestroyContext(mDisplay, mContext);
+            mContext = EGL_NO_CONTEXT;
+        }
+        eglTerminate(mDisplay);
+        mDisplay = EGL_NO_DISPLAY;
+#endif
+    }
+
+    bool
+    HeadlessWindowComponent::initFrameBuffer
+    ()
+    {
+        LOG_DEBUG("HeadlessWindowComponent: Creating {}x{} framebuffer", mWidth, mHeight);
+
+        freeFrameBuffer();
+
+        glGenFramebuffers(1, &mFBO);
+        glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
+        GLCheckError();
+
+        glGenTextures(1, &mTexture);
+        glBindTexture(GL_TEXTURE_2D, mTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, mWidth, mHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mTexture, 0);
+        GLCheckError();
+
+        glGenRenderbuffers(1, &mDepthBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, mDepthBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, mWidth, mHeight);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, mDepthBuffer);
+        GLCheckError();
+
+        GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+        if (status != GL_FRAMEBUFFER_COMPLETE)
+        {
+            LOG_ERROR("HeadlessWindowComponent: Unable to create framebuffer, error = {}",
+                      GLGetFrameBufferError(status));
+            freeFrameBuffer();
+            return false;
+        }
+
+        mFrameBufferWidth = mWidth;
+        mFrameBufferHeight = mHeight;
+        glViewport(0, 0, mWidth, mHeight);
+        return true;
+    }
+
+    void
+    HeadlessWindowComponent::freeFrameBuffer
+    ()
+    {
+        if (mFBO != 0)
+        {
+            glDeleteFramebuffers(1, &mFBO);
+            mFBO = 0;
+        }
+
+        if (mDepthBuffer != 0)
+        {
+            glDeleteRenderbuffers(1, &mDepthBuffer);
+            mDepthBuffer = 0;
+        }
+
+        if (mTexture != 0)
+        {
+            glDeleteTextures(1, &mTexture);
+            mTexture = 0;
+        }
+    }
+
+    void
+    HeadlessWindowComponent::getCurrentDimensions
+    ()
+    {
+        // Dimensions only change through setWidth/setHeight
+        LOG_TRACE("HeadlessWindowComponent: {}", __FUNCTION__);
+    }
+
+    void
+    HeadlessWindowComponent::updateWindow
+    ()
+    {
+        if (mWidth != mFrameBufferWidth || mHeight != mFrameBufferHeight)
+        {
+            LOG_DEBUG("HeadlessWindowComponent: Resizing to {}x{}", mWidth, mHeight);
+            if (initFrameBuffer()) setWindowSizeChangedFlag(true);
+        }
+    }
+
+    void
+    HeadlessWindowComponent::swapBuffers
+    ()
+    {
+        // Nothing to present, just finish the frame so timings include the
+        // GPU work and the frame is ready to read back.
+        if (mContextType == HEADLESS_CONTEXT_EGL) glFinish();
+
+        mFrameCount++;
+        if (mMaxFrames > 0 && mFrameCount >= mMaxFrames)
+        {
+            LOG_INFO("HeadlessWindowComponent: Reached {} frames, closing", mFrameCount);
+            setShouldClose(true);
+        }
+    }
+
+    void
+    HeadlessWindowComponent::bindFrameBuffer
+    ()
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
+        GLCheckError();
+    }
+
+    GLuint
+    HeadlessWindowComponent::getFrameBuffer
+    ()
+    const
+    {
+        return mFBO;
+    }
+
+    GLuint
+    HeadlessWindowComponent::getDepthBuffer
+    ()
+    const
+    {
+        return mDepthBuffer;
+    }
+
+    void
+    HeadlessWindowComponent::pushTasks
+    ()
+    {
+
+    }
+
+    HeadlessContextType
+    HeadlessWindowComponent::getContextType
+    ()
+    const
+    {
+        return mContextType;
+    }
+
+    void
+    HeadlessWindowComponent::setFallbackToNull
+    (bool fallback)
+    {
+        mFallbackToNull = fallback;
+    }
+
+    void
+    HeadlessWindowComponent::setMaxFrames
+    (unsigned long frames)
+    {
+        mMaxFrames = frames;
+    }
+
+    unsigned long
+    HeadlessWindowComponent::getFrameCount
+    ()
+    const
+    {
+        return mFrameCount;
+    }
+
+    bool
+    HeadlessWindowComponent::readFrame
+    (vector<uint8_t>& rgba)
+    {
+        if (mFBO == 0) return false;
+
+        size_t rowBytes = static_cast<size_t>(mFrameBufferWidth) * 4;
+        rgba.assign(rowBytes * mFrameBufferHeight, 0);
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, mFBO);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, mFrameBufferWidth, mFrameBufferHeight, GL_RGBA, GL_UNSIGNED_BYTE, &rgba[0]);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        GLCheckError();
+
+        // GL reads bottom row first
+        vector<uint8_t> row(rowBytes);
+        for (int top = 0, bottom = mFrameBufferHeight - 1; top < bottom; top++, bottom--)
+        {
+            uint8_t* topRow = &rgba[top * rowBytes];
+            uint8_t* bottomRow = &rgba[bottom * rowBytes];
+            memcpy(&row[0], topRow, rowBytes);
+            memcpy(topRow, bottomRow, rowBytes);
+            memcpy(bottomRow, &row[0], rowBytes);
+        }
+        return true;
+    }
+
+    bool
+    HeadlessWindowComponent::writeFrame
+    (StorageManager& sm, const string& path)
+    {
+        vector<uint8_t> rgba;
+        if (!readFrame(rgba)) return false;
+
+        string header = "P6\n" + std::to_string(mFrameBufferWidth) + " " +
+                std::to_string(mFrameBufferHeight) + "\n255\n";
+
+        vector<uint8_t> ppm(header.begin(), header.end());
+        ppm.reserve(ppm.size() + (rgba.size() / 4) * 3);
+        for (size_t i = 0; i < rgba.size(); i += 4)
+        {
+            ppm.push_back(rgba[i]);
+            ppm.push_back(rgba[i+1]);
+            ppm.push_back(rgba[i+2]);
+        }
+
+        auto& file = sm.openFile(path);
+        bool retval = file.writeBinary(ppm);
+        sm.closeFile(file);
+        return retval;
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <DreamCore.h>
+
+#include <vector>
+#include <string>
+
+#if defined(DREAM_HEADLESS_EGL)
+#include <EGL/egl.h>
+#endif
+
+using octronic::dream::WindowComponent;
+using octronic::dream::StorageManager;
+using std::vector;
+using std::string;
+
+namespace octronic::dream::headless
+{
+    enum HeadlessContextType
+    {
+        /**
+         * @brief A surfaceless EGL context, such as Mesa's llvmpipe on a
+         * machine without a GPU or display.
+         */
+        HEADLESS_CONTEXT_EGL,
+        /**
+         * @brief No GL context at all, GL calls go to the GLDispatch null
+         * backend.
+         */
+        HEADLESS_CONTEXT_NULL
+    };
+
+    /**
+     * @brief The HeadlessWindowComponent renders without a window or
+     * display. The scene is drawn into an offscreen FBO returned by
+     * getFrameBuffer, and frames can be read back for image comparison.
+     *
+     * When no EGL context can be created the component falls back to the
+     * GLDispatch null backend, so the CPU side of the render path still
+     * runs on machines without Mesa.
+     */
+    class HeadlessWindowComponent : public WindowComponent
+    {
+    public:
+        const static int DEFAULT_WIDTH;
+        const static int DEFAULT_HEIGHT;
+
+        HeadlessWindowComponent(HeadlessContextType type = HEADLESS_CONTEXT_EGL);
+        ~HeadlessWindowComponent() override;
+
+        bool init() override;
+        void getCurrentDimensions() override;
+        void swapBuffers() override;
+        void updateWindow() override;
+        void bindFrameBuffer() override;
+        GLuint getFrameBuffer() const override;
+        GLuint getDepthBuffer() const override;
+        void pushTasks() override;
+
+        HeadlessContextType getContextType() const;
+        void setFallbackToNull(bool fallback);
+
+        /**
+         * @brief Close the window after the given number of frames have
+         * been swapped, 0 to run until closed.
+         */
+        void setMaxFrames(unsigned long frames);
+        unsigned long getFrameCount() const;
+
+        /**
+         * @brief Read the last rendered frame as tightly packed RGBA rows,
+         * top row first.
+         */
+        bool readFrame(vector<uint8_t>& rgba);
+
+        /**
+         * @brief Write the last rendered frame as a binary PPM image.
+         */
+        bool writeFrame(StorageManager& sm, const string& path);
+
+    private:
+        bool initEGL();
+        void freeEGL();
+        bool initFrameBuffer();
+        void freeFrameBuffer();
+
+    private:
+        HeadlessContextType mContextType;
+        bool mFallbackToNull;
+        GLuint mFBO;
+        GLuint mTexture;
+        GLuint mDepthBuffer;
+        int mFrameBufferWidth;
+        int mFrameBufferHeight;
+        unsigned long mFrameCount;
+        unsigned long mMaxFrames;
+#if defined(DREAM_HEADLESS_EGL)
+        EGLDisplay mDisplay;
+        EGLContext mContext;
+#endif
+    };
+}
@@ -0,0 +1,197 @@
+#include "NullAudioComponent.h"
+
+using std::make_shared;
+
+namespace octronic::dream::headless
+{
+    // NullAudioImplementation =================================================
+
+    NullAudioImplementation::NullAudioImplementation
+    (AudioRuntime& parent)
+        : AudioRuntimeImplementation(parent),
+          mState(octronic::dream::AUDIO_STATUS_STOPPED),
+          mSourcePosition(0.0f),
+          mVolume(1.0f),
+          mSampleOffset(0)
+    {
+    }
+
+    void
+    NullAudioImplementation::play
+    ()
+    {
+        mState = octronic::dream::AUDIO_STATUS_PLAYING;
+    }
+
+    void
+    NullAudioImplementation::pause
+    ()
+    {
+        mState = octronic::dream::AUDIO_STATUS_PAUSED;
+    }
+
+    void
+    NullAudioImplementation::stop
+    ()
+    {
+        mState = octronic::dream::AUDIO_STATUS_STOPPED;
+        mSampleOffset = 0;
+    }
+
+    vec3
+    NullAudioImplementation::getSourcePosition
+    ()
+    const
+    {
+        return mSourcePosition;
+    }
+
+    void
+    NullAudioImplementation::setSourcePosition
+    (const vec3& pos)
+    {
+        mSourcePosition = pos;
+    }
+
+    float
+    NullAudioImplementation::getVolume
+    ()
+    const
+    {
+        return mVolume;
+    }
+
+    void
+    NullAudioImplementation::setVolume
+    (float volume)
+    {
+        mVolume = volume;
+    }
+
+    AudioStatus
+    NullAudioImplementation::getState
+    ()
+    {
+        return mState;
+    }
+
+    unsigned int
+    NullAudioImplementation::getSampleOffset
+    ()
+    const
+    {
+        return mSampleOffset;
+    }
+
+    void
+    NullAudioImplementation::setSampleOffset
+    (unsigned int offset)
+    {
+        mSampleOffset = offset;
+    }
+
+    int
+    NullAudioImplementation::getDurationInSamples
+    ()
+    {
+        return 0;
+    }
+
+    bool
+    NullAudioImplementation::loadFromDefinition
+    ()
+    {
+        mParent.get().setLoaded(true);
+        return true;
+    }
+
+    // NullAudioComponent ======================================================
+
+    NullAudioComponent::NullAudioComponent
+    ()
+        : AudioComponent(),
+          mVolume(1.0f)
+    {
+        LOG_TRACE("NullAudioComponent: Constructing");
+    }
+
+    NullAudioComponent::~NullAudioComponent
+    ()
+    {
+        LOG_TRACE("NullAudioComponent: Destructing");
+    }
+
+    bool
+    NullAudioComponent::init
+    ()
+    {
+        LOG_DEBUG("NullAudioComponent: Initialising...");
+        mVoicesPlaying.assign(mVoices.size(), false);
+        return true;
+    }
+
+    void
+    NullAudioComponent::setListenerPosition
+    (const vec3& pos)
+    {
+        mListenerPosition = pos;
+    }
+
+    void
+    NullAudioComponent::setVolume
+    (float volume)
+    {
+        mVolume = volume;
+    }
+
+    float
+    NullAudioComponent::getVolume
+    ()
+    {
+        return mVolume;
+    }
+
+    AudioRuntime&
+    NullAudioComponent::getAudioRuntime
+    (AudioDefinition& def)
+    {
+        auto& audioCache = getProjectRuntime().getAudioCache();
+        auto& aRunt = audioCache.getRuntime(def);
+
+        if (!aRunt.getImpl())
+        {
+            aRunt.setImpl(make_shared<NullAudioImplementation>(aRunt));
+        }
+        return aRunt;
+    }
+
+    bool
+    NullAudioComponent::startVoice
+    (size_t voice, AudioRuntime& runtime, const vec3&)
+    {
+        if (voice >= mVoicesPlaying.size()) return false;
+        mVoicesPlaying[voice] = runtime.getLooping();
+        return true;
+    }
+
+    void
+    NullAudioComponent::releaseVoice
+    (size_t voice)
+    {
+        if (voice < mVoicesPlaying.size()) mVoicesPlaying[voice] = false;
+    }
+
+    bool
+    NullAudioComponent::isVoicePlaying
+    (size_t voice)
+    const
+    {
+        return voice < mVoicesPlaying.size() && mVoicesPlaying[voice];
+    }
+
+    void
+    NullAudioComponent::setVoicePosition
+    (size_t, const vec3&)
+    {
+    }
+}
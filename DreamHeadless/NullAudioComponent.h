@@ -0,0 +1,79 @@
+#pragma once
+
+#include <DreamCore.h>
+
+#include <vector>
+
+using octronic::dream::AudioComponent;
+using octronic::dream::AudioDefinition;
+using octronic::dream::AudioRuntime;
+using octronic::dream::AudioRuntimeImplementation;
+using octronic::dream::AudioStatus;
+using std::vector;
+
+namespace octronic::dream::headless
+{
+    /**
+     * @brief Audio runtime that decodes nothing. It loads immediately and
+     * only keeps the state a script can query.
+     */
+    class NullAudioImplementation : public AudioRuntimeImplementation
+    {
+    public:
+        NullAudioImplementation(AudioRuntime& parent);
+
+        void play() override;
+        void pause() override;
+        void stop() override;
+
+        vec3 getSourcePosition() const override;
+        void setSourcePosition(const vec3& pos) override;
+
+        float getVolume() const override;
+        void  setVolume(float volume) override;
+
+        AudioStatus getState() override;
+
+        unsigned int getSampleOffset() const override;
+        void         setSampleOffset(unsigned int offset) override;
+
+        int getDurationInSamples() override;
+
+        bool loadFromDefinition() override;
+
+    private:
+        AudioStatus mState;
+        vec3 mSourcePosition;
+        float mVolume;
+        unsigned int mSampleOffset;
+    };
+
+    /**
+     * @brief The NullAudioComponent runs the audio path without a device,
+     * for headless runs and benchmarks. Voices are taken and released as
+     * usual. Looping voices play until stopped, and one shots end on the
+     * next update.
+     */
+    class NullAudioComponent : public AudioComponent
+    {
+    public:
+        NullAudioComponent();
+        ~NullAudioComponent() override;
+
+        bool init() override;
+        void setListenerPosition(const vec3&) override;
+        void setVolume(float) override;
+        float getVolume() override;
+        AudioRuntime& getAudioRuntime(AudioDefinition& def) override;
+
+    protected:
+        bool startVoice(size_t voice, AudioRuntime& runtime, const vec3& position) override;
+        void releaseVoice(size_t voice) override;
+        bool isVoicePlaying(size_t voice) const override;
+        void setVoicePosition(size_t voice, const vec3& position) override;
+
+    private:
+        float mVolume;
+        vector<bool> mVoicesPlaying;
+    };
+}
@@ -1,5 +1,6 @@
 #include "OpenALAudioComponent.h"
 #include "OpenALImplementation.h"
+#include "OpenALStreamImplementation.h"
 
 #include <iostream>
 
@@ -22,6 +23,14 @@ namespace octronic::dream::open_al
   ()
   {
     LOG_TRACE("AudioComponent: Destructing");
+
+    if (!mVoiceSources.empty())
+    {
+      stopAllVoices();
+      alDeleteSources(static_cast<ALsizei>(mVoiceSources.size()), &mVoiceSources[0]);
+      mVoiceSources.clear();
+    }
+
     alcMakeContextCurrent(nullptr);
 
     if (mContext != nullptr)
@@ -47,6 +56,16 @@ namespace octronic::dream::open_al
     alcMakeContextCurrent(mContext);
     vec3 position(0.0f);
     setListenerPosition(position);
+
+    mVoiceSources.resize(mVoices.size());
+    alGetError();
+    alGenSources(static_cast<ALsizei>(mVoiceSources.size()), &mVoiceSources[0]);
+    if (alGetError() != AL_NO_ERROR)
+    {
+      LOG_ERROR("AudioComponent: Unable to generate {} voice sources", mVoiceSources.size());
+      mVoiceSources.clear();
+      mVoices.clear();
+    }
     return true;
   }
 
@@ -54,6 +73,7 @@ namespace octronic::dream::open_al
   OpenALAudioComponent::setListenerPosition
   (const vec3& pos)
   {
+    mListenerPosition = pos;
     alListener3f(AL_POSITION, pos.x, pos.y, pos.z);
   }
 
@@ -80,7 +100,7 @@ namespace octronic::dream::open_al
     auto& audioCache = getProjectRuntime().getAudioCache();
     auto& aRunt = audioCache.getRuntime(def);
 
-    if (!aRunt.getLoaded())
+    if (!aRunt.getImpl())
     {
       shared_ptr<AudioLoader> loader;
 
@@ -97,10 +117,65 @@ namespace octronic::dream::open_al
         throw std::exception();
       }
 
-      auto aImpl = make_shared<OpenALImplementation>(aRunt);
+      shared_ptr<AudioRuntimeImplementation> aImpl;
+
+      if (def.getStream())
+      {
+        aImpl = make_shared<OpenALStreamImplementation>(aRunt);
+      }
+      else
+      {
+        aImpl = make_shared<OpenALImplementation>(aRunt);
+      }
+
       aRunt.setImpl(aImpl);
       aRunt.setAudioLoader(loader);
     }
     return aRunt;
   }
+
+  // Voices ====================================================================
+
+  bool
+  OpenALAudioComponent::startVoice
+  (size_t voice, AudioRuntime& runtime, const vec3& position)
+  {
+    auto impl = std::dynamic_pointer_cast<OpenALImplementation>(runtime.getImpl());
+    if (!impl || impl->getBuffer() == 0) return false;
+
+    // Every voice playing this asset shares the runtime's AL buffer
+    ALuint source = mVoiceSources[voice];
+    alSourcei(source, AL_BUFFER, static_cast<ALint>(impl->getBuffer()));
+    alSourcei(source, AL_LOOPING, runtime.getLooping() ? 1 : 0);
+    alSourcef(source, AL_GAIN, impl->getVolume());
+    alSource3f(source, AL_POSITION, position.x, position.y, position.z);
+    alSourcePlay(source);
+    return true;
+  }
+
+  void
+  OpenALAudioComponent::releaseVoice
+  (size_t voice)
+  {
+    ALuint source = mVoiceSources[voice];
+    alSourceStop(source);
+    alSourcei(source, AL_BUFFER, 0);
+  }
+
+  bool
+  OpenALAudioComponent::isVoicePlaying
+  (size_t voice)
+  const
+  {
+    ALint state = 0;
+    alGetSourcei(mVoiceSources[voice], AL_SOURCE_STATE, &state);
+    return state == AL_PLAYING || state == AL_PAUSED;
+  }
+
+  void
+  OpenALAudioComponent::setVoicePosition
+  (size_t voice, const vec3& position)
+  {
+    alSource3f(mVoiceSources[voice], AL_POSITION, position.x, position.y, position.z);
+  }
 }
@@ -27,8 +27,18 @@ namespace octronic::dream::open_al
     float getVolume() override;
     AudioRuntime& getAudioRuntime(AudioDefinition& def) override;
 
+  protected:
+    bool startVoice(size_t voice, AudioRuntime& runtime, const vec3& position) override;
+    void releaseVoice(size_t voice) override;
+    bool isVoicePlaying(size_t voice) const override;
+    void setVoicePosition(size_t voice, const vec3& position) override;
+
   private:
     ALCdevice*  mDevice;
     ALCcontext* mContext;
+    /**
+     * @brief One AL source per pooled voice, generated once in init.
+     */
+    std::vector<ALuint> mVoiceSources;
   };
 }
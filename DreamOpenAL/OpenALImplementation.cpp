@@ -17,7 +17,12 @@ namespace octronic::dream::open_al
   ()
   {
     LOG_DEBUG("OpenALImplementation: {}", __FUNCTION__);
-    if (mALBuffer!=0) alDeleteBuffers(1,&mALBuffer);
+    // Pooled voices may still have the buffer attached
+    if (mALBuffer!=0)
+    {
+      mParent.get().getProjectRuntime().getAudioComponent().stopVoices(mParent.get());
+      alDeleteBuffers(1,&mALBuffer);
+    }
     if (mALSource!=0) alDeleteSources(1,&mALSource);
   }
 
@@ -26,12 +31,44 @@ namespace octronic::dream::open_al
   ()
   {
     auto& parent = mParent.get();
-    auto& pr = parent.getProjectRuntime();
-    auto& ad = static_cast<AudioDefinition&>(parent.getDefinition());
     auto loader = parent.getAudioLoader();
 
     LOG_DEBUG("OpenALImplementation: {}", __FUNCTION__);
-    if (!loader->loadIntoBuffer(pr, ad)) return false;
+
+    if (parent.getLoadError()) return false;
+
+    // The file is read here as the StorageManager is not thread safe, the
+    // decode runs on the AudioComponent's loader pool so a few assets can
+    // decode at once. The load task is deferred until the decode has
+    // finished.
+    if (!mDecodeResult.valid())
+    {
+      auto& pr = parent.getProjectRuntime();
+      auto& ad = static_cast<AudioDefinition&>(parent.getDefinition());
+      if (!loader->readFileData(pr, ad)) return false;
+
+      auto& loaderPool = pr.getAudioComponent().getLoaderPool();
+      mDecodeResult = loaderPool.submit([loader]()
+      {
+        bool decoded = loader->decodeIntoBuffer();
+        loader->releaseData();
+        return decoded;
+      });
+      return false;
+    }
+
+    if (mDecodeResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+      return false;
+    }
+
+    if (!mDecodeResult.get())
+    {
+      LOG_ERROR("OpenALImplementation: Unable to decode {}", parent.getNameAndUuidString());
+      parent.setLoadError(true);
+      return false;
+    }
+
     if (!loadIntoAL()) return false;
     return true;
   }
@@ -263,10 +300,15 @@ namespace octronic::dream::open_al
           break;
       }
 
-      alBufferData(mALBuffer, mALFormat, &loader->getAudioBuffer()[0],
-          static_cast<ALsizei>(loader->getAudioBuffer().size()),
+      auto& audioBuffer = loader->getAudioBuffer();
+      alBufferData(mALBuffer, mALFormat, &audioBuffer[0],
+          static_cast<ALsizei>(audioBuffer.size()),
           loader->getSampleRate());
 
+      // AL keeps its own copy, don't hold the PCM twice
+      audioBuffer.clear();
+      audioBuffer.shrink_to_fit();
+
       alSourcei(mALSource, AL_BUFFER, static_cast<ALint>(mALBuffer));
       alSourcei(mALSource, AL_LOOPING, parent.getLooping() ? 1 : 0 );
     }
@@ -3,8 +3,10 @@
 #include "ALHeader.h"
 #include <DreamCore.h>
 #include <deque>
+#include <future>
 
 using std::deque;
+using std::future;
 using glm::vec3;
 using octronic::dream::AudioComponent;
 using octronic::dream::AudioDefinition;
@@ -59,5 +61,10 @@ namespace octronic::dream::open_al
         ALuint mALSource;
         ALuint mALBuffer;
         ALint mALDurationInSamples;
+        /**
+         * @brief Result of the asynchronous decode started by
+         * loadFromDefinition.
+         */
+        future<bool> mDecodeResult;
     };
 }
@@ -0,0 +1,346 @@
+#include "OpenALStreamImplementation.h"
+
+#include <chrono>
+
+using std::lock_guard;
+
+namespace octronic::dream::open_al
+{
+  const size_t OpenALStreamImplementation::STREAM_BUFFER_COUNT = 4;
+  const size_t OpenALStreamImplementation::STREAM_BUFFER_SIZE = 32768;
+  const unsigned int OpenALStreamImplementation::STREAM_THREAD_SLEEP_MS = 10;
+
+  OpenALStreamImplementation::OpenALStreamImplementation
+  (AudioRuntime& parent)
+    : OpenALImplementation(parent),
+      mSamplesPlayed(0),
+      mPlaying(false),
+      mEndOfStream(false),
+      mStreamThreadRunning(false)
+  {
+    LOG_DEBUG("OpenALStreamImplementation: {}", __FUNCTION__);
+  }
+
+  OpenALStreamImplementation::~OpenALStreamImplementation
+  ()
+  {
+    LOG_DEBUG("OpenALStreamImplementation: {}", __FUNCTION__);
+    stopStreamThread();
+
+    if (mALSource != 0) unqueueAllBuffers();
+
+    if (!mALStreamBuffers.empty())
+    {
+      alDeleteBuffers(static_cast<ALsizei>(mALStreamBuffers.size()), &mALStreamBuffers[0]);
+      mALStreamBuffers.clear();
+    }
+
+    auto loader = mParent.get().getAudioLoader();
+    if (loader) loader->closeStream();
+  }
+
+  bool
+  OpenALStreamImplementation::loadFromDefinition
+  ()
+  {
+    auto& parent = mParent.get();
+    auto& pr = parent.getProjectRuntime();
+    auto& ad = static_cast<AudioDefinition&>(parent.getDefinition());
+    auto loader = parent.getAudioLoader();
+
+    LOG_DEBUG("OpenALStreamImplementation: {}", __FUNCTION__);
+
+    stopStreamThread();
+
+    if (!loader->openStream(pr, ad)) return false;
+
+    lock_guard<mutex> lock(mStreamMutex);
+
+    if (mALSource == 0)
+    {
+      generateSource();
+    }
+    else
+    {
+      unqueueAllBuffers();
+    }
+
+    if (mALStreamBuffers.empty())
+    {
+      mALStreamBuffers.resize(STREAM_BUFFER_COUNT);
+      alGetError();
+      alGenBuffers(static_cast<ALsizei>(STREAM_BUFFER_COUNT), &mALStreamBuffers[0]);
+      if (alGetError() != AL_NO_ERROR)
+      {
+        LOG_ERROR("OpenALStreamImplementation: Unable to generate stream buffers");
+        mALStreamBuffers.clear();
+        parent.setLoadError(true);
+        return false;
+      }
+    }
+
+    if (mALSource == static_cast<ALuint>(-1))
+    {
+      LOG_ERROR("OpenALStreamImplementation: Unable to generate source");
+      parent.setLoadError(true);
+      return false;
+    }
+
+    switch(loader->getChannels())
+    {
+      case 1:
+        mALFormat = AL_FORMAT_MONO16;
+        break;
+      case 2:
+      default:
+        mALFormat = AL_FORMAT_STEREO16;
+        break;
+    }
+
+    // Looping is handled by rewinding the loader, not by the source
+    alSourcei(mALSource, AL_LOOPING, 0);
+
+    mStreamChunk.resize(STREAM_BUFFER_SIZE);
+    mSamplesPlayed = 0;
+    mPlaying = false;
+    mEndOfStream = false;
+
+    mStreamThreadRunning = true;
+    mStreamThread = thread(&OpenALStreamImplementation::streamThreadMain, this);
+
+    LOG_DEBUG("OpenALStreamImplementation: Streaming {}", parent.getNameAndUuidString());
+    parent.setLoaded(true);
+    return true;
+  }
+
+  void
+  OpenALStreamImplementation::play
+  ()
+  {
+    LOG_DEBUG("OpenALStreamImplementation: Playing source {}", mALSource);
+    lock_guard<mutex> lock(mStreamMutex);
+
+    ALint queued = 0;
+    alGetSourcei(mALSource, AL_BUFFERS_QUEUED, &queued);
+
+    if (queued == 0)
+    {
+      // Finished last time round, start again from the top
+      if (mEndOfStream)
+      {
+        mParent.get().getAudioLoader()->seekStream(0);
+        mSamplesPlayed = 0;
+        mEndOfStream = false;
+      }
+      primeBuffers();
+    }
+
+    alSourcePlay(mALSource);
+    mPlaying = true;
+  }
+
+  void
+  OpenALStreamImplementation::pause
+  ()
+  {
+    LOG_DEBUG("OpenALStreamImplementation: Pausing source {}", mALSource);
+    lock_guard<mutex> lock(mStreamMutex);
+    mPlaying = false;
+    alSourcePause(mALSource);
+  }
+
+  void
+  OpenALStreamImplementation::stop
+  ()
+  {
+    LOG_DEBUG("OpenALStreamImplementation: Stopping source {}", mALSource);
+    lock_guard<mutex> lock(mStreamMutex);
+    mPlaying = false;
+    unqueueAllBuffers();
+    mParent.get().getAudioLoader()->seekStream(0);
+    mSamplesPlayed = 0;
+    mEndOfStream = false;
+  }
+
+  AudioStatus
+  OpenALStreamImplementation::getState
+  ()
+  {
+    {
+      lock_guard<mutex> lock(mStreamMutex);
+      // The source may be briefly stopped while starved of buffers
+      if (mPlaying) return AUDIO_STATUS_PLAYING;
+    }
+    return OpenALImplementation::getState();
+  }
+
+  int
+  OpenALStreamImplementation::getDurationInSamples
+  ()
+  {
+    return static_cast<int>(mParent.get().getAudioLoader()->getDurationInSamples());
+  }
+
+  unsigned int
+  OpenALStreamImplementation::getSampleOffset
+  ()
+  const
+  {
+    lock_guard<mutex> lock(mStreamMutex);
+    ALint sampleOffset = 0;
+    alGetSourcei(mALSource, AL_SAMPLE_OFFSET, &sampleOffset);
+
+    unsigned long offset = mSamplesPlayed + sampleOffset;
+    unsigned long duration = mParent.get().getAudioLoader()->getDurationInSamples();
+    if (duration > 0) offset %= duration;
+    return static_cast<unsigned int>(offset);
+  }
+
+  void
+  OpenALStreamImplementation::setSampleOffset
+  (unsigned int offset)
+  {
+    LOG_DEBUG("OpenALStreamImplementation: {}", __FUNCTION__);
+    lock_guard<mutex> lock(mStreamMutex);
+    auto loader = mParent.get().getAudioLoader();
+
+    unqueueAllBuffers();
+
+    if (!loader->seekStream(offset))
+    {
+      loader->seekStream(0);
+      offset = 0;
+    }
+
+    mSamplesPlayed = offset;
+    mEndOfStream = false;
+
+    if (mPlaying)
+    {
+      primeBuffers();
+      alSourcePlay(mALSource);
+    }
+  }
+
+  void
+  OpenALStreamImplementation::streamThreadMain
+  ()
+  {
+    LOG_DEBUG("OpenALStreamImplementation: Stream thread started for {}",
+              mParent.get().getNameAndUuidString());
+
+    while (mStreamThreadRunning)
+    {
+      {
+        lock_guard<mutex> lock(mStreamMutex);
+        updateStream();
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(STREAM_THREAD_SLEEP_MS));
+    }
+
+    LOG_DEBUG("OpenALStreamImplementation: Stream thread finished");
+  }
+
+  void
+  OpenALStreamImplementation::updateStream
+  ()
+  {
+    if (!mPlaying) return;
+
+    auto loader = mParent.get().getAudioLoader();
+    size_t bytesPerSample = loader->getChannels() * 2;
+
+    // Refill the buffers the source has finished with
+    ALint processed = 0;
+    alGetSourcei(mALSource, AL_BUFFERS_PROCESSED, &processed);
+
+    while (processed-- > 0)
+    {
+      ALuint buffer = 0;
+      alSourceUnqueueBuffers(mALSource, 1, &buffer);
+
+      ALint size = 0;
+      alGetBufferi(buffer, AL_SIZE, &size);
+      mSamplesPlayed += size / bytesPerSample;
+
+      if (!mEndOfStream) fillBuffer(buffer);
+    }
+
+    ALint state = 0;
+    alGetSourcei(mALSource, AL_SOURCE_STATE, &state);
+
+    if (state != AL_PLAYING)
+    {
+      ALint queued = 0;
+      alGetSourcei(mALSource, AL_BUFFERS_QUEUED, &queued);
+
+      if (queued > 0)
+      {
+        LOG_DEBUG("OpenALStreamImplementation: Source {} starved, restarting", mALSource);
+        alSourcePlay(mALSource);
+      }
+      else
+      {
+        LOG_DEBUG("OpenALStreamImplementation: Source {} reached end of stream", mALSource);
+        mPlaying = false;
+      }
+    }
+  }
+
+  bool
+  OpenALStreamImplementation::fillBuffer
+  (ALuint buffer)
+  {
+    auto& parent = mParent.get();
+    auto loader = parent.getAudioLoader();
+
+    long bytes = loader->readStream(&mStreamChunk[0], mStreamChunk.size());
+
+    if (bytes == 0 && parent.getLooping() && loader->seekStream(0))
+    {
+      bytes = loader->readStream(&mStreamChunk[0], mStreamChunk.size());
+    }
+
+    if (bytes <= 0)
+    {
+      mEndOfStream = true;
+      return false;
+    }
+
+    alBufferData(buffer, mALFormat, &mStreamChunk[0],
+                 static_cast<ALsizei>(bytes), loader->getSampleRate());
+    alSourceQueueBuffers(mALSource, 1, &buffer);
+    return true;
+  }
+
+  void
+  OpenALStreamImplementation::primeBuffers
+  ()
+  {
+    for (ALuint buffer : mALStreamBuffers)
+    {
+      if (!fillBuffer(buffer)) break;
+    }
+  }
+
+  void
+  OpenALStreamImplementation::unqueueAllBuffers
+  ()
+  {
+    // Stopping marks every queued buffer as processed, detaching the
+    // buffer from a stopped source then empties the queue.
+    alSourceStop(mALSource);
+    alSourcei(mALSource, AL_BUFFER, 0);
+  }
+
+  void
+  OpenALStreamImplementation::stopStreamThread
+  ()
+  {
+    mStreamThreadRunning = false;
+    if (mStreamThread.joinable())
+    {
+      mStreamThread.join();
+    }
+  }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "OpenALImplementation.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using std::atomic;
+using std::mutex;
+using std::thread;
+using std::vector;
+
+namespace octronic::dream::open_al
+{
+    /**
+     * @brief Streaming AudioRuntime data for an OpenAL based Audio Clip.
+     *
+     * Rather than decoding the whole clip into a single AL buffer, a
+     * background thread decodes it a chunk at a time into a small ring of
+     * buffers queued on the source with alSourceQueueBuffers. Buffers are
+     * refilled as the source finishes playing them, so only
+     * STREAM_BUFFER_COUNT * STREAM_BUFFER_SIZE bytes of PCM are resident.
+     */
+    class OpenALStreamImplementation : public OpenALImplementation
+    {
+    public:
+        static const size_t STREAM_BUFFER_COUNT;
+        static const size_t STREAM_BUFFER_SIZE;
+        static const unsigned int STREAM_THREAD_SLEEP_MS;
+
+        OpenALStreamImplementation(AudioRuntime& parent);
+        ~OpenALStreamImplementation();
+
+        bool loadFromDefinition() override;
+
+        void play() override;
+        void pause() override;
+        void stop() override;
+
+        AudioStatus getState() override;
+
+        int getDurationInSamples() override;
+        unsigned int getSampleOffset() const override;
+        void setSampleOffset(unsigned int offset) override;
+
+    protected:
+        void streamThreadMain();
+        void updateStream();
+        bool fillBuffer(ALuint buffer);
+        void primeBuffers();
+        void unqueueAllBuffers();
+        void stopStreamThread();
+
+    protected:
+        vector<ALuint> mALStreamBuffers;
+        vector<uint8_t> mStreamChunk;
+        /**
+         * @brief Samples in buffers that have already been played and
+         * unqueued, AL_SAMPLE_OFFSET is relative to the current queue.
+         */
+        unsigned long mSamplesPlayed;
+        /**
+         * @brief Set while the clip should be playing, the stream thread
+         * restarts the source if it runs dry before the clip has finished.
+         */
+        bool mPlaying;
+        bool mEndOfStream;
+        atomic<bool> mStreamThreadRunning;
+        mutable mutex mStreamMutex;
+        thread mStreamThread;
+    };
+}
@@ -2,6 +2,10 @@
 
 using octronic::dream::tool::DreamToolContext;
 
+#ifdef DREAM_TRACK_ALLOCATIONS
+DREAM_ALLOCATION_HOOK()
+#endif
+
 int main(int argc,char** argv)
 {
     LOG_LEVEL(LOG_LEVEL_ERROR);
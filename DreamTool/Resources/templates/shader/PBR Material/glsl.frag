@@ -22,11 +22,15 @@ uniform samplerCube uIrradianceTexture;
 uniform samplerCube uPreFilterTexture;
 uniform sampler2D uBrdfLutTexture;
 
-// lights
-uniform vec3 uLightPositions[4];
-uniform vec3 uLightColors[4];
-
-uniform vec3 uCameraPosition;
+// camera & lights, shared by every shader
+layout (std140) uniform FrameData
+{
+    mat4 uProjectionMatrix;
+    mat4 uViewMatrix;
+    vec4 uCameraPosition;
+    vec4 uLightPositions[4];
+    vec4 uLightColors[4];
+};
 
 const float PI = 3.14159265359;
 // ----------------------------------------------------------------------------
@@ -106,7 +110,7 @@ void main()
        
     // input lighting data
     vec3 N = getNormalFromMap();
-    vec3 V = normalize(uCameraPosition - WorldPos);
+    vec3 V = normalize(uCameraPosition.xyz - WorldPos);
     vec3 R = reflect(-V, N); 
 
     // calculate reflectance at normal incidence; if dia-electric (like plastic) use F0 
@@ -119,11 +123,11 @@ void main()
     for(int i = 0; i < 4; ++i) 
     {
         // calculate per-light radiance
-        vec3 L = normalize(uLightPositions[i] - WorldPos);
+        vec3 L = normalize(uLightPositions[i].xyz - WorldPos);
         vec3 H = normalize(V + L);
-        float distance = length(uLightPositions[i] - WorldPos);
+        float distance = length(uLightPositions[i].xyz - WorldPos);
         float attenuation = 1.0 / (distance * distance);
-        vec3 radiance = uLightColors[i] * attenuation;
+        vec3 radiance = uLightColors[i].rgb * attenuation;
 
         // Cook-Torrance BRDF
         float NDF = DistributionGGX(N, H, roughness);   
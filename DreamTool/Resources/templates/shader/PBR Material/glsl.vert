@@ -12,8 +12,14 @@ out vec2 TexCoords;
 out vec3 WorldPos;
 out vec3 Normal;
 
-uniform mat4 uProjectionMatrix;
-uniform mat4 uViewMatrix;
+layout (std140) uniform FrameData
+{
+    mat4 uProjectionMatrix;
+    mat4 uViewMatrix;
+    vec4 uCameraPosition;
+    vec4 uLightPositions[4];
+    vec4 uLightColors[4];
+};
 uniform mat4 uModelMatrixArray[100];
 
 void main()
@@ -9,11 +9,11 @@
 layout (location = 0) in vec4 coord;
 out vec2 texpos;
 
-uniform mat4 uModel;
-uniform mat4 uProj;
+// Sprite corners are transformed into screen space by the SpriteBatch
+uniform mat4 uProjectionMatrix;
 
 void main(void) 
 {
-  gl_Position = uProj * uModel * vec4(coord.xy, 0, 1);
+  gl_Position = uProjectionMatrix * vec4(coord.xy, 0, 1);
   texpos = coord.zw;
 }
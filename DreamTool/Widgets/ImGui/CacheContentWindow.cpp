@@ -4,6 +4,37 @@
 
 namespace octronic::dream::tool
 {
+  namespace
+  {
+    string
+    FormatBytes
+    (size_t bytes)
+    {
+      char buffer[32] = {0};
+      if (bytes >= 1024 * 1024)
+      {
+        snprintf(buffer, 32, "%.1f MB", bytes / (1024.0 * 1024.0));
+      }
+      else
+      {
+        snprintf(buffer, 32, "%.1f KB", bytes / 1024.0);
+      }
+      return buffer;
+    }
+
+    void
+    FormatTitle
+    (char* title, const CacheMemoryUsage& usage)
+    {
+      // Fixed ID after ### so the header stays open as the sizes change
+      snprintf(title, 128, "%s Cache (%zu) %s RAM, %s GPU###%sCache",
+               usage.name.c_str(), usage.runtimes,
+               FormatBytes(usage.cpuBytes).c_str(),
+               FormatBytes(usage.gpuBytes).c_str(),
+               usage.name.c_str());
+    }
+  }
+
   CacheContentWindow::CacheContentWindow
   (DreamToolContext& proj) : ImGuiWidget(proj,false)
   {
@@ -30,10 +61,20 @@ namespace octronic::dream::tool
         auto& pRunt = pRuntOpt.value();
 
         char title[128] = {0};
-        string formatStr = "%s Cache (%d)";
+
+        size_t cpuTotal = 0;
+        size_t gpuTotal = 0;
+        auto memoryUsage = pRunt.getCacheMemoryUsage();
+        for (auto& usage : memoryUsage)
+        {
+          cpuTotal += usage.cpuBytes;
+          gpuTotal += usage.gpuBytes;
+        }
+        ImGui::Text("Total %s RAM, %s GPU", FormatBytes(cpuTotal).c_str(), FormatBytes(gpuTotal).c_str());
+        ImGui::Separator();
 
         auto& audioCache = pRunt.getAudioCache();
-        snprintf(title, 128, formatStr.c_str(), "Audio", audioCache.runtimeCount());
+        FormatTitle(title, memoryUsage[0]);
         if (ImGui::CollapsingHeader(title))
         {
           for (auto instance : audioCache.getRuntimeVector())
@@ -43,7 +84,7 @@ namespace octronic::dream::tool
         }
 
         auto& fontCache = pRunt.getFontCache();
-        snprintf(title, 128, formatStr.c_str(), "Font", fontCache.runtimeCount());
+        FormatTitle(title, memoryUsage[1]);
 
         if (ImGui::CollapsingHeader(title))
         {
@@ -54,7 +95,7 @@ namespace octronic::dream::tool
         }
 
         auto& materialCache = pRunt.getMaterialCache();
-        snprintf(title, 128, formatStr.c_str(), "Material", materialCache.runtimeCount());
+        FormatTitle(title, memoryUsage[2]);
         if (ImGui::CollapsingHeader(title))
         {
           for (auto& instance : materialCache.getRuntimeVector())
@@ -64,7 +105,7 @@ namespace octronic::dream::tool
         }
 
         auto& modelCache = pRunt.getModelCache();
-        snprintf(title, 128, formatStr.c_str(), "Model", modelCache.runtimeCount());
+        FormatTitle(title, memoryUsage[3]);
         if (ImGui::CollapsingHeader(title))
         {
           for (auto& instance : modelCache.getRuntimeVector())
@@ -74,7 +115,7 @@ namespace octronic::dream::tool
         }
 
         auto& scriptCache = pRunt.getScriptCache();
-        snprintf(title, 128, formatStr.c_str(), "Script", scriptCache.runtimeCount());
+        FormatTitle(title, memoryUsage[4]);
         if (ImGui::CollapsingHeader(title))
         {
           for (auto& instance : scriptCache.getRuntimeVector())
@@ -84,7 +125,7 @@ namespace octronic::dream::tool
         }
 
         auto& shaderCache = pRunt.getShaderCache();
-        snprintf(title, 128, formatStr.c_str(), "Shader", shaderCache.runtimeCount());
+        FormatTitle(title, memoryUsage[5]);
         if (ImGui::CollapsingHeader(title))
         {
           for (auto& instance : shaderCache.getRuntimeVector())
@@ -94,7 +135,7 @@ namespace octronic::dream::tool
         }
 
         auto& textureCache = pRunt.getTextureCache();
-        snprintf(title, 128, formatStr.c_str(), "Texture", textureCache.runtimeCount());
+        FormatTitle(title, memoryUsage[6]);
         if (ImGui::CollapsingHeader(title))
         {
           for (auto& instance : textureCache.getRuntimeVector())
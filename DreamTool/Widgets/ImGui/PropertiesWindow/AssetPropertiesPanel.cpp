@@ -348,6 +348,24 @@ namespace octronic::dream::tool
 
         ImGui::Text("Format: %s", audioDef.getFormat().c_str());
 
+        bool loop = audioDef.getLoop();
+        if (ImGui::Checkbox("Loop",&loop))
+        {
+          audioDef.setLoop(loop);
+        }
+
+        bool stream = audioDef.getStream();
+        if (ImGui::Checkbox("Stream",&stream))
+        {
+          audioDef.setStream(stream);
+        }
+
+        int priority = audioDef.getPriority();
+        if (ImGui::InputInt("Priority",&priority))
+        {
+          audioDef.setPriority(priority);
+        }
+
         if(ImGui::Button("Remove File"))
         {
           audioDef.setFormat("");
@@ -779,6 +797,12 @@ namespace octronic::dream::tool
 
       ImGui::Text("Model Format: %s", def.getFormat().c_str());
 
+      bool compact = def.getCompactVertices();
+      if (ImGui::Checkbox("Compact Vertices",&compact))
+      {
+        def.setCompactVertices(compact);
+      }
+
       if (ImGui::Button("Reload Asset"))
       {
         auto& modelRuntime = modelCache.getRuntime(def);
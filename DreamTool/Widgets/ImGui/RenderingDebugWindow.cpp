@@ -3,15 +3,24 @@
 #include "DreamToolContext.h"
 
 #include <DreamCore.h>
+#include <nfd.h>
+
+#include <cinttypes>
 
 using octronic::dream::Project;
 using octronic::dream::ProjectRuntime;
+using octronic::dream::Profiler;
+using octronic::dream::ProfilerEvent;
+using octronic::dream::AllocationTracker;
+using octronic::dream::FrameStats;
+using octronic::dream::FrameStatSummary;
 
 namespace octronic::dream::tool
 {
   RenderingDebugWindow::RenderingDebugWindow
   (DreamToolContext& state)
-    : ImGuiWidget(state,false)
+    : ImGuiWidget(state,false),
+      mFrameHistory(FRAME_HISTORY_SIZE, 0.f)
   {
   }
 
@@ -38,11 +47,7 @@ namespace octronic::dream::tool
 
         if (ImGui::CollapsingHeader("Statistics"))
         {
-          ImGui::PushItemWidth(-1);
-          ImGui::PlotLines("FPS",&pRunt.getFrameDurationHistory()[0],
-              ProjectRuntime::MaxFrameCount, 0, "FPS", 0.f, 250.f, ImVec2(0,50));
-          ImGui::PopItemWidth();
-          ImGui::Text("Average: %.3f",pRunt.getAverageFramerate());
+          drawFrameStats(pRunt.getFrameStats());
           ImGui::Separator();
           ImGui::Text("Geometry Triangles Drawn: %ld", ModelMesh::TrianglesDrawn);
           ImGui::Text("Geometry Meshes Drawn: %ld", ModelMesh::MeshesDrawn);
@@ -51,6 +56,35 @@ namespace octronic::dream::tool
           ImGui::Text("Shadow Triangles Drawn: %ld", ModelMesh::ShadowTrianglesDrawn);
           ImGui::Text("Shadow Meshes Drawn: %ld", ModelMesh::ShadowMeshesDrawn);
           ImGui::Text("Shadow Draw Calls: %ld", ModelMesh::ShadowDrawCalls);
+          ImGui::Separator();
+          if (AllocationTracker::IsInstalled())
+          {
+            auto allocations = AllocationTracker::GetLastFrame();
+            ImGui::Text("Frame Allocations: %" PRIu64 " (%" PRIu64 " bytes)", allocations.allocations, allocations.bytes);
+            ImGui::Text("Frame Frees: %" PRIu64, allocations.frees);
+          }
+          else
+          {
+            ImGui::Text("Allocation tracking is off, build with DREAM_TRACK_ALLOCATIONS");
+          }
+        }
+
+        if (ImGui::CollapsingHeader("Occlusion Culling"))
+        {
+          bool occlusion = gfx.getOcclusionCulling();
+          if (ImGui::Checkbox("Enabled", &occlusion))
+          {
+            gfx.setOcclusionCulling(occlusion);
+          }
+          auto& culler = gfx.getOcclusionCuller();
+          ImGui::Text("Depth Buffer: %dx%d", culler.getWidth(), culler.getHeight());
+          ImGui::Text("Occluder Triangles: %ld", culler.getOccluderTriangleCount());
+          ImGui::Text("Meshes Occluded: %ld", gfx.getRenderQueue().getOccludedCount());
+        }
+
+        if (ImGui::CollapsingHeader("Profiler"))
+        {
+          drawProfiler();
         }
 
         if(ImGui::CollapsingHeader("Shadow Pass"))
@@ -65,6 +99,136 @@ namespace octronic::dream::tool
     }
   }
 
+  void
+  RenderingDebugWindow::drawFrameStats
+  (const FrameStats& stats)
+  {
+    auto& frameTimes = stats.getHistogram(FRAME_STAT_FRAME_TIME);
+    size_t count = frameTimes.getHistory(mFrameHistory.data(), mFrameHistory.size(), 1e-6);
+
+    ImGui::PushItemWidth(-1);
+    ImGui::PlotLines("Frame ms", mFrameHistory.data(), count, 0, "Frame ms", 0.f, 50.f, ImVec2(0,50));
+    ImGui::PopItemWidth();
+    ImGui::Text("Average: %.3f FPS", stats.getAverageFrameRate());
+    ImGui::Text("Hitches: %" PRIu64 " (last on frame %" PRIu64 ", %.3f ms)", stats.getHitchCount(),
+                stats.getLastHitchFrame(), stats.getLastHitchTime() / 1000000.0);
+
+    ImGui::Columns(5);
+    ImGui::Text("Stat");
+    ImGui::NextColumn();
+    ImGui::Text("p50");
+    ImGui::NextColumn();
+    ImGui::Text("p95");
+    ImGui::NextColumn();
+    ImGui::Text("p99");
+    ImGui::NextColumn();
+    ImGui::Text("max");
+    ImGui::NextColumn();
+    ImGui::Separator();
+
+    for (int i = 0; i < FRAME_STAT_COUNT; i++)
+    {
+      auto stat = static_cast<FrameStat>(i);
+      FrameStatSummary summary = stats.getSummary(stat);
+      // Times are in ns, show them in ms
+      double scale = stat <= FRAME_STAT_DESTRUCTION_TIME ? 1e-6 : 1.0;
+
+      ImGui::Text("%s", FrameStats::GetStatName(stat));
+      ImGui::NextColumn();
+      ImGui::Text("%.3f", summary.p50 * scale);
+      ImGui::NextColumn();
+      ImGui::Text("%.3f", summary.p95 * scale);
+      ImGui::NextColumn();
+      ImGui::Text("%.3f", summary.p99 * scale);
+      ImGui::NextColumn();
+      ImGui::Text("%.3f", summary.max * scale);
+      ImGui::NextColumn();
+    }
+    ImGui::Columns(1);
+  }
+
+  void
+  RenderingDebugWindow::drawProfiler
+  ()
+  {
+    auto& ctx = getContext();
+
+    bool enabled = Profiler::IsEnabled();
+    if (ImGui::Checkbox("Enabled##Profiler", &enabled))
+    {
+      Profiler::SetEnabled(enabled);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Clear##Profiler"))
+    {
+      Profiler::Clear();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Export Chrome Trace..."))
+    {
+      nfdchar_t *tracePath = NULL;
+      nfdfilteritem_t filter[1] = {{"Chrome Trace", "json"}};
+      nfdresult_t result = NFD_SaveDialog(&tracePath, filter, 1, ctx.getLastDirectory().c_str(), "trace.json");
+
+      if (result == NFD_OKAY)
+      {
+        auto& fm = ctx.getStorageManager();
+        auto& traceFile = fm.openFile(tracePath);
+        if (!traceFile.writeString(Profiler::ToChromeTrace().dump()))
+        {
+          LOG_ERROR("RenderingDebugWindow: Unable to write trace to {}", tracePath);
+        }
+        fm.closeFile(traceFile);
+        NFD_FreePath(tracePath);
+      }
+      else if (result == NFD_ERROR)
+      {
+        LOG_ERROR("RenderingDebugWindow: Error: {}", NFD_GetError());
+      }
+    }
+
+    if (!enabled) return;
+
+    ImGui::Text("Frame %" PRIu64 ": %.3f ms", Profiler::GetFrameNumber(),
+                Profiler::GetLastFrameDuration() / 1000000.0);
+
+    auto events = Profiler::GetLastFrameEvents();
+    auto threadNames = Profiler::GetThreadNames();
+
+    ImGui::Separator();
+    ImGui::Columns(4);
+    ImGui::Text("Zone");
+    ImGui::NextColumn();
+    ImGui::Text("Thread");
+    ImGui::NextColumn();
+    ImGui::Text("ms");
+    ImGui::NextColumn();
+    ImGui::Text("Allocs");
+    ImGui::NextColumn();
+    ImGui::Separator();
+
+    size_t rows = 0;
+    for (auto& event : events)
+    {
+      if (rows++ >= MAX_PROFILER_ROWS)
+      {
+        ImGui::Text("%zu more...", events.size() - MAX_PROFILER_ROWS);
+        break;
+      }
+      ImGui::Text("%*s%s", static_cast<int>(event.depth * 2), "", event.name);
+      ImGui::NextColumn();
+      ImGui::Text("%s", event.thread < threadNames.size() ? threadNames[event.thread].c_str() : "");
+      ImGui::NextColumn();
+      ImGui::Text("%.3f", (event.end - event.start) / 1000000.0);
+      ImGui::NextColumn();
+      ImGui::Text("%" PRIu64, event.allocations);
+      ImGui::NextColumn();
+    }
+    ImGui::Columns(1);
+  }
+
+  const size_t RenderingDebugWindow::MAX_PROFILER_ROWS = 500;
+  const size_t RenderingDebugWindow::FRAME_HISTORY_SIZE = 240;
   ImVec2 RenderingDebugWindow::UV1 = ImVec2(0,1);
   ImVec2 RenderingDebugWindow::UV2 = ImVec2(1,0);
 }
@@ -2,6 +2,10 @@
 
 #include "ImGuiWidget.h"
 
+#include <vector>
+
+using std::vector;
+
 namespace octronic::dream::tool
 {
     class RenderingDebugWindow
@@ -12,5 +16,14 @@ namespace octronic::dream::tool
 
         void draw() override;
         static ImVec2 UV1, UV2;
+        const static size_t MAX_PROFILER_ROWS;
+        const static size_t FRAME_HISTORY_SIZE;
+
+    private:
+        void drawProfiler();
+        void drawFrameStats(const FrameStats& stats);
+
+    private:
+        vector<float> mFrameHistory;
     };
 }